@@ -15,6 +15,7 @@
 #ifndef STARKWARE_AIR_COMPONENTS_KECCAK_KECCAK_H_
 #define STARKWARE_AIR_COMPONENTS_KECCAK_KECCAK_H_
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -180,6 +181,35 @@ class KeccakComponent {
     return theta_aux_columns;
   }
 
+  /*
+    Collects the values written to a diluted column during one round, so that they are written to
+    the trace in a single batch (see TableCheckCellView::WriteTrace()).
+  */
+  class ColumnWrites {
+   public:
+    explicit ColumnWrites(size_t capacity) {
+      indices_.reserve(capacity);
+      values_.reserve(capacity);
+    }
+
+    void Add(uint64_t index, uint64_t value) {
+      indices_.push_back(index);
+      values_.push_back(value);
+    }
+
+    void Flush(
+        const TableCheckCellView<FieldElementT>& column,
+        gsl::span<const gsl::span<FieldElementT>> trace) {
+      column.WriteTrace(indices_, values_, trace);
+      indices_.clear();
+      values_.clear();
+    }
+
+   private:
+    std::vector<uint64_t> indices_;
+    std::vector<uint64_t> values_;
+  };
+
   /*
     Append field elements from src, represented as chunks of 25 bytes, to dst.
   */
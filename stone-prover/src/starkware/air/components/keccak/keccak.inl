@@ -50,15 +50,20 @@ std::vector<FieldElementT> KeccakComponent<FieldElementT>::WriteTrace(
   }
 
   // Parse inputs and outputs to diluted form.
-  parse_to_diluted_.WriteTrace(
+  const std::vector<std::vector<std::optional<uint64_t>>> diluted_io = parse_to_diluted_.WriteTrace(
       input_output, std::array{state_begin_column_, state_end_column_}, component_index, trace);
 
-  // Init state.
+  // Init state from the values written to state_begin_column_. They are taken from the output of
+  // parse_to_diluted_ rather than read back from the diluted pool, which other instances may be
+  // writing to concurrently.
+  const std::vector<std::optional<uint64_t>>& state_begin = diluted_io[0];
   std::array<std::array<std::array<uint64_t, 64>, 5>, 5> state{};
   for (size_t i = 0; i < 5; ++i) {
     for (size_t j = 0; j < 5; ++j) {
       for (size_t k = 0; k < 64; ++k) {
-        state.at(i)[j][k] = state_begin_column_.Get(RowIndex(i, j, k) + 2048 * component_index);
+        const std::optional<uint64_t>& value = state_begin.at(RowIndex(i, j, k));
+        ASSERT_RELEASE(value.has_value(), "Uninitialized value");
+        state.at(i)[j][k] = *value;
       }
     }
   }
@@ -70,6 +75,23 @@ std::vector<FieldElementT> KeccakComponent<FieldElementT>::WriteTrace(
     diluted_mask++;
   }
 
+  // The writes of each round are collected per column and written to the trace in batches.
+  std::vector<std::vector<ColumnWrites>> parity_writes(
+      3, std::vector<ColumnWrites>(5, ColumnWrites(64)));
+  ColumnWrites after_theta_rho_pi_writes(25 * 64);
+  std::vector<std::vector<std::vector<ColumnWrites>>> theta_aux_writes;
+  theta_aux_writes.reserve(5);
+  for (size_t i = 0; i < 5; ++i) {
+    theta_aux_writes.emplace_back();
+    theta_aux_writes.back().reserve(5);
+    for (size_t j = 0; j < 5; ++j) {
+      theta_aux_writes.back().emplace_back(theta_aux_columns_[i][j].size(), ColumnWrites(64));
+    }
+  }
+  ColumnWrites chi_iota_aux0_writes(25 * 64);
+  ColumnWrites state_writes(25 * 64);
+  ColumnWrites chi_iota_aux2_writes(25 * 64);
+
   // Begin computation.
   for (size_t round = 0; round < 24; ++round) {
     // Compute parity bits.
@@ -80,9 +102,9 @@ std::vector<FieldElementT> KeccakComponent<FieldElementT>::WriteTrace(
             state[0][j][k] + state[1][j][k] + state[2][j][k] + state[3][j][k] + state[4][j][k];
         parities.at(j)[k] = diluted_mask & value;
         for (size_t b = 0; b < 3; ++b) {
-          parity_columns_[b][j].WriteTrace(
+          parity_writes[b][j].Add(
               round + 32 * (RowIndex(0, 0, k) + 2048 * component_index),
-              diluted_mask & (value >> b), trace);
+              diluted_mask & (value >> b));
         }
         rotated_parity_columns_[j].SetCell(
             trace, round + 32 * (RowIndex(0, 0, (k + 1) % 64) + 2048 * component_index),
@@ -103,12 +125,12 @@ std::vector<FieldElementT> KeccakComponent<FieldElementT>::WriteTrace(
                                  parities.at((j + 1) % 5)[(k + 63) % 64];
           const size_t rho_k = (k + kOffsets.at(i)[j]) % 64;
           after_theta_rho_pi_state.at(pi_i)[pi_j][rho_k] = diluted_mask & value;
-          after_theta_rho_pi_column_.WriteTrace(
+          after_theta_rho_pi_writes.Add(
               round + 32 * (RowIndex(pi_i, pi_j, rho_k) + 2048 * component_index),
-              diluted_mask & value, trace);
-          theta_aux_columns_[pi_i][pi_j][n].WriteTrace(
+              diluted_mask & value);
+          theta_aux_writes[pi_i][pi_j][n].Add(
               adjusted_round + 32 * (RowIndex(0, 0, rho_k) + 2048 * component_index),
-              diluted_mask & (value >> 1), trace);
+              diluted_mask & (value >> 1));
         }
       }
     }
@@ -125,20 +147,37 @@ std::vector<FieldElementT> KeccakComponent<FieldElementT>::WriteTrace(
             value += 2 * diluted_mask;
           }
           state.at(i)[j][k] = diluted_mask & (value >> 1);
-          chi_iota_aux0_column_.WriteTrace(
-              round + 32 * (RowIndex(i, j, k) + 2048 * component_index), diluted_mask & value,
-              trace);
+          chi_iota_aux0_writes.Add(
+              round + 32 * (RowIndex(i, j, k) + 2048 * component_index), diluted_mask & value);
           if (round < 23) {
-            state_column_.WriteTrace(
+            state_writes.Add(
                 round + 1 + 32 * (RowIndex(i, j, k) + 2048 * component_index),
-                diluted_mask & (value >> 1), trace);
+                diluted_mask & (value >> 1));
           }
-          chi_iota_aux2_column_.WriteTrace(
+          chi_iota_aux2_writes.Add(
               round + 32 * (RowIndex(i, j, k) + 2048 * component_index),
-              diluted_mask & (value >> 2), trace);
+              diluted_mask & (value >> 2));
+        }
+      }
+    }
+
+    // Write the values of this round to the trace.
+    for (size_t b = 0; b < 3; ++b) {
+      for (size_t j = 0; j < 5; ++j) {
+        parity_writes[b][j].Flush(parity_columns_[b][j], trace);
+      }
+    }
+    after_theta_rho_pi_writes.Flush(after_theta_rho_pi_column_, trace);
+    for (size_t i = 0; i < 5; ++i) {
+      for (size_t j = 0; j < 5; ++j) {
+        for (size_t n = 0; n < theta_aux_columns_[i][j].size(); ++n) {
+          theta_aux_writes[i][j][n].Flush(theta_aux_columns_[i][j][n], trace);
         }
       }
     }
+    chi_iota_aux0_writes.Flush(chi_iota_aux0_column_, trace);
+    state_writes.Flush(state_column_, trace);
+    chi_iota_aux2_writes.Flush(chi_iota_aux2_column_, trace);
   }
   return input_output;
 }
@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -86,8 +87,11 @@ class ParseToDilutedComponent {
     input is the list of field elements as they appear in the input column.
     One instance includes n_instances_ * n_repetitions_ * n_words_ field elements.
     Writes also the output columns in diluted_columns.
+    Returns, for each repetition, the values written to diluted_columns[rep], indexed by their row
+    within the instance (i.e., without the total_period_ * component_index offset). Rows that are
+    not written hold std::nullopt.
   */
-  void WriteTrace(
+  std::vector<std::vector<std::optional<uint64_t>>> WriteTrace(
       gsl::span<const FieldElementT> input,
       gsl::span<const TableCheckCellView<FieldElementT>> diluted_columns, uint64_t component_index,
       gsl::span<const gsl::span<FieldElementT>> trace) const;
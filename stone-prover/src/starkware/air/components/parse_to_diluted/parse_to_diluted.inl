@@ -28,13 +28,20 @@ size_t ParseToDilutedComponent<FieldElementT>::RowIndex(size_t m) const {
 }
 
 template <typename FieldElementT>
-void ParseToDilutedComponent<FieldElementT>::WriteTrace(
+std::vector<std::vector<std::optional<uint64_t>>> ParseToDilutedComponent<FieldElementT>::WriteTrace(
     gsl::span<const FieldElementT> input,
     gsl::span<const TableCheckCellView<FieldElementT>> diluted_columns, uint64_t component_index,
     gsl::span<const gsl::span<FieldElementT>> trace) const {
   ASSERT_RELEASE(input.size() == n_instances_ * n_repetitions_ * n_words_, "Invalid input size.");
   const FieldElementT spacing_shift = FieldElementT::FromUint(Pow2(diluted_spacing_));
   const auto two = FieldElementT::FromUint(2);
+  // The diluted values of the last instance, which are written to diluted_columns in one batch.
+  std::vector<uint64_t> diluted_indices;
+  std::vector<uint64_t> diluted_values;
+  diluted_indices.reserve(n_total_bits_);
+  diluted_values.reserve(n_total_bits_);
+  std::vector<std::vector<std::optional<uint64_t>>> written_values(
+      n_repetitions_, std::vector<std::optional<uint64_t>>(total_period_));
   for (size_t rep = 0; rep < n_repetitions_; ++rep) {
     for (size_t instance = 0; instance < n_instances_; ++instance) {
       for (size_t index = n_total_bits_; index < extended_dimensions_total_size_; ++index) {
@@ -65,7 +72,8 @@ void ParseToDilutedComponent<FieldElementT>::WriteTrace(
 
         const std::vector<bool> bits = current_input.ToStandardForm().ToBoolVector();
         for (int64_t j = state_rep_[i] - 1; j >= 0; --j, --bit_index) {
-          single_column_cumulative_sum *= two;
+          // Multiply by 2.
+          single_column_cumulative_sum += single_column_cumulative_sum;
           if (bits[j]) {
             single_column_cumulative_sum += FieldElementT::One();
           }
@@ -85,15 +93,19 @@ void ParseToDilutedComponent<FieldElementT>::WriteTrace(
                                                                  total_period_ * component_index)),
               value);
           if (instance == n_instances_ - 1) {
-            diluted_columns[rep].WriteTrace(
-                row_bit_index + total_period_ * component_index,
-                (value - two * prev_value).ToStandardForm().AsUint(), trace);
+            diluted_indices.push_back(row_bit_index + total_period_ * component_index);
+            diluted_values.push_back((value - two * prev_value).ToStandardForm().AsUint());
+            written_values[rep].at(row_bit_index) = diluted_values.back();
             prev_value = value;
           }
         }
       }
     }
+    diluted_columns[rep].WriteTrace(diluted_indices, diluted_values, trace);
+    diluted_indices.clear();
+    diluted_values.clear();
   }
+  return written_values;
 }
 
 }  // namespace starkware
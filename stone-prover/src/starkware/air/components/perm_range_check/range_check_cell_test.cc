@@ -14,6 +14,7 @@
 
 #include "starkware/air/components/perm_range_check/range_check_cell.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -108,5 +109,78 @@ TEST_F(RangeCheckCellTest, InvalidRanges) {
       HasSubstr("rc_max must be smaller than"));
 }
 
+/*
+  Tests that the batched WriteTrace() writes the same trace and values as writing the values one at
+  a time, and that it rejects an index that was already written.
+*/
+TEST_F(RangeCheckCellTest, BatchedWriteTrace) {
+  Prng prng;
+  const auto indices = prng.UniformDistinctIntVector<uint64_t>(0, trace_length - 1, values_length);
+  const auto values = prng.UniformIntVector<uint64_t>(0, 1000, values_length);
+
+  RangeCheckCell<FieldElementT> expected_cell("test", ctx, trace_length);
+  std::vector<std::vector<FieldElementT>> expected_trace = {
+      std::vector<FieldElementT>(trace_length, FieldElementT::Zero())};
+  for (size_t i = 0; i < values_length; ++i) {
+    expected_cell.WriteTrace(indices[i], values[i], SpanAdapter(expected_trace));
+  }
+
+  RangeCheckCell<FieldElementT> rc_cell("test", ctx, trace_length);
+  std::vector<std::vector<FieldElementT>> trace = {
+      std::vector<FieldElementT>(trace_length, FieldElementT::Zero())};
+  const size_t batch_size = 7;
+  for (size_t begin = 0; begin < values_length; begin += batch_size) {
+    const size_t size = std::min(batch_size, values_length - begin);
+    rc_cell.WriteTrace(
+        gsl::make_span(indices).subspan(begin, size), gsl::make_span(values).subspan(begin, size),
+        SpanAdapter(trace));
+  }
+
+  EXPECT_EQ(trace, expected_trace);
+  for (size_t i = 0; i < values_length; ++i) {
+    EXPECT_EQ(rc_cell.Get(indices[i]), values[i]);
+  }
+  EXPECT_EQ(std::move(rc_cell).Consume(), std::move(expected_cell).Consume());
+
+  RangeCheckCell<FieldElementT> twice_cell("test", ctx, trace_length);
+  const std::vector<uint64_t> repeated_indices = {3, 5, 3};
+  EXPECT_ASSERT(
+      twice_cell.WriteTrace(repeated_indices, std::vector<uint64_t>{1, 2, 3}, SpanAdapter(trace)),
+      HasSubstr("Table check unit 3 was already written."));
+}
+
+/*
+  Tests that the batched TableCheckCellView::WriteTrace() maps the indices through the view like
+  the single value WriteTrace().
+*/
+TEST_F(RangeCheckCellTest, ViewBatchedWriteTrace) {
+  ctx.AddVirtualColumn("test/view", VirtualColumn(/*column=*/0, /*step=*/4, /*row_offset=*/3));
+  Prng prng;
+  const uint64_t view_length = trace_length / 4;
+  const size_t n_values = view_length / 4;
+  const auto indices = prng.UniformDistinctIntVector<uint64_t>(0, view_length - 1, n_values);
+  const auto values = prng.UniformIntVector<uint64_t>(0, 1000, n_values);
+
+  RangeCheckCell<FieldElementT> expected_cell("test", ctx, trace_length);
+  const TableCheckCellView<FieldElementT> expected_view(&expected_cell, "test/view", ctx);
+  std::vector<std::vector<FieldElementT>> expected_trace = {
+      std::vector<FieldElementT>(trace_length, FieldElementT::Zero())};
+  for (size_t i = 0; i < n_values; ++i) {
+    expected_view.WriteTrace(indices[i], values[i], SpanAdapter(expected_trace));
+  }
+
+  RangeCheckCell<FieldElementT> rc_cell("test", ctx, trace_length);
+  const TableCheckCellView<FieldElementT> view(&rc_cell, "test/view", ctx);
+  std::vector<std::vector<FieldElementT>> trace = {
+      std::vector<FieldElementT>(trace_length, FieldElementT::Zero())};
+  view.WriteTrace(indices, values, SpanAdapter(trace));
+
+  EXPECT_EQ(trace, expected_trace);
+  for (size_t i = 0; i < n_values; ++i) {
+    EXPECT_EQ(view.Get(indices[i]), values[i]);
+    EXPECT_EQ(trace[0][4 * indices[i] + 3], FieldElementT::FromUint(values[i]));
+  }
+}
+
 }  // namespace
 }  // namespace starkware
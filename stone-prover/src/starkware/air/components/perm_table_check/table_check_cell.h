@@ -58,6 +58,14 @@ class TableCheckCell {
   */
   void WriteTrace(uint64_t index, uint64_t value, gsl::span<const gsl::span<FieldElementT>> trace);
 
+  /*
+    Same as WriteTrace() above, for a batch of values. The lock is taken once for the entire batch,
+    and the values are converted to field elements before it is taken.
+  */
+  void WriteTrace(
+      gsl::span<const uint64_t> indices, gsl::span<const uint64_t> values,
+      gsl::span<const gsl::span<FieldElementT>> trace);
+
   std::vector<uint64_t> Consume() && { return std::move(values_); }
 
   uint64_t Get(uint64_t index) const {
@@ -96,6 +104,13 @@ class TableCheckCellView {
     parent_->WriteTrace(view_.At(index), value, trace);
   }
 
+  /*
+    Writes a batch of values to the trace. See TableCheckCell::WriteTrace().
+  */
+  void WriteTrace(
+      gsl::span<const uint64_t> indices, gsl::span<const uint64_t> values,
+      gsl::span<const gsl::span<FieldElementT>> trace) const;
+
   uint64_t Get(uint64_t index) const { return parent_->Get(view_.At(index)); }
 
  private:
@@ -34,4 +34,40 @@ void TableCheckCell<FieldElementT>::WriteTrace(
   vc_.SetCell(trace, index, FieldElementT::FromUint(value));
 }
 
+template <typename FieldElementT>
+void TableCheckCell<FieldElementT>::WriteTrace(
+    const gsl::span<const uint64_t> indices, const gsl::span<const uint64_t> values,
+    const gsl::span<const gsl::span<FieldElementT>> trace) {
+  ASSERT_RELEASE(indices.size() == values.size(), "Mismatching number of indices and values.");
+  // Convert the values to field elements before taking the lock.
+  std::vector<FieldElementT> field_values;
+  field_values.reserve(values.size());
+  for (const uint64_t value : values) {
+    field_values.push_back(FieldElementT::FromUint(value));
+  }
+
+  std::unique_lock lock(*write_trace_lock_);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const uint64_t index = indices[i];
+    ASSERT_RELEASE(
+        is_initialized_[index] == false,
+        "Table check unit " + std::to_string(index) + " was already written.");
+    is_initialized_[index] = true;
+    values_[index] = values[i];
+    vc_.SetCell(trace, index, field_values[i]);
+  }
+}
+
+template <typename FieldElementT>
+void TableCheckCellView<FieldElementT>::WriteTrace(
+    const gsl::span<const uint64_t> indices, const gsl::span<const uint64_t> values,
+    const gsl::span<const gsl::span<FieldElementT>> trace) const {
+  std::vector<uint64_t> parent_indices;
+  parent_indices.reserve(indices.size());
+  for (const uint64_t index : indices) {
+    parent_indices.push_back(view_.At(index));
+  }
+  parent_->WriteTrace(parent_indices, values, trace);
+}
+
 }  // namespace starkware
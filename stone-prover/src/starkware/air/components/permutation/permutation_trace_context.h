@@ -38,8 +38,11 @@ class PermutationTraceContext : public TraceContext {
     Trace trace = air_->GetTrace();
     // Initialize interaction_data_ with relevant data to interaction trace.
     for (size_t i = 0; i < AirT::kNOriginalCols; i++) {
-      originals_.push_back(trace.GetColumn(i).template As<FieldElementT>());
-      perms_.push_back(trace.GetColumn(i + AirT::kNOriginalCols).template As<FieldElementT>());
+      const auto original = trace.GetColumn(i).AsSpan().template As<FieldElementT>();
+      const auto perm =
+          trace.GetColumn(i + AirT::kNOriginalCols).AsSpan().template As<FieldElementT>();
+      originals_.emplace_back(original.begin(), original.end());
+      perms_.emplace_back(perm.begin(), perm.end());
     }
     return trace;
   }
@@ -48,6 +48,34 @@ class RangeCheckComponent {
     }
   }
 
+  /*
+    Returns the values WriteTrace() writes for value, in the order of the component's rows.
+  */
+  std::vector<FieldElementT> ComputeValues(const uint64_t value) const {
+    std::vector<FieldElementT> values;
+    values.reserve(component_height_);
+    for (uint64_t j = 0; j < component_height_; j++) {
+      const uint64_t shifted_value = (j < 64) ? (value >> j) : 0;
+      values.push_back(FieldElementT::FromUint(shifted_value));
+    }
+    return values;
+  }
+
+  /*
+    Same as WriteTrace(), given the values of the component as returned by ComputeValues(). Use
+    this when the same value is written many times.
+  */
+  void WriteTrace(
+      gsl::span<const FieldElementT> values, const uint64_t component_index,
+      const gsl::span<const gsl::span<FieldElementT>> trace) const {
+    ASSERT_RELEASE(column_.column < trace.size(), "Invalid column index");
+    ASSERT_RELEASE(values.size() == component_height_, "Wrong number of values");
+    const uint64_t row_offset = component_index * component_height_;
+    for (uint64_t j = 0; j < component_height_; j++) {
+      column_.SetCell(trace, row_offset + j, values[j]);
+    }
+  }
+
  private:
   /*
     The period of the component (inside the virtual column).
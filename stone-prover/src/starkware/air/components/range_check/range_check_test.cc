@@ -0,0 +1,63 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/air/components/range_check/range_check.h"
+
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/air/components/trace_generation_context.h"
+#include "starkware/algebra/fields/test_field_element.h"
+#include "starkware/math/math.h"
+#include "starkware/randomness/prng.h"
+
+namespace starkware {
+namespace {
+
+using FieldElementT = TestFieldElement;
+
+/*
+  Checks that writing the values returned by ComputeValues() gives the same trace as writing the
+  value directly.
+*/
+TEST(RangeCheckComponent, ComputeValuesMatchesWriteTrace) {
+  const uint64_t component_height = 16;
+  const uint64_t n_components = 8;
+  TraceGenerationContext ctx;
+  ctx.AddVirtualColumn("test/column", VirtualColumn(/*column=*/1, /*step=*/2, /*row_offset=*/1));
+  const RangeCheckComponent<FieldElementT> range_check("test", ctx, component_height);
+  Prng prng;
+
+  const uint64_t trace_length = 2 * component_height * n_components;
+  std::vector<std::vector<FieldElementT>> expected_trace(
+      2, std::vector<FieldElementT>(trace_length, FieldElementT::Zero()));
+  std::vector<std::vector<FieldElementT>> trace = expected_trace;
+  const std::vector<gsl::span<FieldElementT>> expected_spans(
+      expected_trace.begin(), expected_trace.end());
+  const std::vector<gsl::span<FieldElementT>> spans(trace.begin(), trace.end());
+
+  for (uint64_t component_index = 0; component_index < n_components; ++component_index) {
+    const auto value = prng.UniformInt<uint64_t>(0, Pow2(component_height) - 1);
+    range_check.WriteTrace(value, component_index, expected_spans);
+    const std::vector<FieldElementT> values = range_check.ComputeValues(value);
+    ASSERT_EQ(values.size(), component_height);
+    range_check.WriteTrace(values, component_index, spans);
+  }
+  EXPECT_EQ(trace, expected_trace);
+}
+
+}  // namespace
+}  // namespace starkware
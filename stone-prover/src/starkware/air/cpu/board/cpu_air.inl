@@ -20,6 +20,7 @@
 #include "starkware/air/cpu/builtin/poseidon/poseidon_builtin_prover_context.h"
 #include "starkware/air/cpu/builtin/range_check/range_check_builtin_prover_context.h"
 #include "starkware/air/cpu/builtin/signature/signature_builtin_prover_context.h"
+#include "starkware/utils/huge_page_arena.h"
 #include "starkware/utils/profiling.h"
 #include "starkware/utils/task_manager.h"
 
@@ -74,9 +75,14 @@ constexpr uint64_t CpuAir<FieldElementT, LayoutId>::EcOpRatio() const {
 template <typename FieldElementT, int LayoutId>
 void CpuAir<FieldElementT, LayoutId>::BuildPeriodicColumns(
     const FieldElementT& gen, [[maybe_unused]] Builder* builder) const {
+  // The values of the constant periodic columns below only depend on the layout, so they are
+  // computed once per process (which matters when many proofs are generated by the same process,
+  // see prover_server.h).
+
   // Pedersen builtin.
   if constexpr (CpuAir::kHasPedersenBuiltin) {  // NOLINT: clang-tidy if constexpr bug.
-    for (const auto& [column_name, column_values] : hash_factory_.ComputePeriodicColumnValues()) {
+    static const auto kPedersenColumnValues = hash_factory_.ComputePeriodicColumnValues();
+    for (const auto& [column_name, column_values] : kPedersenColumnValues) {
       const auto& column_info = this->ctx_.GetPeriodicColumn(column_name);
       builder->AddPeriodicColumn(
           PeriodicColumn<FieldElementT>(
@@ -87,11 +93,12 @@ void CpuAir<FieldElementT, LayoutId>::BuildPeriodicColumns(
 
   // Periodic columns for ecdsa constant column.
   if constexpr (CpuAir::kHasEcdsaBuiltin) {  // NOLINT: clang-tidy if constexpr bug.
-    const auto& [points_x, points_y] = EcPoint<FieldElementT>::ToCoordinatesAndExpand(
+    static const auto kEcdsaGeneratorPoints = EcPoint<FieldElementT>::ToCoordinatesAndExpand(
         TwosPowersOfPoint(
             this->ecdsa__sig_config_.generator_point, this->ecdsa__sig_config_.alpha,
             CpuAir::kEcdsaElementBits),
         CpuAir::kEcdsaElementHeight);
+    const auto& [points_x, points_y] = kEcdsaGeneratorPoints;
 
     const auto& column_info_x = this->ctx_.GetPeriodicColumn("ecdsa/generator_points/x");
     builder->AddPeriodicColumn(
@@ -137,9 +144,8 @@ std::pair<CpuAirProverContext1<FieldElementT>, Trace> CpuAir<FieldElementT, Layo
   ASSERT_RELEASE(cpu_trace.size() == n_steps_, "Wrong number of trace entries.");
 
   ProfilingBlock init_trace_block("Init trace memory");
-  std::vector<std::vector<FieldElementT>> trace(
-      this->kNumColumnsFirst,
-      std::vector<FieldElementT>(this->trace_length_, FieldElementT::Zero()));
+  std::vector<HugePageVector<FieldElementT>> trace =
+      Trace::AllocateZeros<FieldElementT>(this->kNumColumnsFirst, this->trace_length_);
   std::vector<gsl::span<FieldElementT>> trace_spans(trace.begin(), trace.end());
   init_trace_block.CloseBlock();
 
@@ -148,11 +154,16 @@ std::pair<CpuAirProverContext1<FieldElementT>, Trace> CpuAir<FieldElementT, Layo
 
   {
     ProfilingBlock cpu_component_block("CpuComponent::WriteTrace");
-    TaskManager::GetInstance().ParallelFor(cpu_trace.size(), [&](const TaskInfo& task_info) {
-      const size_t idx = task_info.start_idx;
-      cpu_component_.WriteTrace(
-          idx, cpu_trace[idx], *memory, &memory_pool, &rc16_pool, trace_spans);
-    });
+    const auto decoded_instructions = cpu_component_.DecodeInstructions(cpu_trace, *memory);
+    TaskManager::GetInstance().ParallelFor(
+        cpu_trace.size(),
+        [&](const TaskInfo& task_info) {
+          const size_t begin = task_info.start_idx;
+          cpu_component_.WriteTrace(
+              begin, cpu_trace.subspan(begin, task_info.end_idx - begin), decoded_instructions,
+              *memory, &memory_pool, &rc16_pool, trace_spans);
+        },
+        CpuComponent<FieldElementT>::kWriteTraceBatchSize);
   }
 
   // Write public memory in trace.
@@ -294,9 +305,8 @@ std::pair<CpuAirProverContext1<FieldElementT>, Trace> CpuAir<FieldElementT, Layo
 template <typename FieldElementT, int LayoutId>
 Trace CpuAir<FieldElementT, LayoutId>::GetInteractionTrace(
     CpuAirProverContext1<FieldElementT>&& cpu_air_prover_context1) const {
-  std::vector<std::vector<FieldElementT>> trace(
-      this->kNumColumnsSecond,
-      std::vector<FieldElementT>(this->trace_length_, FieldElementT::Zero()));
+  std::vector<HugePageVector<FieldElementT>> trace =
+      Trace::AllocateZeros<FieldElementT>(this->kNumColumnsSecond, this->trace_length_);
 
   const std::vector<FieldElementT> interaction_elms_vec = {
       this->memory__multi_column_perm__perm__interaction_elm_,
@@ -14,6 +14,7 @@
 
 #include "starkware/air/cpu/board/cpu_air.h"
 
+#include <algorithm>
 #include <optional>
 #include <sstream>
 #include <string>
@@ -27,10 +28,12 @@
 #include "starkware/air/cpu/board/cpu_air_test_instructions_trace.bin.h"
 #include "starkware/air/cpu/board/cpu_air_trace_context.h"
 #include "starkware/air/test_utils.h"
+#include "starkware/algebra/field_to_int.h"
 #include "starkware/algebra/fields/prime_field_element.h"
 #include "starkware/error_handling/test_utils.h"
 #include "starkware/statement/cpu/cpu_air_statement.h"
 #include "starkware/utils/json.h"
+#include "starkware/utils/huge_page_arena.h"
 #include "starkware/utils/json_builder.h"
 
 namespace starkware {
@@ -202,6 +205,60 @@ TEST_F(CpuAirTest, WrongRcMinRcMax) {
   ExpectTraceGenerationAssert("Invalid value for rc_max: Must be >= rc_min.");
 }
 
+/*
+  Checks DecodeInstructions() against decoding the instruction of each step, and that writing the
+  CPU component trace in batches gives the same trace as writing it one step at a time.
+*/
+TEST_F(CpuAirTest, CpuComponentBatchedWriteTrace) {
+  statement = std::make_unique<CpuAirStatement>(
+      GetParams()["statement"], public_input.Build(), GetPrivateInput());
+  // The test program uses the "plain" layout.
+  using PlainAirT = CpuAir<FieldElementT, 10>;
+  const auto& air = dynamic_cast<const PlainAirT&>(statement->GetAir());
+  const TraceGenerationContext ctx = air.GetTraceGenerationContext();
+  const std::vector<TraceEntry<FieldElementT>> cpu_trace =
+      TraceEntry<FieldElementT>::ReadFile(&trace_file);
+  const CpuMemory<FieldElementT> memory = CpuMemory<FieldElementT>::ReadFile(&memory_file);
+  const CpuComponent<FieldElementT> cpu_component("cpu", ctx);
+
+  const auto decoded_instructions = cpu_component.DecodeInstructions(cpu_trace, memory);
+  for (const auto& entry : cpu_trace) {
+    const uint64_t encoded_instruction = ToUint64(memory.At(entry.pc));
+    const auto expected = DecodedInstruction::DecodeInstruction(encoded_instruction);
+    const auto& cached = decoded_instructions.at(entry.pc);
+    EXPECT_EQ(cached.decoded.off0, expected.off0);
+    EXPECT_EQ(cached.decoded.off1, expected.off1);
+    EXPECT_EQ(cached.decoded.off2, expected.off2);
+    EXPECT_EQ(cached.decoded.flags, expected.flags);
+    EXPECT_EQ(cached.encoded_value, FieldElementT::FromUint(encoded_instruction));
+    ASSERT_EQ(cached.opcode_rc_values.size(), CpuComponent<FieldElementT>::kOffsetBits);
+    for (size_t j = 0; j < cached.opcode_rc_values.size(); ++j) {
+      EXPECT_EQ(cached.opcode_rc_values[j], FieldElementT::FromUint(expected.flags >> j));
+    }
+  }
+
+  // Writes the trace in batches of batch_size steps.
+  const auto write_trace = [&](size_t batch_size) {
+    std::vector<HugePageVector<FieldElementT>> trace =
+        Trace::AllocateZeros<FieldElementT>(PlainAirT::kNumColumnsFirst, air.TraceLength());
+    std::vector<gsl::span<FieldElementT>> trace_spans(trace.begin(), trace.end());
+    MemoryCell<FieldElementT> memory_pool("mem_pool", ctx, air.TraceLength());
+    RangeCheckCell<FieldElementT> rc16_pool("rc16_pool", ctx, air.TraceLength());
+    for (size_t begin = 0; begin < cpu_trace.size(); begin += batch_size) {
+      cpu_component.WriteTrace(
+          begin,
+          gsl::make_span(cpu_trace).subspan(begin, std::min(batch_size, cpu_trace.size() - begin)),
+          decoded_instructions, memory, &memory_pool, &rc16_pool, trace_spans);
+    }
+    return trace;
+  };
+
+  const auto per_step_trace = write_trace(1);
+  EXPECT_EQ(write_trace(5), per_step_trace);
+  EXPECT_EQ(write_trace(CpuComponent<FieldElementT>::kWriteTraceBatchSize), per_step_trace);
+  run_test = true;
+}
+
 }  // namespace
 }  // namespace cpu
 }  // namespace starkware
@@ -24,6 +24,7 @@
 #include "starkware/air/components/diluted_check/diluted_check_cell.h"
 #include "starkware/air/components/keccak/keccak.h"
 #include "starkware/air/components/memory/memory.h"
+#include "starkware/utils/json.h"
 
 namespace starkware {
 namespace cpu {
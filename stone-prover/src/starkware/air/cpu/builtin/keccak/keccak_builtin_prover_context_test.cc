@@ -0,0 +1,282 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/air/cpu/builtin/keccak/keccak_builtin_prover_context.h"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/air/cpu/board/cpu_air_definition.h"
+#include "starkware/algebra/fields/prime_field_element.h"
+#include "starkware/crypt_tools/hash_context/pedersen_hash_context.h"
+#include "starkware/randomness/prng.h"
+#include "starkware/stl_utils/containers.h"
+#include "starkware/utils/huge_page_arena.h"
+#include "starkware/utils/task_manager.h"
+
+namespace starkware {
+namespace cpu {
+namespace {
+
+using FieldElementT = PrimeFieldElement<252, 0>;
+using KeccakContextT = KeccakBuiltinProverContext<FieldElementT>;
+using KeccakComponentT = KeccakComponent<FieldElementT>;
+using DilutedCheckCellT = diluted_check_cell::DilutedCheckCell<FieldElementT>;
+
+// The all_cairo layout, which has a keccak builtin and the fewest trace columns among such layouts.
+class AirDefinition : public CpuAirDefinition<FieldElementT, 9> {
+ public:
+  using CpuAirDefinition<FieldElementT, 9>::CpuAirDefinition;
+  void BuildPeriodicColumns(const FieldElementT& /*gen*/, Builder* /*builder*/) const override {}
+};
+
+/*
+  The trace and the pools written by the keccak builtin. Only the digest of each column is kept, as
+  a full trace for several keccak instances takes hundreds of megabytes.
+*/
+struct KeccakTraceDigest {
+  std::vector<std::vector<uint64_t>> column_digests;
+  std::vector<uint64_t> diluted_pool;
+  std::vector<uint64_t> memory_addresses;
+  std::vector<FieldElementT> memory_values;
+
+  bool operator==(const KeccakTraceDigest& other) const {
+    return column_digests == other.column_digests && diluted_pool == other.diluted_pool &&
+           memory_addresses == other.memory_addresses && memory_values == other.memory_values;
+  }
+
+  /*
+    Returns a single number summarizing the digest, to compare with a known answer.
+  */
+  uint64_t Fingerprint() const {
+    uint64_t fingerprint = 0;
+    const auto add = [&fingerprint](uint64_t value) {
+      fingerprint = fingerprint * 0x100000001b3ULL + value;
+    };
+    for (const auto& column_digest : column_digests) {
+      std::for_each(column_digest.begin(), column_digest.end(), add);
+    }
+    std::for_each(diluted_pool.begin(), diluted_pool.end(), add);
+    std::for_each(memory_addresses.begin(), memory_addresses.end(), add);
+    for (const FieldElementT& value : memory_values) {
+      const auto limbs = value.ToStandardForm();
+      std::for_each(limbs.begin(), limbs.end(), add);
+    }
+    return fingerprint;
+  }
+
+  /*
+    Returns the memory value at the given address.
+  */
+  FieldElementT MemoryAt(uint64_t address) const {
+    const auto it = std::find(memory_addresses.begin(), memory_addresses.end(), address);
+    ASSERT_RELEASE(it != memory_addresses.end(), "Address was not written.");
+    return memory_values.at(it - memory_addresses.begin());
+  }
+};
+
+class KeccakBuiltinProverContextTest : public ::testing::Test {
+ public:
+  static constexpr size_t kNInstances = 2;
+  static constexpr size_t kNInvocations = AirDefinition::kDilutedNBits;
+  static constexpr size_t kDilutedSpacing = AirDefinition::kDilutedSpacing;
+  static constexpr uint64_t kBeginAddr = 5000;
+  static constexpr size_t kIoLength = 2 * KeccakComponentT::kStateSizeInWords;
+  const uint64_t trace_length = kNInstances * AirDefinition::kKeccakRatio * kNInvocations *
+                                AirDefinition::kCpuComponentHeight;
+
+  KeccakBuiltinProverContextTest()
+      : definition_(
+            trace_length, FieldElementT::Zero(), FieldElementT::One(), MemSegments(),
+            GetStandardPedersenHashContext()),
+        ctx_(definition_.GetTraceGenerationContext()) {
+    // Random inputs, with a few invocations left empty (and hence computed on the zero state).
+    for (size_t invocation = 0; invocation < kNInstances * kNInvocations; ++invocation) {
+      std::array<std::byte, KeccakComponentT::kStateSizeInBytes> state{};
+      if (!IsEmptyInvocation(invocation)) {
+        const auto bytes = prng_.RandomByteVector(state.size());
+        std::copy(bytes.begin(), bytes.end(), state.begin());
+        inputs_.emplace(invocation, state);
+      }
+    }
+  }
+
+  /*
+    The builtin parallelizes over the threads of the TaskManager singleton, which is created with
+    --n_threads on first use.
+  */
+  static void SetUpTestSuite() { FLAGS_n_threads = std::max<uint32_t>(FLAGS_n_threads, 4); }
+
+  static bool IsEmptyInvocation(size_t invocation) { return invocation % 5 == 3; }
+
+  /*
+    Writes the trace with KeccakBuiltinProverContext, which writes the instances in parallel.
+  */
+  KeccakTraceDigest WriteTraceParallel() const {
+    return WriteTrace([&](MemoryCell<FieldElementT>* memory_pool, DilutedCheckCellT* diluted_pool,
+                          gsl::span<const gsl::span<FieldElementT>> trace) {
+      std::map<uint64_t, KeccakContextT::Input> inputs;
+      for (const auto& [invocation, state] : inputs_) {
+        inputs.emplace(invocation, ToBuiltinInput(state));
+      }
+      KeccakContextT(
+          "keccak", ctx_, memory_pool, diluted_pool, kBeginAddr, kNInstances, kDilutedSpacing,
+          kNInvocations, inputs)
+          .WriteTrace(trace);
+    });
+  }
+
+  /*
+    Writes the same trace by calling KeccakComponent::WriteTrace() for one instance after the
+    other.
+  */
+  KeccakTraceDigest WriteTraceSerial() const {
+    return WriteTrace([&](MemoryCell<FieldElementT>* memory_pool, DilutedCheckCellT* diluted_pool,
+                          gsl::span<const gsl::span<FieldElementT>> trace) {
+      std::vector<DilutedCheckCellT*> diluted_pools(4, diluted_pool);
+      const KeccakComponentT component(
+          "keccak/keccak", ctx_, kNInvocations, diluted_pools, kDilutedSpacing);
+      const MemoryCellView<FieldElementT> mem_input_output(
+          memory_pool, "keccak/input_output", ctx_);
+      for (size_t instance = 0; instance < kNInstances; ++instance) {
+        std::vector<std::byte> input(KeccakComponentT::kStateSizeInBytes * kNInvocations);
+        for (size_t i = 0; i < kNInvocations; ++i) {
+          const auto it = inputs_.find(instance * kNInvocations + i);
+          if (it != inputs_.end()) {
+            std::copy(
+                it->second.begin(), it->second.end(),
+                input.begin() + i * KeccakComponentT::kStateSizeInBytes);
+          }
+        }
+        const auto io = component.WriteTrace(input, instance, trace);
+        for (size_t i = 0; i < kNInvocations * kIoLength; ++i) {
+          const uint64_t index = instance * kNInvocations * kIoLength + i;
+          mem_input_output.WriteTrace(index, kBeginAddr + index, io[i], trace);
+        }
+      }
+    });
+  }
+
+ private:
+  static MemSegmentAddresses MemSegments() {
+    MemSegmentAddresses segments;
+    for (const char* name : {"execution", "program", "pedersen", "range_check", "ecdsa", "bitwise",
+                             "ec_op", "keccak", "poseidon"}) {
+      segments[name] = MemorySegment{1000, 1000};
+    }
+    return segments;
+  }
+
+  /*
+    Converts a keccak state to the input of the builtin: 8 words of 25 bytes each, little-endian.
+  */
+  static KeccakContextT::Input ToBuiltinInput(gsl::span<const std::byte> state) {
+    KeccakContextT::Input input;
+    for (size_t word = 0; word < input.size(); ++word) {
+      std::array<std::byte, FieldElementT::SizeInBytes()> buffer{};
+      const auto word_bytes = state.subspan(
+          word * KeccakComponentT::kBytesInWord, KeccakComponentT::kBytesInWord);
+      std::copy(word_bytes.begin(), word_bytes.end(), buffer.begin());
+      input.at(word) = FieldElementT::ValueType::FromBytes(buffer, /*use_big_endian=*/false);
+    }
+    return input;
+  }
+
+  template <typename WriteFunc>
+  KeccakTraceDigest WriteTrace(const WriteFunc& write) const {
+    std::vector<HugePageVector<FieldElementT>> trace =
+        Trace::AllocateZeros<FieldElementT>(AirDefinition::kNumColumnsFirst, trace_length);
+    const std::vector<gsl::span<FieldElementT>> trace_spans(trace.begin(), trace.end());
+    MemoryCell<FieldElementT> memory_pool("mem_pool", ctx_, trace_length);
+    DilutedCheckCellT diluted_pool(
+        "diluted_pool", ctx_, trace_length, kDilutedSpacing, AirDefinition::kDilutedNBits);
+    write(&memory_pool, &diluted_pool, trace_spans);
+
+    KeccakTraceDigest digest;
+    for (const auto& column : trace) {
+      std::vector<uint64_t> column_digest(4, 0);
+      for (size_t row = 0; row < column.size(); ++row) {
+        const auto value = column[row].ToStandardForm();
+        for (size_t i = 0; i < column_digest.size(); ++i) {
+          column_digest[i] = column_digest[i] * 0x100000001b3ULL + (value[i] ^ row);
+        }
+      }
+      digest.column_digests.push_back(std::move(column_digest));
+    }
+    digest.diluted_pool = std::move(diluted_pool).Consume();
+    auto [addresses, values, public_memory] = std::move(memory_pool).Consume();
+    (void)public_memory;
+    digest.memory_addresses = std::move(addresses);
+    digest.memory_values = std::move(values);
+    return digest;
+  }
+
+  // A fixed seed, so that the trace can be compared with a known answer.
+  Prng prng_{MakeByteArray<0xca, 0xfe, 0xca, 0xfe>()};
+  const AirDefinition definition_;
+  const TraceGenerationContext ctx_;
+  std::map<uint64_t, std::array<std::byte, KeccakComponentT::kStateSizeInBytes>> inputs_;
+};
+
+/*
+  The builtin writes the instances in parallel, while they share the diluted and memory pools.
+  Checks that the result is the same as writing the instances one after the other.
+*/
+TEST_F(KeccakBuiltinProverContextTest, ParallelMatchesSerial) {
+  EXPECT_EQ(WriteTraceParallel(), WriteTraceSerial());
+}
+
+/*
+  Compares the trace with a known answer, and checks the output of the Keccak-f permutation on the
+  zero state.
+*/
+TEST_F(KeccakBuiltinProverContextTest, KnownAnswer) {
+  const KeccakTraceDigest digest = WriteTraceParallel();
+  // Computed with the serial KeccakComponent::WriteTrace() before the instances were parallelized.
+  EXPECT_EQ(digest.Fingerprint(), 0xcb6241da5ed442e9ULL);
+
+  // Keccak-f[1600] of the zero state, as 8 words of 25 bytes each.
+  const std::array<FieldElementT, KeccakComponentT::kStateSizeInWords> zero_state_output = {
+      FieldElementT::FromBigInt(0x4dd598261ea65aa9ee84d5ccf933c0478af1258f7940e1dde7_Z),
+      FieldElementT::FromBigInt(0x47c4ff97a42d7f8e6fd48b284e056253d057bd1547306f8049_Z),
+      FieldElementT::FromBigInt(0x8ffc64ad30a6f71b19059c8c5bda0cd6192e7690fee5a0a446_Z),
+      FieldElementT::FromBigInt(0xdbcf555fa9a6e6260d712103eb5aa93f2317d63530935ab7d0_Z),
+      FieldElementT::FromBigInt(0x5a21d9ae6101f22f1a11a5569f43b831cd0347c82681a57c16_Z),
+      FieldElementT::FromBigInt(0x5a554fd00ecb613670957bc4661164befef28cc970f205e563_Z),
+      FieldElementT::FromBigInt(0x41f924a2c509e4940c7922ae3a26148c3ee88a1ccf32c8b87c_Z),
+      FieldElementT::FromBigInt(0xeaf1ff7b5ceca24975f644e97f30a13b16f53526e70465c218_Z),
+  };
+  size_t n_empty_invocations = 0;
+  for (size_t invocation = 0; invocation < kNInstances * kNInvocations; ++invocation) {
+    if (!IsEmptyInvocation(invocation)) {
+      continue;
+    }
+    ++n_empty_invocations;
+    const uint64_t output_addr =
+        kBeginAddr + invocation * kIoLength + KeccakComponentT::kStateSizeInWords;
+    for (size_t word = 0; word < zero_state_output.size(); ++word) {
+      EXPECT_EQ(digest.MemoryAt(output_addr + word), zero_state_output.at(word));
+    }
+  }
+  EXPECT_GT(n_empty_invocations, 0U);
+}
+
+}  // namespace
+}  // namespace cpu
+}  // namespace starkware
@@ -18,6 +18,7 @@
 #include <cstddef>
 #include <istream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "third_party/gsl/gsl-lite.hpp"
@@ -74,16 +75,48 @@ class CpuComponent {
         jnz_tmp1_column_(ctx.GetVirtualColumn(name + "/update_registers/update_pc/tmp1")) {}
 
   /*
-    Writes the trace for one instruction of the component.
+    The part of the trace of an instruction that depends only on its encoding. Programs execute the
+    same few program words many times, so this is computed once per distinct pc and shared by all
+    the steps executing it.
+  */
+  struct CachedInstruction {
+    DecodedInstruction decoded;
+    Instruction inst;
+    FieldElementT encoded_value;
+    // The values of the "decode/opcode_rc" component for decoded.flags.
+    std::vector<FieldElementT> opcode_rc_values;
+    bool res_add;
+    bool res_mul;
+    bool pc_jnz;
+  };
+
+  // A map from a pc to the CachedInstruction of the instruction in memory at that pc.
+  using DecodedInstructionCache = std::unordered_map<uint64_t, CachedInstruction>;
+
+  /*
+    Decodes the instruction at each distinct pc executed in cpu_trace.
+  */
+  DecodedInstructionCache DecodeInstructions(
+      gsl::span<const TraceEntry<FieldElementT>> cpu_trace,
+      const CpuMemory<FieldElementT>& memory) const;
+
+  /*
+    Writes the trace for the instructions first_instruction_index, first_instruction_index + 1,
+    ..., whose trace entries are given in values. The instructions are looked up in
+    decoded_instructions, which should be the result of DecodeInstructions() on a trace containing
+    values. The trace is written column by column.
   */
   void WriteTrace(
-      uint64_t instruction_index, const TraceEntry<FieldElementT>& values,
-      const CpuMemory<FieldElementT>& memory, MemoryCell<FieldElementT>* memory_cell,
-      RangeCheckCell<FieldElementT>* range_check_cell,
+      uint64_t first_instruction_index, gsl::span<const TraceEntry<FieldElementT>> values,
+      const DecodedInstructionCache& decoded_instructions, const CpuMemory<FieldElementT>& memory,
+      MemoryCell<FieldElementT>* memory_cell, RangeCheckCell<FieldElementT>* range_check_cell,
       gsl::span<const gsl::span<FieldElementT>> trace) const;
 
   static constexpr size_t kOffsetBits = 16;
 
+  // The number of consecutive instructions a single WriteTrace() call should handle.
+  static constexpr size_t kWriteTraceBatchSize = 256;
+
  private:
   // Component name.
   const std::string name_;
@@ -12,69 +12,155 @@
 // See the License for the specific language governing permissions
 // and limitations under the License.
 
+#include <unordered_set>
+
 #include "starkware/algebra/field_to_int.h"
 
 namespace starkware {
 namespace cpu {
 
+template <typename FieldElementT>
+auto CpuComponent<FieldElementT>::DecodeInstructions(
+    const gsl::span<const TraceEntry<FieldElementT>> cpu_trace,
+    const CpuMemory<FieldElementT>& memory) const -> DecodedInstructionCache {
+  std::unordered_set<uint64_t> pcs;
+  for (const auto& entry : cpu_trace) {
+    pcs.insert(entry.pc);
+  }
+
+  DecodedInstructionCache decoded_instructions;
+  decoded_instructions.reserve(pcs.size());
+  for (const uint64_t pc : pcs) {
+    const uint64_t encoded_instruction = ToUint64(memory.At(pc));
+    const auto decoded_inst = DecodedInstruction::DecodeInstruction(encoded_instruction);
+
+    const bool res_add = ((decoded_inst.flags >> kResAddBit) & 1) != 0;
+    const bool res_mul = ((decoded_inst.flags >> kResMulBit) & 1) != 0;
+    const bool pc_jnz = ((decoded_inst.flags >> kPcJnzBit) & 1) != 0;
+    const size_t total_res_flags =
+        static_cast<size_t>(res_add) + static_cast<size_t>(res_mul) + static_cast<size_t>(pc_jnz);
+    ASSERT_RELEASE(total_res_flags <= 1, "Invalid RES flags in instruction");
+
+    decoded_instructions.emplace(
+        pc,
+        CachedInstruction{
+            decoded_inst, Instruction(decoded_inst), FieldElementT::FromUint(encoded_instruction),
+            opcode_rc_.ComputeValues(decoded_inst.flags), res_add, res_mul, pc_jnz});
+  }
+
+  return decoded_instructions;
+}
+
 template <typename FieldElementT>
 void CpuComponent<FieldElementT>::WriteTrace(
-    const uint64_t instruction_index, const TraceEntry<FieldElementT>& values,
-    const CpuMemory<FieldElementT>& memory, MemoryCell<FieldElementT>* memory_cell,
-    RangeCheckCell<FieldElementT>* range_check_cell,
+    const uint64_t first_instruction_index, const gsl::span<const TraceEntry<FieldElementT>> values,
+    const DecodedInstructionCache& decoded_instructions, const CpuMemory<FieldElementT>& memory,
+    MemoryCell<FieldElementT>* memory_cell, RangeCheckCell<FieldElementT>* range_check_cell,
     const gsl::span<const gsl::span<FieldElementT>> trace) const {
   // Get prover context.
   ProverContext prover_ctx(name_, ctx_, memory_cell, range_check_cell);
+  const size_t n_steps = values.size();
+
+  // Look up the instructions and read their operands from memory.
+  std::vector<const CachedInstruction*> instructions;
+  std::vector<uint64_t> dst_addrs;
+  std::vector<uint64_t> op0_addrs;
+  std::vector<uint64_t> op1_addrs;
+  std::vector<FieldElementT> dst_values;
+  std::vector<FieldElementT> op0_values;
+  std::vector<FieldElementT> op1_values;
+  instructions.reserve(n_steps);
+  dst_addrs.reserve(n_steps);
+  op0_addrs.reserve(n_steps);
+  op1_addrs.reserve(n_steps);
+  dst_values.reserve(n_steps);
+  op0_values.reserve(n_steps);
+  op1_values.reserve(n_steps);
+  for (const auto& entry : values) {
+    const CachedInstruction& cached = decoded_instructions.at(entry.pc);
+    instructions.push_back(&cached);
+    dst_addrs.push_back(entry.ComputeDstAddr(cached.inst));
+    dst_values.push_back(memory.At(dst_addrs.back()));
+    op0_addrs.push_back(entry.ComputeOp0Addr(cached.inst));
+    op0_values.push_back(memory.At(op0_addrs.back()));
+    op1_addrs.push_back(entry.ComputeOp1Addr(cached.inst, op0_values.back()));
+    op1_values.push_back(memory.At(op1_addrs.back()));
+  }
 
   // "decode" columns.
-  const uint64_t encoded_instruction = ToUint64(memory.At(values.pc));
-  const auto decoded_inst = DecodedInstruction::DecodeInstruction(encoded_instruction);
-  const Instruction inst(decoded_inst);
-
-  prover_ctx.mem_pc.WriteTrace(
-      instruction_index, values.pc, FieldElementT::FromUint(encoded_instruction), trace);
-  prover_ctx.rc_off0.WriteTrace(instruction_index, decoded_inst.off0, trace);
-  prover_ctx.rc_off1.WriteTrace(instruction_index, decoded_inst.off1, trace);
-  prover_ctx.rc_off2.WriteTrace(instruction_index, decoded_inst.off2, trace);
-  opcode_rc_.WriteTrace(decoded_inst.flags, instruction_index, trace);
-
-  const uint64_t dst_addr = values.ComputeDstAddr(inst);
-  const FieldElementT dst_value = memory.At(dst_addr);
-  const uint64_t op0_addr = values.ComputeOp0Addr(inst);
-  const FieldElementT op0_value = memory.At(op0_addr);
-  const uint64_t op1_addr = values.ComputeOp1Addr(inst, op0_value);
-  const FieldElementT op1_value = memory.At(op1_addr);
+  for (size_t i = 0; i < n_steps; ++i) {
+    prover_ctx.mem_pc.WriteTrace(
+        first_instruction_index + i, values[i].pc, instructions[i]->encoded_value, trace);
+  }
+  for (size_t i = 0; i < n_steps; ++i) {
+    prover_ctx.rc_off0.WriteTrace(
+        first_instruction_index + i, instructions[i]->decoded.off0, trace);
+  }
+  for (size_t i = 0; i < n_steps; ++i) {
+    prover_ctx.rc_off1.WriteTrace(
+        first_instruction_index + i, instructions[i]->decoded.off1, trace);
+  }
+  for (size_t i = 0; i < n_steps; ++i) {
+    prover_ctx.rc_off2.WriteTrace(
+        first_instruction_index + i, instructions[i]->decoded.off2, trace);
+  }
+  for (size_t i = 0; i < n_steps; ++i) {
+    opcode_rc_.WriteTrace(instructions[i]->opcode_rc_values, first_instruction_index + i, trace);
+  }
 
   // "operands" columns.
-  prover_ctx.mem_dst.WriteTrace(instruction_index, dst_addr, dst_value, trace);
-  prover_ctx.mem_op0.WriteTrace(instruction_index, op0_addr, op0_value, trace);
-  prover_ctx.mem_op1.WriteTrace(instruction_index, op1_addr, op1_value, trace);
-
-  const FieldElementT mul_value = op0_value * op1_value;
-  mul_column_.SetCell(trace, instruction_index, mul_value);
-
-  const bool res_add = ((decoded_inst.flags >> kResAddBit) & 1) != 0;
-  const bool res_mul = ((decoded_inst.flags >> kResMulBit) & 1) != 0;
-  const bool pc_jnz = ((decoded_inst.flags >> kPcJnzBit) & 1) != 0;
-  const size_t total_res_flags =
-      static_cast<size_t>(res_add) + static_cast<size_t>(res_mul) + static_cast<size_t>(pc_jnz);
-  ASSERT_RELEASE(total_res_flags <= 1, "Invalid RES flags in instruction");
-  const FieldElementT res_value =
-      res_add ? op0_value + op1_value
-              : (res_mul ? mul_value
-                         : (pc_jnz ? (dst_value == FieldElementT::Zero() ? FieldElementT::Zero()
-                                                                         : dst_value.Inverse())
-                                   : op1_value));
-  res_column_.SetCell(trace, instruction_index, res_value);
+  for (size_t i = 0; i < n_steps; ++i) {
+    prover_ctx.mem_dst.WriteTrace(first_instruction_index + i, dst_addrs[i], dst_values[i], trace);
+  }
+  for (size_t i = 0; i < n_steps; ++i) {
+    prover_ctx.mem_op0.WriteTrace(first_instruction_index + i, op0_addrs[i], op0_values[i], trace);
+  }
+  for (size_t i = 0; i < n_steps; ++i) {
+    prover_ctx.mem_op1.WriteTrace(first_instruction_index + i, op1_addrs[i], op1_values[i], trace);
+  }
+
+  std::vector<FieldElementT> mul_values;
+  mul_values.reserve(n_steps);
+  for (size_t i = 0; i < n_steps; ++i) {
+    mul_values.push_back(op0_values[i] * op1_values[i]);
+    mul_column_.SetCell(trace, first_instruction_index + i, mul_values.back());
+  }
+
+  std::vector<FieldElementT> res_values;
+  res_values.reserve(n_steps);
+  for (size_t i = 0; i < n_steps; ++i) {
+    const CachedInstruction& cached = *instructions[i];
+    const FieldElementT& dst_value = dst_values[i];
+    res_values.push_back(
+        cached.res_add
+            ? op0_values[i] + op1_values[i]
+            : (cached.res_mul ? mul_values[i]
+                              : (cached.pc_jnz ? (dst_value == FieldElementT::Zero()
+                                                      ? FieldElementT::Zero()
+                                                      : dst_value.Inverse())
+                                               : op1_values[i])));
+    res_column_.SetCell(trace, first_instruction_index + i, res_values.back());
+  }
 
   // "registers" columns.
-  ap_column_.SetCell(trace, instruction_index, values.ap);
-  fp_column_.SetCell(trace, instruction_index, values.fp);
+  for (size_t i = 0; i < n_steps; ++i) {
+    ap_column_.SetCell(trace, first_instruction_index + i, values[i].ap);
+  }
+  for (size_t i = 0; i < n_steps; ++i) {
+    fp_column_.SetCell(trace, first_instruction_index + i, values[i].fp);
+  }
 
   // "update_registers" columns.
-  const FieldElementT jnz_tmp0_value = pc_jnz ? dst_value : FieldElementT::Zero();
-  jnz_tmp0_column_.SetCell(trace, instruction_index, jnz_tmp0_value);
-  jnz_tmp1_column_.SetCell(trace, instruction_index, jnz_tmp0_value * res_value);
+  for (size_t i = 0; i < n_steps; ++i) {
+    const FieldElementT jnz_tmp0_value =
+        instructions[i]->pc_jnz ? dst_values[i] : FieldElementT::Zero();
+    jnz_tmp0_column_.SetCell(trace, first_instruction_index + i, jnz_tmp0_value);
+  }
+  for (size_t i = 0; i < n_steps; ++i) {
+    const FieldElementT jnz_tmp1_value =
+        instructions[i]->pc_jnz ? dst_values[i] * res_values[i] : FieldElementT::Zero();
+    jnz_tmp1_column_.SetCell(trace, first_instruction_index + i, jnz_tmp1_value);
+  }
 }
 
 }  // namespace cpu
@@ -27,6 +27,7 @@
 #include "starkware/air/trace.h"
 #include "starkware/air/trace_context.h"
 #include "starkware/math/math.h"
+#include "starkware/utils/huge_page_arena.h"
 
 namespace starkware {
 
@@ -228,7 +229,8 @@ std::vector<size_t> DomainPredicateToList(
 */
 template <typename FieldElementT>
 Trace MergeTraces(const gsl::span<Trace> traces) {
-  std::vector<std::vector<FieldElementT>> merged_trace_vals;
+  using AllocatorT = HugePageAllocator<FieldElementT>;
+  std::vector<HugePageVector<FieldElementT>> merged_trace_vals;
   size_t merged_trace_size = 0;
   for (const auto& trace : traces) {
     merged_trace_size += trace.Width();
@@ -238,7 +240,12 @@ Trace MergeTraces(const gsl::span<Trace> traces) {
   for (auto& trace : traces) {
     std::vector<FieldElementVector> columns = std::move(trace).ConsumeAsColumnsVector();
     for (FieldElementVector& column : columns) {
-      merged_trace_vals.push_back(std::move(column.As<FieldElementT>()));
+      if (column.Holds<FieldElementT, AllocatorT>()) {
+        merged_trace_vals.push_back(std::move(column.As<FieldElementT, AllocatorT>()));
+      } else {
+        const auto values = column.AsSpan().As<FieldElementT>();
+        merged_trace_vals.emplace_back(values.begin(), values.end());
+      }
     }
   }
   return Trace(std::move(merged_trace_vals));
@@ -15,10 +15,14 @@
 #ifndef STARKWARE_AIR_TRACE_H_
 #define STARKWARE_AIR_TRACE_H_
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
 #include "starkware/algebra/polymorphic/field_element_vector.h"
+#include "starkware/math/math.h"
+#include "starkware/utils/huge_page_arena.h"
+#include "starkware/utils/task_manager.h"
 
 namespace starkware {
 
@@ -30,31 +34,67 @@ class Trace {
   Trace& operator=(const Trace&) = default;
   Trace& operator=(Trace&&) = default;
 
-  template <typename FieldElementT>
-  explicit Trace(std::vector<std::vector<FieldElementT>>&& values) {
+  template <typename FieldElementT, typename AllocatorT>
+  explicit Trace(std::vector<std::vector<FieldElementT, AllocatorT>>&& values) {
     for (auto& column : values) {
-      values_.emplace_back(FieldElementVector::Make<FieldElementT>(std::move(column)));
+      values_.emplace_back(FieldElementVector::Make(std::move(column)));
     }
   }
 
   /*
-    Allocates a vector of values that may be passed to the constructor.
+    Allocates a vector of values that may be passed to the constructor. The columns are
+    HugePageVector-s, so that the LDE, which takes them over (see LdeManager::AddEvaluation()), is
+    served by the HugePageArena as well.
   */
   template <typename FieldElementT>
-  static std::vector<std::vector<FieldElementT>> Allocate(size_t n_columns, size_t trace_length) {
-    std::vector<std::vector<FieldElementT>> values;
+  static std::vector<HugePageVector<FieldElementT>> Allocate(
+      size_t n_columns, size_t trace_length) {
+    std::vector<HugePageVector<FieldElementT>> values;
     values.reserve(n_columns);
     for (size_t col = 0; col < n_columns; col++) {
-      values.emplace_back(FieldElementT::UninitializedVector(trace_length));
+      values.emplace_back(
+          FieldElementT::template UninitializedVector<HugePageAllocator<FieldElementT>>(
+              trace_length));
+    }
+    return values;
+  }
+
+  /*
+    Same as Allocate(), with all the values set to zero. The columns are zeroed in parallel, in
+    chunks of kZeroingChunkSize elements, rather than written by the calling thread, so that the
+    memory of large traces is also touched (and, on NUMA machines, placed) by all the workers.
+  */
+  template <typename FieldElementT>
+  static std::vector<HugePageVector<FieldElementT>> AllocateZeros(
+      size_t n_columns, size_t trace_length) {
+    std::vector<HugePageVector<FieldElementT>> values =
+        Allocate<FieldElementT>(n_columns, trace_length);
+    const size_t n_chunks_per_column = DivCeil(trace_length, kZeroingChunkSize);
+    if (n_columns * n_chunks_per_column == 0) {
+      return values;
     }
+    TaskManager::GetInstance().ParallelFor(
+        n_columns * n_chunks_per_column, [&](const TaskInfo& task_info) {
+          for (size_t i = task_info.start_idx; i < task_info.end_idx; ++i) {
+            HugePageVector<FieldElementT>& column = values[i / n_chunks_per_column];
+            const size_t begin = (i % n_chunks_per_column) * kZeroingChunkSize;
+            const size_t end = std::min(begin + kZeroingChunkSize, trace_length);
+            std::fill(column.begin() + begin, column.begin() + end, FieldElementT::Zero());
+          }
+        });
     return values;
   }
 
+  /*
+    Copies the given values to HugePageVector columns, like Allocate().
+  */
   static Trace CopyFrom(gsl::span<const ConstFieldElementSpan> values) {
     Trace trace;
     trace.values_.reserve(values.size());
     for (auto& column : values) {
-      trace.values_.emplace_back(FieldElementVector::CopyFrom(column));
+      trace.values_.emplace_back(
+          FieldElementVector::MakeUninitializedHugePage(column.GetField(), column.Size()));
+      trace.values_.back().AsSpan().CopyDataFrom(column);
     }
     return trace;
   }
@@ -84,12 +124,14 @@ class Trace {
     std::vector<gsl::span<const FieldElementT>> result;
     result.reserve(values_.size());
     for (const FieldElementVector& v : values_) {
-      result.push_back(gsl::make_span(v.As<FieldElementT>()));
+      result.push_back(gsl::make_span(v.AsSpan().template As<FieldElementT>()));
     }
     return result;
   }
 
  private:
+  static constexpr size_t kZeroingChunkSize = 1 << 16;
+
   Trace() = default;
 
   std::vector<FieldElementVector> values_;
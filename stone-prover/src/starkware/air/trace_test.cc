@@ -18,6 +18,7 @@
 
 #include "starkware/algebra/fields/test_field_element.h"
 #include "starkware/randomness/prng.h"
+#include "starkware/utils/huge_page_arena.h"
 
 namespace starkware {
 namespace {
@@ -30,11 +31,11 @@ TEST(Trace, Getters) {
   const size_t height = prng.UniformInt(1, 10);
 
   // Construct trace values.
-  std::vector<std::vector<FieldElementT>> trace_vals =
+  std::vector<HugePageVector<FieldElementT>> trace_vals =
       Trace::Allocate<FieldElementT>(width, height);
 
   // Keep trace values for future comparison.
-  const std::vector<std::vector<FieldElementT>> trace_vals_saved = trace_vals;
+  const std::vector<HugePageVector<FieldElementT>> trace_vals_saved = trace_vals;
 
   // Construct trace.
   Trace trace(std::move(trace_vals));
@@ -45,6 +46,7 @@ TEST(Trace, Getters) {
   for (size_t i = 0; i < width; ++i) {
     EXPECT_EQ(trace_as[i].size(), height);
     EXPECT_EQ(trace.GetColumn(i).Size(), height);
+    EXPECT_TRUE((trace.GetColumn(i).Holds<FieldElementT, HugePageAllocator<FieldElementT>>()));
     for (size_t j = 0; j < height; j++) {
       EXPECT_EQ(trace_as[i][j], trace_vals_saved[i][j]);
       EXPECT_EQ(trace.GetColumn(i)[j].As<FieldElementT>(), trace_vals_saved[i][j]);
@@ -52,5 +54,49 @@ TEST(Trace, Getters) {
   }
 }
 
+TEST(Trace, AllocateZeros) {
+  Prng prng;
+  const size_t width = prng.UniformInt(1, 10);
+  // Some columns span several zeroing chunks, with a partial last chunk.
+  const size_t height = prng.UniformInt<size_t>(1, 3 * Pow2(16) + 10);
+
+  const std::vector<HugePageVector<FieldElementT>> trace_vals =
+      Trace::AllocateZeros<FieldElementT>(width, height);
+  ASSERT_EQ(trace_vals.size(), width);
+  for (const auto& column : trace_vals) {
+    ASSERT_EQ(column.size(), height);
+    for (const FieldElementT& value : column) {
+      ASSERT_EQ(value, FieldElementT::Zero());
+    }
+  }
+
+  EXPECT_TRUE(Trace::AllocateZeros<FieldElementT>(width, 0)[0].empty());
+  EXPECT_TRUE(Trace::AllocateZeros<FieldElementT>(0, height).empty());
+}
+
+TEST(Trace, AllocateFromHugePageArena) {
+  FLAGS_huge_page_arena = true;
+  HugePageArena& arena = HugePageArena::GetInstance();
+  arena.ReleaseCachedBuffers();
+  const size_t width = 3;
+  const size_t height = Pow2(20);
+  const size_t trace_bytes = width * height * sizeof(FieldElementT);
+
+  const HugePageArena::Stats stats_before = arena.GetStats();
+  {
+    const Trace trace(Trace::Allocate<FieldElementT>(width, height));
+    EXPECT_GE(arena.GetStats().mapped_bytes, stats_before.mapped_bytes + trace_bytes);
+  }
+  // The columns are kept by the arena, and reused by the next trace.
+  EXPECT_GE(arena.GetStats().cached_bytes, trace_bytes);
+  {
+    const Trace trace(Trace::Allocate<FieldElementT>(width, height));
+    EXPECT_GE(arena.GetStats().reused_bytes, stats_before.reused_bytes + trace_bytes);
+  }
+
+  arena.ReleaseCachedBuffers();
+  FLAGS_huge_page_arena = false;
+}
+
 }  // namespace
 }  // namespace starkware
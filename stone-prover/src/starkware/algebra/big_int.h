@@ -125,6 +125,15 @@ class BigInt {
   */
   static constexpr BigInt Inverse(const BigInt& value, const BigInt& modulus);
 
+  /*
+    Same as Inverse(), for an odd modulus, and much faster.
+    The implementation is the variable-time variant of the safegcd algorithm of Bernstein and Yang
+    ("Fast constant-time gcd computation and modular inversion"), which applies 62 division steps
+    at a time to the low limbs and then updates the full numbers with a 2x2 matrix.
+    The running time depends on the value, which is fine since the prover has no secrets.
+  */
+  static BigInt InverseOddModulus(const BigInt& value, const BigInt& modulus);
+
   constexpr bool IsEven() const;
 
   constexpr bool IsMsbSet() const;
@@ -176,6 +185,14 @@ class BigInt {
   static constexpr BigInt MontMul(
       const BigInt& x, const BigInt& y, const BigInt& modulus, uint64_t montgomery_mprime);
 
+  /*
+    Calculates x/2^(64N) mod modulus, assuming that montgomery_mprime is (-(modulus^-1)) mod 2^64.
+    Assumes that x < modulus * 2^(64N) and modulus.NumLeadingZeros() > 0. The result is in the range
+    [0, 2*modulus), like the result of MontMul().
+  */
+  static constexpr BigInt MontgomeryReduce(
+      const BigInt<2 * N>& x, const BigInt& modulus, uint64_t montgomery_mprime);
+
   auto rbegin() const { return value_.rbegin(); }  // NOLINT
   auto rend() const { return value_.rend(); }      // NOLINT
 
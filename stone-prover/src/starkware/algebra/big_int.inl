@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions
 // and limitations under the License.
 
+#include <algorithm>
+#include <array>
 #include <iomanip>
 #include <ios>
 #include <limits>
@@ -235,6 +237,295 @@ constexpr BigInt<N> BigInt<N>::Inverse(const BigInt& value, const BigInt& modulu
   return v.coef;
 }
 
+namespace bigint {
+namespace details {
+
+/*
+  Helpers of BigInt::InverseOddModulus(). Numbers are represented in signed 62-bit limbs: every
+  limb but the last is in [0, 2^62), and the last one carries the sign and the remaining bits.
+*/
+template <size_t L>
+using Signed62 = std::array<int64_t, L>;
+
+constexpr uint64_t kMask62 = std::numeric_limits<uint64_t>::max() >> 2;
+
+/*
+  The number of signed 62-bit limbs used for a BigInt<N> modulus, with room for the sign.
+*/
+template <size_t N>
+constexpr size_t kSigned62Limbs = N * 64 / 62 + 1;
+
+/*
+  The transition matrix of 62 division steps, multiplied by 2^62.
+*/
+struct DivstepsMatrix {
+  int64_t u, v, q, r;
+};
+
+/*
+  Returns the inverse of an odd x modulo 2^62.
+*/
+inline uint64_t Inverse62(uint64_t x) {
+  // x is its own inverse modulo 2^3, and every Newton iteration doubles the number of correct bits.
+  uint64_t res = x;
+  for (size_t i = 0; i < 5; ++i) {
+    res *= 2 - x * res;
+  }
+  return res & kMask62;
+}
+
+/*
+  Applies 62 division steps to the low 62 bits of f and g, where f is odd, and returns the new
+  eta (minus delta in the notation of the paper). Steps that only shift g are done together.
+*/
+inline int64_t Divsteps62Var(int64_t eta, uint64_t f0, uint64_t g0, DivstepsMatrix* t) {
+  uint64_t u = 1, v = 0, q = 0, r = 1;
+  uint64_t f = f0, g = g0;
+  int i = 62;
+  while (true) {
+    // Shift out the zeros at the bottom of g, stopping after i steps.
+    const int zeros = __builtin_ctzll(g | (std::numeric_limits<uint64_t>::max() << i));
+    g >>= zeros;
+    u <<= zeros;
+    v <<= zeros;
+    eta -= zeros;
+    i -= zeros;
+    if (i == 0) {
+      break;
+    }
+    // Now f and g are odd. Cancel as many low bits of g as possible by adding a multiple of f.
+    uint64_t w;
+    if (eta < 0) {
+      eta = -eta;
+      std::swap(f, g);
+      g = -g;
+      std::swap(u, q);
+      q = -q;
+      std::swap(v, r);
+      r = -r;
+      const int limit = std::min<int>(eta + 1, i);
+      const uint64_t mask = (std::numeric_limits<uint64_t>::max() >> (64 - limit)) & 63U;
+      w = (f * g * (f * f - 2)) & mask;
+    } else {
+      const int limit = std::min<int>(eta + 1, i);
+      const uint64_t mask = (std::numeric_limits<uint64_t>::max() >> (64 - limit)) & 15U;
+      w = f + (((f + 1) & 4) << 1);
+      w = (-w * g) & mask;
+    }
+    g += f * w;
+    q += u * w;
+    r += v * w;
+  }
+  *t = {static_cast<int64_t>(u), static_cast<int64_t>(v), static_cast<int64_t>(q),
+        static_cast<int64_t>(r)};
+  return eta;
+}
+
+/*
+  Computes (d, e) = t * (d, e) / 2^62 modulo the modulus, where the division is made exact by
+  adding multiples of the modulus. Keeps d and e in the range (-2 * modulus, modulus).
+*/
+template <size_t L>
+void UpdateDe(
+    Signed62<L>* d, Signed62<L>* e, const DivstepsMatrix& t, const Signed62<L>& modulus,
+    uint64_t modulus_inv62) {
+  const int64_t sd = (*d)[L - 1] >> 63;
+  const int64_t se = (*e)[L - 1] >> 63;
+  int64_t md = (t.u & sd) + (t.v & se);
+  int64_t me = (t.q & sd) + (t.r & se);
+  Int128 cd = static_cast<Int128>(t.u) * (*d)[0] + static_cast<Int128>(t.v) * (*e)[0];
+  Int128 ce = static_cast<Int128>(t.q) * (*d)[0] + static_cast<Int128>(t.r) * (*e)[0];
+  // Choose md and me such that the low 62 bits of cd and ce become zero.
+  md -= static_cast<int64_t>(
+      (modulus_inv62 * static_cast<uint64_t>(cd) + static_cast<uint64_t>(md)) & kMask62);
+  me -= static_cast<int64_t>(
+      (modulus_inv62 * static_cast<uint64_t>(ce) + static_cast<uint64_t>(me)) & kMask62);
+  cd += static_cast<Int128>(modulus[0]) * md;
+  ce += static_cast<Int128>(modulus[0]) * me;
+  cd >>= 62;
+  ce >>= 62;
+  for (size_t i = 1; i < L; ++i) {
+    cd += static_cast<Int128>(t.u) * (*d)[i] + static_cast<Int128>(t.v) * (*e)[i] +
+          static_cast<Int128>(modulus[i]) * md;
+    ce += static_cast<Int128>(t.q) * (*d)[i] + static_cast<Int128>(t.r) * (*e)[i] +
+          static_cast<Int128>(modulus[i]) * me;
+    (*d)[i - 1] = static_cast<int64_t>(static_cast<uint64_t>(cd) & kMask62);
+    (*e)[i - 1] = static_cast<int64_t>(static_cast<uint64_t>(ce) & kMask62);
+    cd >>= 62;
+    ce >>= 62;
+  }
+  (*d)[L - 1] = static_cast<int64_t>(cd);
+  (*e)[L - 1] = static_cast<int64_t>(ce);
+}
+
+/*
+  Computes (f, g) = t * (f, g) / 2^62 on the first len limbs, where the division is exact.
+*/
+template <size_t L>
+void UpdateFg(size_t len, Signed62<L>* f, Signed62<L>* g, const DivstepsMatrix& t) {
+  Int128 cf = static_cast<Int128>(t.u) * (*f)[0] + static_cast<Int128>(t.v) * (*g)[0];
+  Int128 cg = static_cast<Int128>(t.q) * (*f)[0] + static_cast<Int128>(t.r) * (*g)[0];
+  cf >>= 62;
+  cg >>= 62;
+  for (size_t i = 1; i < len; ++i) {
+    cf += static_cast<Int128>(t.u) * (*f)[i] + static_cast<Int128>(t.v) * (*g)[i];
+    cg += static_cast<Int128>(t.q) * (*f)[i] + static_cast<Int128>(t.r) * (*g)[i];
+    (*f)[i - 1] = static_cast<int64_t>(static_cast<uint64_t>(cf) & kMask62);
+    (*g)[i - 1] = static_cast<int64_t>(static_cast<uint64_t>(cg) & kMask62);
+    cf >>= 62;
+    cg >>= 62;
+  }
+  (*f)[len - 1] = static_cast<int64_t>(cf);
+  (*g)[len - 1] = static_cast<int64_t>(cg);
+}
+
+/*
+  Brings every limb but the last to the range [0, 2^62).
+*/
+template <size_t L>
+void PropagateCarries(Signed62<L>* x) {
+  for (size_t i = 0; i + 1 < L; ++i) {
+    (*x)[i + 1] += (*x)[i] >> 62;
+    (*x)[i] &= static_cast<int64_t>(kMask62);
+  }
+}
+
+/*
+  Adds the modulus to x if x is negative.
+*/
+template <size_t L>
+void AddModulusIfNegative(Signed62<L>* x, const Signed62<L>& modulus) {
+  const int64_t cond_add = (*x)[L - 1] >> 63;
+  for (size_t i = 0; i < L; ++i) {
+    (*x)[i] += modulus[i] & cond_add;
+  }
+  PropagateCarries(x);
+}
+
+/*
+  Given x in the range (-2 * modulus, modulus), returns x (or -x if sign is negative) reduced to
+  the range [0, modulus).
+*/
+template <size_t L>
+void Normalize62(Signed62<L>* x, int64_t sign, const Signed62<L>& modulus) {
+  AddModulusIfNegative(x, modulus);
+  const int64_t cond_negate = sign >> 63;
+  for (int64_t& limb : *x) {
+    limb = (limb ^ cond_negate) - cond_negate;
+  }
+  PropagateCarries(x);
+  AddModulusIfNegative(x, modulus);
+}
+
+/*
+  Returns true if the first len limbs of x represent 1 or -1.
+*/
+template <size_t L>
+bool IsPlusMinusOne(const Signed62<L>& x, size_t len) {
+  const bool is_minus_one = x[len - 1] == -1;
+  if (!is_minus_one && x[0] != 1) {
+    return false;
+  }
+  for (size_t i = 0; i + 1 < len; ++i) {
+    const int64_t expected = is_minus_one ? static_cast<int64_t>(kMask62) : (i == 0 ? 1 : 0);
+    if (x[i] != expected) {
+      return false;
+    }
+  }
+  return is_minus_one || len == 1 || x[len - 1] == 0;
+}
+
+template <size_t L, size_t N>
+Signed62<L> ToSigned62(const BigInt<N>& x) {
+  Signed62<L> res{};
+  for (size_t i = 0; i < L; ++i) {
+    const size_t word = 62 * i / 64;
+    const size_t shift = 62 * i % 64;
+    if (word >= N) {
+      break;
+    }
+    uint64_t limb = x[word] >> shift;
+    if (shift > 2 && word + 1 < N) {
+      limb |= x[word + 1] << (64 - shift);
+    }
+    res.at(i) = static_cast<int64_t>(limb & kMask62);
+  }
+  return res;
+}
+
+/*
+  Converts back a non-negative number smaller than 2^(64 * N).
+*/
+template <size_t N, size_t L>
+BigInt<N> FromSigned62(const Signed62<L>& x) {
+  BigInt<N> res{};
+  for (size_t i = 0; i < L; ++i) {
+    const size_t word = 62 * i / 64;
+    const size_t shift = 62 * i % 64;
+    if (word >= N) {
+      break;
+    }
+    const auto limb = static_cast<uint64_t>(x.at(i));
+    res[word] |= limb << shift;
+    if (shift > 2 && word + 1 < N) {
+      res[word + 1] |= limb >> (64 - shift);
+    }
+  }
+  return res;
+}
+
+}  // namespace details
+}  // namespace bigint
+
+template <size_t N>
+BigInt<N> BigInt<N>::InverseOddModulus(const BigInt& value, const BigInt& modulus) {
+  using bigint::details::Signed62;
+  constexpr size_t kLimbs = bigint::details::kSigned62Limbs<N>;
+  ASSERT_RELEASE(!modulus.IsEven(), "InverseOddModulus() requires an odd modulus.");
+
+  const Signed62<kLimbs> modulus62 = bigint::details::ToSigned62<kLimbs>(modulus);
+  const uint64_t modulus_inv62 = bigint::details::Inverse62(modulus[0]);
+
+  // The invariants are d * value = f and e * value = g (mod modulus), where f and g are the
+  // numbers whose gcd is computed.
+  Signed62<kLimbs> d{};
+  Signed62<kLimbs> e{};
+  e[0] = 1;
+  Signed62<kLimbs> f = modulus62;
+  Signed62<kLimbs> g =
+      bigint::details::ToSigned62<kLimbs>(value < modulus ? value : Div(value, modulus).second);
+  int64_t eta = -1;
+  // The number of limbs of f and g, which shrinks as they become smaller.
+  size_t len = kLimbs;
+
+  while (true) {
+    bigint::details::DivstepsMatrix t{};
+    eta = bigint::details::Divsteps62Var(
+        eta, static_cast<uint64_t>(f[0]), static_cast<uint64_t>(g[0]), &t);
+    bigint::details::UpdateDe(&d, &e, t, modulus62, modulus_inv62);
+    bigint::details::UpdateFg(len, &f, &g, t);
+
+    if (std::all_of(g.begin(), g.begin() + len, [](int64_t limb) { return limb == 0; })) {
+      break;
+    }
+    // If the top limbs of both f and g are only a sign, fold them into the limb below.
+    const int64_t fn = f.at(len - 1);
+    const int64_t gn = g.at(len - 1);
+    if (len > 1 && (fn == 0 || fn == -1) && (gn == 0 || gn == -1)) {
+      f.at(len - 2) |= static_cast<int64_t>(static_cast<uint64_t>(fn) << 62);
+      g.at(len - 2) |= static_cast<int64_t>(static_cast<uint64_t>(gn) << 62);
+      --len;
+    }
+  }
+
+  // Now f = +-GCD(value, modulus) and d * value = f (mod modulus).
+  ASSERT_RELEASE(
+      bigint::details::IsPlusMinusOne(f, len),
+      "GCD(value,modulus) is not 1, in particular, the value is not invertable");
+  bigint::details::Normalize62(&d, f.at(len - 1), modulus62);
+  return bigint::details::FromSigned62<N>(d);
+}
+
 template <size_t N>
 constexpr bool BigInt<N>::IsEven() const {
   // Check the LSB of the number.
@@ -541,6 +832,40 @@ ALWAYS_INLINE constexpr BigInt<N> BigInt<N>::MontMul(
   return res;
 }
 
+template <size_t N>
+ALWAYS_INLINE constexpr BigInt<N> BigInt<N>::MontgomeryReduce(
+    const BigInt<2 * N>& x, const BigInt& modulus, uint64_t montgomery_mprime) {
+  ASSERT_DEBUG(
+      modulus.NumLeadingZeros() > 0, "We require at least one leading zero in the modulus");
+  BigInt<2 * N> tmp = x;
+  // The carry that should be added to tmp[i + N] in the next iteration.
+  uint64_t top_carry = 0;
+
+  for (size_t i = 0; i < N; ++i) {
+    // Add u_i * modulus * 2^(64i), which zeros tmp[i].
+    const uint64_t u_i = tmp[i] * montgomery_mprime;
+    uint64_t carry = 0;
+    for (size_t j = 0; j < N; ++j) {
+      const Uint128 temp = Umul128(modulus[j], u_i) + tmp[i + j] + carry;
+      tmp[i + j] = gsl::narrow_cast<uint64_t>(temp);
+      carry = gsl::narrow_cast<uint64_t>(temp >> 64);
+    }
+    // carry + top_carry <= 2^65 - 2, so the sum below fits in two limbs.
+    const Uint128 temp = static_cast<Uint128>(tmp[i + N]) + carry + top_carry;
+    tmp[i + N] = gsl::narrow_cast<uint64_t>(temp);
+    top_carry = gsl::narrow_cast<uint64_t>(temp >> 64);
+  }
+
+  // x + sum(u_i * modulus * 2^(64i)) < 2 * modulus * 2^(64N) < 2^(128N), so there is no carry out
+  // of the top limb.
+  ASSERT_DEBUG(top_carry == 0, "There shouldn't be a carry here.");
+  BigInt res{};
+  for (size_t i = 0; i < N; ++i) {
+    res[i] = tmp[i + N];
+  }
+  return res;
+}
+
 template <size_t N>
 constexpr size_t BigInt<N>::NumLeadingZeros() const {
   int i = value_.size() - 1;
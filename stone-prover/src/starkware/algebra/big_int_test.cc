@@ -15,6 +15,7 @@
 #include "starkware/algebra/big_int.h"
 
 #include <limits>
+#include <optional>
 
 #include "gtest/gtest.h"
 
@@ -102,6 +103,63 @@ TEST(BigInt, Inv) {
   EXPECT_EQ(a.Inverse(a, p), expected_res);
 }
 
+TEST(BigInt, InverseOddModulus) {
+  BigInt<2> p({0xd80617e084679625, 0x7e5032470e0a7f8e});
+  BigInt<2> a({18, 357});
+
+  BigInt<2> expected_res({0x5c3d33fe0b586f40, 0x6741e17ed2831cc2});
+  EXPECT_EQ(BigInt<2>::InverseOddModulus(a, p), expected_res);
+}
+
+TEST(BigInt, InverseOddModulusEdgeCases) {
+  const auto p = 0x800000000000011000000000000000000000000000000000000000000000001_Z;
+  const auto p_minus_one = p - BigInt<4>::One();
+  EXPECT_EQ(BigInt<4>::InverseOddModulus(BigInt<4>::One(), p), BigInt<4>::One());
+  EXPECT_EQ(BigInt<4>::InverseOddModulus(p_minus_one, p), p_minus_one);
+  for (size_t i = 1; i < BigInt<4>::kDigits - 4; ++i) {
+    BigInt<4> power_of_two = BigInt<4>::One();
+    power_of_two <<= i;
+    EXPECT_EQ(BigInt<4>::InverseOddModulus(power_of_two, p), BigInt<4>::Inverse(power_of_two, p));
+  }
+  // Values larger than the modulus are reduced.
+  EXPECT_EQ(
+      BigInt<4>::InverseOddModulus(p + BigInt<4>(2), p), BigInt<4>::Inverse(BigInt<4>(2), p));
+
+  EXPECT_EQ(BigInt<1>::InverseOddModulus(BigInt<1>(2), BigInt<1>(15)), BigInt<1>(8));
+  EXPECT_ASSERT(
+      BigInt<1>::InverseOddModulus(BigInt<1>(3), BigInt<1>(15)),
+      testing::HasSubstr("GCD(value,modulus)"));
+  EXPECT_ASSERT(
+      BigInt<4>::InverseOddModulus(BigInt<4>::Zero(), p), testing::HasSubstr("GCD(value,modulus)"));
+  EXPECT_ASSERT(BigInt<4>::InverseOddModulus(p, p), testing::HasSubstr("GCD(value,modulus)"));
+  EXPECT_ASSERT(
+      BigInt<1>::InverseOddModulus(BigInt<1>(3), BigInt<1>(16)), testing::HasSubstr("odd modulus"));
+}
+
+TYPED_TEST(BigIntTest, InverseOddModulusRandom) {
+  using BigIntT = TypeParam;
+  for (size_t i = 0; i < 100; ++i) {
+    BigIntT modulus = BigIntT::RandomBigInt(&this->prng);
+    // Check moduli of all sizes.
+    modulus[BigIntT::LimbCount() - 1] >>= this->prng.template UniformInt<size_t>(0, 63);
+    modulus[0] |= 1;
+    const BigIntT value = BigIntT::Div(BigIntT::RandomBigInt(&this->prng), modulus).second;
+    if (value == BigIntT::Zero()) {
+      continue;
+    }
+    // Compare with Inverse(), including the case where the value is not invertible.
+    std::optional<BigIntT> expected;
+    try {
+      expected = BigIntT::Inverse(value, modulus);
+    } catch (const StarkwareException&) {
+      EXPECT_ASSERT(
+          BigIntT::InverseOddModulus(value, modulus), testing::HasSubstr("GCD(value,modulus)"));
+      continue;
+    }
+    EXPECT_EQ(BigIntT::InverseOddModulus(value, modulus), *expected);
+  }
+}
+
 TEST(BigInt, Random) {
   Prng prng;
   for (size_t i = 0; i < 100; ++i) {
@@ -534,6 +592,33 @@ TEST(BigInt, OneLimbMontgomeryReduction) {
   EXPECT_EQ(res, res2);
 }
 
+/*
+  Check that MontgomeryReduce(x * y) == MontMul(x, y) (mod modulus), including for a sum of
+  products that is close to the bound modulus * 2^256.
+*/
+TEST(BigInt, MontgomeryReduce) {
+  Prng prng;
+  auto modulus = 0x73eda753299d7d483339d80809a1d80553bda402fffe5bfeffffffff00000001_Z;
+  auto mprime = 18446744069414584319UL;
+  for (size_t i = 0; i < 100; ++i) {
+    const auto x = BigInt<4>::Div(BigInt<4>::RandomBigInt(&prng), modulus).second;
+    const auto y = BigInt<4>::Div(BigInt<4>::RandomBigInt(&prng), modulus).second;
+    const auto res = BigInt<4>::MontgomeryReduce(x * y, modulus, mprime);
+    EXPECT_LT(res, modulus + modulus);
+    EXPECT_EQ(
+        BigInt<4>::ReduceIfNeeded(res, modulus),
+        BigInt<4>::ReduceIfNeeded(BigInt<4>::MontMul(x, y, modulus, mprime), modulus));
+  }
+
+  // modulus^2 + modulus^2 < modulus * 2^256.
+  const auto max_val = modulus - BigInt<4>::One();
+  const BigInt<8> square = max_val * max_val;
+  const auto res = BigInt<4>::MontgomeryReduce(square + square, modulus, mprime);
+  const auto expected = BigInt<4>::ReduceIfNeeded(
+      BigInt<4>::MontMul(max_val, max_val + max_val - modulus, modulus, mprime), modulus);
+  EXPECT_EQ(BigInt<4>::ReduceIfNeeded(res, modulus), expected);
+}
+
 TEST(BigInt, Serialization) {
   auto num = 0x76d8a6ce180b83a1c1b9cdd9b505e1cce9959ce7c0f4e084b189091985121ece_Z;
   std::array<std::byte, 32> data{};
@@ -85,8 +85,9 @@ class EcPoint {
   void ToBytes(gsl::span<std::byte> span_out, bool use_big_endian = true) const;
 
   /*
-    Given the bool vector representing a scalar, and the alpha of the elliptic curve "y^2 = x^3 +
-    alpha * x + beta" the point is on, returns scalar*point.
+    Given a scalar, and the alpha of the elliptic curve "y^2 = x^3 + alpha * x + beta" the point is
+    on, returns scalar*point. Computed in Jacobian coordinates with a width-5 NAF of the scalar, so
+    a single inverse is computed.
   */
   template <size_t N>
   EcPoint<FieldElementT> MultiplyByScalar(
@@ -108,13 +109,61 @@ class EcPoint {
     computation of 2*P.
   */
   FieldElementT GetTangentSlope(const FieldElementT& alpha) const;
+};
+
+/*
+  A point on an elliptic curve of the form: y^2 = x^3 + alpha*x + beta, in Jacobian coordinates:
+  (x, y, z) represents the point (x / z^2, y / z^3), and any point with z = 0 represents the curve's
+  zero element.
+
+  Unlike EcPoint, the operations compute no inverses, and they support the zero element and adding
+  a point to itself. Use BatchToAffine() to convert many points back to EcPoint with a single
+  inverse.
+*/
+template <typename FieldElementT>
+class JacobianEcPoint {
+ public:
+  constexpr JacobianEcPoint(const FieldElementT& x, const FieldElementT& y, const FieldElementT& z)
+      : x(x), y(y), z(z) {}
+
+  explicit JacobianEcPoint(const EcPoint<FieldElementT>& point)
+      : x(point.x), y(point.y), z(FieldElementT::One()) {}
+
+  static JacobianEcPoint Zero() {
+    return {FieldElementT::One(), FieldElementT::One(), FieldElementT::Zero()};
+  }
+
+  bool IsZero() const { return z == FieldElementT::Zero(); }
+
+  JacobianEcPoint Double(const FieldElementT& alpha) const;
+
+  /*
+    Returns the sum of the two points. alpha is used only if the points are equal.
+  */
+  JacobianEcPoint Add(const JacobianEcPoint& rhs, const FieldElementT& alpha) const;
+
+  /*
+    Same as Add(), for an affine rhs (saves 5 multiplications).
+  */
+  JacobianEcPoint AddAffine(const EcPoint<FieldElementT>& rhs, const FieldElementT& alpha) const;
+
+  JacobianEcPoint operator-() const { return {x, -y, z}; }
 
   /*
-    Returns the sum of this point with a point in the form of std::optional, where std::nullopt
-    represents the curve's zero element.
+    Returns the point in affine coordinates. The point must not be the zero element.
   */
-  std::optional<EcPoint<FieldElementT>> AddOptionalPoint(
-      const std::optional<EcPoint<FieldElementT>>& point, const FieldElementT& alpha) const;
+  EcPoint<FieldElementT> ToAffine() const;
+
+  /*
+    Returns the given points in affine coordinates, computing a single inverse. The points must
+    not be the zero element.
+  */
+  static std::vector<EcPoint<FieldElementT>> BatchToAffine(
+      gsl::span<const JacobianEcPoint> points);
+
+  FieldElementT x;
+  FieldElementT y;
+  FieldElementT z;
 };
 
 /*
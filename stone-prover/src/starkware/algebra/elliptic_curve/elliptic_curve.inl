@@ -15,6 +15,7 @@
 #include "starkware/algebra/field_operations.h"
 #include "starkware/algebra/fields/fraction_field_element.h"
 #include "starkware/error_handling/error_handling.h"
+#include "starkware/math/math.h"
 
 namespace starkware {
 
@@ -225,11 +226,8 @@ template <typename FieldElementT>
 std::vector<EcPoint<FieldElementT>> TwosPowersOfPoint(
     const EcPoint<FieldElementT>& base, const FieldElementT& alpha, size_t num_points,
     const std::optional<gsl::span<FieldElementT>>& slopes, bool allow_more_points) {
-  using FractionFieldElementT = FractionFieldElement<FieldElementT>;
-
-  // To avoid repeated inverse computations we use a fraction field optimization.
-  // We compute the point doubling (and slopes if needed) in the fraction field, and then convert
-  // back to the original field using BatchToBaseFieldElement().
+  // To avoid repeated inverse computations, the doublings are computed in Jacobian coordinates,
+  // and all the points are converted back to affine coordinates together by BatchToAffine().
 
   LOG_IF(ERROR, num_points > FieldElementT::FieldSize().Log2Floor() && !allow_more_points)
       << "It is insecure to request " << num_points << " points which is more than "
@@ -239,60 +237,32 @@ std::vector<EcPoint<FieldElementT>> TwosPowersOfPoint(
     ASSERT_RELEASE(slopes->size() == num_points - 1, "Incorrect number of slopes requested.");
   }
 
-  // Initialize fraction field values.
-  FractionFieldElementT ff_alpha = FractionFieldElementT(alpha);
-  EcPoint<FractionFieldElementT> point =
-      EcPoint<FractionFieldElementT>(FractionFieldElementT(base.x), FractionFieldElementT(base.y));
-
-  // Initialize fraction field columns.
-  // A column for x, y, and possibly slope if we need to compute it.
-  const size_t n_cols_ff = 2;
-  const size_t col_slope = 2;
-  std::vector<std::vector<FractionFieldElementT>> ff_cols(
-      n_cols_ff + (slopes.has_value() ? 1 : 0),
-      std::vector<FractionFieldElementT>(num_points, FractionFieldElementT::Uninitialized()));
-  auto& ff_cols_x = ff_cols[0];
-  auto& ff_cols_y = ff_cols[1];
-  ff_cols_x[0] = point.x;
-  ff_cols_y[0] = point.y;
-
-  // Make sure extra element is invertible.
-  if (slopes.has_value()) {
-    ff_cols[2][0] = FractionFieldElementT::One();
-  }
-
-  // Repeated doubling in fraction field.
+  // Repeated doubling in Jacobian coordinates.
+  std::vector<JacobianEcPoint<FieldElementT>> jacobian_points;
+  jacobian_points.reserve(num_points);
+  jacobian_points.emplace_back(base);
   for (size_t i = 0; i < num_points - 1; ++i) {
+    // The y coordinate of a nonzero Jacobian point is zero iff its affine y coordinate is zero.
     ASSERT_RELEASE(
-        point.y != FractionFieldElementT::Zero(), "Base is of order 2^" + std::to_string(i + 1));
-    if (slopes.has_value()) {
-      point = point.Double(ff_alpha, &ff_cols[col_slope][i + 1]);
-    } else {
-      point = point.Double(ff_alpha, nullptr);
-    }
-    ff_cols_x[i + 1] = point.x;
-    ff_cols_y[i + 1] = point.y;
+        jacobian_points.back().y != FieldElementT::Zero(),
+        "Base is of order 2^" + std::to_string(i + 1));
+    jacobian_points.push_back(jacobian_points.back().Double(alpha));
   }
 
-  // Convert back to original field.
-  std::vector<std::vector<FieldElementT>> cols(
-      n_cols_ff + (slopes.has_value() ? 1 : 0),
-      std::vector<FieldElementT>(num_points, FieldElementT::Uninitialized()));
+  // Convert back to affine coordinates.
+  std::vector<EcPoint<FieldElementT>> points_ret =
+      JacobianEcPoint<FieldElementT>::BatchToAffine(jacobian_points);
 
-  FractionFieldElementT::BatchToBaseFieldElement(
-      ConstSpanAdapter(std::move(ff_cols)), SpanAdapter(cols));
-
-  // Build EC points to return.
-  std::vector<EcPoint<FieldElementT>> points_ret;
-  points_ret.reserve(num_points);
-  for (size_t i = 0; i < num_points; ++i) {
-    points_ret.emplace_back(cols[0][i], cols[1][i]);
-  }
-
-  // Write back slopes to if needed.
-  if (slopes.has_value()) {
+  // Compute the slopes of the tangents, (3 * x^2 + alpha) / (2 * y), if needed.
+  if (slopes.has_value() && num_points > 1) {
+    std::vector<FieldElementT> denominators;
+    denominators.reserve(num_points - 1);
+    for (size_t i = 0; i < num_points - 1; ++i) {
+      denominators.push_back(Times(2, points_ret[i].y));
+    }
+    BatchInverse<FieldElementT>(denominators, *slopes);
     for (size_t i = 0; i < num_points - 1; ++i) {
-      (*slopes)[i] = cols[col_slope][i + 1];
+      (*slopes)[i] *= Times(3, Pow(points_ret[i].x, 2)) + alpha;
     }
   }
 
@@ -304,41 +274,164 @@ bool IsValidCurve(const FieldElementT& alpha, const FieldElementT& beta) {
   return Times(4, Pow(alpha, 3)) != -Times(27, Pow(beta, 2));
 }
 
+namespace details {
+
+/*
+  Returns the width-w NAF of scalar, least significant digit first: the digits are zero or odd, of
+  absolute value less than 2^(w-1), any w consecutive digits contain at most one nonzero digit, and
+  sum(digits[i] * 2^i) = scalar.
+*/
+template <size_t N>
+std::vector<int> WnafDigits(const BigInt<N>& scalar, size_t w) {
+  const uint64_t mask = Pow2(w) - 1;
+  const auto half = static_cast<int>(Pow2(w - 1));
+  // One extra limb, so that adding to the scalar never overflows.
+  BigInt<N + 1> k(scalar);
+  std::vector<int> digits;
+  digits.reserve(BigInt<N>::kDigits + 1);
+  while (k != BigInt<N + 1>::Zero()) {
+    int digit = 0;
+    if (!k.IsEven()) {
+      digit = static_cast<int>(k[0] & mask);
+      if (digit >= half) {
+        digit -= 2 * half;
+      }
+      k = digit > 0 ? k - BigInt<N + 1>(static_cast<uint64_t>(digit))
+                    : k + BigInt<N + 1>(static_cast<uint64_t>(-digit));
+    }
+    digits.push_back(digit);
+    k >>= 1;
+  }
+  return digits;
+}
+
+}  // namespace details
+
 template <typename FieldElementT>
 template <size_t N>
 EcPoint<FieldElementT> EcPoint<FieldElementT>::MultiplyByScalar(
     const BigInt<N>& scalar, const FieldElementT& alpha) const {
-  std::optional<EcPoint<FieldElementT>> res;
-  EcPoint<FieldElementT> power = *this;
-  for (const auto& b : scalar.ToBoolVector()) {
-    if (b) {
-      res = power.AddOptionalPoint(res, alpha);
-    }
-    // if power == -power, then power + power == zero, and will remain zero (so res will not change)
-    // until the end of the for loop. Therefore there is no point to keep looping.
-    if (power == -power) {
-      break;
+  using JacobianT = JacobianEcPoint<FieldElementT>;
+  constexpr size_t kWindowBits = 5;
+
+  // odd_multiples[i] = (2 * i + 1) * point.
+  const JacobianT point(*this);
+  const JacobianT doubled = point.Double(alpha);
+  std::vector<JacobianT> odd_multiples = {point};
+  odd_multiples.reserve(Pow2(kWindowBits - 2));
+  for (size_t i = 1; i < Pow2(kWindowBits - 2); ++i) {
+    odd_multiples.push_back(odd_multiples.back().Add(doubled, alpha));
+  }
+
+  const std::vector<int> digits = details::WnafDigits(scalar, kWindowBits);
+  JacobianT res = JacobianT::Zero();
+  for (auto it = digits.rbegin(); it != digits.rend(); ++it) {
+    res = res.Double(alpha);
+    if (*it > 0) {
+      res = res.Add(odd_multiples[*it / 2], alpha);
+    } else if (*it < 0) {
+      res = res.Add(-odd_multiples[-*it / 2], alpha);
     }
-    power = power.Double(alpha);
   }
-  ASSERT_RELEASE(res.has_value(), "Result of multiplication is the curve's zero element.");
-  return *res;
+  ASSERT_RELEASE(!res.IsZero(), "Result of multiplication is the curve's zero element.");
+  return res.ToAffine();
 }
 
 template <typename FieldElementT>
-std::optional<EcPoint<FieldElementT>> EcPoint<FieldElementT>::AddOptionalPoint(
-    const std::optional<EcPoint<FieldElementT>>& point, const FieldElementT& alpha) const {
-  if (!point) {
+auto JacobianEcPoint<FieldElementT>::Double(const FieldElementT& alpha) const -> JacobianEcPoint {
+  // See EcPoint::Double(). With x = X / Z^2 and y = Y / Z^3, the tangent slope is M / (2 * Y * Z)
+  // where M = 3 * X^2 + alpha * Z^4. Doubling the zero element or a point with y = 0 gives z = 0.
+  const FieldElementT x_squared = x * x;
+  const FieldElementT y_squared = y * y;
+  const FieldElementT z_squared = z * z;
+  const FieldElementT s = Times(4, x * y_squared);
+  const FieldElementT m = Times(3, x_squared) + alpha * z_squared * z_squared;
+  const FieldElementT x2 = m * m - (s + s);
+  const FieldElementT y2 = m * (s - x2) - Times(8, y_squared * y_squared);
+  return {x2, y2, Times(2, y * z)};
+}
+
+template <typename FieldElementT>
+auto JacobianEcPoint<FieldElementT>::Add(const JacobianEcPoint& rhs, const FieldElementT& alpha)
+    const -> JacobianEcPoint {
+  if (IsZero()) {
+    return rhs;
+  }
+  if (rhs.IsZero()) {
     return *this;
   }
-  // If a == -b, then a+b == zero element.
-  if (*point == -*this) {
-    return std::nullopt;
+  // Bring both points to the denominators z1^2 * z2^2 and z1^3 * z2^3.
+  const FieldElementT z1_squared = z * z;
+  const FieldElementT z2_squared = rhs.z * rhs.z;
+  const FieldElementT u1 = x * z2_squared;
+  const FieldElementT u2 = rhs.x * z1_squared;
+  const FieldElementT s1 = y * rhs.z * z2_squared;
+  const FieldElementT s2 = rhs.y * z * z1_squared;
+  const FieldElementT h = u2 - u1;
+  const FieldElementT r = s2 - s1;
+  if (h == FieldElementT::Zero()) {
+    // Either the points are equal, or their sum is the zero element.
+    return r == FieldElementT::Zero() ? Double(alpha) : Zero();
+  }
+  const FieldElementT h_squared = h * h;
+  const FieldElementT h_cubed = h * h_squared;
+  const FieldElementT v = u1 * h_squared;
+  const FieldElementT x3 = r * r - h_cubed - (v + v);
+  const FieldElementT y3 = r * (v - x3) - s1 * h_cubed;
+  return {x3, y3, z * rhs.z * h};
+}
+
+template <typename FieldElementT>
+auto JacobianEcPoint<FieldElementT>::AddAffine(
+    const EcPoint<FieldElementT>& rhs, const FieldElementT& alpha) const -> JacobianEcPoint {
+  if (IsZero()) {
+    return JacobianEcPoint(rhs);
   }
-  if (*point == *this) {
-    return point->Double(alpha);
+  // Same as Add() with rhs.z = 1.
+  const FieldElementT z_squared = z * z;
+  const FieldElementT h = rhs.x * z_squared - x;
+  const FieldElementT r = rhs.y * z * z_squared - y;
+  if (h == FieldElementT::Zero()) {
+    return r == FieldElementT::Zero() ? Double(alpha) : Zero();
+  }
+  const FieldElementT h_squared = h * h;
+  const FieldElementT h_cubed = h * h_squared;
+  const FieldElementT v = x * h_squared;
+  const FieldElementT x3 = r * r - h_cubed - (v + v);
+  const FieldElementT y3 = r * (v - x3) - y * h_cubed;
+  return {x3, y3, z * h};
+}
+
+template <typename FieldElementT>
+EcPoint<FieldElementT> JacobianEcPoint<FieldElementT>::ToAffine() const {
+  ASSERT_RELEASE(!IsZero(), "The zero element has no affine coordinates.");
+  const FieldElementT z_inverse = z.Inverse();
+  const FieldElementT z_inverse_squared = z_inverse * z_inverse;
+  return {x * z_inverse_squared, y * z_inverse_squared * z_inverse};
+}
+
+template <typename FieldElementT>
+std::vector<EcPoint<FieldElementT>> JacobianEcPoint<FieldElementT>::BatchToAffine(
+    gsl::span<const JacobianEcPoint> points) {
+  std::vector<FieldElementT> z_values;
+  z_values.reserve(points.size());
+  for (const JacobianEcPoint& point : points) {
+    ASSERT_RELEASE(!point.IsZero(), "The zero element has no affine coordinates.");
+    z_values.push_back(point.z);
+  }
+  std::vector<FieldElementT> z_inverses = FieldElementT::UninitializedVector(points.size());
+  if (!points.empty()) {
+    BatchInverse<FieldElementT>(z_values, z_inverses);
+  }
+
+  std::vector<EcPoint<FieldElementT>> res;
+  res.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const FieldElementT z_inverse_squared = z_inverses[i] * z_inverses[i];
+    res.emplace_back(
+        points[i].x * z_inverse_squared, points[i].y * z_inverse_squared * z_inverses[i]);
   }
-  return *point + *this;
+  return res;
 }
 
 }  // namespace starkware
@@ -15,6 +15,7 @@
 #include "starkware/algebra/elliptic_curve/elliptic_curve.h"
 
 #include <cstddef>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -165,6 +166,97 @@ TEST(EllipticCurve, MulPowerBecomesZeroTest) {
   EXPECT_ASSERT(point.MultiplyByScalar(0x4_Z, alpha), HasSubstr("zero element"));
 }
 
+TEST(EllipticCurve, MulByScalarMatchesDoubleAndAdd) {
+  Prng prng;
+  const EcPoint<FieldElementT> generator = kPrimeFieldEc0.k_points[1];
+  const FieldElementT& alpha = kPrimeFieldEc0.k_alpha;
+  for (size_t i = 0; i < 10; ++i) {
+    const auto scalar = prng.UniformBigInt(
+        EllipticCurveConstants<FieldElementT>::ValueType::One(), kPrimeFieldEc0.k_order);
+    std::optional<EcPoint<FieldElementT>> expected;
+    EcPoint<FieldElementT> power = generator;
+    for (const bool bit : scalar.ToBoolVector()) {
+      if (bit) {
+        expected = expected.has_value() ? *expected + power : power;
+      }
+      power = power.Double(alpha);
+    }
+    EXPECT_EQ(generator.MultiplyByScalar(scalar, alpha), *expected);
+  }
+}
+
+TEST(EllipticCurve, JacobianMatchesAffine) {
+  Prng prng;
+  const EcPoint<FieldElementT> point1 = {FieldElementT::RandomElement(&prng),
+                                         FieldElementT::RandomElement(&prng)};
+  const FieldElementT alpha = FieldElementT::RandomElement(&prng);
+  // Any point on the curve of point1, with a Jacobian z other than 1.
+  const EcPoint<FieldElementT> point2 = point1.Double(alpha).Double(alpha) + point1;
+  const JacobianEcPoint<FieldElementT> jacobian1(point1);
+  const JacobianEcPoint<FieldElementT> jacobian2 = jacobian1.Double(alpha).Double(alpha).Add(
+      jacobian1, alpha);
+  EXPECT_EQ(jacobian2.ToAffine(), point2);
+
+  EXPECT_EQ(jacobian1.Double(alpha).ToAffine(), point1.Double(alpha));
+  EXPECT_EQ(jacobian2.Add(jacobian1, alpha).ToAffine(), point2 + point1);
+  EXPECT_EQ(jacobian2.AddAffine(point1, alpha).ToAffine(), point2 + point1);
+  EXPECT_EQ(jacobian2.Add(jacobian2, alpha).ToAffine(), point2.Double(alpha));
+  EXPECT_EQ(jacobian2.AddAffine(point2, alpha).ToAffine(), point2.Double(alpha));
+  EXPECT_TRUE(jacobian2.Add(-jacobian2, alpha).IsZero());
+  EXPECT_TRUE(jacobian2.AddAffine(-point2, alpha).IsZero());
+
+  // The zero element.
+  const auto zero = JacobianEcPoint<FieldElementT>::Zero();
+  EXPECT_TRUE(zero.Double(alpha).IsZero());
+  EXPECT_EQ(zero.Add(jacobian2, alpha).ToAffine(), point2);
+  EXPECT_EQ(jacobian2.Add(zero, alpha).ToAffine(), point2);
+  EXPECT_EQ(zero.AddAffine(point2, alpha).ToAffine(), point2);
+  EXPECT_ASSERT(zero.ToAffine(), HasSubstr("zero element"));
+}
+
+TEST(EllipticCurve, BatchToAffine) {
+  Prng prng;
+  std::vector<EcPoint<FieldElementT>> points;
+  std::vector<JacobianEcPoint<FieldElementT>> jacobian_points;
+  for (size_t i = 0; i < 10; ++i) {
+    points.emplace_back(FieldElementT::RandomElement(&prng), FieldElementT::RandomElement(&prng));
+    const FieldElementT z = FieldElementT::RandomElement(&prng);
+    jacobian_points.emplace_back(points[i].x * z * z, points[i].y * z * z * z, z);
+  }
+  EXPECT_EQ(JacobianEcPoint<FieldElementT>::BatchToAffine(jacobian_points), points);
+  EXPECT_TRUE(JacobianEcPoint<FieldElementT>::BatchToAffine({}).empty());
+
+  jacobian_points.push_back(JacobianEcPoint<FieldElementT>::Zero());
+  EXPECT_ASSERT(
+      JacobianEcPoint<FieldElementT>::BatchToAffine(jacobian_points), HasSubstr("zero element"));
+}
+
+TEST(EllipticCurve, TwosPowersOfPointSlopes) {
+  Prng prng;
+  const EcPoint<FieldElementT> base = {FieldElementT::RandomElement(&prng),
+                                       FieldElementT::RandomElement(&prng)};
+  const FieldElementT alpha = FieldElementT::RandomElement(&prng);
+  const size_t num_points = 20;
+  std::vector<FieldElementT> slopes = FieldElementT::UninitializedVector(num_points - 1);
+  const std::vector<EcPoint<FieldElementT>> points =
+      TwosPowersOfPoint(base, alpha, num_points, std::make_optional(gsl::make_span(slopes)));
+
+  EcPoint<FieldElementT> expected = base;
+  for (size_t i = 0; i < num_points; ++i) {
+    EXPECT_EQ(points[i], expected);
+    if (i < num_points - 1) {
+      FieldElementT expected_slope = FieldElementT::Uninitialized();
+      expected = expected.Double(alpha, &expected_slope);
+      EXPECT_EQ(slopes[i], expected_slope);
+    }
+  }
+
+  // A point of order 2 cannot be doubled.
+  EXPECT_ASSERT(
+      TwosPowersOfPoint(EcPoint<FieldElementT>(base.x, FieldElementT::Zero()), alpha, 2),
+      HasSubstr("Base is of order 2^1"));
+}
+
 TEST(EllipticCurve, MinusPointTest) {
   Prng prng;
   FieldElementT x1 = FieldElementT::RandomElement(&prng);
@@ -25,6 +25,7 @@
 
 DECLARE_uint64(four_step_fft_threshold);
 DECLARE_int64(log_min_twiddle_shift_task_size);
+DECLARE_uint64(fft_log_radix);
 
 namespace starkware {
 
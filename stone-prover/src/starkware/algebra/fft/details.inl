@@ -13,6 +13,9 @@
 // and limitations under the License.
 
 
+#include <array>
+#include <type_traits>
+
 #include "third_party/cppitertools/range.hpp"
 
 #include "starkware/algebra/fft/fft_with_precompute.h"
@@ -166,11 +169,18 @@ void FftPrecomputeFourStepNaturalOrderTwiddleFactors(
   auto g = sub_groups_generators[0];
   std::vector<FieldElementT> offsets = FieldElementT::UninitializedVector(num_tasks);
   if (num_fft_layers % 2 == 1) {
-    // If there is an odd number of layers, the last layer has to be ordered regularly.
-    size_t last_layer_size = Pow2(num_fft_layers - 1);
-    FftPrecomputeNaturalOrderOneLayer(
-        bases[0].StartOffset(), g, last_layer_size,
-        factors_out.subspan(last_layer_size - 1, last_layer_size));
+    // If there is an odd number of layers, the last layer is stored as a num_tasks x num_tasks
+    // matrix whose (row, column) entry is the twiddle factor of index column * num_tasks + row.
+    // This is the order in which FourStepFftNatural() applies it.
+    const size_t last_layer_size = Pow2(num_fft_layers - 1);
+    const auto last_layer = factors_out.subspan(last_layer_size - 1, last_layer_size);
+    const FieldElementT g_num_tasks = Pow(g, num_tasks);
+    FieldElementT row_offset = bases[0].StartOffset();
+    for (size_t row = 0; row < num_tasks; ++row) {
+      FftPrecomputeNaturalOrderOneLayer(
+          row_offset, g_num_tasks, num_tasks, last_layer.subspan(row * num_tasks, num_tasks));
+      row_offset *= g;
+    }
     // Need to update initial offset and generator for the rest of the layers.
     g *= g;
     c *= c;
@@ -375,33 +385,133 @@ inline void FftNaturalToReverseLoop<PrimeFieldElement<252, 0>>(
 }
 #endif
 
+/*
+  Applies kNumLayers consecutive layers of FftNaturalToReverseLoop() in a single pass over the
+  data. distance is the distance of the first layer, and twiddle_tree_root_index is the index of
+  its twiddle factors. Each group of 2^kNumLayers elements that interact in these layers is loaded
+  once, transformed in registers and stored once, instead of being loaded and stored in every
+  layer. The butterflies are the same as in the unfused loop, so the output is identical.
+*/
+template <typename FieldElementT, size_t kNumLayers>
+ALWAYS_INLINE void FftNaturalToReverseFusedLoop(
+    const FieldElementT* src, size_t length, gsl::span<const FieldElementT> twiddle_factors,
+    size_t twiddle_tree_root_index, size_t distance, FieldElementT* dst) {
+  constexpr size_t kRadix = Pow2(kNumLayers);
+  const size_t last_distance = distance >> (kNumLayers - 1);
+
+  size_t block = 0;
+  for (size_t i = 0; i < length; i += 2 * distance, ++block) {
+    // The twiddle factors of layer l are stored at twiddles[2^l - 1, 2^(l+1) - 1).
+    auto twiddles = UninitializedFieldElementArray<FieldElementT, kRadix - 1>();
+    for (size_t layer = 0; layer < kNumLayers; ++layer) {
+      const size_t layer_root_index = ((twiddle_tree_root_index + 1) << layer) - 1;
+      for (size_t t = 0; t < Pow2(layer); ++t) {
+        twiddles[Pow2(layer) - 1 + t] =
+            UncheckedAt(twiddle_factors, layer_root_index + (block << layer) + t);
+      }
+    }
+
+    for (size_t j = 0; j < last_distance; ++j) {
+      auto values = UninitializedFieldElementArray<FieldElementT, kRadix>();
+      for (size_t m = 0; m < kRadix; ++m) {
+        // NOLINTNEXTLINE: do not use pointer arithmetic.
+        values[m] = src[i + j + m * last_distance];
+      }
+      for (size_t layer = 0; layer < kNumLayers; ++layer) {
+        const size_t half = kRadix >> (layer + 1);
+        for (size_t m = 0; m < kRadix; ++m) {
+          if ((m & half) == 0) {
+            const FieldElementT& twiddle_factor =
+                twiddles[Pow2(layer) - 1 + (m >> (kNumLayers - layer))];
+            FieldElementT::FftButterfly(
+                values[m], values[m + half], twiddle_factor, &values[m], &values[m + half]);
+          }
+        }
+      }
+      for (size_t m = 0; m < kRadix; ++m) {
+        // NOLINTNEXTLINE: do not use pointer arithmetic.
+        dst[i + j + m * last_distance] = values[m];
+      }
+    }
+  }
+}
+
+/*
+  Applies kNumLayers consecutive layers of the natural order FFT (see
+  FftUsingPrecomputedTwiddleFactorsInner()) in a single pass over the data. distance,
+  twiddle_tree_root_index and jump (the offset between the twiddle factors of consecutive layers)
+  refer to the first of these layers.
+*/
+template <typename FieldElementT, size_t kNumLayers>
+ALWAYS_INLINE void FftNaturalFusedLoop(
+    gsl::span<const FieldElementT> src, gsl::span<const FieldElementT> twiddle_factors,
+    size_t distance, size_t twiddle_tree_root_index, size_t twiddle_stride, size_t jump,
+    gsl::span<FieldElementT> dst) {
+  constexpr size_t kRadix = Pow2(kNumLayers);
+  const size_t n = src.size();
+
+  for (size_t i = 0; i < n; i += kRadix * distance) {
+    for (size_t j = 0; j < distance; j++) {
+      auto values = UninitializedFieldElementArray<FieldElementT, kRadix>();
+      for (size_t m = 0; m < kRadix; ++m) {
+        values[m] = UncheckedAt(src, i + j + m * distance);
+      }
+      for (size_t layer = 0; layer < kNumLayers; ++layer) {
+        const size_t half = Pow2(layer);
+        const size_t layer_root_index = twiddle_tree_root_index + (half - 1) * jump;
+        for (size_t m = 0; m < kRadix; ++m) {
+          if ((m & half) == 0) {
+            const size_t twiddle_index = j + (m & (half - 1)) * distance;
+            FieldElementT::FftButterfly(
+                values[m], values[m + half],
+                UncheckedAt(twiddle_factors, layer_root_index + twiddle_index * twiddle_stride),
+                &values[m], &values[m + half]);
+          }
+        }
+      }
+      for (size_t m = 0; m < kRadix; ++m) {
+        UncheckedAt(dst, i + j + m * distance) = values[m];
+      }
+    }
+  }
+}
+
 template <typename FieldElementT>
 void FftUsingPrecomputedTwiddleFactorsInner(
     gsl::span<const FieldElementT> src, gsl::span<const FieldElementT> twiddle_factors,
     size_t layers_to_skip, size_t iterations, bool normalize, gsl::span<FieldElementT> dst,
     size_t twiddle_tree_root_index, size_t twiddle_stride) {
-  const size_t n = src.size();
+  // The twiddle factors of each layer start jump entries after those of the previous layer.
   size_t jump = twiddle_stride;
-
   size_t distance = Pow2(layers_to_skip);
   gsl::span<const FieldElementT> curr_src = src;
 
-  for (size_t layer = 0; layer < iterations; layer++) {
-    for (size_t i = 0; i < n; i += 2 * distance) {
-      for (size_t j = 0; j < distance; j++) {
-        size_t idx = i + j;
-        FieldElementT::FftButterfly(
-            UncheckedAt(curr_src, idx), UncheckedAt(curr_src, idx + distance),
-            UncheckedAt(twiddle_factors, twiddle_tree_root_index + j * twiddle_stride),
-            &UncheckedAt(dst, idx), &UncheckedAt(dst, idx + distance));
-      }
+  for (size_t layer = 0; layer < iterations;) {
+    const size_t n_fused_layers = std::min<size_t>(FLAGS_fft_log_radix, iterations - layer);
+    switch (n_fused_layers) {
+      case 3:
+        FftNaturalFusedLoop<FieldElementT, 3>(
+            curr_src, twiddle_factors, distance, twiddle_tree_root_index, twiddle_stride, jump,
+            dst);
+        break;
+      case 2:
+        FftNaturalFusedLoop<FieldElementT, 2>(
+            curr_src, twiddle_factors, distance, twiddle_tree_root_index, twiddle_stride, jump,
+            dst);
+        break;
+      default:
+        FftNaturalFusedLoop<FieldElementT, 1>(
+            curr_src, twiddle_factors, distance, twiddle_tree_root_index, twiddle_stride, jump,
+            dst);
+        break;
     }
 
-    twiddle_tree_root_index += jump;
-    jump *= 2;
+    twiddle_tree_root_index += (Pow2(n_fused_layers) - 1) * jump;
+    jump <<= n_fused_layers;
     // First fft iteration copies the data, the following iteration work in-place.
     curr_src = dst;
-    distance <<= 1;
+    distance <<= n_fused_layers;
+    layer += n_fused_layers;
   }
 
   if (normalize) {
@@ -409,71 +519,73 @@ void FftUsingPrecomputedTwiddleFactorsInner(
   }
 }
 
-template <typename FieldElementT>
-void ButterflyTwoArraysNatural(
-    gsl::span<const FieldElementT> src_a, gsl::span<const FieldElementT> src_b,
-    gsl::span<FieldElementT> dst_a, gsl::span<FieldElementT> dst_b,
-    gsl::span<const FieldElementT> twiddle_factors) {
-  size_t n = src_a.size();
-  for (size_t idx = 0; idx < n; idx++) {
-    FieldElementT::FftButterfly(
-        UncheckedAt(src_a, idx), UncheckedAt(src_b, idx), UncheckedAt(twiddle_factors, idx),
-        &UncheckedAt(dst_a, idx), &UncheckedAt(dst_b, idx));
-  }
-}
-
-template <typename FieldElementT>
-void ParallelButterflyTwoArraysNatural(
-    gsl::span<const FieldElementT> src, gsl::span<FieldElementT> dst,
-    gsl::span<const FieldElementT> twiddle_factors, bool normalize,
-    const size_t max_chunk_size = 256) {
-  size_t distance = src.size() / 2;
-  size_t last_twiddle_layer_idx = twiddle_factors.size() / 2;
-  auto twiddle_factors_half = twiddle_factors.subspan(last_twiddle_layer_idx);
-  TaskManager& task_manager = TaskManager::GetInstance();
-  const size_t chunk = std::min<size_t>(max_chunk_size, distance);
-  task_manager.ParallelFor(
-      distance / chunk,
-      [twiddle_factors_half, chunk, distance, src, dst, normalize](const TaskInfo& task_info) {
-        size_t task_start_idx = task_info.start_idx * chunk;
-        ButterflyTwoArraysNatural<FieldElementT>(
-            src.subspan(task_start_idx, chunk), src.subspan(task_start_idx + distance, chunk),
-            dst.subspan(task_start_idx, chunk), dst.subspan(task_start_idx + distance, chunk),
-            twiddle_factors_half.subspan(task_start_idx, chunk));
-        if (normalize) {
-          NormalizeArray(dst.subspan(task_start_idx, chunk));
-          NormalizeArray(dst.subspan(task_start_idx + distance, chunk));
-        }
-      });
-}
-
+/*
+  Computes FFT on src, of size 2^{2k} or 2^{2k+1}, into buff. src and buff may be the same array.
+  Input is in natural order (N), output is in natural order (N).
+  The first pass reads the rows of src directly, so no copy of src into buff is needed.
+
+  In the odd case, each half of src is viewed as a 2^k x 2^k matrix and gets the 2k layers of its
+  own four step FFT. The last layer, which combines the two halves, is applied to each pair of
+  rows right after the second pass computed them, while they are still in the cache. Since both
+  halves are then transposed the same way, the layer commutes with the final transposes, provided
+  that the element at (row, column) uses the twiddle factor of (column, row). The twiddle factors
+  of this layer are stored in that order (see FftPrecomputeFourStepNaturalOrderTwiddleFactors()).
+*/
 template <typename FieldElementT>
 void FourStepFftNatural(
-    gsl::span<const FieldElementT> twiddle_factors, gsl::span<FieldElementT> buff,
-    size_t twiddle_factor_root_index, size_t initial_num_of_layers, bool normalize) {
+    gsl::span<const FieldElementT> src, gsl::span<const FieldElementT> twiddle_factors,
+    gsl::span<FieldElementT> buff, size_t twiddle_factor_root_index, size_t initial_num_of_layers,
+    bool normalize) {
   const size_t num_tasks = Pow2(initial_num_of_layers);
   const size_t chunk = num_tasks;
+  const size_t half_size = chunk * chunk;
+  const size_t n_halves = buff.size() / half_size;
+  ASSERT_RELEASE(n_halves == 1 || n_halves == 2, "buff must be of size 2^{2k} or 2^{2k+1}.");
 
   TaskManager& task_manager = TaskManager::GetInstance();
   task_manager.ParallelFor(
-      num_tasks, [chunk, initial_num_of_layers, twiddle_factor_root_index, twiddle_factors,
-                  buff](const TaskInfo& task_info) {
+      n_halves * num_tasks, [chunk, initial_num_of_layers, twiddle_factor_root_index,
+                             twiddle_factors, src, buff](const TaskInfo& task_info) {
         uint64_t task_start_idx = task_info.start_idx * chunk;
         FftUsingPrecomputedTwiddleFactorsInner<FieldElementT>(
-            buff.subspan(task_start_idx, chunk), twiddle_factors, 0, initial_num_of_layers, false,
+            src.subspan(task_start_idx, chunk), twiddle_factors, 0, initial_num_of_layers, false,
             buff.subspan(task_start_idx, chunk), twiddle_factor_root_index, 1);
       });
-  ParallelTranspose(buff, num_tasks);
+  for (size_t half = 0; half < n_halves; ++half) {
+    ParallelTranspose(buff.subspan(half * half_size, half_size), num_tasks);
+  }
 
   const size_t twiddle_size = chunk - 1;
+  // The twiddle factors of the last layer, in the odd case.
+  const auto last_layer_twiddle_factors = twiddle_factors.subspan(twiddle_factors.size() / 2);
 
   task_manager.ParallelFor(num_tasks, [&](const TaskInfo& task_info) {
     uint64_t work_id = task_info.start_idx;
-    FftUsingPrecomputedTwiddleFactorsInner<FieldElementT>(
-        buff.subspan(chunk * work_id, chunk), twiddle_factors, 0, initial_num_of_layers, normalize,
-        buff.subspan(chunk * work_id, chunk), twiddle_size * (work_id + 1), 1);
+    for (size_t half = 0; half < n_halves; ++half) {
+      const auto row = buff.subspan(half * half_size + chunk * work_id, chunk);
+      FftUsingPrecomputedTwiddleFactorsInner<FieldElementT>(
+          row, twiddle_factors, 0, initial_num_of_layers, normalize && n_halves == 1, row,
+          twiddle_size * (work_id + 1), 1);
+    }
+    if (n_halves == 2) {
+      const auto row_a = buff.subspan(chunk * work_id, chunk);
+      const auto row_b = buff.subspan(half_size + chunk * work_id, chunk);
+      const auto row_twiddle_factors = last_layer_twiddle_factors.subspan(chunk * work_id, chunk);
+      for (size_t column = 0; column < chunk; ++column) {
+        FieldElementT::FftButterfly(
+            UncheckedAt(row_a, column), UncheckedAt(row_b, column),
+            UncheckedAt(row_twiddle_factors, column), &UncheckedAt(row_a, column),
+            &UncheckedAt(row_b, column));
+      }
+      if (normalize) {
+        NormalizeArray(row_a);
+        NormalizeArray(row_b);
+      }
+    }
   });
-  ParallelTranspose(buff, num_tasks);
+  for (size_t half = 0; half < n_halves; ++half) {
+    ParallelTranspose(buff.subspan(half * half_size, half_size), num_tasks);
+  }
 }
 
 template <typename FieldElementT>
@@ -491,23 +603,8 @@ void FftUsingPrecomputedTwiddleFactors(
   }
 
   ValidateFFTSizes(src, dst, num_fft_layers);
-  if (src.data() != dst.data()) {
-    std::copy(src.begin(), src.end(), dst.begin());
-  }
-
-  size_t twiddle_factor_root_index = 0;
-  if (num_fft_layers % 2 == 1) {
-    FourStepFftNatural(
-        twiddle_factors, dst.subspan(0, n / 2), twiddle_factor_root_index, initial_num_layers,
-        false);
-    FourStepFftNatural(
-        twiddle_factors, dst.subspan(n / 2), twiddle_factor_root_index, initial_num_layers, false);
-
-    ParallelButterflyTwoArraysNatural<FieldElementT>(dst, dst, twiddle_factors, normalize, 256);
-  } else {
-    FourStepFftNatural(
-        twiddle_factors, dst, twiddle_factor_root_index, initial_num_layers, normalize);
-  }
+  FourStepFftNatural(
+      src, twiddle_factors, dst, /*twiddle_factor_root_index=*/0, initial_num_layers, normalize);
 }
 
 template <typename BasesT>
@@ -595,23 +692,30 @@ void ParallelButterflyTwoArrays(
 }
 
 /*
-  Auxiliary function that computes FFT on an array, dst, of size 2^{2k}.
+  Auxiliary function that computes FFT on an array, src, of size 2^{2k}, into buff. src and buff may
+  be the same array.
   Input is in natural order (N), output is in bit reversal order (R).
   The computation method:
-    - The function views dst a sqrt(n)xsqrt(n) matrix. It then transposes the matrix, and computes
-    sqrt(n) FFTs on the sqrt(n) rows of the transposed matrix, for half of the needed layers.
+    - The function views src a sqrt(n)xsqrt(n) matrix. It then transposes the matrix into buff
+    (out of place, if src and buff are different arrays), and computes sqrt(n) FFTs on the
+    sqrt(n) rows of the transposed matrix, for half of the needed layers.
     - It then transposes the matrix again, and computes sqrt(n) FFTs on the sqrt(n) rows of the
   matrix, for the remaining layers.
 */
 template <typename FieldElementT>
 void FourStepFft(
-    gsl::span<const FieldElementT> twiddle_factors, gsl::span<FieldElementT> buff,
-    size_t twiddle_tree_root_index, size_t initial_num_of_layers, bool normalize = true) {
+    gsl::span<const FieldElementT> src, gsl::span<const FieldElementT> twiddle_factors,
+    gsl::span<FieldElementT> buff, size_t twiddle_tree_root_index, size_t initial_num_of_layers,
+    bool normalize = true) {
   ASSERT_RELEASE(SafeLog2(buff.size()) % 2 == 0, "buff must be of size 2^{2k}.");
   TaskManager& task_manager = TaskManager::GetInstance();
   const size_t num_tasks = Pow2(initial_num_of_layers);
   const size_t chunk = num_tasks;
-  ParallelTranspose(buff, num_tasks);
+  if (src.data() == buff.data()) {
+    ParallelTranspose(buff, num_tasks);
+  } else {
+    ParallelTranspose(src, buff, num_tasks, num_tasks);
+  }
   task_manager.ParallelFor(
       num_tasks, [buff, &twiddle_factors, chunk, initial_num_of_layers,
                   twiddle_tree_root_index](const TaskInfo& task_info) {
@@ -665,16 +769,16 @@ void FftNaturalToReverseWithPrecompute(
     ParallelButterflyTwoArrays(src, dst, twiddle_factors[0]);
     fft_size /= 2;
     twiddle_tree_root_index += 1;
-  } else if (src.data() != dst.data()) {
-    std::copy(src.begin(), src.end(), dst.begin());
-  }
-  FourStepFft(
-      twiddle_factors, dst.subspan(0, fft_size), twiddle_tree_root_index, initial_num_of_layers,
-      normalize);
-  if (num_fft_layers % 2 /*If odd*/) {
-    FourStepFft(
-        twiddle_factors, dst.subspan(fft_size), twiddle_tree_root_index + 1, initial_num_of_layers,
-        normalize);
+    FourStepFft<FieldElementT>(
+        dst.subspan(0, fft_size), twiddle_factors, dst.subspan(0, fft_size),
+        twiddle_tree_root_index, initial_num_of_layers, normalize);
+    FourStepFft<FieldElementT>(
+        dst.subspan(fft_size), twiddle_factors, dst.subspan(fft_size), twiddle_tree_root_index + 1,
+        initial_num_of_layers, normalize);
+  } else {
+    // The first transpose of FourStepFft() copies src into dst.
+    FourStepFft<FieldElementT>(
+        src, twiddle_factors, dst, twiddle_tree_root_index, initial_num_of_layers, normalize);
   }
 }
 
@@ -694,14 +798,37 @@ void FftNaturalToReverseWithPrecomputeInner(
 
   size_t distance = n;
 
-  for (size_t layer = 0; layer < stop_layer; layer++) {
+  size_t log_radix = FLAGS_fft_log_radix;
+#ifndef __EMSCRIPTEN__
+  // The radix-2 assembly loop of PrimeFieldElement<252, 0> is faster than the fused kernels.
+  if constexpr (std::is_same_v<FieldElementT, PrimeFieldElement<252, 0>>) {  // NOLINT
+    log_radix = 1;
+  }
+#endif
+
+  for (size_t layer = 0; layer < stop_layer;) {
+    const size_t n_fused_layers = std::min(log_radix, stop_layer - layer);
     distance >>= 1;
-    FftNaturalToReverseLoop<FieldElementT>(
-        curr_src.data(), n, &UncheckedAt(twiddle_factors, twiddle_tree_root_index), distance,
-        dst.data());
+    switch (n_fused_layers) {
+      case 3:
+        FftNaturalToReverseFusedLoop<FieldElementT, 3>(
+            curr_src.data(), n, twiddle_factors, twiddle_tree_root_index, distance, dst.data());
+        break;
+      case 2:
+        FftNaturalToReverseFusedLoop<FieldElementT, 2>(
+            curr_src.data(), n, twiddle_factors, twiddle_tree_root_index, distance, dst.data());
+        break;
+      default:
+        FftNaturalToReverseLoop<FieldElementT>(
+            curr_src.data(), n, &UncheckedAt(twiddle_factors, twiddle_tree_root_index), distance,
+            dst.data());
+        break;
+    }
     // First fft iteration copies the data, the following iteration work in-place.
     curr_src = dst;
-    twiddle_tree_root_index = twiddle_tree_root_index * 2 + 1;
+    distance >>= n_fused_layers - 1;
+    twiddle_tree_root_index = ((twiddle_tree_root_index + 1) << n_fused_layers) - 1;
+    layer += n_fused_layers;
   }
   if (normalize) {
     NormalizeArray(dst);
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions
 // and limitations under the License.
 
+#include <cstdint>
+
 #include "gflags/gflags.h"
 
 DEFINE_uint64(
@@ -19,3 +21,17 @@ DEFINE_uint64(
 DEFINE_int64(
     log_min_twiddle_shift_task_size, 10,
     "Sets the minimal task_size used by ComputeTwiddleFromOtherTwiddle.");
+DEFINE_uint64(
+    fft_log_radix, 2,
+    "Number of FFT layers (1, 2 or 3) that are fused into a single pass over the data. Not used by "
+    "the bit reversed FFT over PrimeFieldElement<252, 0>, which has an assembly radix-2 loop.");
+
+namespace {
+
+bool ValidateFftLogRadix(const char* /*flagname*/, uint64_t value) {
+  return value >= 1 && value <= 3;
+}
+
+}  // namespace
+
+DEFINE_validator(fft_log_radix, &ValidateFftLogRadix);
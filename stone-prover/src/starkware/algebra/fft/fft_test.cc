@@ -145,6 +145,20 @@ TYPED_TEST(FftTest, NormalFftTest) {
   TestMultiplicativeFft<BasesT>(0);
 }
 
+TYPED_TEST(FftTest, FusedLayers) {
+  using BasesT = typename TypeParam::BasesT_;
+  if (TypeParam::kUseFourStepFft) {
+    FLAGS_four_step_fft_threshold = 0;
+  }
+  const uint64_t log_radix = FLAGS_fft_log_radix;
+  for (FLAGS_fft_log_radix = 1; FLAGS_fft_log_radix <= 3; ++FLAGS_fft_log_radix) {
+    // The number of layers is not a multiple of the number of fused layers.
+    TestMultiplicativeFft<BasesT>(7);
+    TestMultiplicativeFft<BasesT>(2);
+  }
+  FLAGS_fft_log_radix = log_radix;
+}
+
 template <typename BasesT>
 void TestMultiplicativeIfft(const size_t log_n) {
   using FieldElementT = typename BasesT::FieldElementT;
@@ -379,8 +393,14 @@ void TestTwiddleShiftByElement(const BasesT& bases) {
 
 TYPED_TEST(FftTest, TwiddleShiftByConstantMult) {
   using BasesT = typename TypeParam::BasesT_;
-  auto bases = MakeFftBases<BasesT::kOrder, typename BasesT::FieldElementT>(8);
-  TestTwiddleShiftByElement<BasesT>(bases);
+  if (TypeParam::kUseFourStepFft) {
+    FLAGS_four_step_fft_threshold = 0;
+  }
+  // An odd number of layers has its own twiddle factors layout in the four step FFT.
+  for (const size_t log_n : {8, 9}) {
+    auto bases = MakeFftBases<BasesT::kOrder, typename BasesT::FieldElementT>(log_n);
+    TestTwiddleShiftByElement<BasesT>(bases);
+  }
 }
 
 }  // namespace
@@ -16,10 +16,13 @@
 #define STARKWARE_ALGEBRA_FFT_FFT_WITH_PRECOMPUTE_H_
 
 #include <algorithm>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "starkware/algebra/fft/details.h"
+#include "starkware/algebra/fft/twiddle_factors_cache.h"
 
 namespace starkware {
 
@@ -41,15 +44,29 @@ class DummyFftWithPrecompute : public FftWithPrecomputeBase {
       const FieldElement& /*offset*/, const FieldElement& /*prev_offset*/) override {}
 };
 
+/*
+  Returns the key of the twiddle factors of bases, on the coset of start_offset, in
+  TwiddleFactorsCache. precompute_depth is the number of precomputed layers (at most
+  bases.NumLayers()), since tables of different depths have different sizes.
+*/
+template <typename BasesT>
+std::string TwiddleFactorsCacheKey(
+    const BasesT& bases, const typename BasesT::FieldElementT& start_offset,
+    size_t precompute_depth);
+
+/*
+  Computes an FFT using precomputed twiddle factors. The twiddle factors of the domain given in the
+  constructor are taken from TwiddleFactorsCache::GetInstance(), so instances on the same domain
+  share them. The tables of the cosets visited by ShiftTwiddleFactors() are not cached, since each
+  coset is typically visited once per trace: they are derived from the current table in a buffer
+  owned by the instance.
+*/
 template <typename BasesT>
 class FftWithPrecompute : public FftWithPrecomputeBase {
   using FieldElementT = typename BasesT::FieldElementT;
 
  public:
-  explicit FftWithPrecompute(BasesT bases, size_t precompute_depth)
-      : bases_(std::move(bases)),
-        twiddle_factors_(fft::details::FftPrecomputeTwiddleFactors<BasesT>(
-            bases_, std::min(precompute_depth, bases_.NumLayers()))) {}
+  explicit FftWithPrecompute(BasesT bases, size_t precompute_depth);
 
   explicit FftWithPrecompute(BasesT bases) : FftWithPrecompute(bases, bases.NumLayers()) {}
 
@@ -58,26 +75,26 @@ class FftWithPrecompute : public FftWithPrecomputeBase {
   // Returns the number of FFT layers whose TwiddleFactors were precomputed.
   size_t PrecomputeDepth() const;
 
-  const std::vector<FieldElementT>& GetTwiddleFactors() const { return twiddle_factors_; }
+  const std::vector<FieldElementT>& GetTwiddleFactors() const {
+    return shifted_twiddle_factors_.empty() ? *base_twiddle_factors_ : shifted_twiddle_factors_;
+  }
 
   // Shifts the twiddle factors by c, to accommodate for evaluation.
-  void ShiftTwiddleFactors(const FieldElement& offset, const FieldElement& prev_offset) override {
-    if (twiddle_factors_.empty()) {
-      return;
-    }
-    fft::details::ParallelFromOtherTwiddle<FieldElementT, BasesT>(
-        BasesT::GroupT::GroupOperation(
-            offset.As<FieldElementT>(),
-            BasesT::GroupT::GroupOperationInverse(prev_offset.As<FieldElementT>())),
-        bases_, twiddle_factors_);
-  }
+  void ShiftTwiddleFactors(const FieldElement& offset, const FieldElement& prev_offset) override;
 
  private:
   void FftNaturalOrder(gsl::span<const FieldElementT> src, gsl::span<FieldElementT> dst) const;
   void FftReversedOrder(gsl::span<const FieldElementT> src, gsl::span<FieldElementT> dst) const;
 
   const BasesT bases_;
-  std::vector<FieldElementT> twiddle_factors_;
+  // The number of precomputed layers, at most bases_.NumLayers().
+  const size_t precompute_depth_;
+  // The offset of the coset that GetTwiddleFactors() currently correspond to.
+  FieldElementT start_offset_;
+  // The twiddle factors of the domain of bases_, shared through TwiddleFactorsCache.
+  std::shared_ptr<const std::vector<FieldElementT>> base_twiddle_factors_;
+  // The twiddle factors of the coset of start_offset_. Empty if it is the domain of bases_.
+  std::vector<FieldElementT> shifted_twiddle_factors_;
 };
 
 }  // namespace starkware
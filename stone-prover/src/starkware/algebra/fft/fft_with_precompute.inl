@@ -12,11 +12,70 @@
 // See the License for the specific language governing permissions
 // and limitations under the License.
 
+#include <algorithm>
+#include <string>
+#include <typeinfo>
+
 #include "starkware/algebra/fft/details.h"
 #include "starkware/algebra/fft/fft_with_precompute.h"
 
 namespace starkware {
 
+template <typename BasesT>
+std::string TwiddleFactorsCacheKey(
+    const BasesT& bases, const typename BasesT::FieldElementT& start_offset,
+    const size_t precompute_depth) {
+  using FieldElementT = typename BasesT::FieldElementT;
+  // The layout of natural order twiddle factors depends on whether the four step FFT is used.
+  const bool four_step = BasesT::kOrder == MultiplicativeGroupOrdering::kNaturalOrder &&
+                         bases.NumLayers() >= FLAGS_four_step_fft_threshold;
+  std::string key = std::string(typeid(BasesT).name()) + (four_step ? ":4:" : ":1:") +
+                    std::to_string(precompute_depth) + ":";
+  // The basis of the first layer determines the rest of the layers.
+  std::vector<FieldElementT> elements = bases[0].Basis();
+  elements.push_back(start_offset);
+  const size_t element_size = FieldElementT::SizeInBytes();
+  std::vector<std::byte> bytes(elements.size() * element_size);
+  for (size_t i = 0; i < elements.size(); ++i) {
+    elements[i].ToBytes(gsl::make_span(bytes).subspan(i * element_size, element_size));
+  }
+  key.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  return key;
+}
+
+template <typename BasesT>
+FftWithPrecompute<BasesT>::FftWithPrecompute(BasesT bases, size_t precompute_depth)
+    : bases_(std::move(bases)),
+      precompute_depth_(std::min(precompute_depth, bases_.NumLayers())),
+      start_offset_(bases_[0].StartOffset()) {
+  base_twiddle_factors_ = TwiddleFactorsCache::GetInstance().GetOrCompute<FieldElementT>(
+      TwiddleFactorsCacheKey(bases_, start_offset_, precompute_depth_), [&]() {
+        return fft::details::FftPrecomputeTwiddleFactors<BasesT>(bases_, precompute_depth_);
+      });
+}
+
+template <typename BasesT>
+void FftWithPrecompute<BasesT>::ShiftTwiddleFactors(
+    const FieldElement& offset, const FieldElement& prev_offset) {
+  if (base_twiddle_factors_->empty()) {
+    return;
+  }
+  using GroupT = typename BasesT::GroupT;
+  const FieldElementT shift = GroupT::GroupOperation(
+      offset.As<FieldElementT>(), GroupT::GroupOperationInverse(prev_offset.As<FieldElementT>()));
+  start_offset_ = GroupT::GroupOperation(start_offset_, shift);
+  if (start_offset_ == bases_[0].StartOffset()) {
+    // Back to the domain of bases_. The buffer is kept for the next shift.
+    shifted_twiddle_factors_.clear();
+    return;
+  }
+  if (shifted_twiddle_factors_.empty()) {
+    shifted_twiddle_factors_.assign(base_twiddle_factors_->begin(), base_twiddle_factors_->end());
+  }
+  fft::details::ParallelFromOtherTwiddle<FieldElementT, BasesT>(
+      shift, bases_, shifted_twiddle_factors_);
+}
+
 template <typename BasesT>
 void FftWithPrecompute<BasesT>::Fft(
     const gsl::span<const FieldElementT> src, const gsl::span<FieldElementT> dst) const {
@@ -44,7 +103,7 @@ void FftWithPrecompute<BasesT>::FftNaturalOrder(
   if (last_precomputed_layer_size > 1) {
     for (size_t i = 0; i < src.size(); i += last_precomputed_layer_size) {
       fft::details::FftUsingPrecomputedTwiddleFactors<FieldElementT>(
-          curr_src.subspan(i, last_precomputed_layer_size), twiddle_factors_,
+          curr_src.subspan(i, last_precomputed_layer_size), GetTwiddleFactors(),
           /*normalize=*/full_precompute, dst.subspan(i, last_precomputed_layer_size));
     }
     curr_src = dst;
@@ -61,15 +120,15 @@ template <typename BasesT>
 void FftWithPrecompute<BasesT>::FftReversedOrder(
     const gsl::span<const FieldElementT> src, const gsl::span<FieldElementT> dst) const {
   ASSERT_RELEASE(
-      twiddle_factors_.size() + 1 == src.size() || src.size() == 1,
+      GetTwiddleFactors().size() + 1 == src.size() || src.size() == 1,
       "only full precompute is currently supported");
-  fft::details::FftNaturalToReverseWithPrecompute<FieldElementT>(src, twiddle_factors_, dst);
+  fft::details::FftNaturalToReverseWithPrecompute<FieldElementT>(src, GetTwiddleFactors(), dst);
 }
 
 template <typename BasesT>
 size_t FftWithPrecompute<BasesT>::PrecomputeDepth() const {
   // The number of TwiddleFactors is 1+2+4+...+2^(Precompute_depth -1) = 2^Precompute_depth - 1.
-  return SafeLog2(twiddle_factors_.size() + 1);
+  return SafeLog2(GetTwiddleFactors().size() + 1);
 }
 
 }  // namespace starkware
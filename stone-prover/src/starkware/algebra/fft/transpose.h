@@ -21,63 +21,220 @@
 
 #include "third_party/gsl/gsl-lite.hpp"
 
+#include "starkware/error_handling/error_handling.h"
+#include "starkware/math/math.h"
 #include "starkware/stl_utils/containers.h"
+#include "starkware/utils/attributes.h"
 #include "starkware/utils/task_manager.h"
 
 namespace starkware {
 
+namespace transpose {
+namespace details {
+
 /*
-  Performs transpose on a block of a n^2 size matrix of FieldElements represented as an array of
-  length n^2. The block starts from (corner_i,corner_j) and ends at (corner_i+block_size,
-  corner_j+block_size).
+  Returns the log of the side of the tiles that are transposed through a buffer. A tile occupies at
+  most 4KB, so that the two tiles of a swap stay in the L1 cache.
 */
 template <typename FieldElementT>
-static inline void BlockTranspose(
-    const gsl::span<FieldElementT> a, size_t n, size_t block_size, size_t corner_i,
-    size_t corner_j) {
-  if (corner_i != corner_j) {
-    // Case 1: Off the diagonal.
-    for (size_t i = corner_i; i < corner_i + block_size; ++i) {
-      for (size_t j = corner_j; j < corner_j + block_size; j++) {
-        std::swap(UncheckedAt(a, j * n + i), UncheckedAt(a, i * n + j));
-      }
+constexpr size_t LogTileSize() {
+  constexpr size_t kLogTileBytes = 12;
+  return (kLogTileBytes - std::min<size_t>(Log2Ceil(sizeof(FieldElementT)), kLogTileBytes)) / 2;
+}
+
+/*
+  Copies the size x size block of a (a matrix with row length n) whose top left corner is
+  (corner_i, corner_j) into tile, row by row.
+*/
+template <typename FieldElementT>
+ALWAYS_INLINE void LoadTile(
+    gsl::span<const FieldElementT> a, size_t n, size_t size, size_t corner_i, size_t corner_j,
+    FieldElementT* tile) {
+  for (size_t i = 0; i < size; ++i) {
+    const FieldElementT* row = &UncheckedAt(a, (corner_i + i) * n + corner_j);
+    // NOLINTNEXTLINE: do not use pointer arithmetic.
+    std::copy(row, row + size, tile + i * size);
+  }
+}
+
+/*
+  Writes the transpose of tile (a size x size block that was read by LoadTile()) to the block of a
+  whose top left corner is (corner_i, corner_j). Writes contiguous rows of a.
+*/
+template <typename FieldElementT>
+ALWAYS_INLINE void StoreTransposedTile(
+    const FieldElementT* tile, size_t n, size_t size, size_t corner_i, size_t corner_j,
+    gsl::span<FieldElementT> a) {
+  for (size_t i = 0; i < size; ++i) {
+    FieldElementT* row = &UncheckedAt(a, (corner_i + i) * n + corner_j);
+    for (size_t j = 0; j < size; ++j) {
+      // NOLINTNEXTLINE: do not use pointer arithmetic.
+      row[j] = tile[j * size + i];
     }
-  } else {
-    // Case 2: On the diagonal.
-    for (size_t i = corner_i; i < corner_i + block_size; ++i) {
-      for (size_t j = corner_j; j < i; j++) {
+  }
+}
+
+/*
+  Transposes the size x size block of a whose top left corner is (corner, corner) in place.
+  Recursively splits the block into quadrants, so that the working set of the recursion fits in
+  the cache at some level regardless of the cache sizes.
+*/
+template <typename FieldElementT>
+void TransposeDiagonalBlock(
+    gsl::span<FieldElementT> a, size_t n, size_t size, size_t corner,
+    gsl::span<FieldElementT> tiles);
+
+/*
+  Swaps the size x size block of a whose top left corner is (corner_i, corner_j) with the transpose
+  of the block whose top left corner is (corner_j, corner_i). tiles is a buffer for two tiles.
+*/
+template <typename FieldElementT>
+void SwapTransposedBlocks(
+    gsl::span<FieldElementT> a, size_t n, size_t size, size_t corner_i, size_t corner_j,
+    gsl::span<FieldElementT> tiles) {
+  const size_t log_tile = LogTileSize<FieldElementT>();
+  if (size <= Pow2(log_tile)) {
+    FieldElementT* tile_ij = tiles.data();
+    // NOLINTNEXTLINE: do not use pointer arithmetic.
+    FieldElementT* tile_ji = tiles.data() + size * size;
+    LoadTile<FieldElementT>(a, n, size, corner_i, corner_j, tile_ij);
+    LoadTile<FieldElementT>(a, n, size, corner_j, corner_i, tile_ji);
+    StoreTransposedTile<FieldElementT>(tile_ji, n, size, corner_i, corner_j, a);
+    StoreTransposedTile<FieldElementT>(tile_ij, n, size, corner_j, corner_i, a);
+    return;
+  }
+
+  const size_t half = size / 2;
+  for (size_t di = 0; di < size; di += half) {
+    for (size_t dj = 0; dj < size; dj += half) {
+      SwapTransposedBlocks(a, n, half, corner_i + di, corner_j + dj, tiles);
+    }
+  }
+}
+
+template <typename FieldElementT>
+void TransposeDiagonalBlock(
+    gsl::span<FieldElementT> a, size_t n, size_t size, size_t corner,
+    gsl::span<FieldElementT> tiles) {
+  const size_t log_tile = LogTileSize<FieldElementT>();
+  if (size <= Pow2(log_tile)) {
+    for (size_t i = corner; i < corner + size; ++i) {
+      for (size_t j = corner; j < i; j++) {
         std::swap(UncheckedAt(a, j * n + i), UncheckedAt(a, i * n + j));
       }
     }
+    return;
   }
+
+  const size_t half = size / 2;
+  TransposeDiagonalBlock(a, n, half, corner, tiles);
+  TransposeDiagonalBlock(a, n, half, corner + half, tiles);
+  SwapTransposedBlocks(a, n, half, corner + half, corner, tiles);
 }
 
+/*
+  Writes the transpose of the size x size block of src whose top left corner is
+  (corner_i, corner_j) to dst. src has n_rows rows and n_cols columns, and dst is its transpose.
+*/
+template <typename FieldElementT>
+void TransposeBlockOutOfPlace(
+    gsl::span<const FieldElementT> src, size_t n_rows, size_t n_cols, size_t size,
+    size_t corner_i, size_t corner_j, gsl::span<FieldElementT> dst,
+    gsl::span<FieldElementT> tile) {
+  const size_t log_tile = LogTileSize<FieldElementT>();
+  if (size <= Pow2(log_tile)) {
+    LoadTile<FieldElementT>(src, n_cols, size, corner_i, corner_j, tile.data());
+    StoreTransposedTile<FieldElementT>(tile.data(), n_rows, size, corner_j, corner_i, dst);
+    return;
+  }
+
+  const size_t half = size / 2;
+  for (size_t di = 0; di < size; di += half) {
+    for (size_t dj = 0; dj < size; dj += half) {
+      TransposeBlockOutOfPlace(
+          src, n_rows, n_cols, half, corner_i + di, corner_j + dj, dst, tile);
+    }
+  }
+}
+
+}  // namespace details
+}  // namespace transpose
+
 /*
   Performs transpose on a n^2 size matrix of FieldElements represented as an array of length n^2.
+  n must be a power of 2.
 */
 template <typename FieldElementT>
-static inline void Transpose(const gsl::span<FieldElementT> a) {
-  BlockTranspose(a, a.size(), a.size(), 0, 0);
+static inline void Transpose(const gsl::span<FieldElementT> a, size_t n) {
+  const size_t tile_area = Pow2(2 * transpose::details::LogTileSize<FieldElementT>());
+  std::vector<FieldElementT> tiles(2 * tile_area, a[0]);
+  transpose::details::TransposeDiagonalBlock<FieldElementT>(a, n, n, 0, tiles);
 }
 
 /*
   Performs transpose on a n^2 size matrix of FieldElements represented as an array of length n^2.
-  Uses parallelization to transpose small blocks of the matrix (max size of block is 16x16).
+  n must be a power of 2.
+  The matrix is split into blocks of kBlockSize x kBlockSize, and each task either transposes a
+  block on the diagonal, or swaps a pair of blocks that are symmetric with respect to the diagonal.
+  Blocks are transposed recursively, and the smallest blocks (tiles) are swapped through a buffer,
+  so that both the reads and the writes access contiguous rows.
 */
 template <typename FieldElementT>
 static inline void ParallelTranspose(const gsl::span<FieldElementT> a, size_t n) {
-  size_t block_size = std::min<size_t>(n, 16);
-  std::vector<std::pair<size_t, size_t>> transpose_plan;
-  for (size_t i = 0; i < n; i += block_size) {
-    for (size_t j = 0; j <= i; j += block_size) {
-      transpose_plan.emplace_back(i, j);
-    }
-  }
-  auto f = [&transpose_plan, a, n, block_size](const TaskInfo& task_info) {
-    auto& [i, j] = transpose_plan[task_info.start_idx];
-    BlockTranspose(a, n, block_size, i, j);
-  };
-  TaskManager::GetInstance().ParallelFor(0U, transpose_plan.size(), f);
+  using transpose::details::SwapTransposedBlocks;
+  using transpose::details::TransposeDiagonalBlock;
+  constexpr size_t kBlockSize = 64;
+  const size_t block_size = std::min(n, kBlockSize);
+  const size_t n_blocks = n / block_size;
+  const size_t tile_area = Pow2(2 * transpose::details::LogTileSize<FieldElementT>());
+
+  TaskManager::GetInstance().ParallelFor(
+      n_blocks * n_blocks,
+      [a, n, n_blocks, block_size, tile_area](const TaskInfo& task_info) {
+        std::vector<FieldElementT> tiles(2 * tile_area, a[0]);
+        for (size_t idx = task_info.start_idx; idx < task_info.end_idx; ++idx) {
+          const size_t block_i = idx / n_blocks;
+          const size_t block_j = idx % n_blocks;
+          if (block_i == block_j) {
+            TransposeDiagonalBlock<FieldElementT>(a, n, block_size, block_i * block_size, tiles);
+          } else if (block_i > block_j) {
+            SwapTransposedBlocks<FieldElementT>(
+                a, n, block_size, block_i * block_size, block_j * block_size, tiles);
+          }
+        }
+      },
+      n_blocks);
+}
+
+/*
+  Out of place transpose of a matrix with n_rows rows and n_cols columns (both powers of 2),
+  represented as an array of length n_rows * n_cols. dst is the transposed matrix, with n_cols rows
+  and n_rows columns.
+  As in the in place transpose, each task handles a square block, which is transposed recursively.
+*/
+template <typename FieldElementT>
+static inline void ParallelTranspose(
+    const gsl::span<const FieldElementT> src, const gsl::span<FieldElementT> dst, size_t n_rows,
+    size_t n_cols) {
+  ASSERT_RELEASE(src.size() == n_rows * n_cols, "Wrong matrix size.");
+  ASSERT_RELEASE(dst.size() == src.size(), "src and dst must be of the same size.");
+  constexpr size_t kBlockSize = 64;
+  const size_t block_size = std::min({kBlockSize, n_rows, n_cols});
+  const size_t n_block_cols = n_cols / block_size;
+  const size_t n_blocks = (n_rows / block_size) * n_block_cols;
+  const size_t tile_area = Pow2(2 * transpose::details::LogTileSize<FieldElementT>());
+
+  TaskManager::GetInstance().ParallelFor(
+      n_blocks,
+      [src, dst, n_rows, n_cols, block_size, n_block_cols, tile_area](const TaskInfo& task_info) {
+        std::vector<FieldElementT> tile(tile_area, src[0]);
+        for (size_t idx = task_info.start_idx; idx < task_info.end_idx; ++idx) {
+          transpose::details::TransposeBlockOutOfPlace<FieldElementT>(
+              src, n_rows, n_cols, block_size, (idx / n_block_cols) * block_size,
+              (idx % n_block_cols) * block_size, dst, tile);
+        }
+      },
+      n_block_cols);
 }
 
 }  // namespace starkware
@@ -0,0 +1,77 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/algebra/fft/transpose.h"
+
+#include "gtest/gtest.h"
+
+#include "starkware/algebra/fields/long_field_element.h"
+#include "starkware/algebra/fields/prime_field_element.h"
+#include "starkware/randomness/prng.h"
+
+namespace starkware {
+namespace {
+
+template <typename FieldElementT>
+class TransposeTest : public ::testing::Test {
+ public:
+  Prng prng;
+};
+
+using TestedFieldTypes = ::testing::Types<LongFieldElement, PrimeFieldElement<252, 0>>;
+TYPED_TEST_CASE(TransposeTest, TestedFieldTypes);
+
+TYPED_TEST(TransposeTest, Square) {
+  using FieldElementT = TypeParam;
+  // The sizes cover matrices that are smaller than a block, and matrices of several blocks whose
+  // blocks consist of several tiles.
+  for (size_t log_n : {0, 1, 3, 5, 7, 8}) {
+    const size_t n = Pow2(log_n);
+    const auto src = this->prng.template RandomFieldElementVector<FieldElementT>(n * n);
+    std::vector<FieldElementT> a = src;
+    ParallelTranspose<FieldElementT>(a, n);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        ASSERT_EQ(a[j * n + i], src[i * n + j]) << "n = " << n;
+      }
+    }
+
+    std::vector<FieldElementT> b = src;
+    Transpose<FieldElementT>(b, n);
+    EXPECT_EQ(a, b);
+  }
+}
+
+TYPED_TEST(TransposeTest, OutOfPlace) {
+  using FieldElementT = TypeParam;
+  for (size_t log_rows : {0, 2, 6}) {
+    for (size_t log_cols : {0, 3, 6, 7}) {
+      const size_t n_rows = Pow2(log_rows);
+      const size_t n_cols = Pow2(log_cols);
+      const auto src =
+          this->prng.template RandomFieldElementVector<FieldElementT>(n_rows * n_cols);
+      auto dst = FieldElementT::UninitializedVector(src.size());
+      ParallelTranspose<FieldElementT>(src, dst, n_rows, n_cols);
+      for (size_t i = 0; i < n_rows; ++i) {
+        for (size_t j = 0; j < n_cols; ++j) {
+          ASSERT_EQ(dst[j * n_rows + i], src[i * n_cols + j])
+              << "n_rows = " << n_rows << ", n_cols = " << n_cols;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace starkware
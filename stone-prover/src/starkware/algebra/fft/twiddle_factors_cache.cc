@@ -0,0 +1,79 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/algebra/fft/twiddle_factors_cache.h"
+
+DEFINE_uint64(
+    twiddle_factors_cache_max_bytes, uint64_t(1) << 30,
+    "Memory budget of the process-wide twiddle factors cache. Set to 0 to disable the cache.");
+
+namespace starkware {
+
+TwiddleFactorsCache& TwiddleFactorsCache::GetInstance() {
+  static TwiddleFactorsCache instance(FLAGS_twiddle_factors_cache_max_bytes);
+  return instance;
+}
+
+std::shared_ptr<const void> TwiddleFactorsCache::Find(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->table;
+}
+
+std::shared_ptr<const void> TwiddleFactorsCache::Insert(
+    const std::string& key, std::shared_ptr<const void> table, size_t size_in_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = index_.find(key);
+  if (it != index_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->table;
+  }
+  if (size_in_bytes > max_bytes_) {
+    // Tables that do not fit in the budget are not cached.
+    return table;
+  }
+  while (size_in_bytes_ + size_in_bytes > max_bytes_) {
+    const Entry& victim = entries_.back();
+    size_in_bytes_ -= victim.size_in_bytes;
+    index_.erase(victim.key);
+    entries_.pop_back();
+  }
+  entries_.push_front({key, table, size_in_bytes});
+  index_.emplace(key, entries_.begin());
+  size_in_bytes_ += size_in_bytes;
+  return table;
+}
+
+size_t TwiddleFactorsCache::NumEntries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+size_t TwiddleFactorsCache::SizeInBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_in_bytes_;
+}
+
+void TwiddleFactorsCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  size_in_bytes_ = 0;
+}
+
+}  // namespace starkware
@@ -0,0 +1,100 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#ifndef STARKWARE_ALGEBRA_FFT_TWIDDLE_FACTORS_CACHE_H_
+#define STARKWARE_ALGEBRA_FFT_TWIDDLE_FACTORS_CACHE_H_
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+DECLARE_uint64(twiddle_factors_cache_max_bytes);
+
+namespace starkware {
+
+/*
+  A thread-safe cache of immutable twiddle factor tables, shared by all the FFTs of the process.
+
+  The same tables are needed many times during a proof: the first trace, the interaction trace and
+  the composition trace are all interpolated on the same domain, and evaluated on cosets of the same
+  domain. Each table is identified by a key that describes the FFT domain (see
+  TwiddleFactorsCacheKey() in fft_with_precompute.h). Only the tables of these domains are cached;
+  the tables of their cosets are derived from them by FftWithPrecompute::ShiftTwiddleFactors().
+
+  The total size of the cached tables is bounded by max_bytes. When a new table does not fit, the
+  least recently used tables are evicted. Evicted tables stay alive as long as they are used, since
+  they are returned as shared pointers.
+*/
+class TwiddleFactorsCache {
+ public:
+  explicit TwiddleFactorsCache(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+  /*
+    Returns the process-wide instance. Its memory budget is --twiddle_factors_cache_max_bytes.
+  */
+  static TwiddleFactorsCache& GetInstance();
+
+  /*
+    Returns the table stored under key. If there is no such table, computes it using compute() and
+    stores it. compute() is called without holding the lock of the cache, so it may use the
+    TaskManager and the cache itself.
+  */
+  template <typename FieldElementT>
+  std::shared_ptr<const std::vector<FieldElementT>> GetOrCompute(
+      const std::string& key, const std::function<std::vector<FieldElementT>()>& compute);
+
+  size_t NumEntries() const;
+  size_t SizeInBytes() const;
+  void Clear();
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const void> table;
+    size_t size_in_bytes;
+  };
+
+  /*
+    Returns the table stored under key and marks it as the most recently used one, or nullptr if
+    there is no such table.
+  */
+  std::shared_ptr<const void> Find(const std::string& key);
+
+  /*
+    Stores table under key, unless another thread already stored a table under the same key, in
+    which case the existing table is returned.
+  */
+  std::shared_ptr<const void> Insert(
+      const std::string& key, std::shared_ptr<const void> table, size_t size_in_bytes);
+
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  // Ordered from the most recently used entry to the least recently used one.
+  std::list<Entry> entries_;
+  std::map<std::string, std::list<Entry>::iterator> index_;
+  size_t size_in_bytes_ = 0;
+};
+
+}  // namespace starkware
+
+#include "starkware/algebra/fft/twiddle_factors_cache.inl"
+
+#endif  // STARKWARE_ALGEBRA_FFT_TWIDDLE_FACTORS_CACHE_H_
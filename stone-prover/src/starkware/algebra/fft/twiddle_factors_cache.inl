@@ -0,0 +1,31 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include <utility>
+
+namespace starkware {
+
+template <typename FieldElementT>
+std::shared_ptr<const std::vector<FieldElementT>> TwiddleFactorsCache::GetOrCompute(
+    const std::string& key, const std::function<std::vector<FieldElementT>()>& compute) {
+  std::shared_ptr<const void> table = Find(key);
+  if (table == nullptr) {
+    auto new_table = std::make_shared<const std::vector<FieldElementT>>(compute());
+    const size_t size_in_bytes = new_table->size() * sizeof(FieldElementT);
+    table = Insert(key, std::move(new_table), size_in_bytes);
+  }
+  return std::static_pointer_cast<const std::vector<FieldElementT>>(table);
+}
+
+}  // namespace starkware
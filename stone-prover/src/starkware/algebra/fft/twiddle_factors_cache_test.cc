@@ -0,0 +1,149 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/algebra/fft/twiddle_factors_cache.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/algebra/fft/fft_with_precompute.h"
+#include "starkware/algebra/fields/prime_field_element.h"
+#include "starkware/fft_utils/fft_bases.h"
+
+namespace starkware {
+namespace {
+
+using testing::ElementsAre;
+
+std::vector<uint64_t> Table(size_t size, uint64_t value) {
+  return std::vector<uint64_t>(size, value);
+}
+
+TEST(TwiddleFactorsCache, ComputesOnce) {
+  TwiddleFactorsCache cache(1024);
+  size_t n_computations = 0;
+  const auto compute = [&]() {
+    n_computations++;
+    return Table(4, 7);
+  };
+
+  const auto table_1 = cache.GetOrCompute<uint64_t>("a", compute);
+  const auto table_2 = cache.GetOrCompute<uint64_t>("a", compute);
+  EXPECT_EQ(n_computations, 1U);
+  EXPECT_EQ(table_1, table_2);
+  EXPECT_THAT(*table_1, ElementsAre(7, 7, 7, 7));
+  EXPECT_EQ(cache.NumEntries(), 1U);
+  EXPECT_EQ(cache.SizeInBytes(), 4 * sizeof(uint64_t));
+}
+
+TEST(TwiddleFactorsCache, EvictsLeastRecentlyUsed) {
+  // Room for two tables of 4 elements.
+  TwiddleFactorsCache cache(8 * sizeof(uint64_t));
+  cache.GetOrCompute<uint64_t>("a", [] { return Table(4, 0); });
+  cache.GetOrCompute<uint64_t>("b", [] { return Table(4, 1); });
+  // Use "a", so that "b" is the least recently used table.
+  cache.GetOrCompute<uint64_t>("a", [] { return Table(4, 2); });
+  const auto table_c = cache.GetOrCompute<uint64_t>("c", [] { return Table(4, 3); });
+  EXPECT_EQ(cache.NumEntries(), 2U);
+
+  EXPECT_THAT(
+      *cache.GetOrCompute<uint64_t>("a", [] { return Table(4, 4); }), ElementsAre(0, 0, 0, 0));
+  EXPECT_THAT(
+      *cache.GetOrCompute<uint64_t>("b", [] { return Table(4, 5); }), ElementsAre(5, 5, 5, 5));
+  // The evicted table is still valid.
+  EXPECT_THAT(*table_c, ElementsAre(3, 3, 3, 3));
+}
+
+TEST(TwiddleFactorsCache, LargeTablesAreNotCached) {
+  TwiddleFactorsCache cache(2 * sizeof(uint64_t));
+  const auto table = cache.GetOrCompute<uint64_t>("a", [] { return Table(4, 1); });
+  EXPECT_THAT(*table, ElementsAre(1, 1, 1, 1));
+  EXPECT_EQ(cache.NumEntries(), 0U);
+  EXPECT_EQ(cache.SizeInBytes(), 0U);
+}
+
+TEST(TwiddleFactorsCache, FftWithPrecomputeSharesTwiddleFactors) {
+  using FieldElementT = PrimeFieldElement<252, 0>;
+  using BasesT = MultiplicativeFftBases<FieldElementT, MultiplicativeGroupOrdering::kNaturalOrder>;
+  Prng prng;
+  const FieldElementT offset_1 = FieldElementT::RandomElement(&prng);
+  const FieldElementT offset_2 = FieldElementT::RandomElement(&prng);
+  const BasesT bases(6, offset_1);
+
+  const FftWithPrecompute<BasesT> fft_1(bases);
+  FftWithPrecompute<BasesT> fft_2(bases);
+  EXPECT_EQ(&fft_1.GetTwiddleFactors(), &fft_2.GetTwiddleFactors());
+
+  // Shifting to a coset gives the same table as constructing an instance on that coset, but the
+  // shifted table is not cached.
+  const size_t n_entries = TwiddleFactorsCache::GetInstance().NumEntries();
+  fft_2.ShiftTwiddleFactors(FieldElement(offset_2), FieldElement(offset_1));
+  EXPECT_EQ(TwiddleFactorsCache::GetInstance().NumEntries(), n_entries);
+  EXPECT_NE(&fft_1.GetTwiddleFactors(), &fft_2.GetTwiddleFactors());
+  const FftWithPrecompute<BasesT> fft_3(bases.GetShiftedBases(offset_2));
+  EXPECT_EQ(fft_2.GetTwiddleFactors(), fft_3.GetTwiddleFactors());
+
+  // Shifting back to the domain of the instance returns to the shared table.
+  fft_2.ShiftTwiddleFactors(FieldElement(offset_1), FieldElement(offset_2));
+  EXPECT_EQ(&fft_1.GetTwiddleFactors(), &fft_2.GetTwiddleFactors());
+}
+
+TEST(TwiddleFactorsCache, PrecomputeDepthIsPartOfTheKey) {
+  using FieldElementT = PrimeFieldElement<252, 0>;
+  using BasesT =
+      MultiplicativeFftBases<FieldElementT, MultiplicativeGroupOrdering::kBitReversedOrder>;
+  Prng prng;
+  const size_t log_n = 6;
+  const BasesT bases(log_n, FieldElementT::RandomElement(&prng));
+  const FieldElementT& offset = bases[0].StartOffset();
+  EXPECT_NE(TwiddleFactorsCacheKey(bases, offset, 3), TwiddleFactorsCacheKey(bases, offset, log_n));
+
+  // Fetch a partial table (as MultiplicativeFft does with kPrecomputeDepth) and then a full table.
+  const FftWithPrecompute<BasesT> partial_fft(bases, 3);
+  const FftWithPrecompute<BasesT> full_fft(bases);
+  EXPECT_EQ(full_fft.PrecomputeDepth(), log_n);
+
+  // A depth larger than the number of layers is a full precompute, and shares the full table.
+  const FftWithPrecompute<BasesT> deep_fft(bases, 22);
+  EXPECT_EQ(&deep_fft.GetTwiddleFactors(), &full_fft.GetTwiddleFactors());
+
+  // A bit reversed order FFT requires a full table.
+  const std::vector<FieldElementT> src = prng.RandomFieldElementVector<FieldElementT>(Pow2(log_n));
+  std::vector<FieldElementT> dst = FieldElementT::UninitializedVector(Pow2(log_n));
+  EXPECT_NO_THROW(full_fft.Fft(src, dst));
+}
+
+TEST(TwiddleFactorsCache, ShiftedTablesOfDifferentDepthsAreNotShared) {
+  using FieldElementT = PrimeFieldElement<252, 0>;
+  using BasesT = MultiplicativeFftBases<FieldElementT, MultiplicativeGroupOrdering::kNaturalOrder>;
+  Prng prng;
+  const FieldElementT offset_1 = FieldElementT::RandomElement(&prng);
+  const FieldElementT offset_2 = FieldElementT::RandomElement(&prng);
+  const BasesT bases(6, offset_1);
+
+  FftWithPrecompute<BasesT> partial_fft(bases, 3);
+  partial_fft.ShiftTwiddleFactors(FieldElement(offset_2), FieldElement(offset_1));
+  FftWithPrecompute<BasesT> full_fft(bases);
+  full_fft.ShiftTwiddleFactors(FieldElement(offset_2), FieldElement(offset_1));
+  EXPECT_EQ(full_fft.PrecomputeDepth(), 6U);
+  EXPECT_EQ(
+      partial_fft.GetTwiddleFactors(),
+      FftWithPrecompute<BasesT>(bases.GetShiftedBases(offset_2), 3).GetTwiddleFactors());
+  EXPECT_EQ(
+      full_fft.GetTwiddleFactors(),
+      FftWithPrecompute<BasesT>(bases.GetShiftedBases(offset_2)).GetTwiddleFactors());
+}
+
+}  // namespace
+}  // namespace starkware
@@ -41,11 +41,12 @@ class FieldElementBase {
   Derived operator/(const Derived& other) const;
   constexpr bool operator!=(const Derived& other) const;
 
-  static std::vector<Derived> UninitializedVector(size_t size) {
+  template <typename AllocatorT = std::allocator<Derived>>
+  static std::vector<Derived, AllocatorT> UninitializedVector(size_t size) {
 #ifdef NDEBUG
-    return std::vector<Derived>(size);  // for faster memory allocation.
+    return std::vector<Derived, AllocatorT>(size);  // for faster memory allocation.
 #else
-    return std::vector<Derived>(size, Derived::Uninitialized());
+    return std::vector<Derived, AllocatorT>(size, Derived::Uninitialized());
 #endif
   }
 
@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <functional>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include "glog/logging.h"
@@ -31,6 +32,29 @@ namespace starkware {
 using std::size_t;
 using std::uint64_t;
 
+namespace field_operations {
+namespace details {
+
+template <typename FieldElementT, typename = void>
+struct HasSquare : std::false_type {};
+
+template <typename FieldElementT>
+struct HasSquare<FieldElementT, std::void_t<decltype(std::declval<FieldElementT>().Square())>>
+    : std::true_type {};
+
+template <typename FieldElementT, typename = void>
+struct HasBatchInverse : std::false_type {};
+
+template <typename FieldElementT>
+struct HasBatchInverse<
+    FieldElementT,
+    std::void_t<decltype(FieldElementT::BatchInverse(
+        std::declval<gsl::span<const gsl::span<const FieldElementT>>>(),
+        std::declval<gsl::span<const gsl::span<FieldElementT>>>()))>> : std::true_type {};
+
+}  // namespace details
+}  // namespace field_operations
+
 // --- Basic field-agnostic operations ---
 
 /*
@@ -49,6 +73,19 @@ FieldElementT Times(uint8_t multiplier, const FieldElementT& multiplicand) {
   return product;
 }
 
+/*
+  Returns value * value. Fields with a faster squaring (e.g. ExtensionFieldElement) implement
+  Square(), which is used instead.
+*/
+template <typename FieldElementT>
+FieldElementT Square(const FieldElementT& value) {
+  if constexpr (field_operations::details::HasSquare<FieldElementT>::value) {
+    return value.Square();
+  } else {  // NOLINT: Suppress readability-else-after-return after if constexpr.
+    return value * value;
+  }
+}
+
 /*
   Returns the power of a field element.
   Note that this function doesn't support negative exponents.
@@ -62,7 +99,7 @@ FieldElementT Pow(const FieldElementT& base, uint64_t exp) {
       res *= power;
     }
 
-    power *= power;
+    power = Square(power);
     exp >>= 1;
   }
 
@@ -77,7 +114,10 @@ template <typename FieldElementT>
 FieldElementT Pow(const FieldElementT& base, const std::vector<bool>& exponent_bits) {
   return GenericPow(
       base, exponent_bits, FieldElementT::One(),
-      [](const FieldElementT& multiplier, FieldElementT* dst) { *dst *= multiplier; });
+      [](const FieldElementT& multiplier, FieldElementT* dst) {
+        // GenericPow() squares by passing the same element as both arguments.
+        *dst = (&multiplier == dst ? Square(multiplier) : *dst * multiplier);
+      });
 }
 
 /*
@@ -132,7 +172,7 @@ std::vector<FieldElementT> GetSquares(const FieldElementT& g, size_t len) {
   elements.reserve(len);
   for (size_t i = 0; i < len; ++i) {
     elements.push_back(generator);
-    generator *= generator;
+    generator = Square(generator);
   }
   return elements;
 }
@@ -170,7 +210,7 @@ void BatchPow(
       }
     }
 
-    power *= power;
+    power = Square(power);
   }
 }
 
@@ -203,6 +243,9 @@ std::vector<FieldElementT> BatchPow(
   Use these two equations to iteratively compute the inverse of elements, starting of index n, and
   ending in index 1. Simply put, knowing the inverse of b_j allows computing both the inverse of a_j
   and the inverse of b_{j-1} using only two multiplication operations.
+
+  Fields that can invert a batch faster (e.g. ExtensionFieldElement) implement a static
+  BatchInverse() with the same signature, which is used instead.
 */
 template <typename FieldElementT>
 void BatchInverse(
@@ -222,6 +265,11 @@ void BatchInverse(
     }
   }
 
+  if constexpr (field_operations::details::HasBatchInverse<FieldElementT>::value) {
+    FieldElementT::BatchInverse(input, output);
+    return;
+  }
+
   // Compute the sequence of partial products.
   FieldElementT elements_product = FieldElementT::One();
   const size_t n_cols = input.size();
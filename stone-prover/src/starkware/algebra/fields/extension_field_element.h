@@ -63,10 +63,26 @@ class ExtensionFieldElement : public FieldElementBase<ExtensionFieldElement<Fiel
 
   ExtensionFieldElement operator*(const ExtensionFieldElement& rhs) const;
 
+  /*
+    Same as (*this) * (*this), with fewer base field products. When the base field supports lazy
+    reduction (see PrimeFieldElement::UnreducedMul()), coef0 of the result is reduced once.
+  */
+  ExtensionFieldElement Square() const;
+
   bool operator==(const ExtensionFieldElement& rhs) const;
 
   ExtensionFieldElement Inverse() const;
 
+  /*
+    Computes the inverses of all the elements in input with a single base field inversion. The
+    inverse of an element is its conjugate divided by its norm, which is in the base field, so only
+    the norms are batch-inverted, using BatchInverse() of the base field.
+    Called by BatchInverse() in field_operations.h, which checks the sizes.
+  */
+  static void BatchInverse(
+      gsl::span<const gsl::span<const ExtensionFieldElement>> input,
+      gsl::span<const gsl::span<ExtensionFieldElement>> output);
+
   static constexpr ExtensionFieldElement Zero() {
     return ExtensionFieldElement(FieldElementT::Zero(), FieldElementT::Zero());
   }
@@ -131,6 +147,11 @@ class ExtensionFieldElement : public FieldElementBase<ExtensionFieldElement<Fiel
   }
 
  private:
+  /*
+    Returns coef0_^2 - g * coef1_^2, which is the product of this element and its conjugate.
+  */
+  FieldElementT Norm() const;
+
   /*
     The extension field element is coef0_+coef_1*sqrt(g) for g = FieldElementT::Generator() and
     coef0_, coef1_ are of type FieldElementT.
@@ -17,6 +17,46 @@
 
 namespace starkware {
 
+namespace extension_field_element {
+namespace details {
+
+/*
+  Describes the lazy reduction support of the base field. When kEnabled is true, Square() and the
+  norm computation of ExtensionFieldElement reduce the sum a0^2 + g*a1^2 once, instead of
+  reducing each of its products.
+*/
+template <typename FieldElementT>
+struct LazyReduction {
+  static constexpr bool kEnabled = false;
+};
+
+template <int NBits, int Index>
+struct LazyReduction<PrimeFieldElement<NBits, Index>> {
+  using FieldElementT = PrimeFieldElement<NBits, Index>;
+  using UnreducedT = typename FieldElementT::UnreducedMulType;
+
+  // The integer value of FieldElementT::Generator(), which is g in F[x]/(x^2-g).
+  static constexpr uint64_t kNonResidue = BigPrimeConstants<NBits, Index>::kGenerator;
+
+  // A multiple of the modulus, larger than every product.
+  static constexpr UnreducedT kModulusSquared =
+      FieldElementT::GetModulus() * FieldElementT::GetModulus();
+
+  // The sums reduced below are a0^2 + g*a1^2 and a0^2 + g*(modulus^2 - a1^2).
+  static constexpr bool kEnabled = FieldElementT::MaxUnreducedSum() >= kNonResidue + 1;
+
+  static UnreducedT MulByNonResidue(const UnreducedT& x) {
+    UnreducedT res = x;
+    for (uint64_t i = 1; i < kNonResidue; ++i) {
+      res += x;
+    }
+    return res;
+  }
+};
+
+}  // namespace details
+}  // namespace extension_field_element
+
 template <typename FieldElementT>
 ExtensionFieldElement<FieldElementT> ExtensionFieldElement<FieldElementT>::operator+(
     const ExtensionFieldElement<FieldElementT>& rhs) const {
@@ -45,6 +85,37 @@ ALWAYS_INLINE ExtensionFieldElement<FieldElementT> ExtensionFieldElement<FieldEl
           coef0_ * rhs.coef1_ + coef1_ * rhs.coef0_};
 }
 
+template <typename FieldElementT>
+ExtensionFieldElement<FieldElementT> ExtensionFieldElement<FieldElementT>::Square() const {
+  // (a0 + a1*x)^2 = (a0^2 + g*a1^2) + 2*a0*a1*x.
+  using LazyReduction = extension_field_element::details::LazyReduction<FieldElementT>;
+  if constexpr (LazyReduction::kEnabled) {
+    return {
+        FieldElementT::FromUnreducedMul(
+            FieldElementT::UnreducedMul(coef0_, coef0_) +
+            LazyReduction::MulByNonResidue(FieldElementT::UnreducedMul(coef1_, coef1_))),
+        (coef0_ + coef0_) * coef1_};
+  } else {  // NOLINT: Suppress readability-else-after-return after if constexpr.
+    return {
+        coef0_ * coef0_ + coef1_ * coef1_ * FieldElementT::Generator(),
+        (coef0_ + coef0_) * coef1_};
+  }
+}
+
+template <typename FieldElementT>
+FieldElementT ExtensionFieldElement<FieldElementT>::Norm() const {
+  using LazyReduction = extension_field_element::details::LazyReduction<FieldElementT>;
+  if constexpr (LazyReduction::kEnabled) {
+    // Subtracting a1^2 from modulus^2 keeps the sum non-negative.
+    return FieldElementT::FromUnreducedMul(
+        FieldElementT::UnreducedMul(coef0_, coef0_) +
+        LazyReduction::MulByNonResidue(
+            LazyReduction::kModulusSquared - FieldElementT::UnreducedMul(coef1_, coef1_)));
+  } else {  // NOLINT: Suppress readability-else-after-return after if constexpr.
+    return coef0_ * coef0_ - coef1_ * coef1_ * FieldElementT::Generator();
+  }
+}
+
 template <typename FieldElementT>
 bool ExtensionFieldElement<FieldElementT>::operator==(
     const ExtensionFieldElement<FieldElementT>& rhs) const {
@@ -56,11 +127,40 @@ ExtensionFieldElement<FieldElementT> ExtensionFieldElement<FieldElementT>::Inver
   ASSERT_RELEASE(
       coef0_ != FieldElementT::Zero() || coef1_ != FieldElementT::Zero(),
       "Zero does not have an inverse");
-  const auto denom = coef0_ * coef0_ - coef1_ * coef1_ * FieldElementT::Generator();
-  const auto denom_inv = denom.Inverse();
+  const auto denom_inv = Norm().Inverse();
   return {coef0_ * denom_inv, -coef1_ * denom_inv};
 }
 
+template <typename FieldElementT>
+void ExtensionFieldElement<FieldElementT>::BatchInverse(
+    gsl::span<const gsl::span<const ExtensionFieldElement>> input,
+    gsl::span<const gsl::span<ExtensionFieldElement>> output) {
+  const size_t n_cols = input.size();
+  std::vector<std::vector<FieldElementT>> norms(n_cols);
+  std::vector<std::vector<FieldElementT>> norm_inverses(n_cols);
+  for (size_t col = 0; col < n_cols; ++col) {
+    norms[col].reserve(input[col].size());
+    for (const auto& element : input[col]) {
+      norms[col].push_back(element.Norm());
+    }
+    norm_inverses[col] = FieldElementT::UninitializedVector(input[col].size());
+  }
+
+  std::vector<gsl::span<const FieldElementT>> norms_spans(norms.begin(), norms.end());
+  std::vector<gsl::span<FieldElementT>> norm_inverses_spans(
+      norm_inverses.begin(), norm_inverses.end());
+  ::starkware::BatchInverse<FieldElementT>(
+      gsl::make_span(norms_spans), gsl::make_span(norm_inverses_spans));
+
+  for (size_t col = 0; col < n_cols; ++col) {
+    for (size_t row = 0; row < input[col].size(); ++row) {
+      const ExtensionFieldElement& element = input[col][row];
+      const FieldElementT& norm_inverse = norm_inverses[col][row];
+      output[col][row] = {element.coef0_ * norm_inverse, -element.coef1_ * norm_inverse};
+    }
+  }
+}
+
 template <typename FieldElementT>
 void ExtensionFieldElement<FieldElementT>::ToBytes(
     gsl::span<std::byte> span_out, bool use_big_endian) const {
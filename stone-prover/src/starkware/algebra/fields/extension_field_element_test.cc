@@ -14,17 +14,22 @@
 
 #include "starkware/algebra/fields/extension_field_element.h"
 
+#include <array>
 #include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include "starkware/algebra/fields/long_field_element.h"
+#include "starkware/algebra/fields/prime_field_element.h"
 #include "starkware/algebra/fields/test_field_element.h"
 #include "starkware/error_handling/test_utils.h"
 
 namespace starkware {
 namespace {
 
+using testing::HasSubstr;
+
 using ExtensionFieldElementT = ExtensionFieldElement<TestFieldElement>;
 
 ExtensionFieldElementT ElementFromInts(uint64_t coef0, uint64_t coef1) {
@@ -112,5 +117,96 @@ TEST(ExtensionFieldElement, Division) {
   EXPECT_EQ(a, a_div_b * b);
 }
 
+template <typename T>
+class ExtensionFieldTest : public ::testing::Test {
+ public:
+  using FieldElementT = T;
+  using ExtensionT = ExtensionFieldElement<T>;
+  Prng prng;
+
+  /*
+    Returns random elements, together with elements whose coefficients are 0, 1 and -1, which give
+    the largest unreduced products.
+  */
+  std::vector<ExtensionT> TestElements() {
+    const std::vector<FieldElementT> coefs = {
+        FieldElementT::Zero(), FieldElementT::One(), -FieldElementT::One()};
+    std::vector<ExtensionT> res;
+    for (const auto& coef0 : coefs) {
+      for (const auto& coef1 : coefs) {
+        res.emplace_back(coef0, coef1);
+      }
+    }
+    for (size_t i = 0; i < 20; ++i) {
+      res.push_back(ExtensionT::RandomElement(&prng));
+    }
+    return res;
+  }
+
+  /*
+    Multiplies a and b directly by the definition of the extension field.
+  */
+  static ExtensionT SchoolbookMul(const ExtensionT& a, const ExtensionT& b) {
+    return ExtensionT(
+        a.GetCoef0() * b.GetCoef0() + a.GetCoef1() * b.GetCoef1() * FieldElementT::Generator(),
+        a.GetCoef0() * b.GetCoef1() + a.GetCoef1() * b.GetCoef0());
+  }
+};
+
+using TestedBaseFieldTypes =
+    ::testing::Types<TestFieldElement, LongFieldElement, PrimeFieldElement<252, 0>>;
+TYPED_TEST_CASE(ExtensionFieldTest, TestedBaseFieldTypes);
+
+TYPED_TEST(ExtensionFieldTest, Square) {
+  for (const auto& a : this->TestElements()) {
+    EXPECT_EQ(a.Square(), this->SchoolbookMul(a, a));
+    // Pow() squares with Square().
+    EXPECT_EQ(Pow(a, 3), this->SchoolbookMul(this->SchoolbookMul(a, a), a));
+    EXPECT_EQ(Pow(a, std::vector<bool>{true, true}), Pow(a, 3));
+  }
+}
+
+TYPED_TEST(ExtensionFieldTest, Inverse) {
+  using ExtensionT = typename TestFixture::ExtensionT;
+  for (const auto& a : this->TestElements()) {
+    if (a == ExtensionT::Zero()) {
+      continue;
+    }
+    EXPECT_EQ(a * a.Inverse(), ExtensionT::One());
+  }
+}
+
+TYPED_TEST(ExtensionFieldTest, BatchInverse) {
+  using ExtensionT = typename TestFixture::ExtensionT;
+  std::vector<ExtensionT> input;
+  for (const auto& a : this->TestElements()) {
+    if (a != ExtensionT::Zero()) {
+      input.push_back(a);
+    }
+  }
+  // Goes through ExtensionFieldElement::BatchInverse().
+  std::vector<ExtensionT> output(input.size(), ExtensionT::Zero());
+  BatchInverse<ExtensionT>(input, output);
+  for (size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(output[i], input[i].Inverse());
+  }
+
+  // Several columns, one of them empty.
+  const size_t half = input.size() / 2;
+  std::vector<ExtensionT> inverses(input.size(), ExtensionT::Zero());
+  const std::array<const gsl::span<const ExtensionT>, 3> input_cols = {
+      gsl::make_span(input).subspan(0, half), gsl::span<const ExtensionT>(),
+      gsl::make_span(input).subspan(half)};
+  const std::array<const gsl::span<ExtensionT>, 3> output_cols = {
+      gsl::make_span(inverses).subspan(0, half), gsl::span<ExtensionT>(),
+      gsl::make_span(inverses).subspan(half)};
+  BatchInverse<ExtensionT>(gsl::make_span(input_cols), gsl::make_span(output_cols));
+  EXPECT_EQ(inverses, output);
+
+  input.push_back(ExtensionT::Zero());
+  output.push_back(ExtensionT::Zero());
+  EXPECT_ASSERT(BatchInverse<ExtensionT>(input, output), HasSubstr("contains zero"));
+}
+
 }  // namespace
 }  // namespace starkware
@@ -15,6 +15,7 @@
 #ifndef STARKWARE_ALGEBRA_FIELDS_PRIME_FIELD_ELEMENT_H_
 #define STARKWARE_ALGEBRA_FIELDS_PRIME_FIELD_ELEMENT_H_
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -112,11 +113,38 @@ class PrimeFieldElement : public FieldElementBase<PrimeFieldElement<NBits, Index
 
   constexpr PrimeFieldElement operator-() const { return Zero() - *this; }
 
+  /*
+    Lazy reduction: UnreducedMul() returns the double-width product of the Montgomery
+    representations of two elements, and FromUnreducedMul() reduces it to the product of the
+    elements. Since the reduction is linear, a sum of up to MaxUnreducedSum() such products may be
+    reduced at once, which saves a reduction for every added product.
+  */
+  using UnreducedMulType = BigInt<2 * ValueType::LimbCount()>;
+
+  /*
+    The modulus is smaller than 2^(64N) / MaxUnreducedSum(), hence MaxUnreducedSum() products sum up
+    to less than modulus * 2^(64N), which is the bound required by MontgomeryReduce().
+  */
+  static constexpr uint64_t MaxUnreducedSum() {
+    return uint64_t(1) << std::min<size_t>(GetModulus().NumLeadingZeros(), 63);
+  }
+
+  static UnreducedMulType UnreducedMul(const PrimeFieldElement& x, const PrimeFieldElement& y) {
+    return x.value_ * y.value_;
+  }
+
+  static PrimeFieldElement FromUnreducedMul(const UnreducedMulType& val) {
+    return PrimeFieldElement(ValueType::ReduceIfNeeded(
+        ValueType::MontgomeryReduce(val, GetModulus(), kBigPrimeConstants::kMontgomeryMPrime),
+        GetModulus()));
+  }
+
   bool operator==(const PrimeFieldElement& rhs) const { return value_ == rhs.value_; }
 
   PrimeFieldElement Inverse() const {
     ASSERT_RELEASE(*this != PrimeFieldElement::Zero(), "Zero does not have an inverse");
-    return InverseToMontgomery(ValueType::Inverse(value_, kBigPrimeConstants::kModulus));
+    return InverseToMontgomery(
+        ValueType::InverseOddModulus(value_, kBigPrimeConstants::kModulus));
   }
 
   // Returns a byte serialization of the field element.
@@ -94,6 +94,25 @@ TYPED_TEST(PrimeFieldElementTest, FromInt) {
   EXPECT_EQ(c, expected_res);
 }
 
+TYPED_TEST(PrimeFieldElementTest, UnreducedMul) {
+  Prng prng;
+  const auto a = TypeParam::RandomElement(&prng);
+  const auto b = TypeParam::RandomElement(&prng);
+  EXPECT_EQ(TypeParam::FromUnreducedMul(TypeParam::UnreducedMul(a, b)), a * b);
+
+  // The largest allowed sum: MaxUnreducedSum() products of the largest Montgomery representation.
+  const auto max_element =
+      TypeParam::FromMontgomeryForm(TypeParam::GetModulus() - TypeParam::ValueType::One());
+  const auto max_prod = TypeParam::UnreducedMul(max_element, max_element);
+  auto unreduced_sum = max_prod;
+  auto expected_sum = max_element * max_element;
+  for (uint64_t i = 1; i < TypeParam::MaxUnreducedSum(); ++i) {
+    unreduced_sum += max_prod;
+    expected_sum += max_element * max_element;
+  }
+  EXPECT_EQ(TypeParam::FromUnreducedMul(unreduced_sum), expected_sum);
+}
+
 TEST(PrimeField, ToStandardForm) {
   using ValueType = PrimeFieldElement<252, 0>::ValueType;
   Prng prng;
@@ -14,10 +14,78 @@
 
 #include "starkware/algebra/lde/cached_lde_manager.h"
 
-#include <map>
+#include <vector>
+
+#include "starkware/utils/task_manager.h"
 
 namespace starkware {
 
+namespace {
+
+/*
+  The queries of CachedLdeManager::EvalAtPoints(), grouped by coset. The queries on cosets[i] are
+  query_indices[offsets[i]], ..., query_indices[offsets[i + 1] - 1], and point_indices holds their
+  indices within the coset, in the same order.
+*/
+struct QueriesByCoset {
+  std::vector<uint64_t> cosets;
+  std::vector<size_t> offsets;
+  std::vector<uint64_t> query_indices;
+  std::vector<uint64_t> point_indices;
+  // True if query_indices[i] == i for every i, i.e. the queries were already grouped by coset.
+  bool in_input_order = true;
+
+  size_t NumGroups() const { return cosets.size(); }
+
+  gsl::span<const uint64_t> PointIndices(size_t group) const {
+    return gsl::make_span(point_indices).subspan(offsets[group], GroupSize(group));
+  }
+
+  size_t GroupSize(size_t group) const { return offsets[group + 1] - offsets[group]; }
+};
+
+/*
+  Groups the queries by coset index, keeping the input order within each coset. This is a counting
+  sort, so it does not allocate per query.
+*/
+QueriesByCoset GroupQueriesByCoset(
+    gsl::span<const std::pair<uint64_t, uint64_t>> coset_and_point_indices, size_t n_cosets) {
+  std::vector<size_t> coset_sizes(n_cosets, 0);
+  for (const auto& [coset_index, point_index] : coset_and_point_indices) {
+    (void)point_index;  // Unused.
+    ASSERT_RELEASE(coset_index < n_cosets, "Coset index out of bounds.");
+    coset_sizes[coset_index]++;
+  }
+
+  QueriesByCoset res;
+  // The position in query_indices of the next query on each coset.
+  std::vector<size_t> next_position(n_cosets);
+  size_t offset = 0;
+  for (size_t coset_index = 0; coset_index < n_cosets; ++coset_index) {
+    if (coset_sizes[coset_index] == 0) {
+      continue;
+    }
+    res.cosets.push_back(coset_index);
+    res.offsets.push_back(offset);
+    next_position[coset_index] = offset;
+    offset += coset_sizes[coset_index];
+  }
+  res.offsets.push_back(offset);
+
+  res.query_indices.resize(coset_and_point_indices.size());
+  res.point_indices.resize(coset_and_point_indices.size());
+  for (size_t i = 0; i < coset_and_point_indices.size(); ++i) {
+    const auto& [coset_index, point_index] = coset_and_point_indices[i];
+    const size_t position = next_position[coset_index]++;
+    res.query_indices[position] = i;
+    res.point_indices[position] = point_index;
+    res.in_input_order = res.in_input_order && position == i;
+  }
+  return res;
+}
+
+}  // namespace
+
 std::unique_ptr<CachedLdeManager::LdeCacheEntry> CachedLdeManager::AllocateStorage() const {
   if (config_.store_full_lde) {
     return nullptr;
@@ -58,6 +126,29 @@ const CachedLdeManager::LdeCacheEntry* CachedLdeManager::EvalOnCoset(
   return storage;
 }
 
+void CachedLdeManager::EvalOnAllCosets() {
+  ASSERT_RELEASE(done_adding_, "Must call FinalizeAdding() before calling EvalOnAllCosets()");
+  if (!config_.eval_all_cosets_at_once) {
+    return;
+  }
+  ASSERT_RELEASE(
+      lde_manager_.HasValue(), "Cannot evaluate new values after FinalizeEvaluations() was called");
+
+  // Evaluate only the cosets that are not cached yet.
+  FieldElementVector coset_offsets = FieldElementVector::Make(coset_offsets_->GetField());
+  std::vector<std::vector<FieldElementSpan>> evaluation_results;
+  for (size_t coset_index = 0; coset_index < coset_offsets_->Size(); ++coset_index) {
+    if (cache_[coset_index].has_value()) {
+      continue;
+    }
+    cache_[coset_index] = InitializeEntry();
+    coset_offsets.PushBack(coset_offsets_->At(coset_index));
+    evaluation_results.emplace_back(cache_[coset_index]->begin(), cache_[coset_index]->end());
+  }
+
+  lde_manager_->EvalOnCosets(coset_offsets, evaluation_results);
+}
+
 void CachedLdeManager::EvalAtPoints(
     gsl::span<const std::pair<uint64_t, uint64_t>> coset_and_point_indices,
     gsl::span<const FieldElementSpan> outputs) {
@@ -73,54 +164,103 @@ void CachedLdeManager::EvalAtPoints(
     ASSERT_RELEASE(point_index < domain_size_, "Point index out of range.");
   }
 
-  if (config_.store_full_lde) {
-    // Look up coset in cache.
-    for (size_t i = 0; i < coset_and_point_indices.size(); ++i) {
-      const auto& [coset_index, point_index] = coset_and_point_indices[i];
-      ASSERT_RELEASE(
-          cache_[coset_index].has_value(),
-          "EvalAtPoints with config_.store_full_lde requested a coset that is not cached!");
+  TaskManager& task_manager = TaskManager::GetInstance();
+  const size_t n_points = coset_and_point_indices.size();
+
+  if (config_.store_full_lde || config_.use_fft_for_eval) {
+    const QueriesByCoset queries =
+        GroupQueriesByCoset(coset_and_point_indices, coset_offsets_->Size());
+
+    // The values are gathered in the grouped order. If it differs from the input order, they are
+    // gathered into temporary columns, and scattered to outputs at the end.
+    std::vector<FieldElementVector> grouped_storage;
+    std::vector<FieldElementSpan> grouped_outputs(outputs.begin(), outputs.end());
+    if (!queries.in_input_order) {
+      grouped_outputs.clear();
+      grouped_storage.reserve(n_columns_);
       for (size_t column_index = 0; column_index < n_columns_; ++column_index) {
-        outputs[column_index].Set(i, (*cache_[coset_index])[column_index].At(point_index));
+        grouped_storage.push_back(
+            FieldElementVector::MakeUninitialized(outputs[column_index].GetField(), n_points));
+        grouped_outputs.emplace_back(grouped_storage.back());
       }
     }
-    return;
-  }
+    const auto gather = [&queries, &grouped_outputs](
+                            size_t group, size_t column_index,
+                            const LdeCacheEntry& coset_evaluation) {
+      grouped_outputs[column_index]
+          .SubSpan(queries.offsets[group], queries.GroupSize(group))
+          .GatherFrom(coset_evaluation[column_index], queries.PointIndices(group));
+    };
 
-  // If not found, consider computing the entire coset.
-  if (config_.use_fft_for_eval) {
-    std::map<uint64_t, std::vector<size_t>> coset_to_query_index;
-    for (size_t i = 0; i < coset_and_point_indices.size(); ++i) {
-      const auto& [coset_index, point_index] = coset_and_point_indices[i];
-      (void)point_index;  // Unused.
-      coset_to_query_index[coset_index].push_back(i);
-    }
-    LdeCacheEntry entry = InitializeEntry();
-    for (const auto& [coset_index, query_indices] : coset_to_query_index) {
-      auto coset_evaluation = EvalOnCoset(coset_index, &entry);
-      for (size_t query_index : query_indices) {
-        for (size_t column_index = 0; column_index < n_columns_; ++column_index) {
-          const uint64_t point_index = coset_and_point_indices[query_index].second;
-          outputs[column_index].Set(query_index, (*coset_evaluation)[column_index].At(point_index));
-        }
+    if (config_.store_full_lde) {
+      // Look up cosets in cache.
+      for (uint64_t coset_index : queries.cosets) {
+        ASSERT_RELEASE(
+            cache_[coset_index].has_value(),
+            "EvalAtPoints with config_.store_full_lde requested a coset that is not cached!");
+      }
+      const size_t n_tasks = queries.NumGroups() * n_columns_;
+      task_manager.ParallelFor(
+          n_tasks,
+          [this, &queries, &gather](const TaskInfo& task_info) {
+            for (size_t task = task_info.start_idx; task < task_info.end_idx; ++task) {
+              const size_t group = task / n_columns_;
+              gather(group, task % n_columns_, *cache_[queries.cosets[group]]);
+            }
+          },
+          n_tasks);
+    } else {
+      // Compute the entire cosets. Each coset is evaluated in parallel over the columns, so the
+      // cosets are evaluated one after the other, sharing the FFT precompute.
+      LdeCacheEntry entry = InitializeEntry();
+      for (size_t group = 0; group < queries.NumGroups(); ++group) {
+        const LdeCacheEntry* coset_evaluation = EvalOnCoset(queries.cosets[group], &entry);
+        task_manager.ParallelFor(
+            n_columns_,
+            [group, coset_evaluation, &gather](const TaskInfo& task_info) {
+              for (size_t column_index = task_info.start_idx; column_index < task_info.end_idx;
+                   ++column_index) {
+                gather(group, column_index, *coset_evaluation);
+              }
+            },
+            n_columns_);
       }
     }
+
+    if (!queries.in_input_order) {
+      task_manager.ParallelFor(
+          n_columns_,
+          [&outputs, &grouped_storage, &queries](const TaskInfo& task_info) {
+            for (size_t column_index = task_info.start_idx; column_index < task_info.end_idx;
+                 ++column_index) {
+              outputs[column_index].ScatterFrom(
+                  grouped_storage[column_index], queries.query_indices);
+            }
+          },
+          n_columns_);
+    }
     return;
   }
 
   // Evaluate pointwise.
   ASSERT_RELEASE(
       lde_manager_.HasValue(), "Cannot evaluate new values after FinalizeEvaluations() was called");
+  // The domain of each coset is created once, on its first query.
+  std::vector<std::unique_ptr<FftDomainBase>> coset_domains(coset_offsets_->Size());
   FieldElementVector points = FieldElementVector::Make(coset_offsets_->At(0).GetField());
-  points.Reserve(coset_and_point_indices.size());
+  points.Reserve(n_points);
   for (const auto& [coset_index, point_index] : coset_and_point_indices) {
-    auto domain = lde_manager_->GetDomain(coset_offsets_->At(coset_index));
+    auto& domain = coset_domains.at(coset_index);
+    if (domain == nullptr) {
+      domain = lde_manager_->GetDomain(coset_offsets_->At(coset_index));
+    }
     points.PushBack(domain->GetFieldElementAt(point_index));
   }
 
-  for (size_t column_index = 0; column_index < n_columns_; ++column_index) {
+  task_manager.ParallelFor(n_columns_, [this, &points, outputs](const TaskInfo& task_info) {
+    const size_t column_index = task_info.start_idx;
     EvalAtPointsNotCached(column_index, points, outputs[column_index]);
-  }
+  });
 }
 
 void CachedLdeManager::EvalAtPointsNotCached(
@@ -135,8 +275,8 @@ CachedLdeManager::LdeCacheEntry CachedLdeManager::InitializeEntry() const {
   const uint64_t coset_size = domain_size_;
   entry.reserve(n_columns_);
   for (size_t i = 0; i < n_columns_; ++i) {
-    entry.push_back(
-        FieldElementVector::MakeUninitialized(coset_offsets_->At(0).GetField(), coset_size));
+    entry.push_back(FieldElementVector::MakeUninitializedHugePage(
+        coset_offsets_->At(0).GetField(), coset_size));
   }
   return entry;
 }
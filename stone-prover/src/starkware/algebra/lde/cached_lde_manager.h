@@ -47,6 +47,13 @@ class CachedLdeManager {
       evaluation). This value has no effect when store_full_lde is true.
     */
     bool use_fft_for_eval;
+
+    /*
+      Setting this value to true makes EvalOnAllCosets() compute the LDE on all the cosets as a
+      single batch of FFTs, instead of one coset after the other. This parallelizes better when
+      there are few columns. Requires store_full_lde.
+    */
+    bool eval_all_cosets_at_once;
   };
 
   CachedLdeManager(
@@ -59,6 +66,9 @@ class CachedLdeManager {
         ifft_precompute_(lde_manager_->IfftPrecompute()),
         previous_coset_offset_(coset_offsets_->At(0)) {
     ASSERT_RELEASE(coset_offsets_->Size() > 0, "At least one coset offset required");
+    ASSERT_RELEASE(
+        !config_.eval_all_cosets_at_once || config_.store_full_lde,
+        "eval_all_cosets_at_once requires store_full_lde.");
     domain_size_ = lde_manager_->GetDomain(coset_offsets_->At(0))->Size();
   }
 
@@ -94,8 +104,15 @@ class CachedLdeManager {
   */
   const LdeCacheEntry* EvalOnCoset(uint64_t coset_index, LdeCacheEntry* storage);
 
+  /*
+    Computes all the cosets in advance if eval_all_cosets_at_once is true, so that succeeding
+    EvalOnCoset() calls return cached values. Otherwise, does nothing.
+  */
+  void EvalOnAllCosets();
+
   /*
     Evaluates all columns at point. Cached version, takes pairs of (coset_index, point_index).
+    The queries are grouped by coset, and the (coset, column) pairs are processed in parallel.
   */
   void EvalAtPoints(
       gsl::span<const std::pair<uint64_t, uint64_t>> coset_and_point_indices,
@@ -22,9 +22,11 @@
 #include "gtest/gtest.h"
 
 #include "starkware/algebra/fields/test_field_element.h"
+#include "starkware/algebra/lde/lde.h"
 #include "starkware/algebra/lde/lde_manager_mock.h"
 #include "starkware/algebra/polymorphic/test_utils.h"
 #include "starkware/error_handling/test_utils.h"
+#include "starkware/utils/huge_page_arena.h"
 
 namespace starkware {
 namespace {
@@ -113,7 +115,8 @@ class CachedLdeManagerTest : public ::testing::Test {
 
 void CachedLdeManagerTest::StartTest(bool store_full_lde, bool use_fft_for_eval) {
   CachedLdeManager::Config config{/*store_full_lde=*/store_full_lde,
-                                  /*use_fft_for_eval=*/use_fft_for_eval};
+                                  /*use_fft_for_eval=*/use_fft_for_eval,
+                                  /*eval_all_cosets_at_once=*/false};
   cached_lde_manager_.emplace(
       config,
       /*lde_manager=*/UseOwned(&lde_manager_),
@@ -148,7 +151,9 @@ void CachedLdeManagerTest::StartTest(bool store_full_lde, bool use_fft_for_eval)
     // Test that we got the correct evaluation.
     ASSERT_EQ(result->size(), n_columns_);
     for (size_t column_index = 0; column_index < n_columns_; ++column_index) {
-      ASSERT_EQ((*result)[column_index].As<TestFieldElement>(), coset_evaluation[column_index]);
+      ASSERT_EQ(
+          (*result)[column_index].AsSpan().As<TestFieldElement>(),
+          gsl::make_span(coset_evaluation[column_index]));
     }
   }
 
@@ -162,7 +167,8 @@ void CachedLdeManagerTest::StartTest(bool store_full_lde, bool use_fft_for_eval)
 */
 TEST_F(CachedLdeManagerTest, AddEvaluationVariations) {
   CachedLdeManager::Config config{/*store_full_lde=*/false,
-                                  /*use_fft_for_eval=*/false};
+                                  /*use_fft_for_eval=*/false,
+                                  /*eval_all_cosets_at_once=*/false};
   cached_lde_manager_.emplace(
       config,
       /*lde_manager=*/UseOwned(&lde_manager_),
@@ -194,7 +200,8 @@ TEST_F(CachedLdeManagerTest, EvalOnCoset_Cache) {
     ASSERT_EQ(result->size(), n_columns_);
     for (size_t column_index = 0; column_index < n_columns_; ++column_index) {
       ASSERT_EQ(
-          (*result)[column_index].As<TestFieldElement>(), evaluations_[coset_index][column_index]);
+          (*result)[column_index].AsSpan().As<TestFieldElement>(),
+          gsl::make_span(evaluations_[coset_index][column_index]));
     }
   }
 }
@@ -212,7 +219,8 @@ TEST_F(CachedLdeManagerTest, EvalOnCoset_NoCache) {
     ASSERT_EQ(result->size(), n_columns_);
     for (size_t column_index = 0; column_index < n_columns_; ++column_index) {
       ASSERT_EQ(
-          (*result)[column_index].As<TestFieldElement>(), evaluations_[coset_index][column_index]);
+          (*result)[column_index].AsSpan().As<TestFieldElement>(),
+          gsl::make_span(evaluations_[coset_index][column_index]));
     }
   }
 }
@@ -257,6 +265,37 @@ TEST_F(CachedLdeManagerTest, EvalAtPoints_Cache) {
   TestEvalAtPointsResult(coset_point_indices, outputs);
 }
 
+/*
+  Tests EvalAtPoints() when the queries are already grouped by coset, in which case the values are
+  written directly to the outputs.
+*/
+TEST_F(CachedLdeManagerTest, EvalAtPoints_CacheGroupedQueries) {
+  StartTest(/*store_full_lde=*/true, /*use_fft_for_eval=*/false);
+
+  std::vector<std::pair<size_t, uint64_t>> coset_point_indices;
+  for (size_t coset_index = 0; coset_index < n_cosets_; coset_index += 3) {
+    const size_t n_points_in_coset = prng_.UniformInt(1, 5);
+    for (size_t i = 0; i < n_points_in_coset; ++i) {
+      coset_point_indices.emplace_back(
+          coset_index, prng_.UniformInt(0, static_cast<int>(coset_size_ - 1)));
+    }
+  }
+
+  // Allocate outputs.
+  std::vector<FieldElementVector> outputs;
+  for (size_t column_index = 0; column_index < n_columns_; column_index++) {
+    outputs.push_back(FieldElementVector::MakeUninitialized(
+        Field::Create<TestFieldElement>(), coset_point_indices.size()));
+  }
+
+  // Evaluate points.
+  std::vector<FieldElementSpan> outputs_spans = {outputs.begin(), outputs.end()};
+  cached_lde_manager_->EvalAtPoints(coset_point_indices, outputs_spans);
+
+  // Compare result.
+  TestEvalAtPointsResult(coset_point_indices, outputs);
+}
+
 TEST_F(CachedLdeManagerTest, EvalAtPoints_NoCacheNoFft) {
   StartTest(/*store_full_lde=*/false, /*use_fft_for_eval=*/false);
 
@@ -357,7 +396,8 @@ TEST_F(CachedLdeManagerTest, AddAfterEvalOnCoset) {
 
 TEST_F(CachedLdeManagerTest, AddAfterEvalAtPoints) {
   CachedLdeManager::Config config{/*store_full_lde=*/false,
-                                  /*use_fft_for_eval=*/false};
+                                  /*use_fft_for_eval=*/false,
+                                  /*eval_all_cosets_at_once=*/false};
   cached_lde_manager_.emplace(
       config,
       /*lde_manager=*/UseOwned(&lde_manager_),
@@ -404,12 +444,189 @@ TEST_F(CachedLdeManagerTest, ComputeAfterFinalizeEvaluations) {
       HasSubstr("FinalizeEvaluations()"));
 }
 
+TEST_F(CachedLdeManagerTest, EvalOnAllCosets) {
+  CachedLdeManager::Config config{/*store_full_lde=*/true,
+                                  /*use_fft_for_eval=*/false,
+                                  /*eval_all_cosets_at_once=*/true};
+  cached_lde_manager_.emplace(
+      config,
+      /*lde_manager=*/UseOwned(&lde_manager_),
+      /*coset_offsets=*/UseMovedValue(FieldElementVector::CopyFrom(offsets_)));
+  EXPECT_CALL(lde_manager_, AddEvaluation_rvr(_, _)).Times(n_columns_);
+  for (size_t i = 0; i < n_columns_; ++i) {
+    cached_lde_manager_->AddEvaluation(
+        FieldElementVector::Make(prng_.RandomFieldElementVector<TestFieldElement>(coset_size_)));
+  }
+  cached_lde_manager_->FinalizeAdding();
+
+  // Evaluate the first coset separately. It should not be evaluated again.
+  std::vector<std::vector<TestFieldElement>> first_coset_evaluation;
+  for (size_t column_index = 0; column_index < n_columns_; ++column_index) {
+    first_coset_evaluation.push_back(
+        prng_.RandomFieldElementVector<TestFieldElement>(coset_size_));
+  }
+  EXPECT_CALL(lde_manager_, EvalOnCoset(FieldElement(offsets_[0]), _, _))
+      .WillOnce(SetEvaluation(first_coset_evaluation));
+  cached_lde_manager_->EvalOnCoset(0, nullptr);
+
+  // Indices are: coset_index, column_index, point_index.
+  std::vector<std::vector<std::vector<TestFieldElement>>> evaluations{first_coset_evaluation};
+  for (size_t coset_index = 1; coset_index < n_cosets_; ++coset_index) {
+    evaluations.emplace_back();
+    for (size_t column_index = 0; column_index < n_columns_; ++column_index) {
+      evaluations.back().push_back(prng_.RandomFieldElementVector<TestFieldElement>(coset_size_));
+    }
+  }
+  const std::vector<TestFieldElement> remaining_offsets(offsets_.begin() + 1, offsets_.end());
+  EXPECT_CALL(lde_manager_, EvalOnCosets(_, _))
+      .WillOnce(Invoke([&](const ConstFieldElementSpan& coset_offsets,
+                           gsl::span<const std::vector<FieldElementSpan>> results) {
+        ASSERT_EQ(coset_offsets.As<TestFieldElement>(), gsl::make_span(remaining_offsets));
+        ASSERT_EQ(results.size(), n_cosets_ - 1);
+        for (size_t i = 0; i < results.size(); ++i) {
+          ASSERT_EQ(results[i].size(), n_columns_);
+          for (size_t column_index = 0; column_index < n_columns_; ++column_index) {
+            std::copy(
+                evaluations[i + 1][column_index].begin(), evaluations[i + 1][column_index].end(),
+                results[i][column_index].As<TestFieldElement>().begin());
+          }
+        }
+      }));
+  cached_lde_manager_->EvalOnAllCosets();
+
+  // All the cosets are cached, and no further computation is needed.
+  for (size_t coset_index = 0; coset_index < n_cosets_; ++coset_index) {
+    auto result = cached_lde_manager_->EvalOnCoset(coset_index, nullptr);
+    ASSERT_EQ(result->size(), n_columns_);
+    for (size_t column_index = 0; column_index < n_columns_; ++column_index) {
+      EXPECT_EQ(
+          (*result)[column_index].AsSpan().As<TestFieldElement>(),
+          gsl::make_span(evaluations[coset_index][column_index]));
+    }
+  }
+}
+
+TEST_F(CachedLdeManagerTest, EvalAllCosetsAtOnceRequiresStoreFullLde) {
+  CachedLdeManager::Config config{/*store_full_lde=*/false,
+                                  /*use_fft_for_eval=*/false,
+                                  /*eval_all_cosets_at_once=*/true};
+  EXPECT_ASSERT(
+      cached_lde_manager_.emplace(
+          config,
+          /*lde_manager=*/UseOwned(&lde_manager_),
+          /*coset_offsets=*/UseMovedValue(FieldElementVector::CopyFrom(offsets_))),
+      HasSubstr("eval_all_cosets_at_once requires store_full_lde."));
+}
+
 TEST_F(CachedLdeManagerTest, SecondFinalizeAdding) {
   StartTest(/*store_full_lde=*/false, /*use_fft_for_eval=*/true);
   EXPECT_ASSERT(cached_lde_manager_->FinalizeAdding(), HasSubstr("FinalizeAdding called twice."));
 }
 
+/*
+  Tests the pointwise EvalAtPoints() path (no cache, no FFT) with a real LdeManager and many
+  columns. That path evaluates the columns concurrently on the TaskManager.
+*/
+TEST(CachedLdeManager, EvalAtPoints_NoCacheNoFftManyColumns) {
+  Prng prng;
+  const size_t log_coset_size = 5;
+  const size_t coset_size = Pow2(log_coset_size);
+  const size_t n_cosets = 4;
+  const size_t n_columns = 64;
+  const size_t n_points = 50;
+
+  MultiplicativeFftBases<TestFieldElement> bases(log_coset_size, TestFieldElement::One());
+  CachedLdeManager::Config config{/*store_full_lde=*/false,
+                                  /*use_fft_for_eval=*/false,
+                                  /*eval_all_cosets_at_once=*/false};
+  CachedLdeManager cached_lde_manager(
+      config, TakeOwnershipFrom(MakeLdeManager(bases)),
+      UseMovedValue(
+          FieldElementVector::Make(prng.RandomFieldElementVector<TestFieldElement>(n_cosets))));
+  for (size_t i = 0; i < n_columns; ++i) {
+    cached_lde_manager.AddEvaluation(
+        FieldElementVector::Make(prng.RandomFieldElementVector<TestFieldElement>(coset_size)));
+  }
+  cached_lde_manager.FinalizeAdding();
+
+  // Compute the expected values through the LDE of each coset.
+  std::vector<std::vector<std::vector<TestFieldElement>>> evaluations;
+  auto storage = cached_lde_manager.AllocateStorage();
+  for (size_t coset_index = 0; coset_index < n_cosets; ++coset_index) {
+    const auto* coset_evaluation = cached_lde_manager.EvalOnCoset(coset_index, storage.get());
+    std::vector<std::vector<TestFieldElement>> columns;
+    for (const FieldElementVector& column : *coset_evaluation) {
+      const auto values = column.AsSpan().As<TestFieldElement>();
+      columns.emplace_back(values.begin(), values.end());
+    }
+    evaluations.push_back(std::move(columns));
+  }
+
+  std::vector<std::pair<uint64_t, uint64_t>> coset_point_indices;
+  for (size_t i = 0; i < n_points; ++i) {
+    coset_point_indices.emplace_back(
+        prng.UniformInt<uint64_t>(0, n_cosets - 1), prng.UniformInt<uint64_t>(0, coset_size - 1));
+  }
+  std::vector<FieldElementVector> outputs;
+  for (size_t column_index = 0; column_index < n_columns; ++column_index) {
+    outputs.push_back(
+        FieldElementVector::MakeUninitialized(Field::Create<TestFieldElement>(), n_points));
+  }
+  std::vector<FieldElementSpan> outputs_spans = {outputs.begin(), outputs.end()};
+  cached_lde_manager.EvalAtPoints(coset_point_indices, outputs_spans);
+
+  for (size_t column_index = 0; column_index < n_columns; ++column_index) {
+    for (size_t i = 0; i < n_points; ++i) {
+      const auto& [coset_index, point_index] = coset_point_indices[i];
+      ASSERT_EQ(
+          outputs[column_index].As<TestFieldElement>()[i],
+          evaluations[coset_index][column_index][point_index]);
+    }
+  }
+}
+
 #endif
 
+TEST(CachedLdeManager, CosetsFromHugePageArena) {
+  FLAGS_huge_page_arena = true;
+  HugePageArena& arena = HugePageArena::GetInstance();
+  arena.ReleaseCachedBuffers();
+  Prng prng;
+  const size_t log_coset_size = 19;
+  const size_t coset_size = Pow2(log_coset_size);
+  const size_t n_cosets = 2;
+  const size_t n_columns = 2;
+  const size_t coset_bytes = n_columns * coset_size * sizeof(TestFieldElement);
+
+  MultiplicativeFftBases<TestFieldElement> bases(log_coset_size, TestFieldElement::One());
+  CachedLdeManager::Config config{/*store_full_lde=*/true,
+                                  /*use_fft_for_eval=*/false,
+                                  /*eval_all_cosets_at_once=*/false};
+  CachedLdeManager cached_lde_manager(
+      config, TakeOwnershipFrom(MakeLdeManager(bases)),
+      UseMovedValue(
+          FieldElementVector::Make(prng.RandomFieldElementVector<TestFieldElement>(n_cosets))));
+  for (size_t i = 0; i < n_columns; ++i) {
+    cached_lde_manager.AddEvaluation(
+        FieldElementVector::Make(prng.RandomFieldElementVector<TestFieldElement>(coset_size)));
+  }
+  cached_lde_manager.FinalizeAdding();
+
+  // Each cached coset is accounted in the memory mapped by the arena. Buffers that were freed by
+  // the computation are kept mapped for reuse, so only the memory in use is compared.
+  const auto in_use_bytes = [&arena]() {
+    const HugePageArena::Stats stats = arena.GetStats();
+    return stats.mapped_bytes - stats.cached_bytes;
+  };
+  for (size_t coset_index = 0; coset_index < n_cosets; ++coset_index) {
+    const size_t in_use_bytes_before = in_use_bytes();
+    cached_lde_manager.EvalOnCoset(coset_index, nullptr);
+    EXPECT_GE(in_use_bytes(), in_use_bytes_before + coset_bytes);
+  }
+
+  arena.ReleaseCachedBuffers();
+  FLAGS_huge_page_arena = false;
+}
+
 }  // namespace
 }  // namespace starkware
@@ -66,6 +66,17 @@ class LdeManager {
       const FieldElement& coset_offset,
       gsl::span<const FieldElementSpan> evaluation_results) const = 0;
 
+  /*
+    Evaluates the low degree extensions on several cosets at once. evaluation_results[i] receives
+    the evaluations on the coset with offset coset_offsets[i], in the same format as the
+    evaluation_results of EvalOnCoset().
+    Equivalent to calling EvalOnCoset() for each coset, but all the FFTs (one for each pair of coset
+    and LDE) are executed as a single batch, which parallelizes better when there are few LDEs.
+  */
+  virtual void EvalOnCosets(
+      const ConstFieldElementSpan& coset_offsets,
+      gsl::span<const std::vector<FieldElementSpan>> evaluation_results) const = 0;
+
   /*
     Constructs an LDE from the coefficients of the polynomial (obtained by GetCoefficients()).
   */
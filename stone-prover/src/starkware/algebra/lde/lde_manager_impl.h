@@ -16,9 +16,11 @@
 #define STARKWARE_ALGEBRA_LDE_LDE_MANAGER_IMPL_H_
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "starkware/algebra/lde/lde.h"
+#include "starkware/utils/huge_page_arena.h"
 #include "starkware/utils/task_manager.h"
 
 namespace starkware {
@@ -48,6 +50,10 @@ class LdeManagerTmpl : public LdeManager {
       const FieldElement& coset_offset,
       gsl::span<const FieldElementSpan> evaluation_results) const override;
 
+  void EvalOnCosets(
+      const ConstFieldElementSpan& coset_offsets,
+      gsl::span<const std::vector<FieldElementSpan>> evaluation_results) const override;
+
   void AddFromCoefficients(const ConstFieldElementSpan& coefficients) override;
 
   std::unique_ptr<FftWithPrecomputeBase> FftPrecompute(
@@ -69,7 +75,13 @@ class LdeManagerTmpl : public LdeManager {
   void AddEvaluation(
       gsl::span<const FieldElementT> evaluation, FftWithPrecomputeBase* fft_precomputed = nullptr);
   void AddEvaluation(
-      std::vector<FieldElementT> evaluation, FftWithPrecomputeBase* fft_precomputed = nullptr);
+      const std::vector<FieldElementT>& evaluation,
+      FftWithPrecomputeBase* fft_precomputed = nullptr);
+  /*
+    The LDE is computed in place, in the memory of evaluation.
+  */
+  void AddEvaluation(
+      HugePageVector<FieldElementT>&& evaluation, FftWithPrecomputeBase* fft_precomputed = nullptr);
 
   std::unique_ptr<FftDomainBase> GetDomain(const FieldElement& offset) const override;
 
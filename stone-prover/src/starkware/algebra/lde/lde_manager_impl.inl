@@ -32,7 +32,12 @@ LdeManagerTmpl<LdeT>::LdeManagerTmpl(BasesT bases)
 template <typename LdeT>
 void LdeManagerTmpl<LdeT>::AddEvaluation(
     FieldElementVector&& evaluation, FftWithPrecomputeBase* fft_precomputed) {
-  AddEvaluation(std::move(evaluation.As<FieldElementT>()), fft_precomputed);
+  using AllocatorT = HugePageAllocator<FieldElementT>;
+  if (evaluation.Holds<FieldElementT, AllocatorT>()) {
+    AddEvaluation(std::move(evaluation.As<FieldElementT, AllocatorT>()), fft_precomputed);
+  } else {
+    AddEvaluation(evaluation.As<FieldElementT>(), fft_precomputed);
+  }
 }
 
 template <typename LdeT>
@@ -44,12 +49,19 @@ void LdeManagerTmpl<LdeT>::AddEvaluation(
 template <typename LdeT>
 void LdeManagerTmpl<LdeT>::AddEvaluation(
     gsl::span<const FieldElementT> evaluation, FftWithPrecomputeBase* fft_precomputed) {
-  AddEvaluation(std::vector<FieldElementT>(evaluation.begin(), evaluation.end()), fft_precomputed);
+  AddEvaluation(
+      HugePageVector<FieldElementT>(evaluation.begin(), evaluation.end()), fft_precomputed);
+}
+
+template <typename LdeT>
+void LdeManagerTmpl<LdeT>::AddEvaluation(
+    const std::vector<FieldElementT>& evaluation, FftWithPrecomputeBase* fft_precomputed) {
+  AddEvaluation(gsl::make_span(evaluation), fft_precomputed);
 }
 
 template <typename LdeT>
 void LdeManagerTmpl<LdeT>::AddEvaluation(
-    std::vector<FieldElementT> evaluation, FftWithPrecomputeBase* fft_precomputed) {
+    HugePageVector<FieldElementT>&& evaluation, FftWithPrecomputeBase* fft_precomputed) {
   ldes_vector_.push_back(LdeT::AddFromEvaluation(bases_, std::move(evaluation), fft_precomputed));
 }
 
@@ -82,6 +94,52 @@ void LdeManagerTmpl<LdeT>::EvalOnCoset(
       });
 }
 
+template <typename LdeT>
+void LdeManagerTmpl<LdeT>::EvalOnCosets(
+    const ConstFieldElementSpan& coset_offsets,
+    gsl::span<const std::vector<FieldElementSpan>> evaluation_results) const {
+  const size_t n_cosets = coset_offsets.Size();
+  const size_t n_ldes = ldes_vector_.size();
+  ASSERT_RELEASE(
+      evaluation_results.size() == n_cosets,
+      "evaluation_results.size() must match the number of cosets.");
+  for (const auto& coset_results : evaluation_results) {
+    ASSERT_RELEASE(
+        coset_results.size() == n_ldes,
+        "Each element of evaluation_results must match the number of LDEs.");
+    for (const auto& column : coset_results) {
+      ASSERT_RELEASE(column.Size() == bases_[0].Size(), "Wrong column output size");
+    }
+  }
+
+  // Evaluating the LDE on the union of the cosets amounts to one FFT on each coset, each with its
+  // own twiddle factors. All the FFTs are executed as a single batch of tasks, ordered by coset.
+  // Each task handles a contiguous range of FFTs with a single twiddle factors buffer, which is
+  // shifted from one coset to the next, so that at most one table per worker is alive.
+  const gsl::span<const FieldElementT> offsets = coset_offsets.As<FieldElementT>();
+  const size_t n_ffts = n_cosets * n_ldes;
+  TaskManager::GetInstance().ParallelFor(
+      n_ffts,
+      [this, offsets, evaluation_results, n_ldes](const TaskInfo& task_info) {
+        std::optional<typename LdeT::PrecomputeType> precompute;
+        size_t precompute_coset = 0;
+        for (size_t i = task_info.start_idx; i < task_info.end_idx; ++i) {
+          const size_t coset = i / n_ldes;
+          const size_t idx = i % n_ldes;
+          if (!precompute.has_value()) {
+            precompute.emplace(LdeT::FftPrecompute(bases_, offset_compensation_, offsets[coset]));
+          } else if (coset != precompute_coset) {
+            precompute->ShiftTwiddleFactors(
+                FieldElement(offsets[coset]), FieldElement(offsets[precompute_coset]));
+          }
+          precompute_coset = coset;
+          ldes_vector_[idx].EvalAtCoset(
+              *precompute, evaluation_results[coset][idx].template As<FieldElementT>());
+        }
+      },
+      /*max_chunk_size_for_lambda=*/n_ffts);
+}
+
 template <typename LdeT>
 std::unique_ptr<FftWithPrecomputeBase> LdeManagerTmpl<LdeT>::FftPrecompute(
     const FieldElement& coset_offset) const {
@@ -114,8 +172,8 @@ void LdeManagerTmpl<LdeT>::AddFromCoefficients(const ConstFieldElementSpan& coef
       "Expected number of coefficients to be: " + std::to_string(lde_size_) +
           ". Actual: " + std::to_string(coefficients.Size()));
   const gsl::span<const FieldElementT> coef_span = coefficients.As<FieldElementT>();
-  ldes_vector_.push_back(
-      LdeT::AddFromCoefficients(std::vector<FieldElementT>(coef_span.begin(), coef_span.end())));
+  ldes_vector_.push_back(LdeT::AddFromCoefficients(
+      HugePageVector<FieldElementT>(coef_span.begin(), coef_span.end())));
 }
 
 template <typename LdeT>
@@ -52,6 +52,10 @@ class LdeManagerMock : public LdeManager {
   MOCK_CONST_METHOD2(
       EvalOnCoset,
       void(const FieldElement& coset_offset, gsl::span<const FieldElementSpan> evaluation_results));
+  MOCK_CONST_METHOD2(
+      EvalOnCosets, void(
+                        const ConstFieldElementSpan& coset_offsets,
+                        gsl::span<const std::vector<FieldElementSpan>> evaluation_results));
   MOCK_CONST_METHOD3(
       EvalAtPoints, void(
                         size_t evaluation_idx, const ConstFieldElementSpan& points,
@@ -167,6 +167,54 @@ TYPED_TEST(LdeTest, lde_with_offset) {
   EXPECT_NE(lde_manager.GetCoefficients(0), lde_manager.GetCoefficients(1));
 }
 
+TYPED_TEST(LdeTest, EvalOnCosets) {
+  using LdeT = TypeParam;
+  using FieldElementT = typename LdeT::T;
+  const Field field = Field::Create<FieldElementT>();
+  Prng prng;
+
+  const size_t n = 16;
+  const size_t n_cosets = 3;
+  const size_t n_columns = 2;
+  auto bases = this->GetBases(SafeLog2(n), FieldElementT::RandomElement(&prng));
+  auto lde_manager = LdeManagerTmpl<LdeT>(bases);
+  for (size_t column = 0; column < n_columns; ++column) {
+    lde_manager.AddEvaluation(prng.RandomFieldElementVector<FieldElementT>(n));
+  }
+  const FieldElementVector coset_offsets =
+      FieldElementVector::Make(prng.RandomFieldElementVector<FieldElementT>(n_cosets));
+
+  // Indices are: coset, column.
+  const auto make_outputs = [&]() {
+    std::vector<std::vector<FieldElementVector>> outputs(n_cosets);
+    for (auto& coset_outputs : outputs) {
+      for (size_t column = 0; column < n_columns; ++column) {
+        coset_outputs.push_back(FieldElementVector::MakeUninitialized(field, n));
+      }
+    }
+    return outputs;
+  };
+  auto results = make_outputs();
+  std::vector<std::vector<FieldElementSpan>> result_spans;
+  for (auto& coset_results : results) {
+    result_spans.emplace_back(coset_results.begin(), coset_results.end());
+  }
+  lde_manager.EvalOnCosets(coset_offsets, result_spans);
+
+  // Compare with the evaluation of each coset separately.
+  auto expected = make_outputs();
+  for (size_t coset = 0; coset < n_cosets; ++coset) {
+    lde_manager.EvalOnCoset(
+        coset_offsets[coset],
+        std::vector<FieldElementSpan>(expected[coset].begin(), expected[coset].end()));
+    EXPECT_EQ(results[coset], expected[coset]);
+  }
+
+  EXPECT_ASSERT(
+      lde_manager.EvalOnCosets(coset_offsets, gsl::make_span(result_spans).subspan(1)),
+      testing::HasSubstr("must match the number of cosets"));
+}
+
 template <typename FieldElementT>
 void IdentityTest(size_t log_domain_size) {
   const Field field = Field::Create<FieldElementT>();
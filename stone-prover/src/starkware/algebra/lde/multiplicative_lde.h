@@ -21,6 +21,7 @@
 
 #include "starkware/algebra/fft/fft_with_precompute.h"
 #include "starkware/algebra/fft/multiplicative_group_ordering.h"
+#include "starkware/utils/huge_page_arena.h"
 
 namespace starkware {
 
@@ -35,13 +36,13 @@ class MultiplicativeLde {
   /*
     Constructs an LDE from the coefficients of the polynomial (obtained by GetCoefficients()).
   */
-  static MultiplicativeLde AddFromCoefficients(std::vector<FieldElementT>&& coefficients);
+  static MultiplicativeLde AddFromCoefficients(HugePageVector<FieldElementT>&& coefficients);
 
   /*
     Constructs an LDE from the evaluation of the polynomial on the domain bases[0].
   */
   static MultiplicativeLde AddFromEvaluation(
-      const BasesT& bases, std::vector<FieldElementT>&& evaluation,
+      const BasesT& bases, HugePageVector<FieldElementT>&& evaluation,
       FftWithPrecomputeBase* fft_precomputed);
 
   void EvalAtCoset(
@@ -51,7 +52,7 @@ class MultiplicativeLde {
 
   int64_t GetDegree() const;
 
-  const std::vector<FieldElementT>& GetCoefficients() const { return polynomial_; }
+  const HugePageVector<FieldElementT>& GetCoefficients() const { return polynomial_; }
 
   static FftWithPrecompute<BasesT> FftPrecompute(
       const BasesT& bases, const FieldElementT& offset_compensation,
@@ -63,7 +64,7 @@ class MultiplicativeLde {
 
   static auto GetDualBases(const BasesT& domains);
 
-  explicit MultiplicativeLde(std::vector<FieldElementT>&& polynomial)
+  explicit MultiplicativeLde(HugePageVector<FieldElementT>&& polynomial)
       : polynomial_(std::move(polynomial)) {}
 
   // polynomial_ holds the coefficients of P(c*x) where c = offset_compensation_.Inverse().
@@ -71,7 +72,8 @@ class MultiplicativeLde {
   // parameter 'Order'.
   // If 'Order' is kBitReversedOrder then the coefficients are in Natural order.
   // Otherwise, the coefficients are in bit reversed order.
-  std::vector<FieldElementT> polynomial_;
+  // The polynomials take over the trace columns (see Trace::Allocate()), hence the HugePageVector.
+  HugePageVector<FieldElementT> polynomial_;
 };
 
 }  // namespace starkware
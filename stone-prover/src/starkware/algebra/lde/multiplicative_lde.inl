@@ -23,13 +23,13 @@ namespace starkware {
 
 template <MultiplicativeGroupOrdering Order, typename FieldElementT>
 auto MultiplicativeLde<Order, FieldElementT>::AddFromCoefficients(
-    std::vector<FieldElementT>&& coefficients) -> MultiplicativeLde {
+    HugePageVector<FieldElementT>&& coefficients) -> MultiplicativeLde {
   return MultiplicativeLde(std::move(coefficients));
 }
 
 template <MultiplicativeGroupOrdering Order, typename FieldElementT>
 auto MultiplicativeLde<Order, FieldElementT>::AddFromEvaluation(
-    const BasesT& bases, std::vector<FieldElementT>&& evaluation,
+    const BasesT& bases, HugePageVector<FieldElementT>&& evaluation,
     FftWithPrecomputeBase* fft_precomputed) -> MultiplicativeLde {
   if (bases.NumLayers() > 0) {
     // We implement IFFT using the Dual Order FFT with w_inverse_ instead of w.
@@ -95,7 +95,13 @@ FftWithPrecompute<MultiplicativeFftBases<FieldElementT, Order>>
 MultiplicativeLde<Order, FieldElementT>::FftPrecompute(
     const BasesT& bases, const FieldElementT& offset_compensation,
     const FieldElementT& new_offset) {
-  return FftWithPrecompute<BasesT>(bases.GetShiftedBases(new_offset * offset_compensation));
+  // Only the twiddle factors of the subgroup are shared through TwiddleFactorsCache. The ones of
+  // the coset are derived from them.
+  const FieldElementT one = FieldElementT::One();
+  FftWithPrecompute<BasesT> fft_precompute(bases.GetShiftedBases(one));
+  fft_precompute.ShiftTwiddleFactors(
+      FieldElement(new_offset * offset_compensation), FieldElement(one));
+  return fft_precompute;
 }
 
 template <MultiplicativeGroupOrdering Order, typename FieldElementT>
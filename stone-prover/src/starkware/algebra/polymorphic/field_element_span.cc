@@ -79,6 +79,16 @@ void FieldElementSpan::CopyDataFrom(const ConstFieldElementSpan& other) const {
   wrapper_->CopyDataFrom(other);
 }
 
+void FieldElementSpan::GatherFrom(
+    const ConstFieldElementSpan& other, gsl::span<const uint64_t> indices) const {
+  wrapper_->GatherFrom(other, indices);
+}
+
+void FieldElementSpan::ScatterFrom(
+    const ConstFieldElementSpan& other, gsl::span<const uint64_t> indices) const {
+  wrapper_->ScatterFrom(other, indices);
+}
+
 template <bool IsConst, typename Subclass>
 std::ostream& operator<<(std::ostream& out, const FieldElementSpanImpl<IsConst, Subclass>& span) {
   for (size_t i = 0; i < span.Size(); ++i) {
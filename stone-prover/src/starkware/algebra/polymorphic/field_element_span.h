@@ -114,6 +114,18 @@ class FieldElementSpan : public FieldElementSpanImpl<false, FieldElementSpan> {
   */
   void CopyDataFrom(const ConstFieldElementSpan& other) const;
 
+  /*
+    Sets this[i] = other[indices[i]] for every i. The size of this must be equal to indices.size().
+    Unlike a loop over Set(), the underlying type is resolved once for the whole batch.
+  */
+  void GatherFrom(const ConstFieldElementSpan& other, gsl::span<const uint64_t> indices) const;
+
+  /*
+    Sets this[indices[i]] = other[i] for every i. The size of other must be equal to
+    indices.size().
+  */
+  void ScatterFrom(const ConstFieldElementSpan& other, gsl::span<const uint64_t> indices) const;
+
   /*
     Asserts that the underlying type is FieldElementT, and returns the underlying value.
   */
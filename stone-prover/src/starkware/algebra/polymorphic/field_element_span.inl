@@ -25,6 +25,10 @@ class FieldElementSpanImpl<IsConst, Subclass>::WrapperBase {
   virtual FieldElement operator[](size_t index) const = 0;
   virtual void Set(size_t index, const FieldElement& elt) const = 0;
   virtual void CopyDataFrom(const ConstFieldElementSpan& other) const = 0;
+  virtual void GatherFrom(
+      const ConstFieldElementSpan& other, gsl::span<const uint64_t> indices) const = 0;
+  virtual void ScatterFrom(
+      const ConstFieldElementSpan& other, gsl::span<const uint64_t> indices) const = 0;
   virtual Field GetField() const = 0;
   virtual bool IsEqual(const Subclass& other) const = 0;
   virtual std::unique_ptr<FieldElementSpanImpl::WrapperBase> Clone() const = 0;
@@ -71,6 +75,34 @@ class FieldElementSpanImpl<IsConst, Subclass>::Wrapper : public WrapperBase {
     }
   }
 
+  void GatherFrom(
+      const ConstFieldElementSpan& other, gsl::span<const uint64_t> indices) const override {
+    if constexpr (IsConst) {  // NOLINT
+      ASSERT_RELEASE(false, "Cannot copy to const");
+    } else {  // NOLINT: Suppress readability-else-after-return after if constexpr.
+      ASSERT_RELEASE(Size() == indices.size(), "Wrong number of indices");
+      const gsl::span<const FieldElementT> other_span = other.template As<FieldElementT>();
+      for (size_t i = 0; i < indices.size(); ++i) {
+        ASSERT_RELEASE(indices[i] < other_span.size(), "Index out of range");
+        value_[i] = other_span[indices[i]];
+      }
+    }
+  }
+
+  void ScatterFrom(
+      const ConstFieldElementSpan& other, gsl::span<const uint64_t> indices) const override {
+    if constexpr (IsConst) {  // NOLINT
+      ASSERT_RELEASE(false, "Cannot copy to const");
+    } else {  // NOLINT: Suppress readability-else-after-return after if constexpr.
+      ASSERT_RELEASE(other.Size() == indices.size(), "Wrong number of indices");
+      const gsl::span<const FieldElementT> other_span = other.template As<FieldElementT>();
+      for (size_t i = 0; i < indices.size(); ++i) {
+        ASSERT_RELEASE(indices[i] < value_.size(), "Index out of range");
+        value_[indices[i]] = other_span[i];
+      }
+    }
+  }
+
   Field GetField() const override {
     return Field::Create<typename std::remove_cv<FieldElementT>::type>();
   }
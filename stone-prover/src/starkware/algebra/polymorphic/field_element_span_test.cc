@@ -148,6 +148,41 @@ TEST(FieldElementSpan, Copy) {
   EXPECT_ASSERT(dest_span_small.CopyDataFrom(src_span), testing::HasSubstr("different size"));
 }
 
+TEST(FieldElementSpan, GatherAndScatter) {
+  FieldElementVector src_vec = FieldElementVector::Make<TestFieldElement>(
+      {TestFieldElement::FromUint(4), TestFieldElement::FromUint(6),
+       TestFieldElement::FromUint(17)});
+  ConstFieldElementSpan src_span(src_vec);
+  const std::vector<uint64_t> indices = {2, 0, 1};
+
+  FieldElementVector gathered = FieldElementVector::MakeUninitialized<TestFieldElement>(3);
+  FieldElementSpan(gathered).GatherFrom(src_span, indices);
+  EXPECT_THAT(
+      gathered.As<TestFieldElement>(),
+      ElementsAre(
+          TestFieldElement::FromUint(17), TestFieldElement::FromUint(4),
+          TestFieldElement::FromUint(6)));
+
+  FieldElementVector scattered = FieldElementVector::MakeUninitialized<TestFieldElement>(3);
+  FieldElementSpan(scattered).ScatterFrom(src_span, indices);
+  EXPECT_THAT(
+      scattered.As<TestFieldElement>(),
+      ElementsAre(
+          TestFieldElement::FromUint(6), TestFieldElement::FromUint(17),
+          TestFieldElement::FromUint(4)));
+
+  const std::vector<uint64_t> bad_indices = {0, 3, 1};
+  EXPECT_ASSERT(
+      FieldElementSpan(gathered).GatherFrom(src_span, bad_indices),
+      testing::HasSubstr("out of range"));
+  EXPECT_ASSERT(
+      FieldElementSpan(scattered).ScatterFrom(src_span, bad_indices),
+      testing::HasSubstr("out of range"));
+  EXPECT_ASSERT(
+      FieldElementSpan(gathered).GatherFrom(src_span, gsl::make_span(indices).subspan(1)),
+      testing::HasSubstr("Wrong number of indices"));
+}
+
 TEST(ConstFieldElementSpan, BasicTest) {
   std::vector<TestFieldElement> vec = {
       TestFieldElement::FromUint(4), TestFieldElement::FromUint(6), TestFieldElement::FromUint(17),
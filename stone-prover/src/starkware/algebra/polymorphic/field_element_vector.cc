@@ -16,6 +16,7 @@
 
 #include "starkware/algebra/field_operations.h"
 #include "starkware/algebra/utils/invoke_template_version.h"
+#include "starkware/utils/huge_page_arena.h"
 
 namespace starkware {
 
@@ -44,6 +45,15 @@ FieldElementVector FieldElementVector::MakeUninitialized(const Field& field, siz
       field);
 }
 
+FieldElementVector FieldElementVector::MakeUninitializedHugePage(const Field& field, size_t size) {
+  return InvokeFieldTemplateVersion(
+      [&](auto field_tag) {
+        using FieldElementT = typename decltype(field_tag)::type;
+        return MakeUninitialized<FieldElementT, HugePageAllocator<FieldElementT>>(size);
+      },
+      field);
+}
+
 FieldElementVector FieldElementVector::Make(size_t size, const FieldElement& value) {
   return InvokeFieldTemplateVersion(
       [&](auto field_tag) {
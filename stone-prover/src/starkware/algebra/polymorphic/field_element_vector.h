@@ -29,6 +29,10 @@ namespace starkware {
 /*
   A class representing a vector of FieldElement-s of a common field.
   To create an instance call FieldElementVector::Make().
+
+  The underlying value is a std::vector<FieldElementT, AllocatorT>. AllocatorT is std::allocator,
+  except for the large buffers of the prover, which use HugePageAllocator (see
+  MakeUninitializedHugePage()).
 */
 class FieldElementVector {
  public:
@@ -73,16 +77,24 @@ class FieldElementVector {
   bool operator!=(const FieldElementVector& other) const { return !(*this == other); }
 
   /*
-    Asserts that the underlying type is FieldElementT, and returns the underlying value.
+    Asserts that the underlying type is FieldElementT (and the allocator is AllocatorT), and
+    returns the underlying value.
   */
-  template <typename FieldElementT>
-  const std::vector<FieldElementT>& As() const;
+  template <typename FieldElementT, typename AllocatorT = std::allocator<FieldElementT>>
+  const std::vector<FieldElementT, AllocatorT>& As() const;
 
   /*
-    Asserts that the underlying type is FieldElementT, and returns the underlying value.
+    Asserts that the underlying type is FieldElementT (and the allocator is AllocatorT), and
+    returns the underlying value.
   */
-  template <typename FieldElementT>
-  std::vector<FieldElementT>& As();
+  template <typename FieldElementT, typename AllocatorT = std::allocator<FieldElementT>>
+  std::vector<FieldElementT, AllocatorT>& As();
+
+  /*
+    Returns true if As<FieldElementT, AllocatorT>() may be called.
+  */
+  template <typename FieldElementT, typename AllocatorT = std::allocator<FieldElementT>>
+  bool Holds() const;
 
   /*
     Returns the polymorphic non-const FieldElementSpan for the entire vector.
@@ -94,7 +106,7 @@ class FieldElementVector {
     Creates an instance of FieldElementVector with the given underlying field type and the given
     size.
   */
-  template <typename FieldElementT>
+  template <typename FieldElementT, typename AllocatorT = std::allocator<FieldElementT>>
   static FieldElementVector MakeUninitialized(size_t size);
 
   /*
@@ -110,6 +122,12 @@ class FieldElementVector {
   */
   static FieldElementVector MakeUninitialized(const Field& field, size_t size);
 
+  /*
+    Same as MakeUninitialized(), for the large buffers of the prover (e.g. LDE cosets): the values
+    are stored in a HugePageVector, which is served by the HugePageArena with --huge_page_arena.
+  */
+  static FieldElementVector MakeUninitializedHugePage(const Field& field, size_t size);
+
   /*
     Creates an empty instance of FieldElementVector.
   */
@@ -125,8 +143,8 @@ class FieldElementVector {
     For efficiency, call this function with an r-value:
     auto vec = MakeFieldElementVector(std::move(old_vec));
   */
-  template <typename FieldElementT>
-  static FieldElementVector Make(std::vector<FieldElementT>&& vec);
+  template <typename FieldElementT, typename AllocatorT = std::allocator<FieldElementT>>
+  static FieldElementVector Make(std::vector<FieldElementT, AllocatorT>&& vec);
 
   /*
     Creates an instance of FieldElementVector, with the same values as the input.
@@ -148,7 +166,7 @@ class FieldElementVector {
  private:
   class WrapperBase;
 
-  template <typename T>
+  template <typename T, typename AllocatorT = std::allocator<T>>
   class Wrapper;
 
   std::unique_ptr<WrapperBase> wrapper_;
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions
 // and limitations under the License.
 
+#include <algorithm>
+
 #include "starkware/algebra/polymorphic/field_element_span.h"
 
 namespace starkware {
@@ -28,24 +30,26 @@ class FieldElementVector::WrapperBase {
   virtual Field GetField() const = 0;
   virtual bool operator==(const WrapperBase& other) const = 0;
   bool operator!=(const WrapperBase& other) const { return !(*this == other); }
-  template <typename FieldElementT>
-  std::vector<FieldElementT>& As();
-  template <typename FieldElementT>
-  const std::vector<FieldElementT>& As() const;
+  template <typename FieldElementT, typename AllocatorT>
+  std::vector<FieldElementT, AllocatorT>& As();
+  template <typename FieldElementT, typename AllocatorT>
+  const std::vector<FieldElementT, AllocatorT>& As() const;
   virtual FieldElementSpan AsSpan() = 0;
   virtual ConstFieldElementSpan AsSpan() const = 0;
 };
 
-template <typename FieldElementT>
+template <typename FieldElementT, typename AllocatorT>
 class FieldElementVector::Wrapper : public FieldElementVector::WrapperBase {
  public:
-  explicit Wrapper(std::vector<FieldElementT> vec) : value_(std::move(vec)) {}
+  using VectorT = std::vector<FieldElementT, AllocatorT>;
+
+  explicit Wrapper(VectorT vec) : value_(std::move(vec)) {}
 
   size_t Size() const override { return value_.size(); }
 
-  const std::vector<FieldElementT>& Value() const { return value_; }
+  const VectorT& Value() const { return value_; }
 
-  std::vector<FieldElementT>& Value() { return value_; }
+  VectorT& Value() { return value_; }
 
   FieldElement operator[](size_t index) const override { return FieldElement(value_[index]); }
 
@@ -60,7 +64,9 @@ class FieldElementVector::Wrapper : public FieldElementVector::WrapperBase {
   Field GetField() const override { return Field::Create<FieldElementT>(); }
 
   bool operator==(const WrapperBase& other) const override {
-    return value_ == other.As<FieldElementT>();
+    // other may use a different allocator.
+    const gsl::span<const FieldElementT> other_values = other.AsSpan().As<FieldElementT>();
+    return std::equal(value_.begin(), value_.end(), other_values.begin(), other_values.end());
   }
 
   FieldElementSpan AsSpan() override { return FieldElementSpan(gsl::span<FieldElementT>(value_)); }
@@ -70,49 +76,55 @@ class FieldElementVector::Wrapper : public FieldElementVector::WrapperBase {
   }
 
   static std::unique_ptr<WrapperBase> MakeUninitialized(size_t size) {
-    return std::make_unique<Wrapper>(FieldElementT::UninitializedVector(size));
+    return std::make_unique<Wrapper>(
+        FieldElementT::template UninitializedVector<AllocatorT>(size));
   }
 
-  static std::unique_ptr<WrapperBase> Make(std::vector<FieldElementT>&& vec) {
+  static std::unique_ptr<WrapperBase> Make(VectorT&& vec) {
     return std::make_unique<Wrapper>(std::move(vec));
   }
 
  private:
-  std::vector<FieldElementT> value_;
+  VectorT value_;
 };
 
-template <typename FieldElementT>
-std::vector<FieldElementT>& FieldElementVector::WrapperBase::As() {
-  auto* ptr = dynamic_cast<Wrapper<FieldElementT>*>(this);
+template <typename FieldElementT, typename AllocatorT>
+std::vector<FieldElementT, AllocatorT>& FieldElementVector::WrapperBase::As() {
+  auto* ptr = dynamic_cast<Wrapper<FieldElementT, AllocatorT>*>(this);
   ASSERT_RELEASE(ptr != nullptr, "The underlying type of FieldElementVector is wrong");
   return ptr->Value();
 }
 
-template <typename FieldElementT>
-const std::vector<FieldElementT>& FieldElementVector::WrapperBase::As() const {
-  auto* ptr = dynamic_cast<const Wrapper<FieldElementT>*>(this);
+template <typename FieldElementT, typename AllocatorT>
+const std::vector<FieldElementT, AllocatorT>& FieldElementVector::WrapperBase::As() const {
+  auto* ptr = dynamic_cast<const Wrapper<FieldElementT, AllocatorT>*>(this);
   ASSERT_RELEASE(ptr != nullptr, "The underlying type of FieldElementVector is wrong");
   return ptr->Value();
 }
 
-template <typename FieldElementT>
-std::vector<FieldElementT>& FieldElementVector::As() {
-  return wrapper_->As<FieldElementT>();
+template <typename FieldElementT, typename AllocatorT>
+std::vector<FieldElementT, AllocatorT>& FieldElementVector::As() {
+  return wrapper_->As<FieldElementT, AllocatorT>();
 }
 
-template <typename FieldElementT>
-const std::vector<FieldElementT>& FieldElementVector::As() const {
-  return static_cast<const WrapperBase&>(*wrapper_).As<FieldElementT>();
+template <typename FieldElementT, typename AllocatorT>
+const std::vector<FieldElementT, AllocatorT>& FieldElementVector::As() const {
+  return static_cast<const WrapperBase&>(*wrapper_).As<FieldElementT, AllocatorT>();
 }
 
-template <typename FieldElementT>
+template <typename FieldElementT, typename AllocatorT>
+bool FieldElementVector::Holds() const {
+  return dynamic_cast<const Wrapper<FieldElementT, AllocatorT>*>(wrapper_.get()) != nullptr;
+}
+
+template <typename FieldElementT, typename AllocatorT>
 FieldElementVector FieldElementVector::MakeUninitialized(const size_t size) {
-  return FieldElementVector(Wrapper<FieldElementT>::MakeUninitialized(size));
+  return FieldElementVector(Wrapper<FieldElementT, AllocatorT>::MakeUninitialized(size));
 }
 
-template <typename FieldElementT>
-FieldElementVector FieldElementVector::Make(std::vector<FieldElementT>&& vec) {
-  return FieldElementVector(Wrapper<FieldElementT>::Make(std::move(vec)));
+template <typename FieldElementT, typename AllocatorT>
+FieldElementVector FieldElementVector::Make(std::vector<FieldElementT, AllocatorT>&& vec) {
+  return FieldElementVector(Wrapper<FieldElementT, AllocatorT>::Make(std::move(vec)));
 }
 
 template <typename FieldElementT>
@@ -21,6 +21,7 @@
 #include "starkware/algebra/fields/test_field_element.h"
 #include "starkware/error_handling/test_utils.h"
 #include "starkware/randomness/prng.h"
+#include "starkware/utils/huge_page_arena.h"
 
 namespace starkware {
 namespace {
@@ -59,6 +60,30 @@ TEST(FieldElementVector, MakeDoesNotCopy) {
   EXPECT_EQ(data_ptr, field_element_vector.As<TestFieldElement>().data());
 }
 
+TEST(FieldElementVector, HugePageVector) {
+  using AllocatorT = HugePageAllocator<TestFieldElement>;
+  HugePageVector<TestFieldElement> vec(
+      {TestFieldElement::FromUint(4), TestFieldElement::FromUint(6)});
+  auto data_ptr = vec.data();
+  FieldElementVector huge_page_vec = FieldElementVector::Make(std::move(vec));
+  EXPECT_TRUE((huge_page_vec.Holds<TestFieldElement, AllocatorT>()));
+  EXPECT_FALSE((huge_page_vec.Holds<TestFieldElement>()));
+  EXPECT_EQ(data_ptr, (huge_page_vec.As<TestFieldElement, AllocatorT>().data()));
+  EXPECT_ASSERT(huge_page_vec.As<TestFieldElement>(), HasSubstr("underlying type"));
+
+  // Vectors with different allocators are compared by their values.
+  FieldElementVector std_vec = FieldElementVector::Make<TestFieldElement>(
+      {TestFieldElement::FromUint(4), TestFieldElement::FromUint(6)});
+  EXPECT_FALSE((std_vec.Holds<TestFieldElement, AllocatorT>()));
+  EXPECT_TRUE(huge_page_vec == std_vec);
+  EXPECT_TRUE(std_vec == huge_page_vec);
+
+  const FieldElementVector uninitialized =
+      FieldElementVector::MakeUninitializedHugePage(Field::Create<TestFieldElement>(), 5);
+  EXPECT_EQ(uninitialized.Size(), 5U);
+  EXPECT_TRUE((uninitialized.Holds<TestFieldElement, AllocatorT>()));
+}
+
 TEST(FieldElementVector, MakeWithValue) {
   Prng prng;
   const size_t size = prng.UniformInt(0, 10);
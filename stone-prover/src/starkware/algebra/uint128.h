@@ -18,5 +18,6 @@
 #include <cstdint>
 
 using Uint128 = __uint128_t;
+using Int128 = __int128_t;
 
 #endif  // STARKWARE_ALGEBRA_UINT128_H_
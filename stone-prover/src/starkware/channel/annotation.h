@@ -0,0 +1,72 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#ifndef STARKWARE_CHANNEL_ANNOTATION_H_
+#define STARKWARE_CHANNEL_ANNOTATION_H_
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace starkware {
+
+/*
+  A lazily evaluated annotation for the channel API. An Annotation is either a reference to an
+  existing string or a reference to a callable returning std::string. The callable is only invoked
+  (and the string is only materialized) when the channel actually records the annotation, so call
+  sites on the hot path may pass, e.g.:
+
+    channel->SendDecommitmentNode(node, [&] { return "For node " + std::to_string(index); });
+
+  and pay nothing when annotations are disabled.
+
+  Annotation is a non-owning view: it must only be used as a function parameter and never be stored
+  beyond the full expression in which it was created.
+*/
+class Annotation {
+ public:
+  Annotation(const char* str) : str_(str) {}  // NOLINT: implicit cast.
+
+  Annotation(const std::string& str) : str_(str) {}  // NOLINT: implicit cast.
+
+  Annotation(std::string_view str) : str_(str) {}  // NOLINT: implicit cast.
+
+  template <
+      typename Func, typename = std::enable_if_t<
+                         !std::is_convertible_v<const Func&, std::string_view> &&
+                         std::is_invocable_r_v<std::string, const Func&>>>
+  Annotation(const Func& func)  // NOLINT: implicit cast.
+      : callable_(&func), invoke_(&InvokeCallable<Func>) {}
+
+  /*
+    Materializes the annotation. Should only be called when the annotation is going to be used.
+  */
+  std::string ToString() const {
+    return invoke_ == nullptr ? std::string(str_) : invoke_(callable_);
+  }
+
+ private:
+  template <typename Func>
+  static std::string InvokeCallable(const void* callable) {
+    return (*static_cast<const Func*>(callable))();
+  }
+
+  std::string_view str_;
+  const void* callable_ = nullptr;
+  std::string (*invoke_)(const void*) = nullptr;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_CHANNEL_ANNOTATION_H_
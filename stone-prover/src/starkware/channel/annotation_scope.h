@@ -17,6 +17,7 @@
 
 #include <string>
 
+#include "starkware/channel/annotation.h"
 #include "starkware/channel/channel.h"
 
 namespace starkware {
@@ -41,16 +42,20 @@ namespace starkware {
 class AnnotationScope {
  public:
   /*
-    Enters an annotation scope (new prefix added to annotation printouts).
+    Enters an annotation scope (new prefix added to annotation printouts). If annotations are
+    disabled on the channel, the scope is ignored and its name is never materialized.
   */
-  explicit AnnotationScope(Channel* channel, const std::string& scope) : channel_(channel) {
-    channel->EnterAnnotationScope(scope);
-  }
+  explicit AnnotationScope(Channel* channel, const Annotation& scope)
+      : channel_(channel), entered_(channel->EnterAnnotationScope(scope)) {}
 
   /*
     Exits the annotation scope by sideeffect of destruction.
   */
-  ~AnnotationScope() { channel_->ExitAnnotationScope(); }
+  ~AnnotationScope() {
+    if (entered_) {
+      channel_->ExitAnnotationScope();
+    }
+  }
 
   AnnotationScope(const AnnotationScope&) = delete;
   AnnotationScope& operator=(const AnnotationScope&) = delete;
@@ -59,6 +64,7 @@ class AnnotationScope {
 
  private:
   Channel* channel_;
+  const bool entered_;
 };
 
 }  // namespace starkware
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "starkware/algebra/polymorphic/field.h"
+#include "starkware/channel/annotation.h"
 #include "starkware/channel/channel_statistics.h"
 
 namespace starkware {
@@ -27,17 +28,17 @@ namespace starkware {
 class Channel {
  public:
   FieldElement GetRandomFieldElementFromVerifier(
-      const Field& field, const std::string& annotation = "") {
+      const Field& field, const Annotation& annotation = "") {
     return GetRandomFieldElementFromVerifierImpl(field, annotation);
   }
   virtual FieldElement GetRandomFieldElementFromVerifierImpl(
-      const Field& field, const std::string& annotation) = 0;
+      const Field& field, const Annotation& annotation) = 0;
 
-  uint64_t GetRandomNumberFromVerifier(uint64_t upper_bound, const std::string& annotation = "") {
+  uint64_t GetRandomNumberFromVerifier(uint64_t upper_bound, const Annotation& annotation = "") {
     return GetRandomNumberFromVerifierImpl(upper_bound, annotation);
   }
   virtual uint64_t GetRandomNumberFromVerifierImpl(
-      uint64_t upper_bound, const std::string& annotation) = 0;
+      uint64_t upper_bound, const Annotation& annotation) = 0;
 
   /*
     Only relevant for non-interactive channels. Changes the channel seed to a "safer" seed.
@@ -51,9 +52,18 @@ class Channel {
   */
   virtual void ApplyProofOfWork(size_t security_bits) = 0;
 
-  void EnterAnnotationScope(const std::string& scope) {
-    annotation_scope_.push_back(scope);
+  /*
+    Enters an annotation scope. The scope name is only materialized if some kind of annotation is
+    still enabled. Returns true if the scope was entered, in which case ExitAnnotationScope() must
+    be called to leave it.
+  */
+  bool EnterAnnotationScope(const Annotation& scope) {
+    if (!AnnotationScopesEnabled()) {
+      return false;
+    }
+    annotation_scope_.push_back(scope.ToString());
     UpdateAnnotationPrefix();
+    return true;
   }
   void ExitAnnotationScope() {
     annotation_scope_.pop_back();
@@ -98,6 +108,9 @@ class Channel {
   std::string annotation_prefix_ = ": ";
   ChannelStatistics proof_statistics_;
   bool AnnotationsEnabled() const;
+  bool AnnotationScopesEnabled() const {
+    return annotations_enabled_ || extra_annotations_enabled_;
+  }
   bool in_query_phase_ = false;
 
  private:
@@ -17,6 +17,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include "starkware/algebra/fields/test_field_element.h"
 #include "starkware/channel/annotation_scope.h"
 #include "starkware/channel/noninteractive_verifier_channel.h"
 #include "starkware/error_handling/test_utils.h"
@@ -65,5 +66,28 @@ TEST(Channel, IgnoreAnnotations) {
   ASSERT_EQ(channel.GetAnnotations().size(), 1U);
 }
 
+TEST(Channel, LazyAnnotations) {
+  NoninteractiveVerifierChannel channel(Prng::New(), {});
+  channel.SetExpectedAnnotations({"V->P: /scope 0: lazy 1: Number(0)\n"});
+
+  size_t n_evaluations = 0;
+  {
+    AnnotationScope scope(&channel, [&] { return "scope " + std::to_string(n_evaluations++); });
+    channel.GetAndSendRandomNumber(1, [&] { return "lazy " + std::to_string(n_evaluations++); });
+  }
+  EXPECT_EQ(n_evaluations, 2U);
+
+  channel.DisableAnnotations();
+  channel.DisableExtraAnnotations();
+  {
+    AnnotationScope scope(&channel, [&] { return "scope " + std::to_string(n_evaluations++); });
+    channel.GetAndSendRandomNumber(1, [&] { return "lazy " + std::to_string(n_evaluations++); });
+    channel.AnnotateExtraFieldElement(
+        FieldElement(TestFieldElement::One()), [&] { return std::to_string(n_evaluations++); });
+  }
+  EXPECT_EQ(n_evaluations, 2U);
+  EXPECT_EQ(channel.GetAnnotations().size(), 1U);
+}
+
 }  // namespace
 }  // namespace starkware
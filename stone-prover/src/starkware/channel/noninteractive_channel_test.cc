@@ -16,6 +16,7 @@
 #include "starkware/channel/noninteractive_verifier_channel.h"
 
 #include <cstddef>
+#include <sstream>
 #include <string>
 
 #include "gmock/gmock.h"
@@ -96,6 +97,27 @@ TYPED_TEST(NoninteractiveChannelTest, SendingConsistentWithReceivingBytes) {
   EXPECT_EQ(vdata2, pdata2);
 }
 
+TYPED_TEST(NoninteractiveChannelTest, StreamedProof) {
+  std::ostringstream proof_stream;
+  NoninteractiveProverChannel prover_channel(this->channel_prng.Clone(), &proof_stream);
+  NoninteractiveProverChannel reference_channel(this->channel_prng.Clone());
+
+  const std::vector<std::byte> data = this->RandomByteVector(12);
+  prover_channel.SendBytes(data);
+  reference_channel.SendBytes(data);
+  // The hash chain is updated as if the proof was not streamed.
+  EXPECT_EQ(prover_channel.ReceiveBytes(8), reference_channel.ReceiveBytes(8));
+
+  const std::string streamed = proof_stream.str();
+  const std::vector<std::byte> expected = reference_channel.GetProof();
+  EXPECT_EQ(
+      std::vector<std::byte>(
+          reinterpret_cast<const std::byte*>(streamed.data()),  // NOLINT
+          reinterpret_cast<const std::byte*>(streamed.data()) + streamed.size()),  // NOLINT
+      expected);
+  EXPECT_ASSERT(prover_channel.GetProof(), HasSubstr("not kept in memory"));
+}
+
 TYPED_TEST(NoninteractiveChannelTest, ProofOfWork) {
   NoninteractiveProverChannel prover_channel(this->channel_prng.Clone());
 
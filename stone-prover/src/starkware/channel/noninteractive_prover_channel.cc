@@ -31,12 +31,16 @@
 
 namespace starkware {
 
-NoninteractiveProverChannel::NoninteractiveProverChannel(std::unique_ptr<PrngBase> prng)
-    : prng_(std::move(prng)) {}
+NoninteractiveProverChannel::NoninteractiveProverChannel(
+    std::unique_ptr<PrngBase> prng, std::ostream* proof_stream)
+    : prng_(std::move(prng)), proof_stream_(proof_stream) {}
 
 void NoninteractiveProverChannel::SendBytes(const gsl::span<const std::byte> raw_bytes) {
-  for (std::byte raw_byte : raw_bytes) {
-    proof_.push_back(raw_byte);
+  if (proof_stream_ != nullptr) {
+    proof_stream_->write(
+        reinterpret_cast<const char*>(raw_bytes.data()), raw_bytes.size());  // NOLINT
+  } else {
+    proof_.insert(proof_.end(), raw_bytes.begin(), raw_bytes.end());
   }
   if (!in_query_phase_) {
     prng_->MixSeedWithBytes(raw_bytes);
@@ -81,6 +85,9 @@ void NoninteractiveProverChannel::ApplyProofOfWork(size_t security_bits) {
   SendData(proof_of_work, "POW");
 }
 
-std::vector<std::byte> NoninteractiveProverChannel::GetProof() const { return proof_; }
+std::vector<std::byte> NoninteractiveProverChannel::GetProof() const {
+  ASSERT_RELEASE(proof_stream_ == nullptr, "The proof is streamed and is not kept in memory.");
+  return proof_;
+}
 
 }  // namespace starkware
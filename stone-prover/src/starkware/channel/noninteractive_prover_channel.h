@@ -17,6 +17,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -32,8 +33,13 @@ class NoninteractiveProverChannel : public ProverChannel {
   /*
     Initialize the hash chain to a value based on the public input and the constraints system. This
     ensures that the prover doesn't modify the public input after generating the proof.
+
+    If proof_stream is given, every byte of the proof is written to it as soon as it is sent, so the
+    proof can be streamed to a file while it is being generated. In that case the proof is not kept
+    in memory, and GetProof() may not be called.
   */
-  explicit NoninteractiveProverChannel(std::unique_ptr<PrngBase> prng);
+  explicit NoninteractiveProverChannel(
+      std::unique_ptr<PrngBase> prng, std::ostream* proof_stream = nullptr);
 
   /*
     SendBytes writes raw bytes to the proof and updates the hash chain.
@@ -61,10 +67,14 @@ class NoninteractiveProverChannel : public ProverChannel {
   */
   void ApplyProofOfWork(size_t security_bits) override;
 
+  /*
+    Returns the proof sent so far. May not be called if the proof is streamed to proof_stream.
+  */
   std::vector<std::byte> GetProof() const;
 
  private:
   std::unique_ptr<PrngBase> prng_;
+  std::ostream* proof_stream_;
   std::vector<std::byte> proof_{};
 };
 
@@ -23,6 +23,7 @@
 
 #include <vector>
 
+#include "starkware/channel/proof_of_work_engine.h"
 #include "starkware/channel/prover_channel.h"
 #include "starkware/channel/verifier_channel.h"
 #include "starkware/utils/task_manager.h"
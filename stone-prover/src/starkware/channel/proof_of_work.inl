@@ -46,25 +46,6 @@ std::vector<std::byte> ProofOfWorkProver<HashT>::Prove(
   return Prove(seed, work_bits, &TaskManager::GetInstance(), log_chunk_size);
 }
 
-template <typename HashT>
-std::optional<std::uint64_t> SearchChunk(
-    uint64_t nonce_start, uint64_t chunk_size, gsl::span<std::byte> thread_bytes,
-    uint64_t work_limit) {
-  gsl::span<std::byte> nonce_span = thread_bytes.last(sizeof(uint64_t));
-  for (uint64_t nonce = nonce_start; nonce < nonce_start + chunk_size; ++nonce) {
-    Serialize<uint64_t>(nonce, nonce_span, /*use_big_endian=*/true);
-    const HashT hash = HashT::HashBytesWithLength(thread_bytes);
-    const uint64_t digest_word = Deserialize<uint64_t>(
-        gsl::make_span(hash.GetDigest()).first(sizeof(uint64_t)),
-        /*use_big_endian=*/true);
-    // Test we have enough zero bits.
-    if (digest_word < work_limit) {
-      return nonce;
-    }
-  }
-  return std::nullopt;
-}
-
 template <typename HashT>
 std::vector<std::byte> ProofOfWorkProver<HashT>::Prove(
     gsl::span<const std::byte> seed, size_t work_bits, TaskManager* task_manager,
@@ -74,9 +55,8 @@ std::vector<std::byte> ProofOfWorkProver<HashT>::Prove(
 
   ProfilingBlock profiling_block("Proof of work");
 
-  const HashT init_hash = proof_of_work::details::InitHash<HashT>(seed, work_bits);
-  std::array<std::byte, HashT::kDigestNumBytes + sizeof(uint64_t)> bytes{};
-  std::copy(init_hash.GetDigest().begin(), init_hash.GetDigest().end(), bytes.begin());
+  const proof_of_work::details::ProofOfWorkEngine<HashT> engine(
+      proof_of_work::details::InitHash<HashT>(seed, work_bits));
 
   const uint64_t work_limit = Pow2(64 - work_bits);
   const uint64_t chunk_size = Pow2(log_chunk_size);
@@ -90,14 +70,14 @@ std::vector<std::byte> ProofOfWorkProver<HashT>::Prove(
   std::atomic_uint64_t next_chunk_to_search = nonce_bound;
   std::atomic_uint64_t lowest_nonce_found = std::numeric_limits<uint64_t>::max();
   task_manager->ParallelFor(
-      thread_count, [&lowest_nonce_found, &next_chunk_to_search, &bytes, work_limit, chunk_size,
+      thread_count, [&lowest_nonce_found, &next_chunk_to_search, &engine, work_limit, chunk_size,
                      nonce_bound](const TaskInfo& task_info) {
         uint64_t thread_id = task_info.start_idx;
-        std::array<std::byte, HashT::kDigestNumBytes + sizeof(uint64_t)> thread_bytes(bytes);
+        proof_of_work::details::ProofOfWorkEngine<HashT> thread_engine(engine);
         uint64_t nonce_start = thread_id * chunk_size;
         do {
           std::optional<uint64_t> nonce =
-              SearchChunk<HashT>(nonce_start, chunk_size, thread_bytes, work_limit);
+              thread_engine.SearchChunk(nonce_start, chunk_size, work_limit);
           if (nonce.has_value()) {
             // If a valid nonce was found, check if it is smaller than lowest_nonce_found, and if it
             // is, loop until one of the following happens:
@@ -0,0 +1,120 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+/*
+  Nonce search engines for the proof of work prover. An engine is constructed from the init hash
+  (hash(magic || seed || work_bits)) and tests nonces for the predicate checked by
+  ProofOfWorkVerifier:
+    first 8 bytes of hash(init_hash || nonce), read as a big-endian integer, < work_limit.
+
+  The generic engine calls HashT::HashBytesWithLength() for each nonce. For Keccak256 and
+  Blake2s256, init_hash || nonce (40 bytes) fits in a single block of the hash, so the
+  specializations build the padded block once and only patch the nonce into it. The Blake2s engine
+  additionally precomputes the first half round, which does not depend on the nonce. Nonces are
+  processed kBatchSize at a time, with the state stored as one array per word, so that the rounds
+  are vectorized across the nonces of a batch.
+*/
+
+#ifndef STARKWARE_CHANNEL_PROOF_OF_WORK_ENGINE_H_
+#define STARKWARE_CHANNEL_PROOF_OF_WORK_ENGINE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "starkware/crypt_tools/blake2s.h"
+#include "starkware/crypt_tools/keccak_256.h"
+
+namespace starkware {
+namespace proof_of_work {
+namespace details {
+
+template <typename HashT>
+class ProofOfWorkEngine {
+ public:
+  explicit ProofOfWorkEngine(const HashT& init_hash);
+
+  /*
+    Returns the smallest nonce in [nonce_start, nonce_start + chunk_size) that satisfies the proof
+    of work predicate, or nullopt if there is none.
+  */
+  std::optional<uint64_t> SearchChunk(
+      uint64_t nonce_start, uint64_t chunk_size, uint64_t work_limit);
+
+ private:
+  std::array<std::byte, HashT::kDigestNumBytes + sizeof(uint64_t)> bytes_{};
+};
+
+template <>
+class ProofOfWorkEngine<Keccak256> {
+ public:
+  // A batch of Keccak lanes fills one AVX2 register.
+  static constexpr size_t kBatchSize = 4;
+
+  explicit ProofOfWorkEngine(const Keccak256& init_hash);
+
+  std::optional<uint64_t> SearchChunk(
+      uint64_t nonce_start, uint64_t chunk_size, uint64_t work_limit);
+
+  /*
+    Computes the first 8 digest bytes (as a big-endian integer) of kBatchSize consecutive nonces,
+    starting at nonce_start.
+  */
+  std::array<uint64_t, kBatchSize> HashBatch(uint64_t nonce_start) const;
+
+ private:
+  static constexpr size_t kNumLanes = 25;
+  static constexpr size_t kNonceLane = Keccak256::kDigestNumBytes / sizeof(uint64_t);
+
+  // The padded input block, as Keccak lanes. The nonce lane is left as zero.
+  std::array<uint64_t, kNumLanes> block_{};
+};
+
+template <>
+class ProofOfWorkEngine<Blake2s256> {
+ public:
+  // A batch of Blake2s words fills one AVX2 register.
+  static constexpr size_t kBatchSize = 8;
+
+  explicit ProofOfWorkEngine(const Blake2s256& init_hash);
+
+  std::optional<uint64_t> SearchChunk(
+      uint64_t nonce_start, uint64_t chunk_size, uint64_t work_limit);
+
+  /*
+    Same as ProofOfWorkEngine<Keccak256>::HashBatch().
+  */
+  std::array<uint64_t, kBatchSize> HashBatch(uint64_t nonce_start) const;
+
+ private:
+  static constexpr size_t kNumWords = 16;
+  static constexpr size_t kNonceWord = Blake2s256::kDigestNumBytes / sizeof(uint32_t);
+
+  // The message block. The two nonce words are left as zero.
+  std::array<uint32_t, kNumWords> message_{};
+  // The chaining value, before the compression.
+  std::array<uint32_t, 2> h_{};
+  // The working vector after the column step of the first round, which does not depend on the
+  // nonce.
+  std::array<uint32_t, kNumWords> midstate_{};
+};
+
+}  // namespace details
+}  // namespace proof_of_work
+}  // namespace starkware
+
+#include "starkware/channel/proof_of_work_engine.inl"
+
+#endif  // STARKWARE_CHANNEL_PROOF_OF_WORK_ENGINE_H_
@@ -0,0 +1,300 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include <algorithm>
+
+#include "starkware/utils/serialization.h"
+
+// The batched hash functions are compiled for AVX2, so that each operation on a batch becomes a
+// single vector instruction. As in keccak_256.inl, we assume !__EMSCRIPTEN__ => x86 with AVX2.
+#ifndef __EMSCRIPTEN__
+#define POW_ENGINE_TARGET __attribute__((target("avx2")))
+#else
+#define POW_ENGINE_TARGET
+#endif
+
+namespace starkware {
+namespace proof_of_work {
+namespace details {
+
+inline uint64_t DigestWord(gsl::span<const std::byte> digest) {
+  return Deserialize<uint64_t>(digest.first(sizeof(uint64_t)), /*use_big_endian=*/true);
+}
+
+// ProofOfWorkEngine<HashT>.
+
+template <typename HashT>
+ProofOfWorkEngine<HashT>::ProofOfWorkEngine(const HashT& init_hash) {
+  std::copy(init_hash.GetDigest().begin(), init_hash.GetDigest().end(), bytes_.begin());
+}
+
+template <typename HashT>
+std::optional<uint64_t> ProofOfWorkEngine<HashT>::SearchChunk(
+    uint64_t nonce_start, uint64_t chunk_size, uint64_t work_limit) {
+  gsl::span<std::byte> nonce_span = gsl::make_span(bytes_).last(sizeof(uint64_t));
+  for (uint64_t nonce = nonce_start; nonce < nonce_start + chunk_size; ++nonce) {
+    Serialize<uint64_t>(nonce, nonce_span, /*use_big_endian=*/true);
+    // Test we have enough zero bits.
+    if (DigestWord(HashT::HashBytesWithLength(bytes_).GetDigest()) < work_limit) {
+      return nonce;
+    }
+  }
+  return std::nullopt;
+}
+
+/*
+  Runs HashBatch() over [nonce_start, nonce_start + chunk_size), and returns the first nonce whose
+  digest word is below work_limit.
+*/
+template <typename Engine>
+std::optional<uint64_t> SearchChunkInBatches(
+    const Engine& engine, uint64_t nonce_start, uint64_t chunk_size, uint64_t work_limit) {
+  const uint64_t nonce_end = nonce_start + chunk_size;
+  for (uint64_t batch_start = nonce_start; batch_start < nonce_end;
+       batch_start += Engine::kBatchSize) {
+    const auto digest_words = engine.HashBatch(batch_start);
+    for (size_t i = 0; i < Engine::kBatchSize && batch_start + i < nonce_end; ++i) {
+      if (digest_words[i] < work_limit) {
+        return batch_start + i;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+// ProofOfWorkEngine<Keccak256>.
+
+namespace keccak {
+
+constexpr size_t kBlockBytes = (1600 - 512) / 8;
+
+constexpr std::array<uint64_t, 24> kRoundConstants = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000,
+    0x000000000000808b, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+    0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
+    0x000000008000808b, 0x800000000000008b, 0x8000000000008089, 0x8000000000008003,
+    0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008};
+
+// Rotation offsets of the rho step, indexed by x + 5 * y.
+constexpr std::array<unsigned, 25> kRotations = {
+    0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43, 25, 39, 41, 45, 15, 21, 8, 18, 2, 61, 56, 14};
+
+// The destination of lane x + 5 * y in the pi step, which is y + 5 * ((2 * x + 3 * y) % 5).
+constexpr std::array<size_t, 25> kPiDestinations = {
+    0, 10, 20, 5, 15, 16, 1, 11, 21, 6, 7, 17, 2, 12, 22, 23, 8, 18, 3, 13, 14, 24, 9, 19, 4};
+
+}  // namespace keccak
+
+inline ProofOfWorkEngine<Keccak256>::ProofOfWorkEngine(const Keccak256& init_hash) {
+  const auto digest = gsl::make_span(init_hash.GetDigest());
+  for (size_t i = 0; i < kNonceLane; ++i) {
+    block_[i] =
+        Deserialize<uint64_t>(digest.subspan(i * sizeof(uint64_t), sizeof(uint64_t)), false);
+  }
+  // Original Keccak padding, see Keccak256::keccak_state::Finalize().
+  block_[kNonceLane + 1] = 0x01;
+  block_[(keccak::kBlockBytes - 1) / sizeof(uint64_t)] = uint64_t(0x80) << 56;
+}
+
+inline std::optional<uint64_t> ProofOfWorkEngine<Keccak256>::SearchChunk(
+    uint64_t nonce_start, uint64_t chunk_size, uint64_t work_limit) {
+  return SearchChunkInBatches(*this, nonce_start, chunk_size, work_limit);
+}
+
+POW_ENGINE_TARGET inline std::array<uint64_t, ProofOfWorkEngine<Keccak256>::kBatchSize>
+ProofOfWorkEngine<Keccak256>::HashBatch(uint64_t nonce_start) const {
+  // A Keccak lane for each nonce in the batch.
+  typedef uint64_t Lanes __attribute__((vector_size(kBatchSize * sizeof(uint64_t))));
+  std::array<Lanes, kNumLanes> a;
+  for (size_t i = 0; i < kNumLanes; ++i) {
+    a[i] = Lanes{} + block_[i];
+  }
+  // The nonce is serialized as big-endian, and lanes are read as little-endian.
+  for (size_t j = 0; j < kBatchSize; ++j) {
+    a[kNonceLane][j] = __builtin_bswap64(nonce_start + j);
+  }
+
+  // The loops below must be fully unrolled, so that all indices and rotation offsets are constant.
+  std::array<Lanes, 5> c;
+  std::array<Lanes, kNumLanes> b;
+  for (const uint64_t round_constant : keccak::kRoundConstants) {
+    // Theta.
+#pragma GCC unroll 25
+    for (size_t x = 0; x < 5; ++x) {
+      c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+    }
+#pragma GCC unroll 25
+    for (size_t x = 0; x < 5; ++x) {
+      const Lanes& c_next = c[(x + 1) % 5];
+      const Lanes d = c[(x + 4) % 5] ^ ((c_next << 1) | (c_next >> 63));
+#pragma GCC unroll 25
+      for (size_t y = 0; y < 25; y += 5) {
+        a[x + y] ^= d;
+      }
+    }
+    // Rho and pi. A rotation by 0 is a shift by 0 in both directions.
+#pragma GCC unroll 25
+    for (size_t i = 0; i < kNumLanes; ++i) {
+      const unsigned rotation = keccak::kRotations[i];
+      b[keccak::kPiDestinations[i]] = (a[i] << rotation) | (a[i] >> ((64 - rotation) & 63));
+    }
+    // Chi.
+#pragma GCC unroll 25
+    for (size_t y = 0; y < 25; y += 5) {
+#pragma GCC unroll 25
+      for (size_t x = 0; x < 5; ++x) {
+        a[x + y] = b[x + y] ^ (~b[(x + 1) % 5 + y] & b[(x + 2) % 5 + y]);
+      }
+    }
+    // Iota.
+    a[0] ^= round_constant;
+  }
+
+  // The digest starts with lane 0, in little-endian.
+  std::array<uint64_t, kBatchSize> digest_words;
+  for (size_t j = 0; j < kBatchSize; ++j) {
+    digest_words[j] = __builtin_bswap64(a[0][j]);
+  }
+  return digest_words;
+}
+
+// ProofOfWorkEngine<Blake2s256>.
+
+namespace blake2s {
+
+constexpr std::array<uint32_t, 8> kIv = {0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+                                         0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19};
+
+constexpr std::array<std::array<uint8_t, 16>, 10> kSigma = {{
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+    {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+    {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+    {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+}};
+
+// The (a, b, c, d) indices of the four G applications of the column step and the diagonal step.
+constexpr std::array<std::array<uint8_t, 4>, 8> kMixIndices = {{
+    {0, 4, 8, 12},
+    {1, 5, 9, 13},
+    {2, 6, 10, 14},
+    {3, 7, 11, 15},
+    {0, 5, 10, 15},
+    {1, 6, 11, 12},
+    {2, 7, 8, 13},
+    {3, 4, 9, 14},
+}};
+
+/*
+  The G function of Blake2s. Word is either uint32_t or a vector of uint32_t.
+*/
+template <typename Word>
+inline void Mix(Word* a, Word* b, Word* c, Word* d, const Word& x, const Word& y) {
+  *a += *b + x;
+  *d ^= *a;
+  *d = (*d >> 16) | (*d << 16);
+  *c += *d;
+  *b ^= *c;
+  *b = (*b >> 12) | (*b << 20);
+  *a += *b + y;
+  *d ^= *a;
+  *d = (*d >> 8) | (*d << 24);
+  *c += *d;
+  *b ^= *c;
+  *b = (*b >> 7) | (*b << 25);
+}
+
+}  // namespace blake2s
+
+inline ProofOfWorkEngine<Blake2s256>::ProofOfWorkEngine(const Blake2s256& init_hash) {
+  const auto digest = gsl::make_span(init_hash.GetDigest());
+  for (size_t i = 0; i < kNonceWord; ++i) {
+    message_[i] =
+        Deserialize<uint32_t>(digest.subspan(i * sizeof(uint32_t), sizeof(uint32_t)), false);
+  }
+
+  // Parameter block: digest length, no key, fanout 1, depth 1 (see blake2s_init()).
+  std::array<uint32_t, 8> h = blake2s::kIv;
+  h[0] ^= 0x01010000 | Blake2s256::kDigestNumBytes;
+  std::copy(h.begin(), h.begin() + h_.size(), h_.begin());
+
+  // The input is a single (last) block, so the counter is the input length and the last block
+  // flag is set.
+  std::copy(h.begin(), h.end(), midstate_.begin());
+  std::copy(blake2s::kIv.begin(), blake2s::kIv.end(), midstate_.begin() + h.size());
+  midstate_[12] ^= Blake2s256::kDigestNumBytes + sizeof(uint64_t);
+  midstate_[14] = ~midstate_[14];
+
+  // The column step of the first round only reads message words that precede the nonce.
+  for (size_t k = 0; k < 4; ++k) {
+    const auto& idx = blake2s::kMixIndices[k];
+    blake2s::Mix(
+        &midstate_[idx[0]], &midstate_[idx[1]], &midstate_[idx[2]], &midstate_[idx[3]],
+        message_[blake2s::kSigma[0][2 * k]], message_[blake2s::kSigma[0][2 * k + 1]]);
+  }
+}
+
+inline std::optional<uint64_t> ProofOfWorkEngine<Blake2s256>::SearchChunk(
+    uint64_t nonce_start, uint64_t chunk_size, uint64_t work_limit) {
+  return SearchChunkInBatches(*this, nonce_start, chunk_size, work_limit);
+}
+
+POW_ENGINE_TARGET inline std::array<uint64_t, ProofOfWorkEngine<Blake2s256>::kBatchSize>
+ProofOfWorkEngine<Blake2s256>::HashBatch(uint64_t nonce_start) const {
+  // A Blake2s word for each nonce in the batch.
+  typedef uint32_t Words __attribute__((vector_size(kBatchSize * sizeof(uint32_t))));
+  std::array<Words, kNumWords> v;
+  std::array<Words, kNumWords> m;
+  for (size_t i = 0; i < kNumWords; ++i) {
+    v[i] = Words{} + midstate_[i];
+    m[i] = Words{} + message_[i];
+  }
+  // The nonce is serialized as big-endian, and words are read as little-endian.
+  for (size_t j = 0; j < kBatchSize; ++j) {
+    const uint64_t nonce = nonce_start + j;
+    m[kNonceWord][j] = __builtin_bswap32(static_cast<uint32_t>(nonce >> 32));
+    m[kNonceWord + 1][j] = __builtin_bswap32(static_cast<uint32_t>(nonce));
+  }
+
+  // The column step of the first round is already applied in midstate_.
+  for (size_t round = 0; round < blake2s::kSigma.size(); ++round) {
+    const auto& sigma = blake2s::kSigma[round];
+    for (size_t k = (round == 0 ? 4 : 0); k < 8; ++k) {
+      const auto& idx = blake2s::kMixIndices[k];
+      blake2s::Mix(
+          &v[idx[0]], &v[idx[1]], &v[idx[2]], &v[idx[3]], m[sigma[2 * k]], m[sigma[2 * k + 1]]);
+    }
+  }
+
+  // The digest starts with h[0], h[1], in little-endian.
+  std::array<uint64_t, kBatchSize> digest_words;
+  for (size_t j = 0; j < kBatchSize; ++j) {
+    const uint32_t h0 = h_[0] ^ v[0][j] ^ v[8][j];
+    const uint32_t h1 = h_[1] ^ v[1][j] ^ v[9][j];
+    digest_words[j] = (uint64_t(__builtin_bswap32(h0)) << 32) | __builtin_bswap32(h1);
+  }
+  return digest_words;
+}
+
+}  // namespace details
+}  // namespace proof_of_work
+}  // namespace starkware
+
+#undef POW_ENGINE_TARGET
@@ -18,7 +18,9 @@
 
 #include "starkware/channel/noninteractive_prover_channel.h"
 #include "starkware/channel/noninteractive_verifier_channel.h"
+#include "starkware/crypt_tools/blake2s.h"
 #include "starkware/crypt_tools/keccak_256.h"
+#include "starkware/utils/serialization.h"
 
 namespace starkware {
 namespace {
@@ -77,5 +79,91 @@ TEST(ProofOfWork, ParallelCompleteness) {
 }
 #endif
 
+template <typename HashT>
+class ProofOfWorkEngineTest : public ::testing::Test {};
+
+using EngineHashTypes = ::testing::Types<Keccak256, Blake2s256>;
+TYPED_TEST_CASE(ProofOfWorkEngineTest, EngineHashTypes);
+
+/*
+  Checks the batched engines against hashing init_hash || nonce directly.
+*/
+TYPED_TEST(ProofOfWorkEngineTest, HashBatch) {
+  using HashT = TypeParam;
+  using EngineT = proof_of_work::details::ProofOfWorkEngine<HashT>;
+  Prng prng;
+  const auto init_hash = HashT::HashBytesWithLength(prng.RandomByteVector(32));
+  const EngineT engine(init_hash);
+
+  std::array<std::byte, HashT::kDigestNumBytes + sizeof(uint64_t)> bytes{};
+  std::copy(init_hash.GetDigest().begin(), init_hash.GetDigest().end(), bytes.begin());
+  for (const uint64_t nonce_start : {uint64_t(0), prng.UniformInt<uint64_t>(0, 1UL << 63)}) {
+    const auto digest_words = engine.HashBatch(nonce_start);
+    for (size_t i = 0; i < EngineT::kBatchSize; ++i) {
+      Serialize<uint64_t>(
+          nonce_start + i, gsl::make_span(bytes).last(sizeof(uint64_t)), /*use_big_endian=*/true);
+      const HashT hash = HashT::HashBytesWithLength(bytes);
+      EXPECT_EQ(
+          digest_words.at(i),
+          Deserialize<uint64_t>(
+              gsl::make_span(hash.GetDigest()).first(sizeof(uint64_t)), /*use_big_endian=*/true));
+    }
+  }
+}
+
+/*
+  Checks SearchChunk() on chunks that end with a partial batch: a nonce past the end of the chunk
+  must not be returned, even if it is in the same batch.
+*/
+TYPED_TEST(ProofOfWorkEngineTest, SearchChunkPartialBatch) {
+  using HashT = TypeParam;
+  using EngineT = proof_of_work::details::ProofOfWorkEngine<HashT>;
+  Prng prng;
+  const auto init_hash = HashT::HashBytesWithLength(prng.RandomByteVector(32));
+  EngineT engine(init_hash);
+
+  std::array<std::byte, HashT::kDigestNumBytes + sizeof(uint64_t)> bytes{};
+  std::copy(init_hash.GetDigest().begin(), init_hash.GetDigest().end(), bytes.begin());
+  const auto digest_word = [&bytes](uint64_t nonce) {
+    Serialize<uint64_t>(
+        nonce, gsl::make_span(bytes).last(sizeof(uint64_t)), /*use_big_endian=*/true);
+    const HashT hash = HashT::HashBytesWithLength(bytes);
+    return Deserialize<uint64_t>(
+        gsl::make_span(hash.GetDigest()).first(sizeof(uint64_t)), /*use_big_endian=*/true);
+  };
+
+  const uint64_t nonce_start = prng.UniformInt<uint64_t>(0, 1UL << 62);
+  for (uint64_t chunk_size = 1; chunk_size <= 2 * EngineT::kBatchSize + 1; ++chunk_size) {
+    // Make the first nonce after the chunk valid.
+    const uint64_t work_limit = digest_word(nonce_start + chunk_size) + 1;
+    std::optional<uint64_t> expected;
+    for (uint64_t nonce = nonce_start; nonce < nonce_start + chunk_size; ++nonce) {
+      if (digest_word(nonce) < work_limit) {
+        expected = nonce;
+        break;
+      }
+    }
+    EXPECT_EQ(engine.SearchChunk(nonce_start, chunk_size, work_limit), expected);
+  }
+}
+
+TYPED_TEST(ProofOfWorkEngineTest, Completeness) {
+  using HashT = TypeParam;
+  Prng prng;
+  const size_t work_bits = 15;
+  // Use a chunk size (2) which is smaller than the batch size, so every chunk ends with a partial
+  // batch.
+  auto witness = ProofOfWorkProver<HashT>().Prove(prng.GetPrngState(), work_bits, 1);
+
+  ProofOfWorkVerifier<HashT> pow_verifier;
+  EXPECT_TRUE(pow_verifier.Verify(prng.GetPrngState(), work_bits, witness));
+  // The prover returns the lowest valid nonce.
+  const uint64_t nonce = Deserialize<uint64_t>(witness, /*use_big_endian=*/true);
+  for (uint64_t smaller_nonce = 0; smaller_nonce < nonce; ++smaller_nonce) {
+    Serialize<uint64_t>(smaller_nonce, witness, /*use_big_endian=*/true);
+    ASSERT_FALSE(pow_verifier.Verify(prng.GetPrngState(), work_bits, witness));
+  }
+}
+
 }  // namespace
 }  // namespace starkware
@@ -26,6 +26,7 @@
 #include "starkware/algebra/polymorphic/field_element.h"
 #include "starkware/algebra/polymorphic/field_element_span.h"
 #include "starkware/algebra/polymorphic/field_element_vector.h"
+#include "starkware/channel/annotation.h"
 #include "starkware/channel/channel.h"
 #include "starkware/channel/channel_statistics.h"
 #include "starkware/crypt_tools/utils.h"
@@ -39,64 +40,67 @@ class ProverChannel : public Channel {
  public:
   virtual ~ProverChannel() = default;
 
-  void SendData(gsl::span<const std::byte> data, const std::string& annotation = "") {
+  void SendData(gsl::span<const std::byte> data, const Annotation& annotation = "") {
     SendBytes(data);
     if (AnnotationsEnabled()) {
-      AnnotateProverToVerifier(annotation + ": Data(" + BytesToHexString(data) + ")", data.size());
+      AnnotateProverToVerifier(
+          annotation.ToString() + ": Data(" + BytesToHexString(data) + ")", data.size());
     }
     proof_statistics_.data_count += 1;
   }
 
-  void SendFieldElement(const FieldElement& value, const std::string& annotation = "") {
+  void SendFieldElement(const FieldElement& value, const Annotation& annotation = "") {
     SendFieldElementImpl(value);
     if (AnnotationsEnabled()) {
       AnnotateProverToVerifier(
-          annotation + ": Field Element(" + value.ToString() + ")", value.SizeInBytes());
+          annotation.ToString() + ": Field Element(" + value.ToString() + ")", value.SizeInBytes());
     }
     proof_statistics_.field_element_count += 1;
   }
 
   void SendFieldElementSpan(
-      const ConstFieldElementSpan& values, const std::string& annotation = "") {
+      const ConstFieldElementSpan& values, const Annotation& annotation = "") {
     SendFieldElementSpanImpl(values);
     if (AnnotationsEnabled()) {
       std::ostringstream oss;
-      oss << annotation << ": Field Elements(" << values << ")";
+      oss << annotation.ToString() << ": Field Elements(" << values << ")";
       AnnotateProverToVerifier(oss.str(), values.Size() * values.GetField().ElementSizeInBytes());
     }
     proof_statistics_.field_element_count += values.Size();
   }
 
   template <typename HashT>
-  void SendCommitmentHash(const HashT& hash, const std::string& annotation = "") {
+  void SendCommitmentHash(const HashT& hash, const Annotation& annotation = "") {
     SendBytes(hash.GetDigest());
     if (AnnotationsEnabled()) {
       AnnotateProverToVerifier(
-          annotation + ": Hash(" + hash.ToString() + ")", HashT::kDigestNumBytes);
+          annotation.ToString() + ": Hash(" + hash.ToString() + ")", HashT::kDigestNumBytes);
     }
     proof_statistics_.commitment_count += 1;
     proof_statistics_.hash_count += 1;
   }
 
-  FieldElement ReceiveFieldElement(const Field& field, const std::string& annotation = "") {
+  FieldElement ReceiveFieldElement(const Field& field, const Annotation& annotation = "") {
     FieldElement field_element = ReceiveFieldElementImpl(field);
     if (AnnotationsEnabled()) {
-      AnnotateVerifierToProver(annotation + ": Field Element(" + field_element.ToString() + ")");
+      AnnotateVerifierToProver(
+          annotation.ToString() + ": Field Element(" + field_element.ToString() + ")");
     }
     return field_element;
   }
 
   FieldElement GetRandomFieldElementFromVerifierImpl(
-      const Field& field, const std::string& annotation) override {
+      const Field& field, const Annotation& annotation) override {
     return ReceiveFieldElement(field, annotation);
   }
 
   template <typename HashT>
-  void SendDecommitmentNode(const HashT& hash_node, const std::string& annotation = "") {
+  void SendDecommitmentNode(const HashT& hash_node, const Annotation& annotation = "") {
     SendBytes(hash_node.GetDigest());
     if (AnnotationsEnabled()) {
       AnnotateProverToVerifier(
-          annotation + ": Hash(" + hash_node.ToString() + ")", HashT::kDigestNumBytes);
+          annotation.ToString() + ": Hash(" + hash_node.ToString() + ")",
+          HashT::kDigestNumBytes);
     }
     proof_statistics_.hash_count++;
   }
@@ -105,16 +109,17 @@ class ProverChannel : public Channel {
     Receives a random number from the verifier. The number should be chosen uniformly in the
     range [0, upper_bound).
   */
-  uint64_t ReceiveNumber(uint64_t upper_bound, const std::string& annotation = "") {
+  uint64_t ReceiveNumber(uint64_t upper_bound, const Annotation& annotation = "") {
     uint64_t number = ReceiveNumberImpl(upper_bound);
     if (AnnotationsEnabled()) {
-      AnnotateVerifierToProver(annotation + ": Number(" + std::to_string(number) + ")");
+      AnnotateVerifierToProver(
+          annotation.ToString() + ": Number(" + std::to_string(number) + ")");
     }
     return number;
   }
 
   uint64_t GetRandomNumberFromVerifierImpl(
-      uint64_t upper_bound, const std::string& annotation) override {
+      uint64_t upper_bound, const Annotation& annotation) override {
     return ReceiveNumber(upper_bound, annotation);
   }
 
@@ -26,6 +26,7 @@
 #include "starkware/algebra/polymorphic/field_element.h"
 #include "starkware/algebra/polymorphic/field_element_span.h"
 #include "starkware/algebra/polymorphic/field_element_vector.h"
+#include "starkware/channel/annotation.h"
 #include "starkware/channel/channel.h"
 #include "starkware/crypt_tools/utils.h"
 #include "starkware/utils/to_from_string.h"
@@ -42,16 +43,17 @@ class VerifierChannel : public Channel {
     Generates a random number for the verifier, sends it to the prover and returns it. The number
     should be chosen uniformly in the range [0, upper_bound).
   */
-  uint64_t GetAndSendRandomNumber(uint64_t upper_bound, const std::string& annotation = "") {
+  uint64_t GetAndSendRandomNumber(uint64_t upper_bound, const Annotation& annotation = "") {
     uint64_t number = GetAndSendRandomNumberImpl(upper_bound);
     if (AnnotationsEnabled()) {
-      AnnotateVerifierToProver(annotation + ": Number(" + std::to_string(number) + ")");
+      AnnotateVerifierToProver(
+          annotation.ToString() + ": Number(" + std::to_string(number) + ")");
     }
     return number;
   }
 
   uint64_t GetRandomNumberFromVerifierImpl(
-      uint64_t upper_bound, const std::string& annotation) override {
+      uint64_t upper_bound, const Annotation& annotation) override {
     return GetAndSendRandomNumber(upper_bound, annotation);
   }
 
@@ -60,36 +62,37 @@ class VerifierChannel : public Channel {
     it.
   */
   FieldElement GetAndSendRandomFieldElement(
-      const Field& field, const std::string& annotation = "") {
+      const Field& field, const Annotation& annotation = "") {
     FieldElement field_element = GetAndSendRandomFieldElementImpl(field);
     if (AnnotationsEnabled()) {
-      AnnotateVerifierToProver(annotation + ": Field Element(" + field_element.ToString() + ")");
+      AnnotateVerifierToProver(
+          annotation.ToString() + ": Field Element(" + field_element.ToString() + ")");
     }
     return field_element;
   }
 
   FieldElement GetRandomFieldElementFromVerifierImpl(
-      const Field& field, const std::string& annotation) override {
+      const Field& field, const Annotation& annotation) override {
     return GetAndSendRandomFieldElement(field, annotation);
   }
 
   template <typename HashT>
-  HashT ReceiveCommitmentHash(const std::string& annotation = "") {
+  HashT ReceiveCommitmentHash(const Annotation& annotation = "") {
     HashT hash = HashT::InitDigestTo(ReceiveBytes(HashT::kDigestNumBytes));
     if (AnnotationsEnabled()) {
       AnnotateProverToVerifier(
-          annotation + ": Hash(" + hash.ToString() + ")", HashT::kDigestNumBytes);
+          annotation.ToString() + ": Hash(" + hash.ToString() + ")", HashT::kDigestNumBytes);
     }
     proof_statistics_.commitment_count += 1;
     proof_statistics_.hash_count += 1;
     return hash;
   }
 
-  FieldElement ReceiveFieldElement(const Field& field, const std::string& annotation = "") {
+  FieldElement ReceiveFieldElement(const Field& field, const Annotation& annotation = "") {
     FieldElement field_element = ReceiveFieldElementImpl(field);
     if (AnnotationsEnabled()) {
       AnnotateProverToVerifier(
-          annotation + ": Field Element(" + field_element.ToString() + +")",
+          annotation.ToString() + ": Field Element(" + field_element.ToString() + +")",
           field_element.SizeInBytes());
     }
     proof_statistics_.field_element_count += 1;
@@ -97,27 +100,30 @@ class VerifierChannel : public Channel {
   }
 
   void AnnotateExtraFieldElement(
-      const FieldElement& field_element, const std::string& annotation = "") {
-    AddExtraAnnotation(annotation + ": Field Element(" + field_element.ToString() + ")");
+      const FieldElement& field_element, const Annotation& annotation = "") {
+    if (ExtraAnnotationsDisabled()) {
+      return;
+    }
+    AddExtraAnnotation(annotation.ToString() + ": Field Element(" + field_element.ToString() + ")");
   }
 
   void ReceiveFieldElementSpan(
-      const Field& field, const FieldElementSpan& span, const std::string& annotation = "") {
+      const Field& field, const FieldElementSpan& span, const Annotation& annotation = "") {
     ReceiveFieldElementSpanImpl(field, span);
     if (AnnotationsEnabled()) {
       std::ostringstream oss;
-      oss << annotation << ": Field Elements(" << span << ")";
+      oss << annotation.ToString() << ": Field Elements(" << span << ")";
       AnnotateProverToVerifier(oss.str(), span.Size() * span.GetField().ElementSizeInBytes());
     }
     proof_statistics_.field_element_count += span.Size();
   }
 
   template <typename HashT>
-  HashT ReceiveDecommitmentNode(const std::string& annotation = "") {
+  HashT ReceiveDecommitmentNode(const Annotation& annotation = "") {
     HashT hash = HashT::InitDigestTo(ReceiveBytes(HashT::kDigestNumBytes));
     if (AnnotationsEnabled()) {
       AnnotateProverToVerifier(
-          annotation + ": Hash(" + hash.ToString() + ")", HashT::kDigestNumBytes);
+          annotation.ToString() + ": Hash(" + hash.ToString() + ")", HashT::kDigestNumBytes);
     }
 
     proof_statistics_.hash_count++;
@@ -126,14 +132,18 @@ class VerifierChannel : public Channel {
   }
 
   template <typename HashT>
-  void AnnotateExtraDecommitmentNode(const HashT& hash, const std::string& annotation = "") {
-    AddExtraAnnotation(annotation + ": Hash(" + hash.ToString() + ")");
+  void AnnotateExtraDecommitmentNode(const HashT& hash, const Annotation& annotation = "") {
+    if (ExtraAnnotationsDisabled()) {
+      return;
+    }
+    AddExtraAnnotation(annotation.ToString() + ": Hash(" + hash.ToString() + ")");
   }
 
-  std::vector<std::byte> ReceiveData(size_t num_bytes, const std::string& annotation = "") {
+  std::vector<std::byte> ReceiveData(size_t num_bytes, const Annotation& annotation = "") {
     const std::vector<std::byte> data = ReceiveBytes(num_bytes);
     if (AnnotationsEnabled()) {
-      AnnotateProverToVerifier(annotation + ": Data(" + BytesToHexString(data) + ")", num_bytes);
+      AnnotateProverToVerifier(
+          annotation.ToString() + ": Data(" + BytesToHexString(data) + ")", num_bytes);
     }
     proof_statistics_.data_count += 1;
     return data;
@@ -61,7 +61,7 @@ void CachingCommitmentSchemeProver::AddSegmentForCommitment(
 void CachingCommitmentSchemeProver::Commit() { inner_commitment_scheme_->Commit(); }
 
 std::vector<uint64_t> CachingCommitmentSchemeProver::StartDecommitmentPhase(
-    const std::set<uint64_t>& queries) {
+    const std::vector<uint64_t>& queries) {
   // Send required queries to inner_commitment_scheme_ and save the required queries needed for it.
   missing_element_queries_inner_layer_ = inner_commitment_scheme_->StartDecommitmentPhase(queries);
   // This commitment scheme layer doesn't need to get any data in order to decommit, because it
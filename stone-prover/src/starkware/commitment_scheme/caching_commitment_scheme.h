@@ -55,7 +55,7 @@ class CachingCommitmentSchemeProver : public CommitmentSchemeProver {
 
   void Commit() override;
 
-  std::vector<uint64_t> StartDecommitmentPhase(const std::set<uint64_t>& queries) override;
+  std::vector<uint64_t> StartDecommitmentPhase(const std::vector<uint64_t>& queries) override;
 
   void Decommit(gsl::span<const std::byte> elements_data) override;
 
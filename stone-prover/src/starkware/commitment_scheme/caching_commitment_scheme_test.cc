@@ -63,7 +63,7 @@ TEST(CachingCommitmentSchemeProverTest, CommitAndDecommit) {
   commitment_scheme_prover.Commit();
 
   // Decommitment flow.
-  const std::set<uint64_t> queries{1, 6};
+  const std::vector<uint64_t> queries{1, 6};
 
   // Assumes inner layer packs 2 elements in each hash, hance for queries no. 1, 6 inner layer
   // needs elements no. 0, 1 for the first package and 6, 7 for the second package.
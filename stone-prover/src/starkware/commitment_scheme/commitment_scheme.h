@@ -98,11 +98,12 @@ class CommitmentSchemeProver {
 
   /*
     Starts decommitment phase, by passing queries for integrity queries.
-    The queries are indices of elements from the data vector.
+    The queries are indices of elements from the data vector, sorted in increasing order and
+    without duplicates.
     The function returns a vector of (distinct) indices to elements that should be passed to
     Decommit().
   */
-  virtual std::vector<uint64_t> StartDecommitmentPhase(const std::set<uint64_t>& queries) = 0;
+  virtual std::vector<uint64_t> StartDecommitmentPhase(const std::vector<uint64_t>& queries) = 0;
 
   /*
     Decommit to data stored in queried locations, using the channel provided to the constructor (may
@@ -35,7 +35,7 @@ class CommitmentSchemeProverMock : public CommitmentSchemeProver {
   MOCK_METHOD2(
       AddSegmentForCommitment, void(gsl::span<const std::byte> segment_data, size_t segment_index));
   MOCK_METHOD0(Commit, void());
-  MOCK_METHOD1(StartDecommitmentPhase, std::vector<uint64_t>(const std::set<uint64_t>& queries));
+  MOCK_METHOD1(StartDecommitmentPhase, std::vector<uint64_t>(const std::vector<uint64_t>& queries));
   MOCK_METHOD1(Decommit, void(gsl::span<const std::byte> elements_data));
 };
 
@@ -296,7 +296,8 @@ class CommitmentScheme : public ::testing::Test {
 
     if (include_decommitment) {
       // Generate decommitment for queries_ already drawn.
-      const vector<uint64_t> element_idxs = committer.StartDecommitmentPhase(queries_);
+      const vector<uint64_t> element_idxs = committer.StartDecommitmentPhase(
+          vector<uint64_t>(queries_.begin(), queries_.end()));
       vector<std::byte> elements_data;
       for (const uint64_t index : element_idxs) {
         const auto element = GetElement(index);
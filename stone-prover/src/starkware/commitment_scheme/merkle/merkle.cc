@@ -38,13 +38,13 @@ void MerkleTree<HashT>::AddData(const gsl::span<const HashT>& data, uint64_t sta
   // Hash to compute all internal nodes that can be derived solely from the given data.
   uint64_t cur = (k_data_length + start_index) / 2;
   // Based on the given data, we compute its parent nodes' hashes (referred to here as "sub_layer").
+  const auto nodes = gsl::make_span(nodes_);
   for (size_t sub_layer_length = data.size() / 2; sub_layer_length > 0;
        sub_layer_length /= 2, cur /= 2) {
-    for (size_t i = cur; i < cur + sub_layer_length; i++) {
-      // Compute next sub-layer.
-      nodes_[i] = HashT::Hash(nodes_[i * 2], nodes_[i * 2 + 1]);
-      VLOG(6) << "Wrote to inner node #" << i;
-    }
+    // Compute next sub-layer.
+    HashPairs<HashT>(
+        nodes.subspan(cur * 2, sub_layer_length * 2), nodes.subspan(cur, sub_layer_length));
+    VLOG(6) << "Wrote to inner nodes #" << cur << " to #" << cur + sub_layer_length - 1;
   }
 }
 
@@ -63,8 +63,9 @@ HashT MerkleTree<HashT>::GetRoot(size_t min_depth_assumed_correct) {
 
 template <typename HashT>
 void MerkleTree<HashT>::GenerateDecommitment(
-    const std::set<uint64_t>& queries, ProverChannel* channel) const {
+    gsl::span<const uint64_t> queries, ProverChannel* channel) const {
   ASSERT_RELEASE(!queries.empty(), "Empty input queries.");
+  ASSERT_RELEASE(IsSortedAndUnique(queries), "Queries must be sorted and unique.");
 
   std::queue<uint64_t> queue;
 
@@ -98,7 +99,8 @@ void MerkleTree<HashT>::GenerateDecommitment(
 
 template <typename HashT>
 void MerkleTree<HashT>::SendDecommitmentNode(uint64_t node_index, ProverChannel* channel) const {
-  channel->SendDecommitmentNode(nodes_[node_index], "For node " + std::to_string(node_index));
+  channel->SendDecommitmentNode(
+      nodes_[node_index], [&] { return "For node " + std::to_string(node_index); });
 }
 
 template <typename HashT>
@@ -135,8 +137,8 @@ bool MerkleTree<HashT>::VerifyDecommitment(
       queue.pop();
     } else {
       // This node's sibling is part of the authentication nodes. Read it from the channel.
-      const HashT decommitment_node =
-          channel->ReceiveDecommitmentNode<HashT>("For node " + std::to_string(sibling_node_index));
+      const HashT decommitment_node = channel->ReceiveDecommitmentNode<HashT>(
+          [&] { return "For node " + std::to_string(sibling_node_index); });
       VLOG(7) << "Fetching node " << sibling_node_index << " from channel";
       sibling_node_hash = decommitment_node;
     }
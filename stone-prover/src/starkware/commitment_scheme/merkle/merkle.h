@@ -28,6 +28,7 @@
 
 #include "starkware/channel/prover_channel.h"
 #include "starkware/channel/verifier_channel.h"
+#include "starkware/utils/huge_page_arena.h"
 
 namespace starkware {
 
@@ -68,7 +69,11 @@ class MerkleTree {
   */
   HashT GetRoot(size_t min_depth_assumed_correct);
 
-  void GenerateDecommitment(const std::set<uint64_t>& queries, ProverChannel* channel) const;
+  /*
+    Sends the authentication nodes for the given leaves. queries must be sorted in increasing order
+    and without duplicates.
+  */
+  void GenerateDecommitment(gsl::span<const uint64_t> queries, ProverChannel* channel) const;
 
   static bool VerifyDecommitment(
       const std::map<uint64_t, HashT>& data_to_verify, uint64_t total_data_length,
@@ -77,7 +82,7 @@ class MerkleTree {
   const uint64_t k_data_length;
 
  private:
-  std::vector<HashT> nodes_;
+  HugePageVector<HashT> nodes_;
 
   void SendDecommitmentNode(uint64_t node_index, ProverChannel* channel) const;
 };
@@ -71,7 +71,7 @@ void MerkleCommitmentSchemeProver<HashT>::Commit() {
 
 template <typename HashT>
 std::vector<uint64_t> MerkleCommitmentSchemeProver<HashT>::StartDecommitmentPhase(
-    const std::set<uint64_t>& queries) {
+    const std::vector<uint64_t>& queries) {
   queries_ = queries;
   return {};
 }
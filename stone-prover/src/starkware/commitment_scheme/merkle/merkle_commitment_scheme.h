@@ -46,7 +46,7 @@ class MerkleCommitmentSchemeProver : public CommitmentSchemeProver {
 
   void Commit() override;
 
-  std::vector<uint64_t> StartDecommitmentPhase(const std::set<uint64_t>& queries) override;
+  std::vector<uint64_t> StartDecommitmentPhase(const std::vector<uint64_t>& queries) override;
 
   void Decommit(gsl::span<const std::byte> elements_data) override;
 
@@ -54,7 +54,7 @@ class MerkleCommitmentSchemeProver : public CommitmentSchemeProver {
   const uint64_t n_elements_;
   ProverChannel* channel_;
   MerkleTree<HashT> tree_;
-  std::set<uint64_t> queries_;
+  std::vector<uint64_t> queries_;
 };
 
 template <typename HashT>
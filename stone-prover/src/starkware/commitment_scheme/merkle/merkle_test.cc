@@ -113,7 +113,8 @@ TYPED_TEST(MerkleTreeTest, QueryVerificationPositive) {
   const Prng channel_prng;
   NoninteractiveProverChannel prover_channel(channel_prng.Clone());
   VLOG(4) << "Testing " << num_queries << " queries to a tree with " << data_length << " leaves.";
-  tree.GenerateDecommitment(queries, &prover_channel);
+  tree.GenerateDecommitment(
+      std::vector<uint64_t>(queries.begin(), queries.end()), &prover_channel);
   VLOG(4) << "Queries are : " << queries;
   VLOG(4) << "Data is : " << query_data;
   VLOG(4) << "Root is : " << root;
@@ -151,7 +152,8 @@ TYPED_TEST(MerkleTreeTest, QueryVerificationNegative) {
 
   const Prng channel_prng;
   NoninteractiveProverChannel prover_channel(channel_prng.Clone());
-  tree.GenerateDecommitment(queries, &prover_channel);
+  tree.GenerateDecommitment(
+      std::vector<uint64_t>(queries.begin(), queries.end()), &prover_channel);
   NoninteractiveVerifierChannel verifier_channel(channel_prng.Clone(), prover_channel.GetProof());
   EXPECT_FALSE(
       MerkleTree<TypeParam>::VerifyDecommitment(query_data, data_length, root, &verifier_channel));
@@ -106,16 +106,21 @@ void PackagingCommitmentSchemeProver<HashT>::Commit() {
 
 template <typename HashT>
 std::vector<uint64_t> PackagingCommitmentSchemeProver<HashT>::StartDecommitmentPhase(
-    const std::set<uint64_t>& queries) {
+    const std::vector<uint64_t>& queries) {
   queries_ = queries;
   // Compute missing elements required to compute hashes for current layer.
   missing_element_queries_ = packer_.ElementsRequiredToComputeHashes(queries_);
 
   // Translate query indices from element indices to package indices, since this is what
-  // inner_commitment_scheme handles.
-  std::set<uint64_t> package_queries_to_inner_layer;
+  // inner_commitment_scheme handles. The queries are sorted, so equal package indices are
+  // adjacent.
+  std::vector<uint64_t> package_queries_to_inner_layer;
   for (uint64_t q : queries_) {
-    package_queries_to_inner_layer.insert(q / packer_.k_n_elements_in_package);
+    const uint64_t package = q / packer_.k_n_elements_in_package;
+    if (package_queries_to_inner_layer.empty() ||
+        package_queries_to_inner_layer.back() != package) {
+      package_queries_to_inner_layer.push_back(package);
+    }
   }
   // Send required queries to inner_commitment_scheme_ and get required queries needed for it.
   auto missing_package_queries_inner_layer =
@@ -152,13 +157,13 @@ void PackagingCommitmentSchemeProver<HashT>::Decommit(gsl::span<const std::byte>
     if (is_merkle_layer_) {
       // Send decommitment node with its index in the full merkle. The index is calculated as
       // follows: 2 * GetNumOfPackages() + missing_element_queries_[i].
-      channel_->SendDecommitmentNode(
-          HashT::InitDigestTo(bytes_to_send),
-          "For node " + std::to_string(2 * GetNumOfPackages() + missing_element_queries_[i]));
+      channel_->SendDecommitmentNode(HashT::InitDigestTo(bytes_to_send), [&] {
+        return "For node " + std::to_string(2 * GetNumOfPackages() + missing_element_queries_[i]);
+      });
     } else {
-      channel_->SendData(
-          bytes_to_send,
-          "To complete packages, element #" + std::to_string(missing_element_queries_[i]));
+      channel_->SendData(bytes_to_send, [&] {
+        return "To complete packages, element #" + std::to_string(missing_element_queries_[i]);
+      });
     }
   }
 
@@ -224,21 +229,29 @@ bool PackagingCommitmentSchemeVerifier<HashT>::VerifyIntegrity(
   // For example - if elements_to_verify equals to {2,8} and there are 4 elements in each package
   // then missing_elements_idxs = {0,1,3,9,10,11}: 0,1,3 to verify the package for element 2 and
   // 9,10,11 to verify the package for element 8.
+  std::vector<uint64_t> elements_to_verify_idxs;
+  elements_to_verify_idxs.reserve(elements_to_verify.size());
+  for (const auto& [idx, _] : elements_to_verify) {
+    elements_to_verify_idxs.push_back(idx);
+  }
   const std::vector<uint64_t> missing_elements_idxs =
-      packer_.ElementsRequiredToComputeHashes(Keys(elements_to_verify));
+      packer_.ElementsRequiredToComputeHashes(elements_to_verify_idxs);
 
   std::map<uint64_t, std::vector<std::byte>> full_data_to_verify(elements_to_verify);
   for (const uint64_t missing_element_idx : missing_elements_idxs) {
     if (is_merkle_layer_) {
-      const std::string msg =
-          "For node " + std::to_string(2 * GetNumOfPackages() + missing_element_idx);
-      const auto result_array = channel_->ReceiveDecommitmentNode<HashT>(msg).GetDigest();
+      const auto result_array =
+          channel_
+              ->ReceiveDecommitmentNode<HashT>([&] {
+                return "For node " + std::to_string(2 * GetNumOfPackages() + missing_element_idx);
+              })
+              .GetDigest();
       full_data_to_verify[missing_element_idx] =
           std::vector<std::byte>(std::begin(result_array), std::end(result_array));
     } else {
-      full_data_to_verify[missing_element_idx] = channel_->ReceiveData(
-          size_of_element_,
-          "To complete packages, element #" + std::to_string(missing_element_idx));
+      full_data_to_verify[missing_element_idx] = channel_->ReceiveData(size_of_element_, [&] {
+        return "To complete packages, element #" + std::to_string(missing_element_idx);
+      });
     }
   }
 
@@ -248,9 +261,10 @@ bool PackagingCommitmentSchemeVerifier<HashT>::VerifyIntegrity(
 
   if (!is_merkle_layer_) {
     for (auto const& element : bytes_to_verify) {
-      channel_->AnnotateExtraDecommitmentNode<HashT>(
-          HashT::InitDigestTo(element.second),
-          "For node " + std::to_string(element.first + inner_commitment_scheme_->NumOfElements()));
+      channel_->AnnotateExtraDecommitmentNode<HashT>(HashT::InitDigestTo(element.second), [&] {
+        return "For node " +
+               std::to_string(element.first + inner_commitment_scheme_->NumOfElements());
+      });
     }
   }
 
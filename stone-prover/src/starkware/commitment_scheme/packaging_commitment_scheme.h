@@ -89,7 +89,7 @@ class PackagingCommitmentSchemeProver : public CommitmentSchemeProver {
     decommitment. Returns the elements it needs in order to operate decommit (i.e., to compute
     hashes for the required queries).
   */
-  std::vector<uint64_t> StartDecommitmentPhase(const std::set<uint64_t>& queries) override;
+  std::vector<uint64_t> StartDecommitmentPhase(const std::vector<uint64_t>& queries) override;
 
   void Decommit(gsl::span<const std::byte> elements_data) override;
 
@@ -106,7 +106,7 @@ class PackagingCommitmentSchemeProver : public CommitmentSchemeProver {
   // tree in memory, it recomputes it on demand. Set to false by default.
   const bool is_merkle_layer_;
 
-  std::set<uint64_t> queries_;
+  std::vector<uint64_t> queries_;
 
   // Indices of elements needed for the current commitment scheme to compute the required queries
   // given in queries_. Initialized in StartDecommitmentPhase.
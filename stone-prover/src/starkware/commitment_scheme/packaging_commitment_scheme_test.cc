@@ -191,13 +191,13 @@ TEST(PackagingCommitmentSchemeProver, StartDecommitmentPhaseAndDecommit) {
   Prng prng;
   StrictMock<ProverChannelMock> prover_channel;
   const size_t element_size = 11;
-  const std::set<uint64_t> queries{1, 3, 30};
+  const std::vector<uint64_t> queries{1, 3, 30};
   auto inner_commitment_scheme = std::make_unique<StrictMock<CommitmentSchemeProverMock>>();
   // Inner_commitment_scheme pack 2 elements in a package. Packaging_prover calls
   // StartDecommitmentPhase of inner_commitment_scheme with a set of packages indices of the
   // packages containing queries. There are 8 elements in each package created by packaging_prover,
   // hence, 1 and 3 are in package no. 0, 30 is in package no. 3.
-  std::set<uint64_t> inner_layer_queries{0, 3};
+  std::vector<uint64_t> inner_layer_queries{0, 3};
   EXPECT_CALL(*inner_commitment_scheme, StartDecommitmentPhase(inner_layer_queries))
       .WillOnce(testing::Return(std::vector<uint64_t>{1, 2}));
   // Inner_commitment_scheme needs 16 elements, which are 2 packages (there are 8 element in a
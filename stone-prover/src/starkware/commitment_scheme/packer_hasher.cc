@@ -18,6 +18,7 @@
 
 #include "starkware/commitment_scheme/utils.h"
 #include "starkware/crypt_tools/template_instantiation.h"
+#include "starkware/crypt_tools/utils.h"
 #include "starkware/error_handling/error_handling.h"
 #include "starkware/math/math.h"
 #include "starkware/stl_utils/containers.h"
@@ -77,19 +78,18 @@ std::vector<std::byte> HashElementsTwoToOne(gsl::span<const std::byte> data) {
   const size_t elements_to_hash_size = 2 * HashT::kDigestNumBytes;
   const size_t n_elements_next_layer = SafeDiv(data.size(), elements_to_hash_size);
 
-  std::vector<HashT> bytes_as_hash = BytesAsHash<HashT>(data, HashT::kDigestNumBytes);
+  const std::vector<HashT> bytes_as_hash = BytesAsHash<HashT>(data, HashT::kDigestNumBytes);
 
   // Compute next hash layer.
-  for (size_t i = 0; i < n_elements_next_layer; i++) {
-    bytes_as_hash[i] = HashT::Hash(bytes_as_hash[i * 2], bytes_as_hash[i * 2 + 1]);
-  }
+  std::vector<HashT> next_layer(n_elements_next_layer);
+  HashPairs<HashT>(bytes_as_hash, next_layer);
 
   // Translate to bytes.
   std::vector<std::byte> res;
   res.reserve(n_elements_next_layer * HashT::kDigestNumBytes);
   size_t pos = 0;
   for (size_t i = 0; i < n_elements_next_layer; ++i, pos += elements_to_hash_size) {
-    const auto hash_as_bytes_array = bytes_as_hash[i].GetDigest();
+    const auto hash_as_bytes_array = next_layer[i].GetDigest();
     std::copy(hash_as_bytes_array.begin(), hash_as_bytes_array.end(), std::back_inserter(res));
   }
   return res;
@@ -149,10 +149,12 @@ std::vector<uint64_t> PackerHasher<HashT>::GetElementsInPackages(
 
 template <typename HashT>
 std::vector<uint64_t> PackerHasher<HashT>::ElementsRequiredToComputeHashes(
-    const std::set<uint64_t>& elements_known) const {
-  std::set<uint64_t> packages;
+    gsl::span<const uint64_t> elements_known) const {
+  ASSERT_RELEASE(IsSortedAndUnique(elements_known), "Known elements must be sorted and unique.");
+  std::vector<uint64_t> packages;
 
-  // Get package indices of known_elements.
+  // Get package indices of known_elements. Since elements_known is sorted, equal package indices
+  // are adjacent.
   for (const uint64_t el : elements_known) {
     const uint64_t package_id = el / k_n_elements_in_package;
     ASSERT_RELEASE(
@@ -160,11 +162,12 @@ std::vector<uint64_t> PackerHasher<HashT>::ElementsRequiredToComputeHashes(
                                        std::to_string(k_n_packages) +
                                        "), query: " + std::to_string(package_id));
 
-    packages.insert(package_id);
+    if (packages.empty() || packages.back() != package_id) {
+      packages.push_back(package_id);
+    }
   }
   // Return only elements that belong to packages but are not known.
-  const auto all_packages_elements =
-      GetElementsInPackages(std::vector<uint64_t>{packages.begin(), packages.end()});
+  const auto all_packages_elements = GetElementsInPackages(packages);
   std::vector<uint64_t> required_elements;
   std::set_difference(
       all_packages_elements.begin(), all_packages_elements.end(), elements_known.begin(),
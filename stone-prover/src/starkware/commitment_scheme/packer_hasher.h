@@ -46,9 +46,9 @@ class PackerHasher {
   std::vector<std::byte> PackAndHash(gsl::span<const std::byte> data, bool is_merkle_layer) const;
 
   /*
-    Given a list of elements (elements_known), known to the caller, returns a vector of the
-    additional elements that the caller has to provide so that the packer can compute the set of
-    hashes for the packages including those known elements.
+    Given a sorted list of distinct elements (elements_known), known to the caller, returns a
+    vector of the additional elements that the caller has to provide so that the packer can
+    compute the set of hashes for the packages including those known elements.
 
     A typical use case: when one wants to verify a decommitment for the i-th element. Internally,
     this i-th element is in the same package with a bunch of other elements, which are all hashed
@@ -57,7 +57,7 @@ class PackerHasher {
     one needs to find out who are the i-th element's neighbors in this package.
   */
   std::vector<uint64_t> ElementsRequiredToComputeHashes(
-      const std::set<uint64_t>& elements_known) const;
+      gsl::span<const uint64_t> elements_known) const;
 
   /*
     Given a vector of packages, returns a vector of the indices of all elements in that package. For
@@ -52,7 +52,7 @@ void ParallelTableProver::AddSegmentForCommitment(
 void ParallelTableProver::Commit() { table_prover_->Commit(); }
 
 std::vector<uint64_t> ParallelTableProver::StartDecommitmentPhase(
-    const std::set<RowCol>& data_queries, const std::set<RowCol>& integrity_queries) {
+    const std::vector<RowCol>& data_queries, const std::vector<RowCol>& integrity_queries) {
   return table_prover_->StartDecommitmentPhase(data_queries, integrity_queries);
 }
 
@@ -48,7 +48,8 @@ class ParallelTableProver : public TableProver {
   void Commit() override;
 
   std::vector<uint64_t> StartDecommitmentPhase(
-      const std::set<RowCol>& data_queries, const std::set<RowCol>& integrity_queries) override;
+      const std::vector<RowCol>& data_queries,
+      const std::vector<RowCol>& integrity_queries) override;
 
   void Decommit(gsl::span<const ConstFieldElementSpan> elements_data) override;
 
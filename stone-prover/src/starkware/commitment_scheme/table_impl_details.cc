@@ -41,6 +41,24 @@ std::set<uint64_t> AllQueryRows(
   return all_query_rows;
 }
 
+std::vector<uint64_t> AllQueryRows(
+    gsl::span<const RowCol> data_queries, gsl::span<const RowCol> integrity_queries) {
+  // Both lists are sorted by row, so merging them yields the rows in increasing order.
+  std::vector<uint64_t> all_query_rows;
+  all_query_rows.reserve(data_queries.size() + integrity_queries.size());
+  auto data_it = data_queries.begin();
+  auto integrity_it = integrity_queries.begin();
+  while (data_it != data_queries.end() || integrity_it != integrity_queries.end()) {
+    const bool take_data = integrity_it == integrity_queries.end() ||
+                           (data_it != data_queries.end() && *data_it < *integrity_it);
+    const uint64_t row = (take_data ? data_it++ : integrity_it++)->GetRow();
+    if (all_query_rows.empty() || all_query_rows.back() != row) {
+      all_query_rows.push_back(row);
+    }
+  }
+  return all_query_rows;
+}
+
 std::set<RowCol> ElementsToBeTransmitted(
     size_t n_columns, const std::set<uint64_t>& all_query_rows,
     const std::set<RowCol>& integrity_queries) {
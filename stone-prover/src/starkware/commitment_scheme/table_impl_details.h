@@ -19,6 +19,8 @@
 #include <string>
 #include <vector>
 
+#include "third_party/gsl/gsl-lite.hpp"
+
 #include "starkware/channel/prover_channel.h"
 #include "starkware/commitment_scheme/commitment_scheme.h"
 #include "starkware/commitment_scheme/table_prover.h"
@@ -35,6 +37,12 @@ namespace details {
 std::set<uint64_t> AllQueryRows(
     const std::set<RowCol>& data_queries, const std::set<RowCol>& integrity_queries);
 
+/*
+  Same as above, for sorted lists of queries. Returns the row indices sorted in increasing order.
+*/
+std::vector<uint64_t> AllQueryRows(
+    gsl::span<const RowCol> data_queries, gsl::span<const RowCol> integrity_queries);
+
 /*
   Returns a list of RowCol pointing to the field elements that have to be transmitted to allow the
   verification of the queries. These are all the RowCol locations that are in a row with some
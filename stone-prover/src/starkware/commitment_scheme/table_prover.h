@@ -86,9 +86,11 @@ class TableProver {
       decommitment.
     * integrity_queries - a list of indices for which the verifier can compute the data on its own,
       but it wants to verify that its value are consistent with the commitment.
+
+    Both lists must be sorted in increasing order and without duplicates.
   */
   virtual std::vector<uint64_t> StartDecommitmentPhase(
-      const std::set<RowCol>& data_queries, const std::set<RowCol>& integrity_queries) = 0;
+      const std::vector<RowCol>& data_queries, const std::vector<RowCol>& integrity_queries) = 0;
 
   /*
     Finalizes the decommitment phase on the channel.
@@ -28,12 +28,12 @@
 #include "starkware/commitment_scheme/table_impl_details.h"
 #include "starkware/crypt_tools/utils.h"
 #include "starkware/stl_utils/containers.h"
+#include "starkware/utils/huge_page_arena.h"
 
 namespace starkware {
 
 using starkware::table::details::AllQueryRows;
 using starkware::table::details::ElementDecommitAnnotation;
-using starkware::table::details::ElementsToBeTransmitted;
 
 namespace {
 
@@ -63,7 +63,7 @@ bool VerifyAllColumnsSameLength(const std::vector<gsl::span<const T>>& columns)
   '(y*c+x)*b'.
 */
 template <typename FieldElementT>
-std::vector<std::byte> SerializeFieldColumnsImpl(
+HugePageVector<std::byte> SerializeFieldColumnsImpl(
     const std::vector<gsl::span<const FieldElementT>>& columns) {
   ASSERT_RELEASE(VerifyAllColumnsSameLength(columns), "The sizes of the columns must be the same.");
   const size_t n_columns = columns.size();
@@ -71,7 +71,7 @@ std::vector<std::byte> SerializeFieldColumnsImpl(
   const size_t element_size_in_bytes = FieldElementT::SizeInBytes();
   const size_t n_bytes_row = columns.size() * element_size_in_bytes;
 
-  std::vector<std::byte> serialization(n_rows * n_bytes_row);
+  HugePageVector<std::byte> serialization(n_rows * n_bytes_row);
   auto serialization_span = gsl::make_span(serialization);
 
   for (size_t row = 0; row < n_rows; row++) {
@@ -89,7 +89,7 @@ std::vector<std::byte> SerializeFieldColumnsImpl(
 /*
   This is the polymorphic version of SerializeFieldColumnsImpl.
 */
-std::vector<std::byte> SerializeFieldColumns(gsl::span<const ConstFieldElementSpan> segment) {
+HugePageVector<std::byte> SerializeFieldColumns(gsl::span<const ConstFieldElementSpan> segment) {
   return InvokeFieldTemplateVersion(
       [&](auto field_tag) {
         using FieldElementT = typename decltype(field_tag)::type;
@@ -117,10 +117,14 @@ void TableProverImpl::AddSegmentForCommitment(
 void TableProverImpl::Commit() { commitment_scheme_->Commit(); }
 
 std::vector<uint64_t> TableProverImpl::StartDecommitmentPhase(
-    const std::set<RowCol>& data_queries, const std::set<RowCol>& integrity_queries) {
+    const std::vector<RowCol>& data_queries, const std::vector<RowCol>& integrity_queries) {
+  ASSERT_RELEASE(
+      IsSortedAndUnique(gsl::make_span(data_queries)) &&
+          IsSortedAndUnique(gsl::make_span(integrity_queries)),
+      "data_queries and integrity_queries must be sorted and unique");
   // Make sure data_queries and integrity_queries are disjoint.
   ASSERT_RELEASE(
-      AreDisjoint(data_queries, integrity_queries),
+      AreDisjointSorted(gsl::make_span(data_queries), gsl::make_span(integrity_queries)),
       "data_queries and integrity_queries must be disjoint");
 
   data_queries_ = data_queries;
@@ -133,7 +137,9 @@ std::vector<uint64_t> TableProverImpl::StartDecommitmentPhase(
       commitment_scheme_->StartDecommitmentPhase(all_query_rows_);
 
   // Start by requesting all rows in which there are queries.
-  std::vector<uint64_t> rows_to_request(all_query_rows_.begin(), all_query_rows_.end());
+  std::vector<uint64_t> rows_to_request;
+  rows_to_request.reserve(all_query_rows_.size() + requested_elements.size());
+  rows_to_request.insert(rows_to_request.end(), all_query_rows_.begin(), all_query_rows_.end());
 
   // Add rows requested by the inner commitment scheme.
   std::copy(
@@ -163,27 +169,25 @@ void TableProverImpl::Decommit(gsl::span<const ConstFieldElementSpan> elements_d
     elements_data_last_rows.push_back(column.SubSpan(all_query_rows_.size()));
   }
 
-  // Transmit data for the queries, sorted by row and then column.
-  // Note: currently we cannot simply iterate over to_transmit, since a row, for which all cells are
-  // integrity queries, will not appear at all in this set.
-  std::set<RowCol> to_transmit =
-      ElementsToBeTransmitted(n_columns_, all_query_rows_, integrity_queries_);
-  auto row_it = all_query_rows_.begin();
-  auto to_transmit_it = to_transmit.begin();
-  for (size_t i = 0; row_it != all_query_rows_.end(); i++, row_it++) {
+  // Transmit data for the queries, sorted by row and then column. These are the elements returned
+  // by ElementsToBeTransmitted(). Since both all_query_rows_ and integrity_queries_ are sorted in
+  // the same order, the integrity queries are skipped by advancing a single iterator.
+  auto integrity_it = integrity_queries_.begin();
+  for (size_t i = 0; i < all_query_rows_.size(); i++) {
     for (size_t col = 0; col < n_columns_; col++) {
-      const RowCol query_loc(*row_it, col);
+      const RowCol query_loc(all_query_rows_[i], col);
       // Don't transmit data for integrity queries.
-      if (integrity_queries_.count(query_loc) != 0) {
+      if (integrity_it != integrity_queries_.end() && *integrity_it == query_loc) {
+        integrity_it++;
         continue;
       }
-      ASSERT_RELEASE(
-          *to_transmit_it == query_loc, "Expected to transmit " + to_transmit_it->ToString() +
-                                            " but found " + query_loc.ToString());
-      channel_->SendFieldElement(elements_data[col][i], ElementDecommitAnnotation(query_loc));
-      to_transmit_it++;
+      channel_->SendFieldElement(
+          elements_data[col][i], [&] { return ElementDecommitAnnotation(query_loc); });
     }
   }
+  ASSERT_RELEASE(
+      integrity_it == integrity_queries_.end(),
+      "Found integrity queries outside the rows of all_query_rows_.");
 
   commitment_scheme_->Decommit(SerializeFieldColumns(elements_data_last_rows));
 }
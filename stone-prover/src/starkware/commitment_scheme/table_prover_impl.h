@@ -44,7 +44,8 @@ class TableProverImpl : public TableProver {
   void Commit() override;
 
   std::vector<uint64_t> StartDecommitmentPhase(
-      const std::set<RowCol>& data_queries, const std::set<RowCol>& integrity_queries) override;
+      const std::vector<RowCol>& data_queries,
+      const std::vector<RowCol>& integrity_queries) override;
 
   void Decommit(gsl::span<const ConstFieldElementSpan> elements_data) override;
 
@@ -52,9 +53,9 @@ class TableProverImpl : public TableProver {
   size_t n_columns_;
   MaybeOwnedPtr<CommitmentSchemeProver> commitment_scheme_;
   ProverChannel* channel_;
-  std::set<RowCol> data_queries_;
-  std::set<RowCol> integrity_queries_;
-  std::set<uint64_t> all_query_rows_;
+  std::vector<RowCol> data_queries_;
+  std::vector<RowCol> integrity_queries_;
+  std::vector<uint64_t> all_query_rows_;
 };
 
 }  // namespace starkware
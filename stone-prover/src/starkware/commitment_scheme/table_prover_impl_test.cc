@@ -144,7 +144,7 @@ TEST_F(TableProverImplTest, BasicFlow) {
 
   // Call StartDecommitmentPhase().
   // data_queries are {4, 0}, {4, 1}, {93, 1}.
-  // integrity_querties are {93, 2}, {8, 0}, {8, 1}, {8, 2}.
+  // integrity_querties are {8, 0}, {8, 1}, {8, 2}, {93, 2}.
   // To test that the rows requested by the inner commitment_scheme_prover_ are returned, we
   // mock commitment_scheme_prover_.StartDecommitmentPhase to ask for rows 1 and 20.
   ClearExpectations();
@@ -153,7 +153,7 @@ TEST_F(TableProverImplTest, BasicFlow) {
   const std::vector<uint64_t> expected_requested_rows = {4, 8, 93, 1, 20};
   EXPECT_THAT(
       table_prover_.StartDecommitmentPhase(
-          {{4, 0}, {4, 1}, {93, 1}}, {{93, 2}, {8, 0}, {8, 1}, {8, 2}}),
+          {{4, 0}, {4, 1}, {93, 1}}, {{8, 0}, {8, 1}, {8, 2}, {93, 2}}),
       ElementsAreArray(expected_requested_rows));
 
   // Call Decommit().
@@ -42,7 +42,8 @@ class TableProverMock : public TableProver {
   MOCK_METHOD2(
       StartDecommitmentPhase,
       std::vector<uint64_t>(
-          const std::set<RowCol>& data_queries, const std::set<RowCol>& integrity_queries));
+          const std::vector<RowCol>& data_queries,
+          const std::vector<RowCol>& integrity_queries));
   MOCK_METHOD1(Decommit, void(gsl::span<const ConstFieldElementSpan> elements_data));
 };
 
@@ -46,7 +46,8 @@ std::map<RowCol, FieldElement> TableVerifierImpl::Query(
       n_columns_, AllQueryRows(data_queries, integrity_queries), integrity_queries);
   for (const RowCol& query_loc : to_receive) {
     auto iter_bool = response.insert(
-        {query_loc, channel_->ReceiveFieldElement(field_, ElementDecommitAnnotation(query_loc))});
+        {query_loc, channel_->ReceiveFieldElement(
+                        field_, [&] { return ElementDecommitAnnotation(query_loc); })});
     ASSERT_RELEASE(iter_bool.second, "Received two messages with the same key");
   }
   return response;
@@ -221,7 +221,9 @@ std::vector<std::byte> TableVerifierImplTest::GetValidProof(
   table_prover->Commit();
 
   const std::vector<uint64_t> elements_idxs_for_decommitment =
-      table_prover->StartDecommitmentPhase(data_queries, integrity_queries);
+      table_prover->StartDecommitmentPhase(
+          std::vector<RowCol>(data_queries.begin(), data_queries.end()),
+          std::vector<RowCol>(integrity_queries.begin(), integrity_queries.end()));
   std::vector<FieldElementVector> elements_data;
   for (size_t column = 0; column < n_columns; column++) {
     FieldElementVector res = FieldElementVector::Make<FieldElementT>();
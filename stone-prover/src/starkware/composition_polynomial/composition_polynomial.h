@@ -28,6 +28,18 @@
 
 namespace starkware {
 
+namespace composition_polynomial {
+namespace details {
+
+template <typename FieldElementT>
+class CompositionPolynomialImplWorkerMemory;
+
+template <typename FieldElementT>
+struct CompositionPolynomialImplCosetData;
+
+}  // namespace details
+}  // namespace composition_polynomial
+
 /*
   Represents a polynomial of the form:
 
@@ -74,6 +86,17 @@ class CompositionPolynomial {
       const FieldElement& coset_offset, gsl::span<const ConstFieldElementSpan> trace_lde,
       const FieldElementSpan& out_evaluation, uint64_t task_size) const = 0;
 
+  /*
+    Same as EvalOnCosetBitReversedOutput() above, and in addition runs concurrent_task as one more
+    task of the same task pool. This is used to prepare the next coset (e.g. its trace LDE) while
+    the last tasks of this coset are evaluated, so that threads do not wait for the tail of the
+    coset. concurrent_task may call the TaskManager itself.
+  */
+  virtual void EvalOnCosetBitReversedOutput(
+      const FieldElement& coset_offset, gsl::span<const ConstFieldElementSpan> trace_lde,
+      const FieldElementSpan& out_evaluation, uint64_t task_size,
+      const std::function<void()>& concurrent_task) const = 0;
+
   virtual uint64_t GetDegreeBound() const = 0;
 };
 
@@ -123,6 +146,11 @@ class CompositionPolynomialImpl : public CompositionPolynomial {
       const MultiplicativeNeighbors<FieldElementT>& multiplicative_neighbors,
       gsl::span<FieldElementT> out_evaluation, uint64_t task_size) const;
 
+  void EvalOnCosetBitReversedOutput(
+      const FieldElement& coset_offset, gsl::span<const ConstFieldElementSpan> trace_lde,
+      const FieldElementSpan& out_evaluation, uint64_t task_size,
+      const std::function<void()>& concurrent_task) const override;
+
   uint64_t GetDegreeBound() const override { return air_->GetCompositionPolynomialDegreeBound(); }
 
  private:
@@ -148,6 +176,33 @@ class CompositionPolynomialImpl : public CompositionPolynomial {
       const FieldElementT& offset, uint64_t n_points,
       gsl::span<FieldElementT> denominators_inv) const;
 
+  using CosetData =
+      composition_polynomial::details::CompositionPolynomialImplCosetData<FieldElementT>;
+  using WorkerMemory =
+      composition_polynomial::details::CompositionPolynomialImplWorkerMemory<FieldElementT>;
+
+  /*
+    Computes the data shared by all the tasks of the coset coset_offset*<group_generator>.
+  */
+  CosetData PrepareCoset(
+      const FieldElementT& coset_offset,
+      const MultiplicativeNeighbors<FieldElementT>& multiplicative_neighbors,
+      gsl::span<FieldElementT> out_evaluation, uint64_t task_size) const;
+
+  /*
+    Evaluates all the tasks of the given coset. If concurrent_task is not empty, it is executed as
+    an additional task of the same pool.
+  */
+  void EvalOnCoset(
+      const CosetData& coset, uint64_t task_size,
+      const std::function<void()>& concurrent_task) const;
+
+  /*
+    Evaluates the task_idx-th task of size task_size of the given coset.
+  */
+  void EvalCosetTask(
+      const CosetData& coset, size_t task_idx, uint64_t task_size, WorkerMemory* wm) const;
+
   MaybeOwnedPtr<const AirT> air_;
   FieldElementT trace_generator_;
   uint64_t coset_size_;
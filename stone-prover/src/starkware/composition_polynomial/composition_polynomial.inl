@@ -122,6 +122,25 @@ void CompositionPolynomialImpl<AirT>::EvalOnCosetBitReversedOutput(
       coset_offset.As<FieldElementT>(), neighbors, out_evaluation.As<FieldElementT>(), task_size);
 }
 
+template <typename AirT>
+void CompositionPolynomialImpl<AirT>::EvalOnCosetBitReversedOutput(
+    const FieldElement& coset_offset, gsl::span<const ConstFieldElementSpan> trace_lde,
+    const FieldElementSpan& out_evaluation, uint64_t task_size,
+    const std::function<void()>& concurrent_task) const {
+  std::vector<gsl::span<const FieldElementT>> trace_spans;
+  trace_spans.reserve(trace_lde.size());
+  for (const ConstFieldElementSpan& span : trace_lde) {
+    trace_spans.push_back(span.As<FieldElementT>());
+  }
+
+  MultiplicativeNeighbors<FieldElementT> neighbors(air_->GetMask(), trace_spans);
+  EvalOnCoset(
+      PrepareCoset(
+          coset_offset.As<FieldElementT>(), neighbors, out_evaluation.As<FieldElementT>(),
+          task_size),
+      task_size, concurrent_task);
+}
+
 namespace composition_polynomial {
 namespace details {
 
@@ -153,6 +172,22 @@ class CompositionPolynomialImplWorkerMemory {
   std::vector<FieldElementT> batch_inverse_output;
 };
 
+/*
+  The data of a single coset, which is shared by all the tasks of that coset.
+*/
+template <typename FieldElementT>
+struct CompositionPolynomialImplCosetData {
+  const MultiplicativeNeighbors<FieldElementT>* multiplicative_neighbors;
+  gsl::span<FieldElementT> out_evaluation;
+
+  // The first point of each task.
+  std::vector<FieldElementT> algebraic_offsets;
+
+  std::vector<std::vector<FieldElementT>> all_precomp_domain_evals;
+  std::vector<size_t> precomp_domain_masks;
+  std::vector<typename PeriodicColumn<FieldElementT>::CosetEvaluation> periodic_column_cosets;
+};
+
 }  // namespace details
 }  // namespace composition_polynomial
 
@@ -161,9 +196,16 @@ void CompositionPolynomialImpl<AirT>::EvalOnCosetBitReversedOutput(
     const FieldElementT& coset_offset,
     const MultiplicativeNeighbors<FieldElementT>& multiplicative_neighbors,
     gsl::span<FieldElementT> out_evaluation, uint64_t task_size) const {
-  // Precompute useful constants.
-  const size_t log_coset_size = SafeLog2(coset_size_);
+  EvalOnCoset(
+      PrepareCoset(coset_offset, multiplicative_neighbors, out_evaluation, task_size), task_size,
+      nullptr);
+}
 
+template <typename AirT>
+auto CompositionPolynomialImpl<AirT>::PrepareCoset(
+    const FieldElementT& coset_offset,
+    const MultiplicativeNeighbors<FieldElementT>& multiplicative_neighbors,
+    gsl::span<FieldElementT> out_evaluation, uint64_t task_size) const -> CosetData {
   // Input verification.
   ASSERT_RELEASE(
       out_evaluation.size() == coset_size_,
@@ -174,99 +216,130 @@ void CompositionPolynomialImpl<AirT>::EvalOnCosetBitReversedOutput(
       multiplicative_neighbors.CosetSize() == coset_size_,
       "Given neighbor_iterator is not of expected length.");
 
-  // Evaluate on coset.
-  FieldElementT point = coset_offset;
+  CosetData coset{&multiplicative_neighbors, out_evaluation, {}, {}, {}, {}};
 
-  TaskManager& task_manager = TaskManager::GetInstance();
-  std::vector<FieldElementT> algebraic_offsets;
-  algebraic_offsets.reserve(DivCeil(coset_size_, task_size));
+  FieldElementT point = coset_offset;
+  coset.algebraic_offsets.reserve(DivCeil(coset_size_, task_size));
 
   FieldElementT point_multiplier = Pow(trace_generator_, task_size);
   for (uint64_t task_idx_offset = 0; task_idx_offset < coset_size_; task_idx_offset += task_size) {
-    algebraic_offsets.push_back(point);
+    coset.algebraic_offsets.push_back(point);
     point *= point_multiplier;
   }
 
-  std::vector<std::vector<FieldElementT>> all_precomp_domain_evals =
+  coset.all_precomp_domain_evals =
       air_->PrecomputeDomainEvalsOnCoset(coset_offset, trace_generator_, point_exponents_, shifts_);
-  std::vector<size_t> precomp_domain_masks;
-  precomp_domain_masks.reserve(all_precomp_domain_evals.size());
-  for (auto& vec : all_precomp_domain_evals) {
-    precomp_domain_masks.push_back(vec.size() - 1);
+  coset.precomp_domain_masks.reserve(coset.all_precomp_domain_evals.size());
+  for (auto& vec : coset.all_precomp_domain_evals) {
+    coset.precomp_domain_masks.push_back(vec.size() - 1);
   }
 
-  using WorkerMemoryT =
-      composition_polynomial::details::CompositionPolynomialImplWorkerMemory<FieldElementT>;
-  std::vector<WorkerMemoryT> worker_mem;
-  worker_mem.reserve(task_manager.GetNumThreads());
-  for (size_t i = 0; i < task_manager.GetNumThreads(); ++i) {
-    worker_mem.emplace_back(periodic_columns_.size(), all_precomp_domain_evals.size(), task_size);
-  }
-
-  std::vector<typename PeriodicColumn<FieldElementT>::CosetEvaluation> periodic_column_cosets;
   {
     ProfilingBlock periodic_block("Periodic columns computation.");
 
-    periodic_column_cosets.reserve(periodic_columns_.size());
-    for (const PeriodicColumn<FieldElementT>& column : periodic_columns_) {
-      periodic_column_cosets.emplace_back(column.GetCoset(coset_offset, coset_size_));
+    // The columns are computed in parallel, and each column is also computed in parallel (the
+    // tasks of GetCoset() join the same thread pool).
+    std::vector<std::optional<typename PeriodicColumn<FieldElementT>::CosetEvaluation>> cosets(
+        periodic_columns_.size());
+    TaskManager::GetInstance().ParallelFor(
+        periodic_columns_.size(), [this, &cosets, &coset_offset](const TaskInfo& task_info) {
+          for (size_t i = task_info.start_idx; i < task_info.end_idx; ++i) {
+            cosets[i].emplace(periodic_columns_[i].GetCoset(coset_offset, coset_size_));
+          }
+        });
+    coset.periodic_column_cosets.reserve(periodic_columns_.size());
+    for (auto& column_coset : cosets) {
+      coset.periodic_column_cosets.push_back(std::move(*column_coset));
     }
   }
 
+  return coset;
+}
+
+template <typename AirT>
+void CompositionPolynomialImpl<AirT>::EvalOnCoset(
+    const CosetData& coset, uint64_t task_size,
+    const std::function<void()>& concurrent_task) const {
+  TaskManager& task_manager = TaskManager::GetInstance();
+
+  std::vector<WorkerMemory> worker_mem;
+  worker_mem.reserve(task_manager.GetNumThreads());
+  for (size_t i = 0; i < task_manager.GetNumThreads(); ++i) {
+    worker_mem.emplace_back(
+        periodic_columns_.size(), coset.all_precomp_domain_evals.size(), task_size);
+  }
+
+  // The concurrent task (if any) is task number 0, so that it is started before the evaluation
+  // tasks, and threads that are done with the evaluation tasks join the tasks it creates.
+  const size_t n_concurrent_tasks = concurrent_task ? 1 : 0;
   task_manager.ParallelFor(
-      algebraic_offsets.size(),
-      [this, &all_precomp_domain_evals, &precomp_domain_masks, &algebraic_offsets,
-       &periodic_column_cosets, &worker_mem, &multiplicative_neighbors, &out_evaluation,
-       log_coset_size, task_size](const TaskInfo& task_info) {
-        uint64_t initial_point_idx = task_size * task_info.start_idx;
-        auto point = algebraic_offsets[task_info.start_idx];
-        WorkerMemoryT& wm = worker_mem[TaskManager::GetWorkerId()];
-
-        wm.periodic_columns_iter.clear();
-        for (const auto& column_coset : periodic_column_cosets) {
-          wm.periodic_columns_iter.push_back(column_coset.begin() + initial_point_idx);
+      n_concurrent_tasks + coset.algebraic_offsets.size(),
+      [this, &coset, &concurrent_task, &worker_mem, n_concurrent_tasks,
+       task_size](const TaskInfo& task_info) {
+        if (task_info.start_idx < n_concurrent_tasks) {
+          concurrent_task();
+          return;
         }
+        EvalCosetTask(
+            coset, task_info.start_idx - n_concurrent_tasks, task_size,
+            &worker_mem[TaskManager::GetWorkerId()]);
+      });
+}
 
-        typename MultiplicativeNeighbors<FieldElementT>::Iterator neighbors_iter =
-            multiplicative_neighbors.begin();
-        neighbors_iter += static_cast<size_t>(initial_point_idx);
-
-        const size_t actual_task_size = std::min(task_size, coset_size_ - initial_point_idx);
-        const size_t end_of_coset_index = initial_point_idx + actual_task_size;
-
-        for (size_t point_idx = initial_point_idx; point_idx < end_of_coset_index; point_idx++) {
-          ASSERT_RELEASE(
-              neighbors_iter != multiplicative_neighbors.end(),
-              "neighbors_iter reached the end of the iterator unexpectedly");
-          auto neighbors = *neighbors_iter;
-          // Evaluate periodic columns.
-          for (size_t i = 0; i < periodic_columns_.size(); ++i) {
-            wm.periodic_column_vals[i] = *wm.periodic_columns_iter[i];
-            ++wm.periodic_columns_iter[i];
-          }
-          for (size_t i = 0; i < all_precomp_domain_evals.size(); ++i) {
-            wm.precomp_domain_evals[i] =
-                all_precomp_domain_evals[i][point_idx & precomp_domain_masks[i]];
-          }
-          wm.batch_inverse_input[point_idx - initial_point_idx] = air_->ConstraintsEval(
-              neighbors, wm.periodic_column_vals, coefficients_, point, shifts_,
-              wm.precomp_domain_evals);
+template <typename AirT>
+void CompositionPolynomialImpl<AirT>::EvalCosetTask(
+    const CosetData& coset, size_t task_idx, uint64_t task_size, WorkerMemory* wm) const {
+  const size_t log_coset_size = SafeLog2(coset_size_);
+  const MultiplicativeNeighbors<FieldElementT>& multiplicative_neighbors =
+      *coset.multiplicative_neighbors;
 
-          // Advance evaluation point.
-          point *= trace_generator_;
-          ++neighbors_iter;
-        }
+  uint64_t initial_point_idx = task_size * task_idx;
+  auto point = coset.algebraic_offsets[task_idx];
+
+  wm->periodic_columns_iter.clear();
+  for (const auto& column_coset : coset.periodic_column_cosets) {
+    wm->periodic_columns_iter.push_back(column_coset.begin() + initial_point_idx);
+  }
 
-        auto in_span = gsl::span<const FractionFieldElement<FieldElementT>>(wm.batch_inverse_input)
-                           .first(actual_task_size);
-        auto out_span = gsl::span<FieldElementT>(wm.batch_inverse_output).first(actual_task_size);
-        FractionFieldElement<FieldElementT>::BatchToBaseFieldElement(in_span, out_span);
+  typename MultiplicativeNeighbors<FieldElementT>::Iterator neighbors_iter =
+      multiplicative_neighbors.begin();
+  neighbors_iter += static_cast<size_t>(initial_point_idx);
 
-        for (size_t point_idx = initial_point_idx; point_idx < end_of_coset_index; point_idx++) {
-          out_evaluation[BitReverse(point_idx, log_coset_size)] =
-              wm.batch_inverse_output[point_idx - initial_point_idx];
-        }
-      });
+  const size_t actual_task_size = std::min(task_size, coset_size_ - initial_point_idx);
+  const size_t end_of_coset_index = initial_point_idx + actual_task_size;
+
+  for (size_t point_idx = initial_point_idx; point_idx < end_of_coset_index; point_idx++) {
+    ASSERT_RELEASE(
+        neighbors_iter != multiplicative_neighbors.end(),
+        "neighbors_iter reached the end of the iterator unexpectedly");
+    auto neighbors = *neighbors_iter;
+    // Evaluate periodic columns.
+    for (size_t i = 0; i < periodic_columns_.size(); ++i) {
+      wm->periodic_column_vals[i] = *wm->periodic_columns_iter[i];
+      ++wm->periodic_columns_iter[i];
+    }
+    for (size_t i = 0; i < coset.all_precomp_domain_evals.size(); ++i) {
+      wm->precomp_domain_evals[i] =
+          coset.all_precomp_domain_evals[i][point_idx & coset.precomp_domain_masks[i]];
+    }
+    wm->batch_inverse_input[point_idx - initial_point_idx] = air_->ConstraintsEval(
+        neighbors, wm->periodic_column_vals, coefficients_, point, shifts_,
+        wm->precomp_domain_evals);
+
+    // Advance evaluation point.
+    point *= trace_generator_;
+    ++neighbors_iter;
+  }
+
+  auto in_span = gsl::span<const FractionFieldElement<FieldElementT>>(wm->batch_inverse_input)
+                     .first(actual_task_size);
+  auto out_span = gsl::span<FieldElementT>(wm->batch_inverse_output).first(actual_task_size);
+  FractionFieldElement<FieldElementT>::BatchToBaseFieldElement(in_span, out_span);
+
+  for (size_t point_idx = initial_point_idx; point_idx < end_of_coset_index; point_idx++) {
+    coset.out_evaluation[BitReverse(point_idx, log_coset_size)] =
+        wm->batch_inverse_output[point_idx - initial_point_idx];
+  }
 }
 
 }  // namespace starkware
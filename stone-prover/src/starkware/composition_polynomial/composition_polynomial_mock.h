@@ -31,6 +31,11 @@ class CompositionPolynomialMock : public CompositionPolynomial {
       EvalOnCosetBitReversedOutput, void(
                                         const FieldElement&, gsl::span<const ConstFieldElementSpan>,
                                         const FieldElementSpan&, uint64_t));
+  MOCK_CONST_METHOD5(
+      EvalOnCosetBitReversedOutput,
+      void(
+          const FieldElement&, gsl::span<const ConstFieldElementSpan>, const FieldElementSpan&,
+          uint64_t, const std::function<void()>&));
   MOCK_CONST_METHOD0(GetDegreeBound, uint64_t());
 };
 
@@ -25,6 +25,7 @@
 #include "starkware/algebra/fields/test_field_element.h"
 #include "starkware/error_handling/test_utils.h"
 #include "starkware/randomness/prng.h"
+#include "starkware/utils/task_manager.h"
 
 namespace starkware {
 namespace {
@@ -158,6 +159,28 @@ void TestEvalCompositionOnCoset(const size_t log_coset_size, const uint64_t task
             ConstFieldElementSpan(gsl::span<const FieldElementT>(neighbors))),
         evaluation[BitReverse(i, log_coset_size)]);
   }
+
+  // Evaluate again with a concurrent task, which uses the task manager itself, and check that it
+  // runs exactly once and does not change the evaluation.
+  std::vector<size_t> concurrent_output(trace_length);
+  size_t n_concurrent_calls = 0;
+  FieldElementVector evaluation_with_task =
+      FieldElementVector::MakeUninitialized(Field::Create<FieldElementT>(), trace_length);
+  poly->EvalOnCosetBitReversedOutput(
+      FieldElement(coset_offset),
+      std::vector<ConstFieldElementSpan>(trace_lde.begin(), trace_lde.end()), evaluation_with_task,
+      task_size, [&concurrent_output, &n_concurrent_calls]() {
+        ++n_concurrent_calls;
+        TaskManager::GetInstance().ParallelFor(
+            concurrent_output.size(), [&concurrent_output](const TaskInfo& task_info) {
+              concurrent_output[task_info.start_idx] = task_info.start_idx;
+            });
+      });
+  EXPECT_EQ(evaluation, evaluation_with_task);
+  EXPECT_EQ(n_concurrent_calls, 1U);
+  for (size_t i = 0; i < trace_length; ++i) {
+    ASSERT_EQ(concurrent_output[i], i);
+  }
 }
 
 TEST(CompositionPolynomial, EvalCompositionOnCoset) {
@@ -15,6 +15,8 @@
 #ifndef STARKWARE_COMPOSITION_POLYNOMIAL_PERIODIC_COLUMN_H_
 #define STARKWARE_COMPOSITION_POLYNOMIAL_PERIODIC_COLUMN_H_
 
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -23,6 +25,7 @@
 #include "starkware/algebra/lde/lde.h"
 #include "starkware/algebra/lde/lde_manager_impl.h"
 #include "starkware/algebra/polynomials.h"
+#include "starkware/composition_polynomial/periodic_column_cache.h"
 
 namespace starkware {
 
@@ -64,10 +67,25 @@ class PeriodicColumn {
 
   /*
     Returns a generator that computes the polynomial on a coset.
+    The evaluation is taken from PeriodicColumnCache if it was enabled when the column was
+    constructed.
   */
   CosetEvaluation GetCoset(const FieldElementT& start_point, size_t coset_size) const;
 
  private:
+  /*
+    Computes the evaluation of the column on the coset of start_point, without the cache.
+  */
+  std::vector<FieldElementT> ComputeCoset(const FieldElementT& start_point) const;
+
+  /*
+    Returns the key of the column in PeriodicColumnCache: a hash of the field type, the values and
+    the domain.
+  */
+  static std::string MakeCacheKey(
+      gsl::span<const FieldElementT> values, const FieldElementT& group_generator,
+      const FieldElementT& offset, uint64_t coset_size, uint64_t column_step);
+
   const FieldElementT group_generator_;
 
   /*
@@ -94,6 +112,11 @@ class PeriodicColumn {
   */
   LdeManagerTmpl<MultiplicativeLde<MultiplicativeGroupOrdering::kNaturalOrder, FieldElementT>>
       lde_manager_;
+
+  /*
+    See MakeCacheKey(). Empty if PeriodicColumnCache was disabled on construction.
+  */
+  const std::string cache_key_;
 };
 
 /*
@@ -104,15 +127,22 @@ template <typename FieldElementT>
 class PeriodicColumn<FieldElementT>::CosetEvaluation {
  public:
   explicit CosetEvaluation(std::vector<FieldElementT> values)
-      : values_(std::move(values)), index_mask_(values_.size() - 1) {
+      : CosetEvaluation(std::make_shared<const std::vector<FieldElementT>>(std::move(values))) {}
+
+  /*
+    Constructs an evaluation that shares its values, e.g. with PeriodicColumnCache.
+  */
+  explicit CosetEvaluation(std::shared_ptr<const std::vector<FieldElementT>> values)
+      : values_(std::move(values)), index_mask_(values_->size() - 1) {
     ASSERT_RELEASE(
-        IsPowerOfTwo(values_.size()), "Currently values must be of size which is a power of two.");
+        IsPowerOfTwo(values_->size()),
+        "Currently values must be of size which is a power of two.");
   }
 
   class Iterator {
    public:
-    Iterator(const CosetEvaluation* parent, uint64_t index, const uint64_t index_mask)
-        : parent_(parent), index_(index), index_mask_(index_mask) {}
+    Iterator(const FieldElementT* values, uint64_t index, const uint64_t index_mask)
+        : values_(values), index_(index), index_mask_(index_mask) {}
 
     Iterator& operator++() {
       index_ = (index_ + 1) & index_mask_;
@@ -120,22 +150,22 @@ class PeriodicColumn<FieldElementT>::CosetEvaluation {
     }
 
     Iterator operator+(uint64_t offset) const {
-      return Iterator(parent_, (index_ + offset) & index_mask_, index_mask_);
+      return Iterator(values_, (index_ + offset) & index_mask_, index_mask_);
     }
 
-    FieldElementT operator*() const { return parent_->values_[index_]; }
+    FieldElementT operator*() const { return values_[index_]; }
 
    private:
-    const CosetEvaluation* parent_;
+    const FieldElementT* values_;
     uint64_t index_;
     const uint64_t index_mask_;
   };
 
-  Iterator begin() const { return Iterator(this, 0, index_mask_); }  // NOLINT
+  Iterator begin() const { return Iterator(values_->data(), 0, index_mask_); }  // NOLINT
 
  private:
-  const std::vector<FieldElementT> values_;
-  const uint64_t index_mask_;
+  std::shared_ptr<const std::vector<FieldElementT>> values_;
+  uint64_t index_mask_;
 };
 
 }  // namespace starkware
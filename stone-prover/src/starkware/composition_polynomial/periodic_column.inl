@@ -12,6 +12,11 @@
 // See the License for the specific language governing permissions
 // and limitations under the License.
 
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <typeinfo>
+
 #include "starkware/algebra/fft/multiplicative_fft.h"
 #include "starkware/utils/bit_reversal.h"
 #include "starkware/utils/task_manager.h"
@@ -29,10 +34,37 @@ PeriodicColumn<FieldElementT>::PeriodicColumn(
       lde_manager_(
           MultiplicativeFftBases<FieldElementT, MultiplicativeGroupOrdering::kNaturalOrder>(
               Pow(group_generator, column_step * n_copies_), SafeLog2(values.size()),
-              Pow(offset, n_copies_))) {
+              Pow(offset, n_copies_))),
+      cache_key_(
+          PeriodicColumnCache::Enabled()
+              ? MakeCacheKey(values, group_generator, offset, coset_size, column_step)
+              : "") {
   lde_manager_.AddEvaluation(values);
 }
 
+template <typename FieldElementT>
+std::string PeriodicColumn<FieldElementT>::MakeCacheKey(
+    gsl::span<const FieldElementT> values, const FieldElementT& group_generator,
+    const FieldElementT& offset, uint64_t coset_size, uint64_t column_step) {
+  const std::string header = std::string(typeid(FieldElementT).name()) + ":" +
+                             std::to_string(coset_size) + ":" + std::to_string(column_step) + ":";
+  std::vector<std::byte> description(
+      header.size() + (values.size() + 2) * FieldElementT::SizeInBytes());
+  std::transform(header.begin(), header.end(), description.begin(), [](char c) {
+    return static_cast<std::byte>(c);
+  });
+  auto element_bytes = gsl::make_span(description).subspan(header.size());
+  for (const FieldElementT& element : {group_generator, offset}) {
+    element.ToBytes(element_bytes.subspan(0, FieldElementT::SizeInBytes()));
+    element_bytes = element_bytes.subspan(FieldElementT::SizeInBytes());
+  }
+  for (const FieldElementT& value : values) {
+    value.ToBytes(element_bytes.subspan(0, FieldElementT::SizeInBytes()));
+    element_bytes = element_bytes.subspan(FieldElementT::SizeInBytes());
+  }
+  return PeriodicColumnCache::MakeKey(description);
+}
+
 template <typename FieldElementT>
 FieldElementT PeriodicColumn<FieldElementT>::EvalAtPoint(const FieldElementT& x) const {
   std::vector<FieldElementT> points = {Pow(x, n_copies_)};
@@ -45,13 +77,79 @@ FieldElementT PeriodicColumn<FieldElementT>::EvalAtPoint(const FieldElementT& x)
 template <typename FieldElementT>
 auto PeriodicColumn<FieldElementT>::GetCoset(
     const FieldElementT& start_point, const size_t coset_size) const -> CosetEvaluation {
-  FieldElementT offset = Pow(start_point, n_copies_);
+  const FieldElementT offset = Pow(start_point, n_copies_);
   const uint64_t n_values = lde_manager_.GetDomain(FieldElement(offset))->Size();
   ASSERT_RELEASE(
       coset_size == n_copies_ * column_step_ * n_values,
       "Currently coset_size must be the same as the size of the coset that was used to "
       "create the PeriodicColumn.");
 
+  if (cache_key_.empty()) {
+    return CosetEvaluation(ComputeCoset(start_point));
+  }
+
+  PeriodicColumnCache& cache = PeriodicColumnCache::GetInstance();
+  constexpr size_t kElementSize = FieldElementT::SizeInBytes();
+  // The key of the coset is a hash of the key of the column and the start point.
+  std::vector<std::byte> description(cache_key_.size() + kElementSize);
+  std::transform(cache_key_.begin(), cache_key_.end(), description.begin(), [](char c) {
+    return static_cast<std::byte>(c);
+  });
+  start_point.ToBytes(gsl::make_span(description).subspan(cache_key_.size()));
+  const std::string key = PeriodicColumnCache::MakeKey(description);
+  using ValuesT = std::vector<FieldElementT>;
+  if (std::shared_ptr<const void> cached = cache.Find(key)) {
+    return CosetEvaluation(std::static_pointer_cast<const ValuesT>(cached));
+  }
+
+  const uint64_t size_in_bytes = period_in_trace_ * kElementSize;
+  TaskManager& task_manager = TaskManager::GetInstance();
+  const size_t min_work_size = 1024;
+  std::shared_ptr<const ValuesT> values;
+  std::optional<std::vector<std::byte>> file_bytes;
+  if (PeriodicColumnCache::OnDiskEnabled()) {
+    file_bytes = cache.ReadFile(key, size_in_bytes);
+  }
+  if (file_bytes.has_value()) {
+    ValuesT file_values = FieldElementT::UninitializedVector(period_in_trace_);
+    task_manager.ParallelFor(
+        period_in_trace_,
+        [&file_values, &file_bytes](const TaskInfo& task_info) {
+          for (size_t i = task_info.start_idx; i < task_info.end_idx; ++i) {
+            file_values[i] = FieldElementT::FromBytes(
+                gsl::make_span(*file_bytes).subspan(i * kElementSize, kElementSize));
+          }
+        },
+        period_in_trace_, min_work_size);
+    values = std::make_shared<const ValuesT>(std::move(file_values));
+  } else {
+    cache.RecordMiss();
+    values = std::make_shared<const ValuesT>(ComputeCoset(start_point));
+    if (PeriodicColumnCache::OnDiskEnabled()) {
+      std::vector<std::byte> bytes(size_in_bytes);
+      task_manager.ParallelFor(
+          period_in_trace_,
+          [&values, &bytes](const TaskInfo& task_info) {
+            for (size_t i = task_info.start_idx; i < task_info.end_idx; ++i) {
+              (*values)[i].ToBytes(gsl::make_span(bytes).subspan(i * kElementSize, kElementSize));
+            }
+          },
+          period_in_trace_, min_work_size);
+      cache.WriteFile(key, bytes);
+    }
+  }
+
+  if (PeriodicColumnCache::InMemoryEnabled()) {
+    cache.Insert(key, values, size_in_bytes);
+  }
+  return CosetEvaluation(std::move(values));
+}
+
+template <typename FieldElementT>
+std::vector<FieldElementT> PeriodicColumn<FieldElementT>::ComputeCoset(
+    const FieldElementT& start_point) const {
+  FieldElementT offset = Pow(start_point, n_copies_);
+  const uint64_t n_values = lde_manager_.GetDomain(FieldElement(offset))->Size();
   std::vector<FieldElementT> period_on_coset = FieldElementT::UninitializedVector(period_in_trace_);
 
   const size_t min_work_size = 1024;
@@ -76,7 +174,7 @@ auto PeriodicColumn<FieldElementT>::GetCoset(
       },
       column_step_, min_work_size / n_values);
 
-  return CosetEvaluation(std::move(period_on_coset));
+  return period_on_coset;
 }
 
 }  // namespace starkware
@@ -0,0 +1,155 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/composition_polynomial/periodic_column_cache.h"
+
+#include <unistd.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "glog/logging.h"
+
+#include "starkware/crypt_tools/blake2s.h"
+#include "starkware/utils/to_from_string.h"
+
+DEFINE_uint64(
+    periodic_column_cache_mb, 0,
+    "Optional. Size in megabytes of an in-memory cache of the evaluations of periodic columns on "
+    "cosets, shared by all the proofs of the process (e.g. with --serve).");
+
+DEFINE_string(
+    periodic_column_cache_dir, "",
+    "Optional. A directory in which the evaluations of periodic columns on cosets are stored, so "
+    "that proofs of the same layout and trace length do not recompute them.");
+
+namespace starkware {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string CacheFilePath(const std::string& key) {
+  return (fs::path(FLAGS_periodic_column_cache_dir) / (key + ".bin")).string();
+}
+
+}  // namespace
+
+PeriodicColumnCache& PeriodicColumnCache::GetInstance() {
+  static auto* instance = new PeriodicColumnCache();
+  return *instance;
+}
+
+std::string PeriodicColumnCache::MakeKey(gsl::span<const std::byte> description) {
+  const Blake2s256 digest = Blake2s256::HashBytesWithLength(description);
+  // Drop the "0x" prefix.
+  return BytesToHexString(digest.GetDigest(), /*trim_leading_zeros=*/false).substr(2);
+}
+
+std::shared_ptr<const void> PeriodicColumnCache::Find(const std::string& key) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  stats_.n_memory_hits++;
+  return it->second.first;
+}
+
+void PeriodicColumnCache::Insert(
+    const std::string& key, std::shared_ptr<const void> value, uint64_t size_in_bytes) {
+  const uint64_t max_size_in_bytes = FLAGS_periodic_column_cache_mb * 1024 * 1024;
+  if (size_in_bytes > max_size_in_bytes) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (entries_.count(key) != 0) {
+    return;
+  }
+  while (size_in_bytes_ + size_in_bytes > max_size_in_bytes) {
+    const auto oldest = entries_.find(insertion_order_.front());
+    size_in_bytes_ -= oldest->second.second;
+    entries_.erase(oldest);
+    insertion_order_.pop_front();
+  }
+  entries_.emplace(key, std::make_pair(std::move(value), size_in_bytes));
+  insertion_order_.push_back(key);
+  size_in_bytes_ += size_in_bytes;
+}
+
+std::optional<std::vector<std::byte>> PeriodicColumnCache::ReadFile(
+    const std::string& key, size_t expected_size) {
+  const std::string path = CacheFilePath(key);
+  std::error_code error;
+  if (fs::file_size(path, error) != expected_size || error) {
+    return std::nullopt;
+  }
+  std::vector<std::byte> bytes(expected_size);
+  std::ifstream file(path, std::ios::binary);
+  file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  if (!file) {
+    return std::nullopt;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  stats_.n_disk_hits++;
+  return bytes;
+}
+
+void PeriodicColumnCache::WriteFile(const std::string& key, gsl::span<const std::byte> bytes) {
+  const std::string path = CacheFilePath(key);
+  // A name unique to this writer, renamed over the final name when complete.
+  std::stringstream temp_path;
+  temp_path << path << ".tmp." << getpid() << "." << std::this_thread::get_id();
+
+  std::error_code error;
+  fs::create_directories(FLAGS_periodic_column_cache_dir, error);
+  {
+    std::ofstream file(temp_path.str(), std::ios::binary | std::ios::trunc);
+    file.write(
+        reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+      LOG(ERROR) << "Failed to write the periodic column cache file " << temp_path.str();
+      fs::remove(temp_path.str(), error);
+      return;
+    }
+  }
+  fs::rename(temp_path.str(), path, error);
+  if (error) {
+    LOG(ERROR) << "Failed to rename " << temp_path.str() << " to " << path << ": "
+               << error.message();
+    fs::remove(temp_path.str(), error);
+  }
+}
+
+void PeriodicColumnCache::RecordMiss() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  stats_.n_misses++;
+}
+
+PeriodicColumnCache::Stats PeriodicColumnCache::GetStats() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void PeriodicColumnCache::Clear() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  entries_.clear();
+  insertion_order_.clear();
+  size_in_bytes_ = 0;
+  stats_ = {};
+}
+
+}  // namespace starkware
@@ -0,0 +1,123 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#ifndef STARKWARE_COMPOSITION_POLYNOMIAL_PERIODIC_COLUMN_CACHE_H_
+#define STARKWARE_COMPOSITION_POLYNOMIAL_PERIODIC_COLUMN_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "third_party/gsl/gsl-lite.hpp"
+
+DECLARE_uint64(periodic_column_cache_mb);
+DECLARE_string(periodic_column_cache_dir);
+
+namespace starkware {
+
+/*
+  A process-wide cache of the evaluations of periodic columns on cosets (see
+  PeriodicColumn::GetCoset()). An evaluation depends only on the column (that is, on the layout and
+  the trace length) and on the coset offset, so it is the same in every proof of the same layout
+  and size.
+
+  The cache has two levels, both disabled by default:
+    * In memory, up to --periodic_column_cache_mb megabytes. When full, the oldest evaluations are
+      evicted. Useful when a process proves many statements (--serve).
+    * On disk, in --periodic_column_cache_dir, one file per evaluation named after its key. Useful
+      across processes.
+
+  Entries are type-erased: the value is a std::vector of field elements whose type is part of the
+  key. The key is a hash of a description of the evaluation, see MakeKey().
+*/
+class PeriodicColumnCache {
+ public:
+  struct Stats {
+    uint64_t n_memory_hits = 0;
+    uint64_t n_disk_hits = 0;
+    uint64_t n_misses = 0;
+  };
+
+  PeriodicColumnCache(const PeriodicColumnCache&) = delete;
+  PeriodicColumnCache& operator=(const PeriodicColumnCache&) = delete;
+  PeriodicColumnCache(PeriodicColumnCache&&) = delete;
+  PeriodicColumnCache& operator=(PeriodicColumnCache&&) = delete;
+
+  static PeriodicColumnCache& GetInstance();
+
+  static bool InMemoryEnabled() { return FLAGS_periodic_column_cache_mb != 0; }
+  static bool OnDiskEnabled() { return !FLAGS_periodic_column_cache_dir.empty(); }
+  static bool Enabled() { return InMemoryEnabled() || OnDiskEnabled(); }
+
+  /*
+    Returns the key of the evaluation described by the given bytes.
+  */
+  static std::string MakeKey(gsl::span<const std::byte> description);
+
+  /*
+    Returns the in-memory entry of the given key, or nullptr.
+  */
+  std::shared_ptr<const void> Find(const std::string& key);
+
+  /*
+    Adds an entry to the in-memory cache, evicting old entries if needed. Entries larger than the
+    whole cache are not added.
+  */
+  void Insert(const std::string& key, std::shared_ptr<const void> value, uint64_t size_in_bytes);
+
+  /*
+    Returns the content of the file of the given key, or nullopt if there is no such file or its
+    size is not expected_size.
+  */
+  std::optional<std::vector<std::byte>> ReadFile(const std::string& key, size_t expected_size);
+
+  /*
+    Writes the file of the given key atomically, so that concurrent provers never read a partial
+    file. Failures are logged and otherwise ignored.
+  */
+  void WriteFile(const std::string& key, gsl::span<const std::byte> bytes);
+
+  /*
+    Records a miss in both levels. Hits are recorded by Find() and ReadFile().
+  */
+  void RecordMiss();
+
+  Stats GetStats();
+
+  /*
+    Drops the in-memory entries and the statistics.
+  */
+  void Clear();
+
+ private:
+  PeriodicColumnCache() = default;
+
+  std::mutex mutex_;
+  std::map<std::string, std::pair<std::shared_ptr<const void>, uint64_t>> entries_;
+  // The keys of entries_ in the order of insertion.
+  std::deque<std::string> insertion_order_;
+  uint64_t size_in_bytes_ = 0;
+  Stats stats_;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_COMPOSITION_POLYNOMIAL_PERIODIC_COLUMN_CACHE_H_
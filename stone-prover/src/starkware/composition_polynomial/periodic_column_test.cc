@@ -14,6 +14,8 @@
 
 #include "starkware/composition_polynomial/periodic_column.h"
 
+#include <filesystem>
+#include <string>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -115,5 +117,97 @@ TEST(PeriodicColumn, InvalidCosetSize) {
   EXPECT_ASSERT(TestPeriodicColumn(3, 12, 1, &prng), HasSubstr("must be a power of 2"));
 }
 
+/*
+  Returns the values of the given coset evaluation.
+*/
+std::vector<FieldElementT> CosetValues(
+    const PeriodicColumn<FieldElementT>::CosetEvaluation& coset, size_t coset_size) {
+  std::vector<FieldElementT> values;
+  auto it = coset.begin();
+  for (size_t i = 0; i < coset_size; ++i, ++it) {
+    values.push_back(*it);
+  }
+  return values;
+}
+
+class PeriodicColumnCacheTest : public ::testing::Test {
+ public:
+  PeriodicColumnCacheTest()
+      : group_generator(GetSubGroupGenerator<FieldElementT>(kCosetSize)),
+        values(prng.RandomFieldElementVector<FieldElementT>(kNValues)),
+        start_point(FieldElementT::RandomElement(&prng)) {
+    PeriodicColumnCache::GetInstance().Clear();
+  }
+
+  ~PeriodicColumnCacheTest() override {
+    FLAGS_periodic_column_cache_mb = 0;
+    FLAGS_periodic_column_cache_dir = "";
+    PeriodicColumnCache::GetInstance().Clear();
+  }
+
+  PeriodicColumn<FieldElementT> MakeColumn() const {
+    return PeriodicColumn<FieldElementT>(
+        values, group_generator, FieldElementT::One(), kCosetSize, kColumnStep);
+  }
+
+  static constexpr size_t kNValues = 16;
+  static constexpr size_t kCosetSize = 256;
+  static constexpr size_t kColumnStep = 4;
+
+  Prng prng;
+  const FieldElementT group_generator;
+  const std::vector<FieldElementT> values;
+  const FieldElementT start_point;
+};
+
+TEST_F(PeriodicColumnCacheTest, InMemory) {
+  const std::vector<FieldElementT> expected =
+      CosetValues(MakeColumn().GetCoset(start_point, kCosetSize), kCosetSize);
+
+  FLAGS_periodic_column_cache_mb = 1;
+  PeriodicColumnCache& cache = PeriodicColumnCache::GetInstance();
+  EXPECT_EQ(CosetValues(MakeColumn().GetCoset(start_point, kCosetSize), kCosetSize), expected);
+  EXPECT_EQ(cache.GetStats().n_misses, 1U);
+
+  // Another column with the same values (e.g. in the next proof) hits the cache.
+  EXPECT_EQ(CosetValues(MakeColumn().GetCoset(start_point, kCosetSize), kCosetSize), expected);
+  EXPECT_EQ(cache.GetStats().n_memory_hits, 1U);
+
+  // Another coset does not.
+  const FieldElementT other_start_point = start_point * group_generator;
+  MakeColumn().GetCoset(other_start_point, kCosetSize);
+  EXPECT_EQ(cache.GetStats().n_misses, 2U);
+
+  // Nor does a column with other values.
+  PeriodicColumn<FieldElementT> other_column(
+      prng.RandomFieldElementVector<FieldElementT>(kNValues), group_generator,
+      FieldElementT::One(), kCosetSize, kColumnStep);
+  other_column.GetCoset(start_point, kCosetSize);
+  EXPECT_EQ(cache.GetStats().n_misses, 3U);
+  EXPECT_EQ(cache.GetStats().n_memory_hits, 1U);
+}
+
+TEST_F(PeriodicColumnCacheTest, OnDisk) {
+  const std::string cache_dir = ::testing::TempDir() + "/periodic_column_cache_test";
+  std::filesystem::remove_all(cache_dir);
+  FLAGS_periodic_column_cache_dir = cache_dir;
+  PeriodicColumnCache& cache = PeriodicColumnCache::GetInstance();
+
+  const std::vector<FieldElementT> expected =
+      CosetValues(MakeColumn().GetCoset(start_point, kCosetSize), kCosetSize);
+  EXPECT_EQ(cache.GetStats().n_misses, 1U);
+  EXPECT_EQ(CosetValues(MakeColumn().GetCoset(start_point, kCosetSize), kCosetSize), expected);
+  EXPECT_EQ(cache.GetStats().n_disk_hits, 1U);
+  EXPECT_EQ(cache.GetStats().n_misses, 1U);
+
+  // A file of the wrong size is ignored.
+  for (const auto& entry : std::filesystem::directory_iterator(cache_dir)) {
+    std::filesystem::resize_file(entry.path(), 5);
+  }
+  EXPECT_EQ(CosetValues(MakeColumn().GetCoset(start_point, kCosetSize), kCosetSize), expected);
+  EXPECT_EQ(cache.GetStats().n_misses, 2U);
+  std::filesystem::remove_all(cache_dir);
+}
+
 }  // namespace
 }  // namespace starkware
@@ -0,0 +1,112 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+
+#ifndef STARKWARE_CRYPT_TOOLS_HASH_CONTEXT_PEDERSEN_HASH_ENGINE_H_
+#define STARKWARE_CRYPT_TOOLS_HASH_CONTEXT_PEDERSEN_HASH_ENGINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "third_party/gsl/gsl-lite.hpp"
+
+#include "starkware/algebra/elliptic_curve/elliptic_curve.h"
+#include "starkware/algebra/fields/prime_field_element.h"
+#include "starkware/crypt_tools/hash_context/pedersen_hash_context.h"
+
+namespace starkware {
+
+/*
+  Computes the same hashes as PedersenHashContext::Hash(), faster.
+
+  Instead of adding one constant point per input bit, the input bits are split into windows of
+  window_bits bits, and for every window the sums of all the subsets of its points are precomputed.
+  A hash then adds one table point per nonzero window (63 per 252-bit input with 4-bit windows,
+  instead of up to 252).
+
+  Hash() accumulates the sum in projective coordinates, so it computes a single inverse.
+  HashBatch() computes many hashes in lockstep in affine coordinates: in every step, the
+  denominators of the slopes of all the hashes are inverted together (Montgomery's trick), so the
+  cost of an inverse is shared by the whole batch. Batches smaller than kMinBatchSize use Hash().
+
+  If an addition hits two points with the same x coordinate, or an input is too large, the hash is
+  recomputed by PedersenHashContext::Hash(), so that the results and the errors are the same.
+*/
+template <typename FieldElementT>
+class PedersenHashEngine {
+ public:
+  static constexpr size_t kDefaultWindowBits = 4;
+  // The number of hashes computed in lockstep by every task of HashBatch().
+  static constexpr size_t kBatchSize = 256;
+  // Below this number of hashes, an inverse per window costs more than the projective coordinates
+  // of Hash(), and HashBatch() computes each hash with Hash() (see
+  // pedersen_hash_engine_benchmark.cc).
+  static constexpr size_t kMinBatchSize = 8;
+
+  explicit PedersenHashEngine(
+      const PedersenHashContext<FieldElementT>& hash_ctx, size_t window_bits = kDefaultWindowBits);
+
+  /*
+    Returns the hash of the given inputs.
+  */
+  FieldElementT Hash(gsl::span<const FieldElementT> hash_inputs) const;
+
+  /*
+    Computes outputs.size() hashes, the inputs of the i-th hash being
+    hash_inputs[i * n_inputs, (i + 1) * n_inputs).
+  */
+  void HashBatch(
+      gsl::span<const FieldElementT> hash_inputs, gsl::span<FieldElementT> outputs) const;
+
+  const PedersenHashContext<FieldElementT>& GetHashContext() const { return hash_ctx_; }
+
+ private:
+  /*
+    Writes the window digits of the given inputs to digits, n_windows_per_input_ per input. Returns
+    false if one of the inputs has more than n_element_bits bits.
+  */
+  bool GetDigits(gsl::span<const FieldElementT> hash_inputs, gsl::span<uint8_t> digits) const;
+
+  /*
+    Returns the sum of the points of the given window selected by the bits of digit.
+  */
+  const EcPoint<FieldElementT>& TableEntry(size_t window, size_t digit) const {
+    return table_[(window << window_bits_) + digit];
+  }
+
+  /*
+    Computes the hashes of a single task of HashBatch().
+  */
+  void HashChunk(
+      gsl::span<const FieldElementT> hash_inputs, gsl::span<FieldElementT> outputs) const;
+
+  const PedersenHashContext<FieldElementT> hash_ctx_;
+  const size_t window_bits_;
+  const size_t n_windows_per_input_;
+  // The total number of windows of all the inputs.
+  const size_t n_windows_;
+  std::vector<EcPoint<FieldElementT>> table_;
+};
+
+/*
+  Returns the PedersenHashEngine of GetStandardPedersenHashContext().
+*/
+const PedersenHashEngine<PrimeFieldElement<252, 0>>& GetStandardPedersenHashEngine();
+
+}  // namespace starkware
+
+#include "starkware/crypt_tools/hash_context/pedersen_hash_engine.inl"
+
+#endif  // STARKWARE_CRYPT_TOOLS_HASH_CONTEXT_PEDERSEN_HASH_ENGINE_H_
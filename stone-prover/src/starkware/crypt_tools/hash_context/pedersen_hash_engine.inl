@@ -0,0 +1,211 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+
+#include <algorithm>
+
+#include "starkware/algebra/field_operations.h"
+#include "starkware/error_handling/error_handling.h"
+#include "starkware/math/math.h"
+#include "starkware/utils/task_manager.h"
+
+namespace starkware {
+
+template <typename FieldElementT>
+PedersenHashEngine<FieldElementT>::PedersenHashEngine(
+    const PedersenHashContext<FieldElementT>& hash_ctx, size_t window_bits)
+    : hash_ctx_(hash_ctx),
+      window_bits_(window_bits),
+      n_windows_per_input_(DivCeil(hash_ctx.n_element_bits, window_bits)),
+      n_windows_(hash_ctx.n_inputs * n_windows_per_input_) {
+  // A window never crosses a limb of the standard form of the input.
+  ASSERT_RELEASE(
+      window_bits_ > 0 && window_bits_ <= 8 && 64 % window_bits_ == 0,
+      "window_bits must be 1, 2, 4 or 8.");
+  ASSERT_RELEASE(
+      hash_ctx_.points.size() == hash_ctx_.n_element_bits * hash_ctx_.n_inputs,
+      "Wrong number of points.");
+
+  const size_t window_size = Pow2(window_bits_);
+  table_.reserve(n_windows_ * window_size);
+  for (size_t input = 0; input < hash_ctx_.n_inputs; ++input) {
+    for (size_t window = 0; window < n_windows_per_input_; ++window) {
+      const size_t first_bit = window * window_bits_;
+      const size_t n_bits = std::min(window_bits_, hash_ctx_.n_element_bits - first_bit);
+      const auto points = gsl::make_span(hash_ctx_.points)
+                              .subspan(input * hash_ctx_.n_element_bits + first_bit, n_bits);
+      const size_t window_start = table_.size();
+      for (size_t digit = 0; digit < window_size; ++digit) {
+        if (digit == 0 || digit >= Pow2(n_bits)) {
+          // Never used. Digits of the last window beyond n_element_bits are rejected by
+          // GetDigits().
+          table_.push_back(hash_ctx_.shift_point);
+          continue;
+        }
+        // Add the point of the lowest bit of digit to the entry of the rest of its bits.
+        const size_t lowest_bit = Log2Floor(digit & -digit);
+        const size_t rest = digit & (digit - 1);
+        table_.push_back(
+            rest == 0 ? points[lowest_bit] : table_[window_start + rest] + points[lowest_bit]);
+      }
+    }
+  }
+}
+
+template <typename FieldElementT>
+bool PedersenHashEngine<FieldElementT>::GetDigits(
+    gsl::span<const FieldElementT> hash_inputs, gsl::span<uint8_t> digits) const {
+  const uint64_t mask = Pow2(window_bits_) - 1;
+  for (size_t input = 0; input < hash_inputs.size(); ++input) {
+    const auto value = hash_inputs[input].ToStandardForm();
+    if (value != value.Zero() && value.Log2Floor() >= hash_ctx_.n_element_bits) {
+      return false;
+    }
+    for (size_t window = 0; window < n_windows_per_input_; ++window) {
+      const size_t bit = window * window_bits_;
+      digits[input * n_windows_per_input_ + window] =
+          static_cast<uint8_t>((value[bit / 64] >> (bit % 64)) & mask);
+    }
+  }
+  return true;
+}
+
+template <typename FieldElementT>
+FieldElementT PedersenHashEngine<FieldElementT>::Hash(
+    gsl::span<const FieldElementT> hash_inputs) const {
+  ASSERT_RELEASE(hash_inputs.size() == hash_ctx_.n_inputs, "Wrong number of inputs.");
+  std::vector<uint8_t> digits(n_windows_);
+  if (!GetDigits(hash_inputs, digits)) {
+    return hash_ctx_.Hash(hash_inputs);
+  }
+
+  // The sum in projective coordinates: (x, y) = (x_proj / z, y_proj / z).
+  FieldElementT x_proj = hash_ctx_.shift_point.x;
+  FieldElementT y_proj = hash_ctx_.shift_point.y;
+  FieldElementT z = FieldElementT::One();
+  for (size_t window = 0; window < n_windows_; ++window) {
+    if (digits[window] == 0) {
+      continue;
+    }
+    const EcPoint<FieldElementT>& point = TableEntry(window, digits[window]);
+    // Mixed addition of an affine point to a projective point (9 multiplications and 2 squarings).
+    const FieldElementT u = point.y * z - y_proj;
+    const FieldElementT v = point.x * z - x_proj;
+    if (v == FieldElementT::Zero()) {
+      return hash_ctx_.Hash(hash_inputs);
+    }
+    const FieldElementT v_squared = v * v;
+    const FieldElementT v_cubed = v * v_squared;
+    const FieldElementT r = v_squared * x_proj;
+    const FieldElementT a = u * u * z - v_cubed - (r + r);
+    x_proj = v * a;
+    y_proj = u * (r - a) - v_cubed * y_proj;
+    z = v_cubed * z;
+  }
+  return x_proj * z.Inverse();
+}
+
+template <typename FieldElementT>
+void PedersenHashEngine<FieldElementT>::HashBatch(
+    gsl::span<const FieldElementT> hash_inputs, gsl::span<FieldElementT> outputs) const {
+  ASSERT_RELEASE(
+      hash_inputs.size() == outputs.size() * hash_ctx_.n_inputs, "Wrong number of inputs.");
+  const size_t n_chunks = DivCeil(outputs.size(), kBatchSize);
+  if (n_chunks == 0) {
+    return;
+  }
+  TaskManager::GetInstance().ParallelFor(n_chunks, [&](const TaskInfo& task_info) {
+    const size_t begin = task_info.start_idx * kBatchSize;
+    const size_t size = std::min(kBatchSize, outputs.size() - begin);
+    HashChunk(
+        hash_inputs.subspan(begin * hash_ctx_.n_inputs, size * hash_ctx_.n_inputs),
+        outputs.subspan(begin, size));
+  });
+}
+
+template <typename FieldElementT>
+void PedersenHashEngine<FieldElementT>::HashChunk(
+    gsl::span<const FieldElementT> hash_inputs, gsl::span<FieldElementT> outputs) const {
+  const size_t n_hashes = outputs.size();
+  const size_t n_inputs = hash_ctx_.n_inputs;
+  if (n_hashes < kMinBatchSize) {
+    for (size_t i = 0; i < n_hashes; ++i) {
+      outputs[i] = Hash(hash_inputs.subspan(i * n_inputs, n_inputs));
+    }
+    return;
+  }
+
+  // Hashes that are computed by hash_ctx_ instead, see the class documentation.
+  std::vector<bool> use_hash_ctx(n_hashes, false);
+  std::vector<uint8_t> digits(n_hashes * n_windows_);
+  for (size_t i = 0; i < n_hashes; ++i) {
+    use_hash_ctx[i] = !GetDigits(
+        hash_inputs.subspan(i * n_inputs, n_inputs),
+        gsl::make_span(digits).subspan(i * n_windows_, n_windows_));
+  }
+
+  std::vector<FieldElementT> x(n_hashes, hash_ctx_.shift_point.x);
+  std::vector<FieldElementT> y(n_hashes, hash_ctx_.shift_point.y);
+
+  // The hashes that add a point in the current window, their points and their slope denominators.
+  std::vector<size_t> active;
+  std::vector<const EcPoint<FieldElementT>*> active_points;
+  std::vector<FieldElementT> denominators;
+  active.reserve(n_hashes);
+  active_points.reserve(n_hashes);
+  denominators.reserve(n_hashes);
+  std::vector<FieldElementT> inverses = FieldElementT::UninitializedVector(n_hashes);
+
+  for (size_t window = 0; window < n_windows_; ++window) {
+    active.clear();
+    active_points.clear();
+    denominators.clear();
+    for (size_t i = 0; i < n_hashes; ++i) {
+      const uint8_t digit = digits[i * n_windows_ + window];
+      if (use_hash_ctx[i] || digit == 0) {
+        continue;
+      }
+      const EcPoint<FieldElementT>& point = TableEntry(window, digit);
+      const FieldElementT denominator = point.x - x[i];
+      if (denominator == FieldElementT::Zero()) {
+        use_hash_ctx[i] = true;
+        continue;
+      }
+      active.push_back(i);
+      active_points.push_back(&point);
+      denominators.push_back(denominator);
+    }
+    if (active.empty()) {
+      continue;
+    }
+
+    const auto active_inverses = gsl::make_span(inverses).subspan(0, active.size());
+    BatchInverse<FieldElementT>(denominators, active_inverses);
+    for (size_t j = 0; j < active.size(); ++j) {
+      const size_t i = active[j];
+      const EcPoint<FieldElementT>& point = *active_points[j];
+      const FieldElementT slope = (point.y - y[i]) * active_inverses[j];
+      const FieldElementT new_x = slope * slope - x[i] - point.x;
+      y[i] = slope * (x[i] - new_x) - y[i];
+      x[i] = new_x;
+    }
+  }
+
+  for (size_t i = 0; i < n_hashes; ++i) {
+    outputs[i] = use_hash_ctx[i] ? hash_ctx_.Hash(hash_inputs.subspan(i * n_inputs, n_inputs))
+                                 : x[i];
+  }
+}
+
+}  // namespace starkware
@@ -0,0 +1,94 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+/*
+  Measures the throughput of the Pedersen hash: PedersenHashContext::Hash(),
+  PedersenHashEngine::Hash() and PedersenHashEngine::HashBatch() with batches of several sizes.
+*/
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+
+#include "starkware/crypt_tools/hash_context/pedersen_hash_engine.h"
+#include "starkware/randomness/prng.h"
+
+DEFINE_uint64(n_hashes, 4096, "The number of hashes computed by each measurement.");
+
+namespace starkware {
+namespace {
+
+using FieldElementT = PrimeFieldElement<252, 0>;
+
+/*
+  Runs func, which computes FLAGS_n_hashes hashes, and prints the number of hashes per second.
+*/
+template <typename Func>
+void Measure(const std::string& name, const Func& func) {
+  const auto start = std::chrono::steady_clock::now();
+  func();
+  const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+  std::cout << std::left << std::setw(40) << name << std::right << std::setw(12)
+            << static_cast<uint64_t>(FLAGS_n_hashes / duration.count()) << " hashes/sec"
+            << std::endl;
+}
+
+void Run() {
+  Prng prng;
+  const PedersenHashEngine<FieldElementT>& engine = GetStandardPedersenHashEngine();
+  const PedersenHashContext<FieldElementT>& hash_ctx = engine.GetHashContext();
+  const size_t n_inputs = hash_ctx.n_inputs;
+  const std::vector<FieldElementT> inputs =
+      prng.RandomFieldElementVector<FieldElementT>(FLAGS_n_hashes * n_inputs);
+  std::vector<FieldElementT> outputs = FieldElementT::UninitializedVector(FLAGS_n_hashes);
+  const auto hash_inputs = [&](size_t i) {
+    return gsl::make_span(inputs).subspan(i * n_inputs, n_inputs);
+  };
+
+  Measure("PedersenHashContext::Hash", [&]() {
+    for (size_t i = 0; i < FLAGS_n_hashes; ++i) {
+      outputs[i] = hash_ctx.Hash(hash_inputs(i));
+    }
+  });
+  Measure("PedersenHashEngine::Hash", [&]() {
+    for (size_t i = 0; i < FLAGS_n_hashes; ++i) {
+      outputs[i] = engine.Hash(hash_inputs(i));
+    }
+  });
+  for (const size_t batch_size : {1, 2, 4, 8, 16, 32, 64, 256, 4096}) {
+    Measure("PedersenHashEngine::HashBatch (" + std::to_string(batch_size) + ")", [&]() {
+      for (size_t begin = 0; begin < FLAGS_n_hashes; begin += batch_size) {
+        const size_t size = std::min<size_t>(batch_size, FLAGS_n_hashes - begin);
+        engine.HashBatch(
+            gsl::make_span(inputs).subspan(begin * n_inputs, size * n_inputs),
+            gsl::make_span(outputs).subspan(begin, size));
+      }
+    });
+  }
+}
+
+}  // namespace
+}  // namespace starkware
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);  // NOLINT
+  starkware::Run();
+  return 0;
+}
@@ -0,0 +1,131 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+
+#include "starkware/crypt_tools/hash_context/pedersen_hash_engine.h"
+
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/error_handling/test_utils.h"
+#include "starkware/randomness/prng.h"
+
+namespace starkware {
+namespace {
+
+using FieldElementT = PrimeFieldElement<252, 0>;
+using testing::HasSubstr;
+
+/*
+  Checks Hash() and HashBatch() against PedersenHashContext::Hash() on the given inputs.
+*/
+void TestEngine(
+    const PedersenHashEngine<FieldElementT>& engine, const std::vector<FieldElementT>& inputs) {
+  const PedersenHashContext<FieldElementT>& hash_ctx = engine.GetHashContext();
+  const size_t n_hashes = inputs.size() / hash_ctx.n_inputs;
+  std::vector<FieldElementT> expected;
+  for (size_t i = 0; i < n_hashes; ++i) {
+    const auto hash_inputs =
+        gsl::make_span(inputs).subspan(i * hash_ctx.n_inputs, hash_ctx.n_inputs);
+    expected.push_back(hash_ctx.Hash(hash_inputs));
+    EXPECT_EQ(engine.Hash(hash_inputs), expected.back());
+  }
+
+  std::vector<FieldElementT> outputs = FieldElementT::UninitializedVector(n_hashes);
+  engine.HashBatch(inputs, outputs);
+  EXPECT_EQ(outputs, expected);
+}
+
+/*
+  A context with 3 inputs of 10 bits, so that the last window of every input is partial.
+*/
+PedersenHashContext<FieldElementT> SmallHashContext() {
+  return PedersenHashContext<FieldElementT>(
+      /*n_element_bits=*/10, /*ec_subset_sum_height=*/16, /*n_inputs=*/3,
+      /*shift_point=*/kPrimeFieldEc0.k_points[0],
+      /*points=*/{kPrimeFieldEc0.k_points.begin() + 2, kPrimeFieldEc0.k_points.begin() + 32});
+}
+
+TEST(PedersenHashEngine, StandardHash) {
+  Prng prng;
+  const PedersenHashEngine<FieldElementT>& engine = GetStandardPedersenHashEngine();
+
+  // More than one batch, the last one partial. Includes the smallest and largest inputs.
+  std::vector<FieldElementT> inputs = prng.RandomFieldElementVector<FieldElementT>(
+      2 * (PedersenHashEngine<FieldElementT>::kBatchSize + 10));
+  inputs[0] = FieldElementT::Zero();
+  inputs[1] = FieldElementT::Zero();
+  inputs[2] = -FieldElementT::One();
+  inputs[3] = -FieldElementT::One();
+  TestEngine(engine, inputs);
+
+  // Known answer, from pedersen_test.
+  EXPECT_EQ(
+      engine.Hash(std::vector<FieldElementT>{FieldElementT::Zero(), FieldElementT::Zero()}),
+      FieldElementT::FromBigInt(
+          0x49ee3eba8c1600700ee1b87eb599f16716b0b1022947733551fde4050ca6804_Z));
+}
+
+TEST(PedersenHashEngine, WindowSizes) {
+  Prng prng;
+  const std::vector<FieldElementT> inputs = prng.RandomFieldElementVector<FieldElementT>(20);
+  for (const size_t window_bits : {1, 2, 8}) {
+    TestEngine(
+        PedersenHashEngine<FieldElementT>(GetStandardPedersenHashContext(), window_bits), inputs);
+  }
+  EXPECT_ASSERT(
+      PedersenHashEngine<FieldElementT>(GetStandardPedersenHashContext(), 3),
+      HasSubstr("window_bits"));
+}
+
+TEST(PedersenHashEngine, PartialWindows) {
+  Prng prng;
+  const PedersenHashEngine<FieldElementT> engine(SmallHashContext());
+  std::vector<FieldElementT> inputs;
+  for (size_t i = 0; i < 3 * 50; ++i) {
+    inputs.push_back(FieldElementT::FromUint(prng.UniformInt<uint64_t>(0, Pow2(10) - 1)));
+  }
+  TestEngine(engine, inputs);
+}
+
+TEST(PedersenHashEngine, InputTooLarge) {
+  const PedersenHashEngine<FieldElementT> engine(SmallHashContext());
+  const std::vector<FieldElementT> inputs = {
+      FieldElementT::One(), FieldElementT::FromUint(Pow2(10)), FieldElementT::One()};
+  EXPECT_ASSERT(engine.Hash(inputs), HasSubstr("Given selector is too big"));
+  std::vector<FieldElementT> outputs = FieldElementT::UninitializedVector(1);
+  EXPECT_ASSERT(engine.HashBatch(inputs, outputs), HasSubstr("Given selector is too big"));
+
+  // A batch large enough to be computed in lockstep.
+  const size_t n_hashes = PedersenHashEngine<FieldElementT>::kMinBatchSize;
+  std::vector<FieldElementT> batch_inputs(3 * n_hashes, FieldElementT::One());
+  batch_inputs[3 * n_hashes - 2] = FieldElementT::FromUint(Pow2(10));
+  std::vector<FieldElementT> batch_outputs = FieldElementT::UninitializedVector(n_hashes);
+  EXPECT_ASSERT(
+      engine.HashBatch(batch_inputs, batch_outputs), HasSubstr("Given selector is too big"));
+}
+
+TEST(PedersenHashEngine, SmallBatches) {
+  Prng prng;
+  const PedersenHashEngine<FieldElementT>& engine = GetStandardPedersenHashEngine();
+  for (size_t n_hashes = 0; n_hashes <= PedersenHashEngine<FieldElementT>::kMinBatchSize;
+       ++n_hashes) {
+    TestEngine(engine, prng.RandomFieldElementVector<FieldElementT>(2 * n_hashes));
+  }
+}
+
+}  // namespace
+}  // namespace starkware
@@ -20,6 +20,7 @@
 #include <cstring>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "starkware/algebra/fields/prime_field_element.h"
 
@@ -43,6 +44,12 @@ class Pedersen {
 
   static Pedersen Hash(const Pedersen& val0, const Pedersen& val1);
 
+  /*
+    Sets outputs[i] = Hash(inputs[2 * i], inputs[2 * i + 1]), computing all the hashes at once (see
+    PedersenHashEngine::HashBatch()).
+  */
+  static void HashPairs(gsl::span<const Pedersen> inputs, gsl::span<Pedersen> outputs);
+
   static Pedersen HashBytesWithLength(gsl::span<const std::byte> bytes);
 
   static Pedersen HashBytesWithLength(
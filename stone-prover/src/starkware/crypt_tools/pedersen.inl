@@ -14,7 +14,7 @@
 
 #include "starkware/crypt_tools/pedersen.h"
 
-#include "starkware/crypt_tools/hash_context/pedersen_hash_context.h"
+#include "starkware/crypt_tools/hash_context/pedersen_hash_engine.h"
 #include "starkware/crypt_tools/utils.h"
 #include "starkware/error_handling/error_handling.h"
 #include "starkware/stl_utils/containers.h"
@@ -27,12 +27,26 @@ inline Pedersen Pedersen::InitDigestTo(const gsl::span<const std::byte>& digest)
 }
 
 inline Pedersen Pedersen::Hash(const Pedersen& val0, const Pedersen& val1) {
-  const auto& ctx = GetStandardPedersenHashContext();
+  const auto& engine = GetStandardPedersenHashEngine();
 
-  const auto res = ctx.Hash(val0.state_, val1.state_);
+  const auto res = engine.Hash(std::array<FieldElementT, 2>{val0.state_, val1.state_});
   return Pedersen(res);
 }
 
+inline void Pedersen::HashPairs(gsl::span<const Pedersen> inputs, gsl::span<Pedersen> outputs) {
+  ASSERT_RELEASE(inputs.size() == 2 * outputs.size(), "Wrong number of inputs.");
+  std::vector<FieldElementT> input_states;
+  input_states.reserve(inputs.size());
+  for (const Pedersen& input : inputs) {
+    input_states.push_back(input.state_);
+  }
+  std::vector<FieldElementT> output_states = FieldElementT::UninitializedVector(outputs.size());
+  GetStandardPedersenHashEngine().HashBatch(input_states, output_states);
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    outputs[i] = Pedersen(output_states[i]);
+  }
+}
+
 inline Pedersen Pedersen::HashBytesWithLength(gsl::span<const std::byte> bytes) {
   return Pedersen::HashBytesWithLength(bytes, Pedersen(FieldElementT::Zero()));
 }
@@ -40,7 +54,7 @@ inline Pedersen Pedersen::HashBytesWithLength(gsl::span<const std::byte> bytes)
 inline Pedersen Pedersen::HashBytesWithLength(
     gsl::span<const std::byte> bytes, const Pedersen& initial_hash) {
   FieldElementT state = initial_hash.state_;
-  const auto& ctx = GetStandardPedersenHashContext();
+  const auto& engine = GetStandardPedersenHashEngine();
   const auto modulus = FieldElementT::GetModulus();
 
   size_t bytes_to_hash = bytes.size();
@@ -53,13 +67,14 @@ inline Pedersen Pedersen::HashBytesWithLength(
     const FieldElementT value = FieldElementT::FromBigInt(r);
     ASSERT_RELEASE(q < ValueType(1000), "Unexpectedly large shift.");
     const FieldElementT shift = FieldElementT::FromBigInt(q);
-    state = ctx.Hash(state, value) + shift;
+    state = engine.Hash(std::array<FieldElementT, 2>{state, value}) + shift;
     offset += kDigestNumBytes;
     bytes_to_hash -= kDigestNumBytes;
   }
 
   ASSERT_RELEASE(bytes_to_hash == 0, "Pedersen hash currently does not support partial blocks.");
-  state = ctx.Hash(state, FieldElementT::FromUint(SafeDiv(bytes.size(), kDigestNumBytes)));
+  state = engine.Hash(std::array<FieldElementT, 2>{
+      state, FieldElementT::FromUint(SafeDiv(bytes.size(), kDigestNumBytes))});
 
   return Pedersen(state);
 }
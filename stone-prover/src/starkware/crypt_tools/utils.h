@@ -18,6 +18,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 #include "starkware/error_handling/error_handling.h"
 #include "third_party/gsl/gsl-lite.hpp"
@@ -36,6 +38,32 @@ inline std::array<std::byte, HashT::kDigestNumBytes> InitDigestFromSpan(
   return digest;
 }
 
+template <typename HashT, typename = void>
+struct HasHashPairs : std::false_type {};
+
+template <typename HashT>
+struct HasHashPairs<
+    HashT, std::void_t<decltype(HashT::HashPairs(
+               std::declval<gsl::span<const HashT>>(), std::declval<gsl::span<HashT>>()))>>
+    : std::true_type {};
+
+/*
+  Sets outputs[i] = HashT::Hash(inputs[2 * i], inputs[2 * i + 1]). Hashes that compute many pairs
+  faster together than one by one (e.g. Pedersen) implement a static HashPairs(), which is used
+  instead. inputs and outputs must not overlap.
+*/
+template <typename HashT>
+void HashPairs(gsl::span<const HashT> inputs, gsl::span<HashT> outputs) {
+  ASSERT_RELEASE(inputs.size() == 2 * outputs.size(), "Wrong number of inputs.");
+  if constexpr (HasHashPairs<HashT>::value) {
+    HashT::HashPairs(inputs, outputs);
+  } else {
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      outputs[i] = HashT::Hash(inputs[2 * i], inputs[2 * i + 1]);
+    }
+  }
+}
+
 }  // namespace starkware
 
 #endif  // STARKWARE_CRYPT_TOOLS_UTILS_H_
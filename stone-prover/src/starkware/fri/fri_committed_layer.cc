@@ -14,7 +14,7 @@
 
 #include "starkware/fri/fri_committed_layer.h"
 
-#include <set>
+#include <vector>
 
 #include "starkware/fri/fri_details.h"
 
@@ -54,19 +54,23 @@ FriCommittedLayerByTableProver::ElementsData FriCommittedLayerByTableProver::Eva
   ElementsData elements_data;
   auto& [elements_data_spans, elements_data_vectors] = elements_data;
 
-  size_t coset_size = Pow2(params_.fri_step_list[layer_num_]);
-  elements_data_vectors.reserve(coset_size);
-  elements_data_spans.reserve(coset_size);
+  const size_t coset_size = Pow2(params_.fri_step_list[layer_num_]);
+  const size_t n_rows = required_row_indices.size();
 
+  // Evaluate all the columns in a single call, column after column, and split the result.
+  std::vector<uint64_t> required_indices;
+  required_indices.reserve(coset_size * n_rows);
   for (uint64_t col = 0; col < coset_size; col++) {
-    std::vector<uint64_t> required_indices;
     for (uint64_t row : required_row_indices) {
       required_indices.push_back(row * coset_size + col);
     }
+  }
+  elements_data_vectors.push_back(fri_layer_->EvalAtPoints(required_indices));
 
-    FieldElementVector res = fri_layer_->EvalAtPoints(required_indices);
-    elements_data_vectors.push_back(std::move(res));
-    elements_data_spans.emplace_back(elements_data_vectors[col]);
+  const ConstFieldElementSpan all_columns = elements_data_vectors[0];
+  elements_data_spans.reserve(coset_size);
+  for (uint64_t col = 0; col < coset_size; col++) {
+    elements_data_spans.push_back(all_columns.SubSpan(col * n_rows, n_rows));
   }
   return elements_data;
 }
@@ -82,16 +86,24 @@ void FriCommittedLayerByTableProver::Commit() {
   table_prover_->Commit();
 }
 
-void FriCommittedLayerByTableProver::Decommit(const std::vector<uint64_t>& queries) {
-  std::set<RowCol> layer_data_queries, layer_integrity_queries;
+void FriCommittedLayerByTableProver::PrepareDecommitment(const std::vector<uint64_t>& queries) {
+  std::vector<RowCol> layer_data_queries, layer_integrity_queries;
   NextLayerDataAndIntegrityQueries(
       queries, params_, layer_num_, &layer_data_queries, &layer_integrity_queries);
   std::vector<uint64_t> required_row_indices =
       table_prover_->StartDecommitmentPhase(layer_data_queries, layer_integrity_queries);
 
-  ElementsData elements_data(EvalAtPoints(required_row_indices));
+  prepared_queries_ = queries;
+  prepared_elements_data_.emplace(EvalAtPoints(required_row_indices));
+}
+
+void FriCommittedLayerByTableProver::Decommit(const std::vector<uint64_t>& queries) {
+  if (!prepared_elements_data_.has_value() || prepared_queries_ != queries) {
+    PrepareDecommitment(queries);
+  }
 
-  table_prover_->Decommit(elements_data.elements);
+  table_prover_->Decommit(prepared_elements_data_->elements);
+  prepared_elements_data_.reset();
 }
 
 }  // namespace starkware
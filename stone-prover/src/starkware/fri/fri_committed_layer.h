@@ -16,6 +16,7 @@
 #define STARKWARE_FRI_FRI_COMMITTED_LAYER_H_
 
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -34,6 +35,14 @@ class FriCommittedLayer {
  public:
   explicit FriCommittedLayer(size_t fri_step) : fri_step_(fri_step) {}
   virtual ~FriCommittedLayer() = default;
+
+  /*
+    Computes the data that Decommit() needs for the given queries, without using the channel. It
+    may be called concurrently for different layers. Calling it is optional, Decommit() computes
+    the data itself if it was not prepared for the same queries.
+  */
+  virtual void PrepareDecommitment(const std::vector<uint64_t>& /*queries*/) {}
+
   virtual void Decommit(const std::vector<uint64_t>& queries) = 0;
 
  protected:
@@ -68,6 +77,8 @@ class FriCommittedLayerByTableProver : public FriCommittedLayer {
       const TableProverFactory& table_prover_factory, const FriParameters& params,
       size_t layer_num);
 
+  void PrepareDecommitment(const std::vector<uint64_t>& queries) override;
+
   void Decommit(const std::vector<uint64_t>& queries) override;
 
  private:
@@ -83,6 +94,11 @@ class FriCommittedLayerByTableProver : public FriCommittedLayer {
   const FriParameters& params_;
   const size_t layer_num_;
   std::unique_ptr<TableProver> table_prover_;
+
+  // The queries passed to PrepareDecommitment() and the data it computed for them. Consumed by
+  // Decommit().
+  std::vector<uint64_t> prepared_queries_;
+  std::optional<ElementsData> prepared_elements_data_;
 };
 
 }  // namespace starkware
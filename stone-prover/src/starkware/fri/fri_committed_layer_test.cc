@@ -18,7 +18,9 @@
 #include "gtest/gtest.h"
 #include "starkware/algebra/lde/lde.h"
 #include "starkware/channel/prover_channel_mock.h"
+#include "starkware/commitment_scheme/table_prover_mock.h"
 #include "starkware/crypt_tools/blake2s.h"
+#include "starkware/fri/fri_details.h"
 #include "starkware/fri/fri_folder.h"
 #include "starkware/fri/fri_parameters.h"
 #include "starkware/fri/fri_test_utils.h"
@@ -31,6 +33,9 @@ namespace {
 
 using testing::_;
 using testing::AtLeast;
+using testing::InSequence;
+using testing::Invoke;
+using testing::Return;
 
 using TestedFieldTypes = ::testing::Types<TestFieldElement>;
 using FieldElementT = TestFieldElement;
@@ -109,6 +114,115 @@ TYPED_TEST(FriCommittedLayerTest, FriCommittedLayerByTableProver) {
   committed_layer.Decommit(queries);
 }
 
+/*
+  Checks that Decommit() sends the data prepared by PrepareDecommitment() when the queries match,
+  and prepares the data again when they don't (or when nothing was prepared).
+*/
+TYPED_TEST(FriCommittedLayerTest, PrepareDecommitmentThenDecommit) {
+  Prng prng;
+  std::unique_ptr<details::FriFolderBase> folder(
+      details::FriFolderFromField(Field::Create<TypeParam>()));
+  const size_t log2_eval_domain = 10;
+  const size_t last_layer_degree_bound = 5;
+  const TypeParam offset(FftMultiplicativeGroup<TypeParam>::GroupUnit());
+  FftBasesDefaultImpl<TypeParam> bases = MakeFftBases(log2_eval_domain, offset);
+
+  FriParameters params(
+      {{2, 3, 1} /*fri_step_list=*/,
+       last_layer_degree_bound /*last_layer_degree_bound=*/,
+       2 /*n_queries=*/,
+       UseOwned(&bases) /*fft_bases=*/,
+       Field::Create<TypeParam>() /*field=*/,
+       15 /*proof_of_work_bits=*/});
+
+  details::TestPolynomial<TypeParam> test_layer(&prng, 64 * last_layer_degree_bound);
+  std::vector<TypeParam> eval_domain_data = test_layer.GetData(bases[0]);
+  std::vector<TypeParam> witness_data(
+      eval_domain_data.begin(), eval_domain_data.begin() + SafeDiv(Pow2(log2_eval_domain), 2));
+
+  FieldElement eval_point = FieldElement(TypeParam::RandomElement(&prng));
+  const FriProverConfig fri_prover_config{
+      FriProverConfig::kDefaultMaxNonChunkedLayerSize,
+      FriProverConfig::kDefaultNumberOfChunksBetweenLayers, FriProverConfig::kAllInMemoryLayers};
+
+  FriLayerOutOfMemory layer_0_out(FieldElementVector::CopyFrom(witness_data), UseOwned(&bases));
+  FriLayerProxy layer_1_proxy(*folder, UseOwned(&layer_0_out), eval_point, &fri_prover_config);
+  FriLayerInMemory layer_2_in(UseOwned(&layer_1_proxy));
+
+  const std::vector<uint64_t> queries{2, 4, 6};
+  const std::vector<uint64_t> other_queries{3, 100};
+  const auto expected_queries = [&](const std::vector<uint64_t>& queries) {
+    std::vector<RowCol> data_queries, integrity_queries;
+    details::NextLayerDataAndIntegrityQueries(
+        queries, params, 2, &data_queries, &integrity_queries);
+    return std::make_pair(data_queries, integrity_queries);
+  };
+  const auto [data_queries, integrity_queries] = expected_queries(queries);
+  const auto [other_data_queries, other_integrity_queries] = expected_queries(other_queries);
+
+  // Checks that the decommitted columns hold the layer's values at the given rows.
+  const auto expect_rows = [&](const std::vector<uint64_t>& rows) {
+    return Invoke([&layer_2_in, rows](gsl::span<const ConstFieldElementSpan> elements_data) {
+      ASSERT_EQ(elements_data.size(), 2);
+      for (size_t col = 0; col < 2; ++col) {
+        std::vector<uint64_t> indices;
+        for (uint64_t row : rows) {
+          indices.push_back(row * 2 + col);
+        }
+        EXPECT_EQ(elements_data[col], ConstFieldElementSpan(layer_2_in.EvalAtPoints(indices)));
+      }
+    });
+  };
+
+  TableProverMockFactory table_prover_factory(
+      {std::make_tuple(1, 256, 2), std::make_tuple(1, 256, 2), std::make_tuple(1, 256, 2)});
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_CALL(table_prover_factory[i], AddSegmentForCommitment(_, 0, 2));
+    EXPECT_CALL(table_prover_factory[i], Commit());
+  }
+
+  // Same queries: the prepared data is used as is.
+  {
+    InSequence seq;
+    EXPECT_CALL(table_prover_factory[0], StartDecommitmentPhase(data_queries, integrity_queries))
+        .WillOnce(Return(std::vector<uint64_t>{1, 2, 3}));
+    EXPECT_CALL(table_prover_factory[0], Decommit(_)).WillOnce(expect_rows({1, 2, 3}));
+  }
+
+  // Different queries: Decommit() prepares the data again for its own queries.
+  {
+    InSequence seq;
+    EXPECT_CALL(table_prover_factory[1], StartDecommitmentPhase(data_queries, integrity_queries))
+        .WillOnce(Return(std::vector<uint64_t>{1, 2, 3}));
+    EXPECT_CALL(
+        table_prover_factory[1],
+        StartDecommitmentPhase(other_data_queries, other_integrity_queries))
+        .WillOnce(Return(std::vector<uint64_t>{1, 50}));
+    EXPECT_CALL(table_prover_factory[1], Decommit(_)).WillOnce(expect_rows({1, 50}));
+  }
+
+  // No preparation: Decommit() prepares the data itself.
+  {
+    InSequence seq;
+    EXPECT_CALL(table_prover_factory[2], StartDecommitmentPhase(data_queries, integrity_queries))
+        .WillOnce(Return(std::vector<uint64_t>{1, 2, 3}));
+    EXPECT_CALL(table_prover_factory[2], Decommit(_)).WillOnce(expect_rows({1, 2, 3}));
+  }
+
+  const TableProverFactory factory = table_prover_factory.AsFactory();
+  FriCommittedLayerByTableProver same_queries_layer(1, UseOwned(&layer_2_in), factory, params, 2);
+  FriCommittedLayerByTableProver other_queries_layer(1, UseOwned(&layer_2_in), factory, params, 2);
+  FriCommittedLayerByTableProver unprepared_layer(1, UseOwned(&layer_2_in), factory, params, 2);
+
+  same_queries_layer.PrepareDecommitment(queries);
+  same_queries_layer.Decommit(queries);
+
+  other_queries_layer.PrepareDecommitment(queries);
+  other_queries_layer.Decommit(other_queries);
+
+  unprepared_layer.Decommit(queries);
+}
+
 #endif  // #ifndef __EMSCRIPTEN__.
 
 }  // namespace
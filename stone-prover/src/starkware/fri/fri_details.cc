@@ -21,6 +21,7 @@
 #include "starkware/algebra/utils/invoke_template_version.h"
 #include "starkware/channel/annotation_scope.h"
 #include "starkware/math/math.h"
+#include "starkware/stl_utils/containers.h"
 #include "starkware/utils/profiling.h"
 
 namespace starkware {
@@ -78,7 +79,8 @@ std::vector<uint64_t> ChooseQueryIndices(
   std::vector<uint64_t> query_indices;
   query_indices.reserve(n_queries);
   for (size_t i = 0; i < n_queries; ++i) {
-    query_indices.push_back(channel->GetRandomNumberFromVerifier(domain_size, std::to_string(i)));
+    query_indices.push_back(
+        channel->GetRandomNumberFromVerifier(domain_size, [&] { return std::to_string(i); }));
   }
   std::sort(query_indices.begin(), query_indices.end());
   return query_indices;
@@ -86,7 +88,7 @@ std::vector<uint64_t> ChooseQueryIndices(
 
 void NextLayerDataAndIntegrityQueries(
     const std::vector<uint64_t>& query_indices, const FriParameters& params, size_t layer_num,
-    std::set<RowCol>* data_queries, std::set<RowCol>* integrity_queries) {
+    std::vector<RowCol>* data_queries, std::vector<RowCol>* integrity_queries) {
   // cumulative_fri_step is the sum of fri_step starting from the second layer and up to the
   // requested layer. It allows us to compute the indices of the queries in the requested layer,
   // given the indices of the second layer.
@@ -97,8 +99,9 @@ void NextLayerDataAndIntegrityQueries(
   const size_t layer_fri_step = params.fri_step_list[layer_num];
 
   for (uint64_t idx : query_indices) {
-    integrity_queries->insert(GetTableProverRowCol(idx >> cumulative_fri_step, layer_fri_step));
+    integrity_queries->push_back(GetTableProverRowCol(idx >> cumulative_fri_step, layer_fri_step));
   }
+  SortAndRemoveDuplicates(integrity_queries);
   for (uint64_t idx : query_indices) {
     // Find the first element of the coset: Divide idx by 2^cumulative_fri_step to find the query
     // location in the current layer, then clean the lower bits to get the first query in the coset.
@@ -106,11 +109,12 @@ void NextLayerDataAndIntegrityQueries(
     for (size_t coset_col = 0; coset_col < Pow2(layer_fri_step); coset_col++) {
       RowCol query{coset_row, coset_col};
       // Add the query to data_queries only if it is not an integrity query.
-      if (integrity_queries->count(query) == 0) {
-        data_queries->insert(query);
+      if (!std::binary_search(integrity_queries->begin(), integrity_queries->end(), query)) {
+        data_queries->push_back(query);
       }
     }
   }
+  SortAndRemoveDuplicates(data_queries);
 }
 
 std::vector<uint64_t> SecondLayerQeuriesToFirstLayerQueries(
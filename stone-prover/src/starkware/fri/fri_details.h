@@ -63,11 +63,11 @@ std::vector<uint64_t> SecondLayerQeuriesToFirstLayerQueries(
   verifier will be able to compute one element (integrity query) and the other 7 will be sent in the
   channel (data queries).
 
-  Note: The two resulting sets are disjoint.
+  Note: The two resulting lists are disjoint, sorted and without duplicates.
 */
 void NextLayerDataAndIntegrityQueries(
     const std::vector<uint64_t>& query_indices, const FriParameters& params, size_t layer_num,
-    std::set<RowCol>* data_queries, std::set<RowCol>* integrity_queries);
+    std::vector<RowCol>* data_queries, std::vector<RowCol>* integrity_queries);
 
 std::vector<uint64_t> ChooseQueryIndices(
     Channel* channel, uint64_t domain_size, size_t n_queries, size_t proof_of_work_bits);
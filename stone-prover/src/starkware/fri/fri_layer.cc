@@ -63,11 +63,9 @@ void FriLayerInMemory::GetChunk(
 
 FieldElementVector FriLayerInMemory::EvalAtPoints(
     const gsl::span<uint64_t>& required_indices) const {
-  FieldElementVector res = FieldElementVector::Make(GetDomain()->GetField());
-  res.Reserve(required_indices.size());
-  for (uint64_t i : required_indices) {
-    res.PushBack(evaluation_[i]);
-  }
+  FieldElementVector res =
+      FieldElementVector::MakeUninitialized(GetDomain()->GetField(), required_indices.size());
+  FieldElementSpan(res).GatherFrom(evaluation_, required_indices);
   return res;
 }
 
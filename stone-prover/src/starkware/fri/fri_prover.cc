@@ -21,6 +21,8 @@
 #include "starkware/channel/annotation_scope.h"
 #include "starkware/error_handling/error_handling.h"
 #include "starkware/utils/profiling.h"
+#include "starkware/utils/progress.h"
+#include "starkware/utils/task_manager.h"
 
 namespace starkware {
 
@@ -67,9 +69,10 @@ MaybeOwnedPtr<const FriLayer> FriProver::CommitmentPhase() {
     ASSERT_RELEASE(layer_num == 1 || fri_step != 0, "layer_num is not zero but fri step is");
     ASSERT_RELEASE(layer_num < n_layers_ || is_in_memory, "last layer must be in memory");
 
-    AnnotationScope scope(channel_.get(), "Layer " + std::to_string(layer_num));
+    AnnotationScope scope(channel_.get(), [&] { return "Layer " + std::to_string(layer_num); });
 
     current_layer = CreateNextFriLayer(std::move(current_layer), fri_step, &basis_index);
+    ProgressReporter::GetInstance().ReportStep("FRI layer", layer_num, n_layers_);
 
     if (is_in_memory) {
       if (first_in_memory && fri_step != 0) {
@@ -164,10 +167,15 @@ void FriProver::ProveFri() {
   AnnotationScope scope(channel_.get(), "Decommitment");
 
   ProfilingBlock profiling_block("FRI response generation");
-  size_t layer_num = 0;
-  for (auto& layer : committed_layers_) {
-    AnnotationScope scope(channel_.get(), "Layer " + std::to_string(layer_num++));
-    layer->Decommit(queries);
+  // Preparing the decommitment of a layer does not use the channel, so it is done for all the
+  // layers in parallel. The decommitments are then sent in order.
+  TaskManager::GetInstance().ParallelFor(
+      committed_layers_.size(), [&](const TaskInfo& task_info) {
+        committed_layers_[task_info.start_idx]->PrepareDecommitment(queries);
+      });
+  for (size_t layer_num = 0; layer_num < committed_layers_.size(); ++layer_num) {
+    AnnotationScope scope(channel_.get(), [&] { return "Layer " + std::to_string(layer_num); });
+    committed_layers_[layer_num]->Decommit(queries);
   }
 }
 
@@ -147,6 +147,22 @@ TYPED_TEST(FriTest, ProverBasicFlowWithMockChannel) {
   TableProverMockFactory table_prover_factory(
       {std::make_tuple(2, 16, 8), std::make_tuple(1, 16, 2)});
   StrictMock<MockFunction<void(const std::vector<uint64_t>& queries)>> first_layer_queries_callback;
+  // The decommitments of the layers are prepared in parallel before any of them is sent, so the
+  // StartDecommitmentPhase() calls are not part of the sequence below.
+  // We mock StartDecommitmentPhase() to ask for row 0.
+  const std::vector<uint64_t> simulated_requested_rows = {0};
+  EXPECT_CALL(
+      table_prover_factory[0], StartDecommitmentPhase(
+                                   UnorderedElementsAreArray(
+                                       {RowCol(0, 1), RowCol(0, 2), RowCol(0, 3), RowCol(0, 4),
+                                        RowCol(0, 5), RowCol(0, 7)}),
+                                   UnorderedElementsAre(RowCol(0, 0), RowCol(0, 6))))
+      .WillOnce(Return(simulated_requested_rows));
+  EXPECT_CALL(
+      table_prover_factory[1],
+      StartDecommitmentPhase(
+          UnorderedElementsAre(RowCol(0, 1)), UnorderedElementsAre(RowCol(0, 0))))
+      .WillOnce(Return(std::vector<uint64_t>{}));
   {
     testing::InSequence dummy;
 
@@ -192,15 +208,6 @@ TYPED_TEST(FriTest, ProverBasicFlowWithMockChannel) {
     // which will allow the verifier to compute index 0 on the third layer. Then it will send
     // index 1 of the third layer to allow the verifier to continue to the forth (and last)
     // layer.
-    // We mock StartDecommitmentPhase() to ask for rows 0,...,9.
-    const std::vector<uint64_t> simulated_requested_rows = {0};
-    EXPECT_CALL(
-        table_prover_factory[0], StartDecommitmentPhase(
-                                     UnorderedElementsAreArray(
-                                         {RowCol(0, 1), RowCol(0, 2), RowCol(0, 3), RowCol(0, 4),
-                                          RowCol(0, 5), RowCol(0, 7)}),
-                                     UnorderedElementsAre(RowCol(0, 0), RowCol(0, 6))))
-        .WillOnce(Return(simulated_requested_rows));
     EXPECT_CALL(table_prover_factory[0], Decommit(_))
         .WillOnce(Invoke([&](gsl::span<const ConstFieldElementSpan> aa) {
           EXPECT_EQ(aa.size(), 8);
@@ -209,12 +216,6 @@ TYPED_TEST(FriTest, ProverBasicFlowWithMockChannel) {
           }
         }));
 
-    EXPECT_CALL(
-        table_prover_factory[1],
-        StartDecommitmentPhase(
-            UnorderedElementsAre(RowCol(0, 1)), UnorderedElementsAre(RowCol(0, 0))))
-        .WillOnce(Return(std::vector<uint64_t>{}));
-
     EXPECT_CALL(table_prover_factory[1], Decommit(_))
         .WillOnce(Invoke([&](gsl::span<const ConstFieldElementSpan> aa) {
           const FieldElementVector empty_vector = FieldElementVector::Make<FieldElementT>();
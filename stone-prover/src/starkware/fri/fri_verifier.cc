@@ -19,6 +19,7 @@
 #include <memory>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "starkware/algebra/lde/lde.h"
 #include "starkware/channel/annotation_scope.h"
@@ -45,7 +46,7 @@ void FriVerifier::CommitmentPhase() {
   size_t basis_index = 0;
   for (size_t i = 0; i < n_layers_; i++) {
     size_t cur_fri_step = params_->fri_step_list[i];
-    AnnotationScope scope(channel_.get(), "Layer " + std::to_string(i + 1));
+    AnnotationScope scope(channel_.get(), [&] { return "Layer " + std::to_string(i + 1); });
     basis_index += cur_fri_step;
     if (i == 0) {
       if (params_->fri_step_list[0] != 0) {
@@ -121,17 +122,18 @@ void FriVerifier::VerifyInnerLayers() {
   const size_t first_fri_step = params_->fri_step_list.at(0);
   size_t basis_index = 0;
   for (size_t i = 0; i < n_layers_ - 1; ++i) {
-    AnnotationScope scope(channel_.get(), "Layer " + std::to_string(i + 1));
+    AnnotationScope scope(channel_.get(), [&] { return "Layer " + std::to_string(i + 1); });
 
     const size_t cur_fri_step = params_->fri_step_list[i + 1];
     basis_index += params_->fri_step_list[i];
 
-    std::set<RowCol> layer_data_queries, layer_integrity_queries;
+    std::vector<RowCol> layer_data_queries, layer_integrity_queries;
     NextLayerDataAndIntegrityQueries(
         query_indices_, *params_, i + 1, &layer_data_queries, &layer_integrity_queries);
     // Collect results for data queries.
-    std::map<RowCol, FieldElement> to_verify =
-        table_verifiers_[i]->Query(layer_data_queries, layer_integrity_queries);
+    std::map<RowCol, FieldElement> to_verify = table_verifiers_[i]->Query(
+        std::set<RowCol>(layer_data_queries.begin(), layer_data_queries.end()),
+        std::set<RowCol>(layer_integrity_queries.begin(), layer_integrity_queries.end()));
     const FftDomainBase& basis = params_->fft_bases->At(basis_index);
     uint64_t prev_query_index = std::numeric_limits<uint64_t>::max();
     for (size_t j = 0; j < query_results_.size(); ++j) {
@@ -0,0 +1,196 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/main/binary_proof.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "starkware/error_handling/error_handling.h"
+#include "starkware/utils/serialization.h"
+
+namespace starkware {
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'S', 'T', 'A', 'R', 'K', 'P', 'R', 'F'};
+constexpr uint64_t kFormatVersion = 1;
+constexpr size_t kNumSections = static_cast<size_t>(BinaryProofSection::kNumSections);
+constexpr size_t kSectionTableOffset = kMagic.size() + sizeof(uint64_t);
+constexpr size_t kHeaderSize = kSectionTableOffset + kNumSections * 2 * sizeof(uint64_t);
+
+void WriteUint64(std::ostream* out, uint64_t value) {
+  std::array<std::byte, sizeof(uint64_t)> bytes{};
+  Serialize<uint64_t>(value, bytes);
+  out->write(reinterpret_cast<const char*>(bytes.data()), bytes.size());  // NOLINT
+}
+
+uint64_t ReadUint64(gsl::span<const std::byte> data, size_t offset) {
+  ASSERT_RELEASE(offset + sizeof(uint64_t) <= data.size(), "Binary proof file is truncated.");
+  return Deserialize<uint64_t>(data.subspan(offset, sizeof(uint64_t)));
+}
+
+/*
+  Maps the entire file to memory. Returns an empty span for an empty file.
+*/
+gsl::span<const std::byte> MapFile(const std::string& file_name) {
+  const int fd = open(file_name.c_str(), O_RDONLY);  // NOLINT
+  ASSERT_RELEASE(fd >= 0, "Could not open \"" + file_name + "\" for reading.");
+  struct stat file_stat {};
+  const bool stat_ok = fstat(fd, &file_stat) == 0;
+  const auto size = static_cast<size_t>(file_stat.st_size);
+  void* addr = stat_ok && size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+  close(fd);
+  ASSERT_RELEASE(stat_ok && addr != MAP_FAILED, "Failed to map \"" + file_name + "\" to memory.");
+  if (addr == nullptr) {
+    return {};
+  }
+  return {static_cast<const std::byte*>(addr), size};
+}
+
+void Unmap(gsl::span<const std::byte> mapping) {
+  if (!mapping.empty()) {
+    munmap(const_cast<std::byte*>(mapping.data()), mapping.size());  // NOLINT
+  }
+}
+
+bool HasMagic(gsl::span<const std::byte> data) {
+  return data.size() >= kHeaderSize &&
+         std::equal(kMagic.begin(), kMagic.end(), data.begin(), [](char c, std::byte b) {
+           return std::byte(c) == b;
+         });
+}
+
+}  // namespace
+
+ProofOutputFormat ProofOutputFormatFromString(const std::string& format) {
+  if (format == "json") {
+    return ProofOutputFormat::kJson;
+  }
+  if (format == "binary") {
+    return ProofOutputFormat::kBinary;
+  }
+  THROW_STARKWARE_EXCEPTION("Unknown proof output format: \"" + format + "\".");
+}
+
+// BinaryProofWriter.
+
+BinaryProofWriter::BinaryProofWriter(const std::string& file_name)
+    : file_(file_name, std::ios::binary | std::ios::trunc) {
+  ASSERT_RELEASE(static_cast<bool>(file_), "Could not open \"" + file_name + "\" for writing.");
+  file_.write(kMagic.data(), kMagic.size());
+  WriteUint64(&file_, kFormatVersion);
+  // Placeholder for the section table, see Finalize().
+  const std::vector<char> zeros(kHeaderSize - kSectionTableOffset, 0);
+  file_.write(zeros.data(), zeros.size());
+}
+
+void BinaryProofWriter::WriteSection(
+    BinaryProofSection section, gsl::span<const std::byte> data) {
+  BeginSection(section);
+  file_.write(reinterpret_cast<const char*>(data.data()), data.size());  // NOLINT
+  EndSection();
+}
+
+void BinaryProofWriter::WriteSection(BinaryProofSection section, const std::string& data) {
+  const auto* bytes = reinterpret_cast<const std::byte*>(data.data());  // NOLINT
+  WriteSection(section, gsl::make_span(bytes, data.size()));
+}
+
+void BinaryProofWriter::WriteSection(BinaryProofSection section, const JsonValue& data) {
+  WriteSection(section, data.ToString());
+}
+
+void BinaryProofWriter::BeginSection(BinaryProofSection section) {
+  ASSERT_RELEASE(!finalized_, "Cannot write a section after Finalize() was called.");
+  ASSERT_RELEASE(!current_section_.has_value(), "Previous section was not ended.");
+  const auto idx = static_cast<size_t>(section);
+  ASSERT_RELEASE(idx < kNumSections, "Invalid section.");
+  ASSERT_RELEASE(!written_.at(idx), "Section was already written.");
+  written_.at(idx) = true;
+  sections_.at(idx).offset = file_.tellp();
+  current_section_ = section;
+}
+
+void BinaryProofWriter::EndSection() {
+  ASSERT_RELEASE(current_section_.has_value(), "EndSection() called without BeginSection().");
+  SectionEntry& entry = sections_.at(static_cast<size_t>(*current_section_));
+  entry.size = static_cast<uint64_t>(file_.tellp()) - entry.offset;
+  current_section_ = std::nullopt;
+}
+
+void BinaryProofWriter::Finalize() {
+  ASSERT_RELEASE(!current_section_.has_value(), "Last section was not ended.");
+  ASSERT_RELEASE(!finalized_, "Finalize() was already called.");
+  file_.seekp(kSectionTableOffset);
+  for (const SectionEntry& entry : sections_) {
+    WriteUint64(&file_, entry.offset);
+    WriteUint64(&file_, entry.size);
+  }
+  file_.close();
+  ASSERT_RELEASE(!file_.fail(), "Failed to write binary proof file.");
+  finalized_ = true;
+}
+
+// BinaryProofReader.
+
+BinaryProofReader::BinaryProofReader(const std::string& file_name)
+    : BinaryProofReader(MapFile(file_name), file_name) {}
+
+BinaryProofReader::BinaryProofReader(
+    gsl::span<const std::byte> mapping, const std::string& file_name)
+    : data_(mapping.data()), size_(mapping.size()) {
+  if (!HasMagic(mapping) || ReadUint64(mapping, kMagic.size()) != kFormatVersion) {
+    Unmap(mapping);
+    THROW_STARKWARE_EXCEPTION(
+        "\"" + file_name + "\" is not a binary proof file of a supported version.");
+  }
+}
+
+std::unique_ptr<BinaryProofReader> BinaryProofReader::TryOpen(const std::string& file_name) {
+  const gsl::span<const std::byte> mapping = MapFile(file_name);
+  if (!HasMagic(mapping)) {
+    Unmap(mapping);
+    return nullptr;
+  }
+  return std::unique_ptr<BinaryProofReader>(new BinaryProofReader(mapping, file_name));
+}
+
+BinaryProofReader::~BinaryProofReader() { Unmap({data_, size_}); }
+
+gsl::span<const std::byte> BinaryProofReader::GetSection(BinaryProofSection section) const {
+  const auto idx = static_cast<size_t>(section);
+  ASSERT_RELEASE(idx < kNumSections, "Invalid section.");
+  const gsl::span<const std::byte> data(data_, size_);
+  const size_t entry_offset = kSectionTableOffset + idx * 2 * sizeof(uint64_t);
+  const uint64_t offset = ReadUint64(data, entry_offset);
+  const uint64_t size = ReadUint64(data, entry_offset + sizeof(uint64_t));
+  ASSERT_RELEASE(
+      offset <= size_ && size <= size_ - offset, "Binary proof section exceeds the file size.");
+  return data.subspan(offset, size);
+}
+
+JsonValue BinaryProofReader::GetJsonSection(BinaryProofSection section) const {
+  const auto bytes = GetSection(section);
+  return JsonValue::FromString(
+      std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size()));  // NOLINT
+}
+
+}  // namespace starkware
@@ -0,0 +1,146 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#ifndef STARKWARE_MAIN_BINARY_PROOF_H_
+#define STARKWARE_MAIN_BINARY_PROOF_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "third_party/gsl/gsl-lite.hpp"
+
+#include "starkware/utils/json.h"
+
+namespace starkware {
+
+/*
+  A compact binary alternative to the unified JSON prover output. Instead of hex-encoding the proof
+  inside a JSON document, the proof bytes are stored raw, and the JSON inputs are stored as
+  separate sections.
+
+  Layout (all integers are 64-bit big-endian, as in Serialize<uint64_t>):
+    [magic (8 bytes)][format version]
+    [section table: (offset, size) for each BinaryProofSection]
+    [section data...]
+
+  The section table is written last (the file is patched in place), which allows the proof section
+  to be streamed to the file while the proof is being generated.
+*/
+enum class BinaryProofSection : size_t {
+  kVersion = 0,
+  kPrivateInput,
+  kPublicInput,
+  kProofParameters,
+  kProverConfig,
+  kProof,
+  kAnnotations,
+  kNumSections,
+};
+
+enum class ProofOutputFormat { kJson, kBinary };
+
+/*
+  Parses "json" or "binary".
+*/
+ProofOutputFormat ProofOutputFormatFromString(const std::string& format);
+
+/*
+  Writes a binary proof file. Sections may be written in any order, each at most once. A section
+  is either written at once (WriteSection) or streamed (BeginSection, writes to Stream(),
+  EndSection). Finalize() must be called after all sections were written.
+*/
+class BinaryProofWriter {
+ public:
+  explicit BinaryProofWriter(const std::string& file_name);
+
+  void WriteSection(BinaryProofSection section, gsl::span<const std::byte> data);
+  void WriteSection(BinaryProofSection section, const std::string& data);
+  void WriteSection(BinaryProofSection section, const JsonValue& data);
+
+  void BeginSection(BinaryProofSection section);
+  void EndSection();
+
+  /*
+    The underlying stream. Bytes written to it between BeginSection() and EndSection() become the
+    content of the section.
+  */
+  std::ostream* Stream() { return &file_; }
+
+  /*
+    Writes the section table and closes the file.
+  */
+  void Finalize();
+
+ private:
+  struct SectionEntry {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+  };
+
+  std::ofstream file_;
+  std::array<SectionEntry, static_cast<size_t>(BinaryProofSection::kNumSections)> sections_{};
+  std::array<bool, static_cast<size_t>(BinaryProofSection::kNumSections)> written_{};
+  std::optional<BinaryProofSection> current_section_;
+  bool finalized_ = false;
+};
+
+/*
+  Reads a binary proof file by mapping it to memory. Sections are returned as views into the
+  mapping, and are valid as long as the reader is alive.
+*/
+class BinaryProofReader {
+ public:
+  explicit BinaryProofReader(const std::string& file_name);
+  ~BinaryProofReader();
+
+  BinaryProofReader(const BinaryProofReader&) = delete;
+  BinaryProofReader& operator=(const BinaryProofReader&) = delete;
+  BinaryProofReader(BinaryProofReader&&) = delete;
+  BinaryProofReader& operator=(BinaryProofReader&&) = delete;
+
+  /*
+    Returns a reader for the given file, or nullptr if it is not a binary proof file. The file is
+    opened and mapped only once.
+  */
+  static std::unique_ptr<BinaryProofReader> TryOpen(const std::string& file_name);
+
+  /*
+    Returns the raw bytes of the given section (empty if the section was not written).
+  */
+  gsl::span<const std::byte> GetSection(BinaryProofSection section) const;
+
+  /*
+    Parses the given section as JSON.
+  */
+  JsonValue GetJsonSection(BinaryProofSection section) const;
+
+ private:
+  /*
+    Takes ownership of the given mapping of file_name. Unmaps it and throws if it is not a binary
+    proof of a supported version.
+  */
+  BinaryProofReader(gsl::span<const std::byte> mapping, const std::string& file_name);
+
+  const std::byte* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_MAIN_BINARY_PROOF_H_
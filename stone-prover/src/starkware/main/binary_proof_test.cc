@@ -0,0 +1,94 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/main/binary_proof.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/error_handling/test_utils.h"
+#include "starkware/randomness/prng.h"
+#include "starkware/utils/json_builder.h"
+
+namespace starkware {
+namespace {
+
+using testing::ElementsAreArray;
+using testing::HasSubstr;
+using testing::IsEmpty;
+
+const char* const kFileName = "/tmp/binary_proof_test.bin";
+
+JsonValue SampleJson(const std::string& value) {
+  JsonBuilder builder;
+  builder["value"] = value;
+  builder["array"].Append(1).Append(2).Append(3);
+  return builder.Build();
+}
+
+TEST(BinaryProof, StreamedRoundTrip) {
+  Prng prng;
+  const std::vector<std::byte> proof = prng.RandomByteVector(1000);
+  {
+    BinaryProofWriter writer(kFileName);
+    writer.WriteSection(BinaryProofSection::kPublicInput, SampleJson("public"));
+    writer.WriteSection(BinaryProofSection::kProofParameters, SampleJson("parameters"));
+    // Stream the proof in small chunks, as the channel does.
+    writer.BeginSection(BinaryProofSection::kProof);
+    for (size_t i = 0; i < proof.size(); i += 32) {
+      const size_t chunk_size = std::min<size_t>(32, proof.size() - i);
+      writer.Stream()->write(
+          reinterpret_cast<const char*>(proof.data() + i), chunk_size);  // NOLINT
+    }
+    writer.EndSection();
+    writer.WriteSection(BinaryProofSection::kAnnotations, std::string("annotation\n"));
+    writer.Finalize();
+  }
+
+  const BinaryProofReader reader(kFileName);
+  EXPECT_EQ(reader.GetJsonSection(BinaryProofSection::kPublicInput), SampleJson("public"));
+  EXPECT_EQ(reader.GetJsonSection(BinaryProofSection::kProofParameters), SampleJson("parameters"));
+  EXPECT_THAT(reader.GetSection(BinaryProofSection::kProof), ElementsAreArray(proof));
+  EXPECT_EQ(reader.GetSection(BinaryProofSection::kAnnotations).size(), 11U);
+  EXPECT_THAT(reader.GetSection(BinaryProofSection::kPrivateInput), IsEmpty());
+
+  const std::unique_ptr<BinaryProofReader> opened_reader = BinaryProofReader::TryOpen(kFileName);
+  ASSERT_NE(opened_reader, nullptr);
+  EXPECT_THAT(opened_reader->GetSection(BinaryProofSection::kProof), ElementsAreArray(proof));
+  std::remove(kFileName);
+}
+
+TEST(BinaryProof, NotABinaryProof) {
+  SampleJson("json").Write(kFileName);
+  EXPECT_ASSERT(BinaryProofReader{kFileName}, HasSubstr("is not a binary proof file"));
+  EXPECT_EQ(BinaryProofReader::TryOpen(kFileName), nullptr);
+  std::remove(kFileName);
+}
+
+TEST(BinaryProof, SectionWrittenTwice) {
+  BinaryProofWriter writer(kFileName);
+  writer.WriteSection(BinaryProofSection::kProof, std::string("proof"));
+  EXPECT_ASSERT(
+      writer.WriteSection(BinaryProofSection::kProof, std::string("proof")),
+      HasSubstr("already written"));
+  std::remove(kFileName);
+}
+
+}  // namespace
+}  // namespace starkware
@@ -18,6 +18,8 @@
     input). It ran successfully and ended at the given pc.
 */
 
+#include <memory>
+
 #include "gflags/gflags.h"
 
 #include "starkware/main/prover_main_helper.h"
@@ -33,6 +35,18 @@ int main(int argc, char** argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
   google::InitGoogleLogging(argv[0]);  // NOLINT
 
+  if (ProverServeModeRequested()) {
+    ProverServerMainHelper(
+        [](const JsonValue& statement_parameters, const JsonValue& public_input,
+           const JsonValue& private_input) -> std::unique_ptr<Statement> {
+          return std::make_unique<CpuAirStatement>(
+              statement_parameters, public_input, private_input);
+        },
+        GetProverVersion());
+    WriteStats();
+    return 0;
+  }
+
   CpuAirStatement statement(GetParametersInput()["statement"], GetPublicInput(), GetPrivateInput());
   ProfilingBlock profiling_block("Prover", 0);
   ProverMainHelper(&statement, GetProverVersion());
@@ -15,7 +15,9 @@
 #include "starkware/main/prover_main_helper.h"
 
 #include <sys/resource.h>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -23,37 +25,90 @@
 #include "gflags/gflags.h"
 
 #include "starkware/channel/noninteractive_prover_channel.h"
+#include "starkware/main/binary_proof.h"
 #include "starkware/main/prover_main_helper_impl.h"
+#include "starkware/main/prover_server.h"
+#include "starkware/stark/prover_config_planner.h"
 #include "starkware/stark/stark.h"
 #include "starkware/stark/utils.h"
 #include "starkware/utils/flag_validators.h"
+#include "starkware/utils/profiling.h"
+
+DEFINE_bool(
+    serve, false,
+    "Run as a prover daemon: instead of proving the statement given by the input flags, process "
+    "proof jobs from --spool_dir until a shutdown is requested. See prover_server.h.");
+
+DEFINE_string(spool_dir, "", "The directory from which proof jobs are taken in --serve mode.");
+
+DEFINE_uint32(
+    serve_poll_interval_ms, 100,
+    "In --serve mode, the time to wait before checking the spool directory again when there are no "
+    "pending jobs.");
+
+namespace {
+
+/*
+  In --serve mode the input and output files are given per job, so the file flags are optional.
+*/
+bool ValidateInputFileUnlessServing(const char* flagname, const std::string& file_name) {
+  return FLAGS_serve ? starkware::ValidateOptionalInputFile(flagname, file_name)
+                     : starkware::ValidateInputFile(flagname, file_name);
+}
+
+bool ValidateOutputFileUnlessServing(const char* flagname, const std::string& file_name) {
+  return FLAGS_serve ? starkware::ValidateOptionalOutputFile(flagname, file_name)
+                     : starkware::ValidateOutputFile(flagname, file_name);
+}
+
+}  // namespace
 
 DEFINE_string(private_input_file, "", "Path to the json file containing the private input.");
-DEFINE_validator(private_input_file, &starkware::ValidateInputFile);
+DEFINE_validator(private_input_file, &ValidateInputFileUnlessServing);
 
 DEFINE_bool(fix_public_input, false, "Re-compute public input");
 
 DEFINE_string(
     out_file, "", "Path to the unified output file that will contain the output and input data.");
-DEFINE_validator(out_file, &starkware::ValidateOutputFile);
+DEFINE_validator(out_file, &ValidateOutputFileUnlessServing);
+
+DEFINE_string(
+    out_file_format, "json",
+    "Format of out_file: \"json\" for the unified JSON output, or \"binary\" for the compact "
+    "binary proof file, to which the proof is streamed while it is generated.");
 
 DEFINE_string(
     prover_config_file, "",
     "Path to the json file containing parameters controlling the prover optimization parameters.");
-DEFINE_validator(prover_config_file, &starkware::ValidateInputFile);
+DEFINE_validator(prover_config_file, &ValidateInputFileUnlessServing);
 
 DEFINE_bool(generate_annotations, false, "Optional. Generate proof annotations.");
 
 DEFINE_string(parameter_file, "", "Path to the json file containing the proof parameters.");
-DEFINE_validator(parameter_file, &starkware::ValidateInputFile);
+DEFINE_validator(parameter_file, &ValidateInputFileUnlessServing);
 
 DEFINE_string(public_input_file, "", "Path to the json file containing the public input.");
-DEFINE_validator(public_input_file, &starkware::ValidateInputFile);
+DEFINE_validator(public_input_file, &ValidateInputFileUnlessServing);
+
+DEFINE_string(
+    memory_budget, "",
+    "Optional. The memory available to the prover, e.g. \"64G\". If given, the prover config "
+    "fields that trade memory for time are replaced by the fastest choice whose predicted peak "
+    "memory fits in it, and the prover fails before proving if none fits.");
+
+DEFINE_bool(
+    dry_run, false,
+    "Print the predicted peak memory and time of the prover config (and the config chosen for "
+    "--memory_budget, if given) and exit without proving.");
 
 namespace starkware {
 
 namespace {
 
+uint64_t GetMemoryBudget() {
+  return FLAGS_memory_budget.empty() ? 0 : ParseMemorySize(FLAGS_memory_budget);
+}
+
 void DisableCoreDump() {
   struct rlimit rlim {};
 
@@ -61,6 +116,40 @@ void DisableCoreDump() {
   setrlimit(RLIMIT_CORE, &rlim);
 }
 
+/*
+  Returns the value of an optional boolean field of a job.
+*/
+bool GetJobFlag(const JsonValue& job, const std::string& name) {
+  return job[name].HasValue() && job[name].AsBool();
+}
+
+/*
+  Runs a single --serve job. The job is a JSON object with the same fields as the command line
+  flags of a single proof: "private_input_file", "public_input_file", "parameter_file",
+  "prover_config_file" and "out_file", and optionally "out_file_format", "generate_annotations"
+  and "fix_public_input". The --memory_budget of the server applies to every job.
+*/
+void RunProverJob(
+    const JsonValue& job, const StatementFactory& statement_factory,
+    const ProverVersion& prover_version) {
+  const JsonValue parameters = JsonValue::FromFile(job["parameter_file"].AsString());
+  const JsonValue public_input_from_file = JsonValue::FromFile(job["public_input_file"].AsString());
+  const std::unique_ptr<Statement> statement = statement_factory(
+      parameters["statement"], public_input_from_file,
+      JsonValue::FromFile(job["private_input_file"].AsString()));
+  const ProofOutputFormat out_file_format = ProofOutputFormatFromString(
+      job["out_file_format"].HasValue() ? job["out_file_format"].AsString() : "json");
+  const JsonValue public_input = GetJobFlag(job, "fix_public_input")
+                                     ? statement->FixPublicInput()
+                                     : public_input_from_file;
+
+  ProfilingBlock profiling_block("Prover", 0);
+  ProverMainHelperImpl(
+      statement.get(), parameters, JsonValue::FromFile(job["prover_config_file"].AsString()),
+      public_input, job["out_file"].AsString(), GetJobFlag(job, "generate_annotations"),
+      prover_version, out_file_format, GetMemoryBudget());
+}
+
 }  // namespace
 
 JsonValue GetPrivateInput() { return JsonValue::FromFile(FLAGS_private_input_file); }
@@ -72,10 +161,24 @@ void ProverMainHelper(Statement* statement, const ProverVersion& prover_version)
   // Disable core dumps to save storage space.
   DisableCoreDump();
 
+  const ProofOutputFormat out_file_format = ProofOutputFormatFromString(FLAGS_out_file_format);
   JsonValue public_input = FLAGS_fix_public_input ? statement->FixPublicInput() : GetPublicInput();
   ProverMainHelperImpl(
       statement, GetParametersInput(), GetStarkProverConfig(), public_input, FLAGS_out_file,
-      FLAGS_generate_annotations, prover_version);
+      FLAGS_generate_annotations, prover_version, out_file_format, GetMemoryBudget(),
+      FLAGS_dry_run);
+}
+
+bool ProverServeModeRequested() { return FLAGS_serve; }
+
+void ProverServerMainHelper(
+    const StatementFactory& statement_factory, const ProverVersion& prover_version) {
+  DisableCoreDump();
+
+  ProverServer server(FLAGS_spool_dir, [&](const JsonValue& job) {
+    RunProverJob(job, statement_factory, prover_version);
+  });
+  server.Serve(std::chrono::milliseconds(FLAGS_serve_poll_interval_ms));
 }
 
 }  // namespace starkware
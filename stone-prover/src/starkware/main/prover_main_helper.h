@@ -15,6 +15,9 @@
 #ifndef STARKWARE_MAIN_PROVER_MAIN_HELPER_H_
 #define STARKWARE_MAIN_PROVER_MAIN_HELPER_H_
 
+#include <functional>
+#include <memory>
+
 #include "starkware/main/prover_version.h"
 #include "starkware/stark/stark.h"
 #include "starkware/statement/statement.h"
@@ -26,6 +29,27 @@ namespace starkware {
 */
 void ProverMainHelper(Statement* statement, const ProverVersion& prover_version);
 
+/*
+  Constructs the statement of a proof job from the "statement" section of the parameters, the
+  public input and the private input.
+*/
+using StatementFactory = std::function<std::unique_ptr<Statement>(
+    const JsonValue& statement_parameters, const JsonValue& public_input,
+    const JsonValue& private_input)>;
+
+/*
+  Returns true if the --serve flag was given, in which case main() should call
+  ProverServerMainHelper() instead of ProverMainHelper().
+*/
+bool ProverServeModeRequested();
+
+/*
+  Helper function for writing a main() function for STARK prover daemons. Processes proof jobs
+  from --spool_dir (see prover_server.h) until a shutdown is requested.
+*/
+void ProverServerMainHelper(
+    const StatementFactory& statement_factory, const ProverVersion& prover_version);
+
 /*
   Reads the json file specified by the --private_input flag.
 */
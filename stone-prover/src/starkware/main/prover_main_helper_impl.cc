@@ -16,7 +16,9 @@
 
 #include <cstddef>
 #include <fstream>
+#include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -28,12 +30,15 @@
 #include "starkware/channel/noninteractive_prover_channel.h"
 #include "starkware/crypt_tools/invoke.h"
 #include "starkware/crypt_tools/masked_hash.h"
+#include "starkware/main/binary_proof.h"
+#include "starkware/stark/prover_config_planner.h"
 #include "starkware/stark/stark.h"
 #include "starkware/stark/utils.h"
 #include "starkware/utils/flag_validators.h"
 #include "starkware/utils/json_builder.h"
 #include "starkware/utils/maybe_owned_ptr.h"
 #include "starkware/utils/profiling.h"
+#include "starkware/utils/task_manager.h"
 
 namespace starkware {
 
@@ -49,6 +54,15 @@ static JsonValue StringToJsonArray(const std::string& string_with_newlines) {
   auto json = output.Build();
   return json["array"];
 }
+
+static JsonValue ProverVersionToJson(const ProverVersion& prover_version) {
+  JsonBuilder output;
+  output["statement_name"] = prover_version.statement_name;
+  output["proof_hash"] = prover_version.proof_hash;
+  output["commit_hash"] = prover_version.commit_hash;
+  return output.Build();
+}
+
 /*
   Save unified output of the prover (including the inputs).
 */
@@ -58,9 +72,7 @@ static void SaveUnitedProverOutput(
     const std::string& annotations, const ProverVersion& prover_version) {
   JsonBuilder output;
 
-  output["version"]["statement_name"] = prover_version.statement_name;
-  output["version"]["proof_hash"] = prover_version.proof_hash;
-  output["version"]["commit_hash"] = prover_version.commit_hash;
+  output["version"] = ProverVersionToJson(prover_version);
 
   output["private_input"] = private_input;
   output["public_input"] = public_input;
@@ -76,7 +88,8 @@ static void SaveUnitedProverOutput(
 std::vector<std::byte> ProverMainHelperImpl(
     Statement* statement, const JsonValue& parameters, const JsonValue& stark_config_json,
     const JsonValue& public_input, const std::string& out_file_name, bool generate_annotations,
-    const ProverVersion& prover_version) {
+    const ProverVersion& prover_version, ProofOutputFormat out_file_format, uint64_t memory_budget,
+    bool dry_run) {
   const Air& air = statement->GetAir();
 
   StarkProverConfig stark_config(StarkProverConfig::FromJson(stark_config_json));
@@ -91,6 +104,44 @@ std::vector<std::byte> ProverMainHelperImpl(
   StarkParameters stark_params =
       StarkParameters::FromJson(parameters["stark"], field, UseOwned(&air), use_extension_field);
 
+  // Note that n_verifier_friendly_commitment_layers params needs be either 0 or at least
+  // log(table_prover_n_tasks_per_segment) * n_cosets. See
+  // CalculateNVerifierFriendlyLayersInSegment in
+  // src/starkware/commitment_scheme/commitment_scheme_builder.inl.
+  const size_t n_verifier_friendly_commitment_layers =
+      parameters["n_verifier_friendly_commitment_layers"].HasValue()
+          ? parameters["n_verifier_friendly_commitment_layers"].AsUint64()
+          : 0;
+
+  // Choose the config that fits in the memory budget, and in a dry run only print the plan.
+  std::optional<JsonValue> planned_config_json;
+  if (memory_budget != 0 || dry_run) {
+    const ProverConfigPlanner planner(ProverPlanInput::FromStarkParameters(
+        stark_params, FLAGS_n_threads, n_verifier_friendly_commitment_layers));
+    if (dry_run) {
+      std::cout << "Given config: " << planner.Estimate(stark_config).ToString() << std::endl;
+    }
+    if (memory_budget != 0) {
+      const ProverPlan plan = planner.Plan(stark_config, memory_budget);
+      if (dry_run) {
+        std::cout << "Planned config: " << plan.ToString() << std::endl;
+      } else {
+        LOG(INFO) << "Planned config: " << plan.ToString();
+      }
+      ASSERT_RELEASE(
+          dry_run || plan.fits_memory_budget,
+          "No prover config fits in the memory budget. Smallest: " + plan.ToString());
+      stark_config = plan.config;
+      planned_config_json.emplace(stark_config.ToJson());
+    }
+  }
+  const JsonValue& prover_config_json =
+      planned_config_json.has_value() ? *planned_config_json : stark_config_json;
+  if (dry_run) {
+    std::cout << "Prover config: " << prover_config_json.ToString() << std::endl;
+    return {};
+  }
+
   const std::string channel_hash =
       parameters["channel_hash"].HasValue() ? parameters["channel_hash"].AsString() : "keccak256";
 
@@ -100,9 +151,26 @@ std::vector<std::byte> ProverMainHelperImpl(
     return prng.Clone();
   });
 
-  NoninteractiveProverChannel channel(std::move(prng));
+  // In the binary format, the inputs are written first and the proof is streamed to the file by
+  // the channel.
+  std::optional<BinaryProofWriter> binary_writer;
+  if (!out_file_name.empty() && out_file_format == ProofOutputFormat::kBinary) {
+    binary_writer.emplace(out_file_name);
+    binary_writer->WriteSection(BinaryProofSection::kVersion, ProverVersionToJson(prover_version));
+    binary_writer->WriteSection(BinaryProofSection::kPrivateInput, statement->GetPrivateInput());
+    binary_writer->WriteSection(BinaryProofSection::kPublicInput, public_input);
+    binary_writer->WriteSection(BinaryProofSection::kProofParameters, parameters);
+    binary_writer->WriteSection(BinaryProofSection::kProverConfig, prover_config_json);
+    binary_writer->BeginSection(BinaryProofSection::kProof);
+  }
+
+  NoninteractiveProverChannel channel(
+      std::move(prng), binary_writer.has_value() ? binary_writer->Stream() : nullptr);
   if (!generate_annotations) {
     channel.DisableAnnotations();
+    // The prover never generates extra annotations. Disabling them as well allows the channel to
+    // skip annotation scopes altogether.
+    channel.DisableExtraAnnotations();
   }
 
   const std::string commitment_hash = parameters["commitment_hash"].HasValue()
@@ -114,15 +182,6 @@ std::vector<std::byte> ProverMainHelperImpl(
           ? parameters["verifier_friendly_commitment_hash"].AsString()
           : commitment_hash;
 
-  // Note that n_verifier_friendly_commitment_layers params needs be either 0 or at least
-  // log(table_prover_n_tasks_per_segment) * n_cosets. See
-  // CalculateNVerifierFriendlyLayersInSegment in
-  // src/starkware/commitment_scheme/commitment_scheme_builder.inl.
-  const size_t n_verifier_friendly_commitment_layers =
-      parameters["n_verifier_friendly_commitment_layers"].HasValue()
-          ? parameters["n_verifier_friendly_commitment_layers"].AsUint64()
-          : 0;
-
   TableProverFactory table_prover_factory = InvokeByHashFunc(commitment_hash, [&](auto hash_tag) {
     using HashT = typename decltype(hash_tag)::type;
     return GetTableProverFactory<HashT>(
@@ -141,7 +200,9 @@ std::vector<std::byte> ProverMainHelperImpl(
   // elements, which is destroyed when the function ends.
   prover.ProveStark(statement->GetTraceContext());
 
-  std::vector<std::byte> proof_bytes = channel.GetProof();
+  // A streamed proof is not kept in memory.
+  std::vector<std::byte> proof_bytes =
+      binary_writer.has_value() ? std::vector<std::byte>{} : channel.GetProof();
 
   // Print statistics.
   LOG(INFO) << channel.GetStatistics().ToString();
@@ -151,9 +212,17 @@ std::vector<std::byte> ProverMainHelperImpl(
     if (generate_annotations) {
       annotations << channel;
     }
-    SaveUnitedProverOutput(
-        out_file_name, statement->GetPrivateInput(), public_input, parameters, stark_config_json,
-        BytesToHexString(proof_bytes, false), annotations.str(), prover_version);
+    if (binary_writer.has_value()) {
+      binary_writer->EndSection();
+      if (generate_annotations) {
+        binary_writer->WriteSection(BinaryProofSection::kAnnotations, annotations.str());
+      }
+      binary_writer->Finalize();
+    } else {
+      SaveUnitedProverOutput(
+          out_file_name, statement->GetPrivateInput(), public_input, parameters, prover_config_json,
+          BytesToHexString(proof_bytes, false), annotations.str(), prover_version);
+    }
   }
   return proof_bytes;
 }
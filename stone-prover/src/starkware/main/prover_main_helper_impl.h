@@ -16,9 +16,11 @@
 #define STARKWARE_MAIN_PROVER_MAIN_HELPER_IMPL_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
+#include "starkware/main/binary_proof.h"
 #include "starkware/main/prover_version.h"
 #include "starkware/stark/stark.h"
 #include "starkware/statement/statement.h"
@@ -27,12 +29,22 @@ namespace starkware {
 
 /*
   Helper function that reads the configurations from objects (instead of files) and returns the
-  proof generated. If a path proof_file_name is given, the proof is written to it.
+  proof generated. If a path proof_file_name is given, the proof is written to it, either as a
+  unified JSON document or, for ProofOutputFormat::kBinary, as a binary proof file (see
+  binary_proof.h) to which the proof is streamed while it is generated. A streamed proof is not
+  kept in memory, and an empty proof is returned.
+
+  If memory_budget (in bytes) is nonzero, the fields of the prover config that trade memory for
+  time are replaced by the fastest choice whose predicted peak memory fits in it (see
+  prover_config_planner.h). If dry_run is true, the predicted cost of the config is printed and an
+  empty proof is returned without proving.
 */
 std::vector<std::byte> ProverMainHelperImpl(
     Statement* statement, const JsonValue& parameters, const JsonValue& stark_config_json,
     const JsonValue& public_input, const std::string& out_file_name = "",
-    bool generate_annotations = false, const ProverVersion& prover_version = {});
+    bool generate_annotations = false, const ProverVersion& prover_version = {},
+    ProofOutputFormat out_file_format = ProofOutputFormat::kJson, uint64_t memory_budget = 0,
+    bool dry_run = false);
 
 }  // namespace starkware
 
@@ -0,0 +1,115 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/main/prover_server.h"
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "glog/logging.h"
+
+#include "starkware/error_handling/error_handling.h"
+
+namespace starkware {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+bool HasJobSuffix(const std::string& file_name) {
+  const std::string suffix = ProverServer::kJobSuffix;
+  return file_name.size() > suffix.size() &&
+         file_name.compare(file_name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+ProverServer::ProverServer(std::string spool_dir, JobRunner job_runner)
+    : spool_dir_(std::move(spool_dir)), job_runner_(std::move(job_runner)) {
+  ASSERT_RELEASE(
+      fs::is_directory(spool_dir_), "Spool directory \"" + spool_dir_ + "\" does not exist.");
+}
+
+std::optional<std::string> ProverServer::ClaimNextJob() const {
+  std::vector<std::string> pending_jobs;
+  for (const auto& entry : fs::directory_iterator(spool_dir_)) {
+    if (entry.is_regular_file() && HasJobSuffix(entry.path().filename().string())) {
+      pending_jobs.push_back(entry.path().string());
+    }
+  }
+  std::sort(pending_jobs.begin(), pending_jobs.end());
+
+  for (const std::string& job_path : pending_jobs) {
+    // rename() is atomic, so if several servers share a spool directory, only one of them
+    // succeeds in claiming the job.
+    const std::string running_path = job_path + ".running";
+    std::error_code error;
+    fs::rename(job_path, running_path, error);
+    if (!error) {
+      return running_path;
+    }
+  }
+  return std::nullopt;
+}
+
+bool ProverServer::ProcessNextJob() {
+  const std::optional<std::string> running_path = ClaimNextJob();
+  if (!running_path.has_value()) {
+    return false;
+  }
+  // Strip ".running".
+  const std::string job_path = fs::path(*running_path).replace_extension().string();
+  LOG(INFO) << "Processing job " << job_path;
+
+  std::optional<std::string> error_message;
+  try {
+    job_runner_(JsonValue::FromFile(*running_path));
+  } catch (const std::exception& e) {
+    error_message = e.what();
+  }
+
+  if (error_message.has_value()) {
+    LOG(ERROR) << "Job " << job_path << " failed: " << *error_message;
+    std::ofstream(job_path + ".error") << *error_message << std::endl;
+    fs::rename(*running_path, job_path + ".failed");
+    n_jobs_failed_++;
+  } else {
+    fs::rename(*running_path, job_path + ".done");
+    n_jobs_succeeded_++;
+  }
+  return true;
+}
+
+bool ProverServer::ShutdownRequested() const {
+  return fs::exists(fs::path(spool_dir_) / kShutdownFileName);
+}
+
+void ProverServer::Serve(std::chrono::milliseconds poll_interval) {
+  LOG(INFO) << "Serving proof jobs from " << spool_dir_;
+  while (!ShutdownRequested()) {
+    if (!ProcessNextJob()) {
+      std::this_thread::sleep_for(poll_interval);
+    }
+  }
+  fs::remove(fs::path(spool_dir_) / kShutdownFileName);
+  LOG(INFO) << "Shutting down after " << n_jobs_succeeded_ << " successful and " << n_jobs_failed_
+            << " failed jobs.";
+}
+
+}  // namespace starkware
@@ -0,0 +1,86 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#ifndef STARKWARE_MAIN_PROVER_SERVER_H_
+#define STARKWARE_MAIN_PROVER_SERVER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+
+#include "starkware/utils/json.h"
+
+namespace starkware {
+
+/*
+  A long running prover that takes proof jobs from a spool directory. Running many proofs in one
+  process avoids paying the process startup for each proof: the thread pool is created once, and
+  precomputation that only depends on the layout (e.g., the constant periodic columns of the
+  builtins) is computed by the first job and reused by the following ones.
+
+  Protocol:
+    * A client submits a job by creating <name>.json in the spool directory. The file should be
+      written under a different name and then renamed, so that the server never reads a partial
+      job.
+    * The server claims a job by renaming it to <name>.json.running. Jobs are processed one at a
+      time, in lexicographic order of their names, and each job uses the whole thread pool.
+    * When the job is done, the file is renamed to <name>.json.done. If the job failed, it is
+      renamed to <name>.json.failed and the error message is written to <name>.json.error.
+    * Creating a file named "shutdown" in the spool directory stops the server after the current
+      job. The server removes the file when it stops.
+
+  The content of the job file is passed as is to the JobRunner given to the constructor.
+*/
+class ProverServer {
+ public:
+  using JobRunner = std::function<void(const JsonValue& job)>;
+
+  static constexpr const char* kJobSuffix = ".json";
+  static constexpr const char* kShutdownFileName = "shutdown";
+
+  ProverServer(std::string spool_dir, JobRunner job_runner);
+
+  /*
+    Processes the next pending job, if there is one. Returns false if there was no pending job.
+  */
+  bool ProcessNextJob();
+
+  /*
+    Processes jobs until a shutdown is requested. Polls the spool directory every poll_interval when
+    there are no pending jobs.
+  */
+  void Serve(std::chrono::milliseconds poll_interval);
+
+  size_t NumJobsSucceeded() const { return n_jobs_succeeded_; }
+  size_t NumJobsFailed() const { return n_jobs_failed_; }
+
+ private:
+  /*
+    Claims the first pending job, and returns the path of the claimed (.running) file.
+  */
+  std::optional<std::string> ClaimNextJob() const;
+
+  bool ShutdownRequested() const;
+
+  const std::string spool_dir_;
+  const JobRunner job_runner_;
+  size_t n_jobs_succeeded_ = 0;
+  size_t n_jobs_failed_ = 0;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_MAIN_PROVER_SERVER_H_
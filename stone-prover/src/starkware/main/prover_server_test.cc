@@ -0,0 +1,134 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/main/prover_server.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/error_handling/test_utils.h"
+#include "starkware/utils/json_builder.h"
+
+namespace starkware {
+namespace {
+
+namespace fs = std::filesystem;
+
+using testing::ElementsAre;
+using testing::HasSubstr;
+
+class ProverServerTest : public ::testing::Test {
+ public:
+  ProverServerTest() {
+    fs::remove_all(kSpoolDir);
+    fs::create_directories(kSpoolDir);
+  }
+  ~ProverServerTest() override { fs::remove_all(kSpoolDir); }
+
+  ProverServerTest(const ProverServerTest&) = delete;
+  ProverServerTest& operator=(const ProverServerTest&) = delete;
+  ProverServerTest(ProverServerTest&&) = delete;
+  ProverServerTest& operator=(ProverServerTest&&) = delete;
+
+ protected:
+  static void SubmitJob(const std::string& name, const std::string& id) {
+    JsonBuilder builder;
+    builder["id"] = id;
+    builder.Build().Write(SpoolPath(name));
+  }
+
+  static std::string SpoolPath(const std::string& name) { return kSpoolDir + "/" + name; }
+
+  static std::string ReadFile(const std::string& name) {
+    std::ifstream file(SpoolPath(name));
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+  }
+
+  static inline const std::string kSpoolDir = "/tmp/prover_server_test";
+};
+
+TEST_F(ProverServerTest, ProcessesJobsInOrder) {
+  std::vector<std::string> ids;
+  ProverServer server(
+      kSpoolDir, [&](const JsonValue& job) { ids.push_back(job["id"].AsString()); });
+
+  SubmitJob("job_b.json", "b");
+  SubmitJob("job_a.json", "a");
+  // Files without the .json suffix are not jobs.
+  SubmitJob("job_c.json.tmp", "c");
+
+  EXPECT_TRUE(server.ProcessNextJob());
+  EXPECT_TRUE(server.ProcessNextJob());
+  EXPECT_FALSE(server.ProcessNextJob());
+  EXPECT_THAT(ids, ElementsAre("a", "b"));
+  EXPECT_EQ(server.NumJobsSucceeded(), 2U);
+  EXPECT_TRUE(fs::exists(SpoolPath("job_a.json.done")));
+  EXPECT_TRUE(fs::exists(SpoolPath("job_b.json.done")));
+  EXPECT_FALSE(fs::exists(SpoolPath("job_a.json")));
+}
+
+TEST_F(ProverServerTest, FailedJob) {
+  ProverServer server(kSpoolDir, [](const JsonValue& job) {
+    if (job["id"].AsString() == "bad") {
+      THROW_STARKWARE_EXCEPTION("Invalid job.");
+    }
+  });
+
+  SubmitJob("job_0.json", "bad");
+  SubmitJob("job_1.json", "good");
+  // A job which is not valid JSON.
+  std::ofstream(SpoolPath("job_2.json")) << "{";
+
+  while (server.ProcessNextJob()) {
+  }
+  EXPECT_EQ(server.NumJobsSucceeded(), 1U);
+  EXPECT_EQ(server.NumJobsFailed(), 2U);
+  EXPECT_TRUE(fs::exists(SpoolPath("job_0.json.failed")));
+  EXPECT_THAT(ReadFile("job_0.json.error"), HasSubstr("Invalid job."));
+  EXPECT_TRUE(fs::exists(SpoolPath("job_1.json.done")));
+  EXPECT_TRUE(fs::exists(SpoolPath("job_2.json.failed")));
+}
+
+TEST_F(ProverServerTest, Shutdown) {
+  size_t n_jobs = 0;
+  ProverServer server(kSpoolDir, [&](const JsonValue& /*job*/) {
+    n_jobs++;
+    // Request a shutdown while the first job is running.
+    std::ofstream(SpoolPath(ProverServer::kShutdownFileName)).flush();
+  });
+
+  SubmitJob("job_0.json", "0");
+  SubmitJob("job_1.json", "1");
+  server.Serve(std::chrono::milliseconds(1));
+  EXPECT_EQ(n_jobs, 1U);
+  EXPECT_TRUE(fs::exists(SpoolPath("job_1.json")));
+  EXPECT_FALSE(fs::exists(SpoolPath(ProverServer::kShutdownFileName)));
+}
+
+TEST_F(ProverServerTest, MissingSpoolDir) {
+  EXPECT_ASSERT(
+      ProverServer(kSpoolDir + "/missing", [](const JsonValue& /*job*/) {}),
+      HasSubstr("does not exist"));
+}
+
+}  // namespace
+}  // namespace starkware
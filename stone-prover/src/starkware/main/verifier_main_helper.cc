@@ -16,7 +16,9 @@
 
 #include <cstddef>
 #include <fstream>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "third_party/gsl/gsl-lite.hpp"
@@ -25,12 +27,15 @@
 #include "starkware/commitment_scheme/table_verifier.h"
 #include "starkware/commitment_scheme/table_verifier_impl.h"
 #include "starkware/crypt_tools/keccak_256.h"
+#include "starkware/main/binary_proof.h"
 #include "starkware/main/verifier_main_helper_impl.h"
 #include "starkware/proof_system/proof_system.h"
 #include "starkware/randomness/prng.h"
 #include "starkware/utils/flag_validators.h"
 
-DEFINE_string(in_file, "", "Path to the unified input file.");
+DEFINE_string(
+    in_file, "",
+    "Path to the unified input file. Either the JSON output of the prover or a binary proof file.");
 DEFINE_validator(in_file, &starkware::ValidateInputFile);
 
 DEFINE_string(
@@ -56,15 +61,29 @@ JsonValue ReadInputJson(const std::string& in_file_name) {
 struct VerifierParameters {
   JsonValue public_input;
   JsonValue parameters;
-  std::vector<std::byte> proof;
+  // The proof is either a view into the mapped binary proof file held by binary_proof_reader, or
+  // a view into proof_bytes decoded from the JSON input.
+  std::unique_ptr<BinaryProofReader> binary_proof_reader;
+  std::vector<std::byte> proof_bytes;
+  gsl::span<const std::byte> proof;
 };
 
 VerifierParameters GetVerifierParameters() {
+  if (auto reader = BinaryProofReader::TryOpen(FLAGS_in_file)) {
+    JsonValue public_input = reader->GetJsonSection(BinaryProofSection::kPublicInput);
+    JsonValue parameters = reader->GetJsonSection(BinaryProofSection::kProofParameters);
+    const auto proof = reader->GetSection(BinaryProofSection::kProof);
+    return {std::move(public_input), std::move(parameters), std::move(reader), {}, proof};
+  }
+
   JsonValue input_json = ReadInputJson(FLAGS_in_file);
   std::string proof_hex = input_json["proof_hex"].AsString();
   std::vector<std::byte> proof((proof_hex.size() - 1) / 2);
   starkware::HexStringToBytes(proof_hex, proof);
-  return {input_json["public_input"], input_json["proof_parameters"], proof};
+  VerifierParameters verifier_params{
+      input_json["public_input"], input_json["proof_parameters"], nullptr, std::move(proof), {}};
+  verifier_params.proof = verifier_params.proof_bytes;
+  return verifier_params;
 }
 
 }  // namespace
@@ -36,7 +36,7 @@
 namespace starkware {
 
 bool VerifierMainHelperImpl(
-    Statement* statement, const std::vector<std::byte>& proof, const JsonValue& parameters,
+    Statement* statement, gsl::span<const std::byte> proof, const JsonValue& parameters,
     const std::string& annotation_file_name, const std::string& extra_output_file_name) {
   try {
     const Air& air = statement->GetAir();
@@ -15,8 +15,10 @@
 #ifndef STARKWARE_MAIN_VERIFIER_MAIN_HELPER_IMPL_H_
 #define STARKWARE_MAIN_VERIFIER_MAIN_HELPER_IMPL_H_
 
+#include <cstddef>
 #include <string>
-#include <vector>
+
+#include "third_party/gsl/gsl-lite.hpp"
 
 #include "starkware/stark/stark.h"
 #include "starkware/statement/statement.h"
@@ -27,7 +29,7 @@ namespace starkware {
   Helper function for writing a main() function for STARK verifiers.
 */
 bool VerifierMainHelperImpl(
-    Statement* statement, const std::vector<std::byte>& proof, const JsonValue& parameters,
+    Statement* statement, gsl::span<const std::byte> proof, const JsonValue& parameters,
     const std::string& annotation_file_name, const std::string& extra_output_file_name);
 
 }  // namespace starkware
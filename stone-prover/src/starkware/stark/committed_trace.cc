@@ -15,9 +15,12 @@
 #include "starkware/stark/committed_trace.h"
 
 #include <map>
+#include <vector>
 
 #include "starkware/algebra/fields/field_operations_helper.h"
+#include "starkware/stl_utils/containers.h"
 #include "starkware/utils/profiling.h"
+#include "starkware/utils/progress.h"
 
 namespace starkware {
 
@@ -75,6 +78,11 @@ void CommittedTraceProver::Commit(Trace&& trace, const FftBases& trace_domain, b
 
   lde_->FinalizeAdding();
 
+  if (cached_lde_config_.eval_all_cosets_at_once) {
+    ProfilingBlock lde_block("LDE");
+    lde_->EvalOnAllCosets();
+  }
+
   auto storage = lde_->AllocateStorage();
   for (uint64_t coset_index = 0; coset_index < evaluation_domain_->NumCosets(); coset_index++) {
     ProfilingBlock lde_block("LDE");
@@ -86,6 +94,8 @@ void CommittedTraceProver::Commit(Trace&& trace, const FftBases& trace_domain, b
     table_prover_->AddSegmentForCommitment(
         {lde_evaluations->begin(), lde_evaluations->end()}, coset_index);
     commit_to_lde_block.CloseBlock();
+    ProgressReporter::GetInstance().ReportStep(
+        "LDE coset", coset_index + 1, evaluation_domain_->NumCosets());
   }
 
   table_prover_->Commit();
@@ -100,13 +110,15 @@ void CommittedTraceProver::DecommitQueries(
   const uint64_t trace_length = evaluation_domain_->Group().Size();
 
   // The commitment items we need to open.
-  std::set<RowCol> data_queries;
+  std::vector<RowCol> data_queries;
+  data_queries.reserve(queries.size());
   for (const auto& [coset_index, offset, column_index] : queries) {
     ASSERT_RELEASE(coset_index < evaluation_domain_->NumCosets(), "Coset index out of range");
     ASSERT_RELEASE(offset < trace_length, "Coset offset out of range");
     ASSERT_RELEASE(column_index < NumColumns(), "Column index out of range");
-    data_queries.emplace(coset_index * trace_length + offset, column_index);
+    data_queries.emplace_back(coset_index * trace_length + offset, column_index);
   }
+  SortAndRemoveDuplicates(&data_queries);
 
   // Commitment rows to fetch.
   const std::vector<uint64_t> rows_to_fetch =
@@ -157,10 +169,12 @@ void CommittedTraceProver::EvalMaskAtPoint(
     lde_->EvalAtPointsNotCached(column_index, points, column_output);
 
     // Place outputs at correct place.
-    for (size_t i = 0; i < offsets.size(); ++i) {
-      const size_t mask_index = offsets[i].second;
-      output.Set(mask_index, column_output.At(i));
+    std::vector<uint64_t> mask_indices;
+    mask_indices.reserve(offsets.size());
+    for (const auto& offset_pair : offsets) {
+      mask_indices.push_back(offset_pair.second);
     }
+    output.ScatterFrom(column_output, mask_indices);
   }
 }
 
@@ -35,7 +35,8 @@ void TestEndToEnd(
     bool verify_decommit_in_base_field = false) {
   SCOPED_TRACE(
       "config = {" + std::to_string(config.store_full_lde) + "," +
-      std::to_string(config.use_fft_for_eval) + ", order = " +
+      std::to_string(config.use_fft_for_eval) + "," +
+      std::to_string(config.eval_all_cosets_at_once) + "}, order = " +
       (order == MultiplicativeGroupOrdering::kNaturalOrder ? "Natural order"
                                                            : "Bit reversed order"));
   Prng prng;
@@ -155,21 +156,30 @@ void TestEndToEnd(
 }
 
 TEST(CommittedTraceProver, Basic) {
-  TestEndToEnd<TestFieldElement>({false, false}, MultiplicativeGroupOrdering::kNaturalOrder);
-  TestEndToEnd<TestFieldElement>({false, true}, MultiplicativeGroupOrdering::kNaturalOrder);
-  TestEndToEnd<TestFieldElement>({true, true}, MultiplicativeGroupOrdering::kNaturalOrder);
-  TestEndToEnd<TestFieldElement>({false, false}, MultiplicativeGroupOrdering::kBitReversedOrder);
-  TestEndToEnd<TestFieldElement>({false, true}, MultiplicativeGroupOrdering::kBitReversedOrder);
-  TestEndToEnd<TestFieldElement>({true, true}, MultiplicativeGroupOrdering::kBitReversedOrder);
+  TestEndToEnd<TestFieldElement>({false, false, false}, MultiplicativeGroupOrdering::kNaturalOrder);
+  TestEndToEnd<TestFieldElement>({false, true, false}, MultiplicativeGroupOrdering::kNaturalOrder);
+  TestEndToEnd<TestFieldElement>({true, true, false}, MultiplicativeGroupOrdering::kNaturalOrder);
+  TestEndToEnd<TestFieldElement>(
+      {false, false, false}, MultiplicativeGroupOrdering::kBitReversedOrder);
+  TestEndToEnd<TestFieldElement>(
+      {false, true, false}, MultiplicativeGroupOrdering::kBitReversedOrder);
+  TestEndToEnd<TestFieldElement>(
+      {true, true, false}, MultiplicativeGroupOrdering::kBitReversedOrder);
+  TestEndToEnd<TestFieldElement>({true, false, true}, MultiplicativeGroupOrdering::kNaturalOrder);
+  TestEndToEnd<TestFieldElement>(
+      {true, false, true}, MultiplicativeGroupOrdering::kBitReversedOrder);
 
   // When verify_decommit_in_base_field is true the verifier expects the trace to be generated in
   // the base field (and not in the extension field, as done in the test), hence an exception should
   // be thrown. When verify_decommit_in_base_field is false, the decommit should pass.
   TestEndToEnd<ExtensionFieldElement<TestFieldElement>>(
-      {true, true}, MultiplicativeGroupOrdering::kBitReversedOrder,
+      {true, true, false}, MultiplicativeGroupOrdering::kBitReversedOrder,
       /*verify_decommit_in_base_field=*/true);
   TestEndToEnd<ExtensionFieldElement<TestFieldElement>>(
-      {true, true}, MultiplicativeGroupOrdering::kBitReversedOrder,
+      {true, true, false}, MultiplicativeGroupOrdering::kBitReversedOrder,
+      /*verify_decommit_in_base_field=*/false);
+  TestEndToEnd<ExtensionFieldElement<TestFieldElement>>(
+      {true, false, true}, MultiplicativeGroupOrdering::kBitReversedOrder,
       /*verify_decommit_in_base_field=*/false);
 }
 
@@ -14,10 +14,13 @@
 
 #include "starkware/stark/composition_oracle.h"
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "starkware/channel/annotation_scope.h"
 #include "starkware/utils/profiling.h"
+#include "starkware/utils/progress.h"
 
 namespace starkware {
 
@@ -117,14 +120,22 @@ FieldElementVector CompositionOracleProver::EvalComposition(uint64_t task_size)
   ASSERT_RELEASE(
       n_segments <= evaluation_domain_->NumCosets(),
       "Composition polynomial degree bound is larger than evaluation domain");
-  auto evaluation =
-      FieldElementVector::MakeUninitialized(field, composition_polynomial_->GetDegreeBound());
+  auto evaluation = FieldElementVector::MakeUninitializedHugePage(
+      field, composition_polynomial_->GetDegreeBound());
+
+  // The storages of the coset coset_index are storages[coset_index % kNCosetsInMemory] and
+  // bitrev_storages[coset_index % kNCosetsInMemory].
+  std::vector<std::vector<std::unique_ptr<std::vector<FieldElementVector>>>> storages(
+      kNCosetsInMemory);
+  for (auto& coset_storages : storages) {
+    coset_storages.reserve(traces_.size());
+    for (const auto& trace : traces_) {
+      coset_storages.emplace_back(trace->GetLde()->AllocateStorage());
+    }
+  }
 
-  std::vector<std::unique_ptr<std::vector<FieldElementVector>>> storages;
   size_t n_cached_columns = 0;
-  storages.reserve(traces_.size());
   for (const auto& trace : traces_) {
-    storages.emplace_back(trace->GetLde()->AllocateStorage());
     if (trace->GetLde()->IsCached()) {
       n_cached_columns += trace->NumColumns();
     }
@@ -133,45 +144,69 @@ FieldElementVector CompositionOracleProver::EvalComposition(uint64_t task_size)
   // Allocate storage for bit reversal.
   const size_t n_total_columns = Sum(GetWidths(traces_));
 
-  std::vector<FieldElementVector> bitrev_storages;
-  bitrev_storages.reserve(n_cached_columns);
-  for (size_t i = 0; i < n_cached_columns; ++i) {
-    bitrev_storages.emplace_back(FieldElementVector::MakeUninitialized(field, trace_length));
+  std::vector<std::vector<FieldElementVector>> bitrev_storages(kNCosetsInMemory);
+  for (auto& coset_bitrev_storages : bitrev_storages) {
+    coset_bitrev_storages.reserve(n_cached_columns);
+    for (size_t i = 0; i < n_cached_columns; ++i) {
+      coset_bitrev_storages.emplace_back(
+          FieldElementVector::MakeUninitialized(field, trace_length));
+    }
   }
 
-  const size_t log_n_cosets = SafeLog2(evaluation_domain_->NumCosets());
-  for (uint64_t coset_index = 0; coset_index < n_segments; coset_index++) {
+  std::vector<std::vector<ConstFieldElementSpan>> all_evals(kNCosetsInMemory);
+  const auto compute_coset_lde = [&](uint64_t coset_index) {
+    const size_t storage_index = coset_index % kNCosetsInMemory;
     size_t bitrev_storage_index = 0;
-    std::vector<ConstFieldElementSpan> all_evals;
-    all_evals.reserve(n_total_columns);
+    std::vector<ConstFieldElementSpan>& coset_evals = all_evals[storage_index];
+    coset_evals.clear();
+    coset_evals.reserve(n_total_columns);
 
     // Evaluate all traces at the coset.
     for (size_t trace_idx = 0; trace_idx < traces_.size(); ++trace_idx) {
+      std::vector<FieldElementVector>* storage = storages[storage_index][trace_idx].get();
       ProfilingBlock profiling_lde_block("LDE2");
       const std::vector<FieldElementVector>* coset_columns_eval =
-          traces_[trace_idx]->GetLde()->EvalOnCoset(coset_index, storages[trace_idx].get());
+          traces_[trace_idx]->GetLde()->EvalOnCoset(coset_index, storage);
       profiling_lde_block.CloseBlock();
 
       ProfilingBlock profiling_block("BitReversal of columns");
       for (size_t col_idx = 0; col_idx < coset_columns_eval->size(); ++col_idx) {
         if (traces_[trace_idx]->GetLde()->IsCached()) {
+          std::vector<FieldElementVector>& coset_bitrev_storages = bitrev_storages[storage_index];
           ASSERT_RELEASE(
-              bitrev_storage_index < bitrev_storages.size(), "Not enough bitrev storages");
-          BitReverseVector(coset_columns_eval->at(col_idx), bitrev_storages[bitrev_storage_index]);
-          all_evals.emplace_back(bitrev_storages[bitrev_storage_index++]);
+              bitrev_storage_index < coset_bitrev_storages.size(), "Not enough bitrev storages");
+          BitReverseVector(
+              coset_columns_eval->at(col_idx), coset_bitrev_storages[bitrev_storage_index]);
+          coset_evals.emplace_back(coset_bitrev_storages[bitrev_storage_index++]);
         } else {
-          BitReverseInPlace(storages[trace_idx]->at(col_idx));
-          all_evals.emplace_back(storages[trace_idx]->at(col_idx));
+          BitReverseInPlace(storage->at(col_idx));
+          coset_evals.emplace_back(storage->at(col_idx));
         }
       }
     }
+  };
+
+  const size_t log_n_cosets = SafeLog2(evaluation_domain_->NumCosets());
+  compute_coset_lde(0);
+  for (uint64_t coset_index = 0; coset_index < n_segments; coset_index++) {
+    // The LDE of the next coset is computed while the last tasks of this coset are evaluated. Its
+    // storage was used by the previous coset, whose evaluation is done.
+    std::function<void()> compute_next_coset_lde;
+    if (coset_index + 1 < n_segments) {
+      compute_next_coset_lde = [&compute_coset_lde, coset_index]() {
+        compute_coset_lde(coset_index + 1);
+      };
+    }
 
     const size_t coset_natural_index = BitReverse(coset_index, log_n_cosets);
     const FieldElement coset_offset = evaluation_domain_->CosetsOffsets()[coset_natural_index];
     ProfilingBlock composition_block("Actual point-wise computation");
     composition_polynomial_->EvalOnCosetBitReversedOutput(
-        coset_offset, all_evals,
-        evaluation.AsSpan().SubSpan(coset_index * trace_length, trace_length), task_size);
+        coset_offset, all_evals[coset_index % kNCosetsInMemory],
+        evaluation.AsSpan().SubSpan(coset_index * trace_length, trace_length), task_size,
+        compute_next_coset_lde);
+    composition_block.CloseBlock();
+    ProgressReporter::GetInstance().ReportStep("Composition coset", coset_index + 1, n_segments);
   }
   return evaluation;
 }
@@ -179,7 +214,7 @@ FieldElementVector CompositionOracleProver::EvalComposition(uint64_t task_size)
 void CompositionOracleProver::DecommitQueries(
     const std::vector<std::pair<uint64_t, uint64_t>>& queries) const {
   for (size_t trace_i = 0; trace_i < traces_.size(); ++trace_i) {
-    AnnotationScope scope(channel_, "Trace " + std::to_string(trace_i));
+    AnnotationScope scope(channel_, [&] { return "Trace " + std::to_string(trace_i); });
     const auto trace_queries =
         QueriesToTraceQueries(queries, split_masks_[trace_i], evaluation_domain_->Group().Size());
 
@@ -200,12 +235,17 @@ void CompositionOracleProver::EvalMaskAtPoint(
     trace_mask_evaluations.push_back(std::move(eval));
   }
 
+  // Trace trace_i evaluated its part of the mask in order, so its j-th value belongs to the j-th
+  // mask item that refers to one of its columns.
   const auto& sizes = GetWidths(traces_);
-  std::vector<size_t> mask_offset_in_trace(traces_.size());
+  std::vector<std::vector<uint64_t>> mask_indices_in_trace(traces_.size());
   for (size_t mask_i = 0; mask_i < mask_.size(); ++mask_i) {
     const auto& mask_col = mask_[mask_i].second;
     const auto& trace_i = ColumnToTraceColumn(mask_col, sizes).first;
-    output.Set(mask_i, trace_mask_evaluations[trace_i][mask_offset_in_trace[trace_i]++]);
+    mask_indices_in_trace[trace_i].push_back(mask_i);
+  }
+  for (size_t trace_i = 0; trace_i < traces_.size(); ++trace_i) {
+    output.ScatterFrom(trace_mask_evaluations[trace_i], mask_indices_in_trace[trace_i]);
   }
 }
 
@@ -243,7 +283,7 @@ FieldElementVector CompositionOracleVerifier::VerifyDecommitment(
   std::vector<FieldElementVector> trace_mask_values;
   trace_mask_values.reserve(traces_.size());
   for (size_t trace_i = 0; trace_i < traces_.size(); ++trace_i) {
-    AnnotationScope scope(channel_, "Trace " + std::to_string(trace_i));
+    AnnotationScope scope(channel_, [&] { return "Trace " + std::to_string(trace_i); });
     const auto trace_queries =
         QueriesToTraceQueries(queries, split_masks_[trace_i], evaluation_domain_->Group().Size());
 
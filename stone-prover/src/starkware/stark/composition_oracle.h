@@ -49,12 +49,19 @@ class CompositionOracleProver {
       gsl::span<const std::pair<int64_t, uint64_t>> mask, MaybeOwnedPtr<const Air> air,
       MaybeOwnedPtr<const CompositionPolynomial> composition_polynomial, ProverChannel* channel);
 
+  /*
+    The number of cosets whose trace LDE is held in memory at the same time by EvalComposition():
+    the coset that is evaluated and the next one.
+  */
+  static constexpr size_t kNCosetsInMemory = 2;
+
   /*
     Evaluates the composition polynomial over d cosets, where d is the degree bound of the
     composition polynomial over the trace length.
 
     The evaluation is done in task_size tasks. This is forwarded to the composition polynomial
-    EvalOnCosetBitReversedOutput, see more info there.
+    EvalOnCosetBitReversedOutput, see more info there. The LDE of the next coset is computed in the
+    same task pool, while the tasks of the current coset are evaluated.
   */
   FieldElementVector EvalComposition(uint64_t task_size) const;
 
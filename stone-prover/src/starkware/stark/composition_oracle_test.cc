@@ -14,6 +14,7 @@
 
 #include "starkware/stark/composition_oracle.h"
 
+#include <functional>
 #include <memory>
 
 #include "gmock/gmock.h"
@@ -36,6 +37,7 @@ using testing::Invoke;
 using testing::Property;
 using testing::Return;
 using testing::StrictMock;
+using testing::Truly;
 
 using FieldElementT = TestFieldElement;
 
@@ -100,7 +102,8 @@ void CompositionOracleProverTester::TestEvalComposition(size_t degree_bound) {
   Prng prng;
   CachedLdeManager::Config cached_lde_manager_config = {
       /*store_full_lde=*/false,
-      /*use_fft_for_eval=*/false};
+      /*use_fft_for_eval=*/false,
+      /*eval_all_cosets_at_once=*/false};
 
   const size_t log_cosets = SafeLog2(evaluation_domain.NumCosets());
   for (uint64_t i = 0; i < coset_offsets_bit_reversed.Size(); ++i) {
@@ -132,7 +135,9 @@ void CompositionOracleProverTester::TestEvalComposition(size_t degree_bound) {
       .WillRepeatedly(Return(degree_bound * trace_length));
   for (uint64_t coset_index = 0; coset_index < degree_bound; coset_index++) {
     const FieldElement coset_offset = coset_offsets_bit_reversed[coset_index];
-    // Test that each coset is computed with correct offset, and correct sizes of arguments.
+    const bool is_last = coset_index + 1 == degree_bound;
+    // Test that each coset is computed with correct offset, and correct sizes of arguments. The LDE
+    // of the next coset is computed by the concurrent task, so it is invoked before the next call.
     EXPECT_CALL(
         composition_polynomial,
         EvalOnCosetBitReversedOutput(
@@ -140,7 +145,16 @@ void CompositionOracleProverTester::TestEvalComposition(size_t degree_bound) {
             AllOf(
                 Property(&gsl::span<const ConstFieldElementSpan>::size, n_traces * n_columns),
                 Each(Property(&ConstFieldElementSpan::Size, trace_length))),
-            Property(&FieldElementSpan::Size, trace_length), task_size));
+            Property(&FieldElementSpan::Size, trace_length), task_size,
+            Truly([is_last](const std::function<void()>& task) { return !task == is_last; })))
+        .WillOnce(Invoke([](const FieldElement& /*coset_offset*/,
+                            gsl::span<const ConstFieldElementSpan> /*trace_lde*/,
+                            const FieldElementSpan& /*out_evaluation*/, uint64_t /*task_size*/,
+                            const std::function<void()>& concurrent_task) {
+          if (concurrent_task) {
+            concurrent_task();
+          }
+        }));
   }
 
   // Create CompositionOracleProver.
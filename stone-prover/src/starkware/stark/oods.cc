@@ -28,7 +28,7 @@ std::pair<Trace, std::unique_ptr<FftBases>> BreakCompositionPolynomial(
   const std::unique_ptr<const PolynomialBreak> poly_break =
       MakePolynomialBreak(bases, log_n_breaks);
 
-  FieldElementVector output = FieldElementVector::MakeUninitialized(
+  FieldElementVector output = FieldElementVector::MakeUninitializedHugePage(
       composition_evaluation.GetField(), composition_evaluation.Size());
   const std::vector<ConstFieldElementSpan> output_spans =
       poly_break->Break(composition_evaluation, output);
@@ -77,7 +77,7 @@ std::vector<std::tuple<size_t, FieldElement, FieldElement>> ProveOods(
     // Send values. This loop also creates the LHS of the boundary constraints to be returned.
     for (size_t i = 0; i < trace_evaluation_at_mask.Size(); ++i) {
       const auto& trace_eval_at_idx = trace_evaluation_at_mask.At(i);
-      channel->SendFieldElement(trace_eval_at_idx, std::to_string(i));
+      channel->SendFieldElement(trace_eval_at_idx, [&] { return std::to_string(i); });
       const auto& [row_offset, column_index] = mask[i];
       const auto& row_element = trace_gen.Pow(row_offset);
       boundary_constraints.emplace_back(column_index, point * row_element, trace_eval_at_idx);
@@ -113,7 +113,8 @@ std::vector<std::tuple<size_t, FieldElement, FieldElement>> ProveOods(
 
     // Send values. This loops also creates the RHS of the boundary constraints.
     for (size_t i = 0; i < broken_evaluation.Size(); ++i) {
-      channel->SendFieldElement(broken_evaluation.At(i), std::to_string(trace_mask_size + i));
+      channel->SendFieldElement(
+          broken_evaluation.At(i), [&] { return std::to_string(trace_mask_size + i); });
 
       // Assuming all broken_column appear right after trace columns.
       boundary_constraints.emplace_back(
@@ -148,7 +149,8 @@ std::vector<std::tuple<size_t, FieldElement, FieldElement>> VerifyOods(
   std::vector<bool> cols_seen(original_oracle.Width(), false);
 
   for (size_t i = 0; i < mask.size(); ++i) {
-    const FieldElement value = channel->ReceiveFieldElement(field, std::to_string(i));
+    const FieldElement value =
+        channel->ReceiveFieldElement(field, [&] { return std::to_string(i); });
     const auto& [row_offset, column_index] = mask[i];
     original_oracle_mask_evaluation.PushBack(value);
     boundary_constraints.emplace_back(column_index, point * trace_gen.Pow(row_offset), value);
@@ -175,7 +177,7 @@ std::vector<std::tuple<size_t, FieldElement, FieldElement>> VerifyOods(
   broken_evaluation.Reserve(n_breaks);
   for (size_t i = 0; i < n_breaks; ++i) {
     const FieldElement value =
-        channel->ReceiveFieldElement(field, std::to_string(trace_mask_size + i));
+        channel->ReceiveFieldElement(field, [&] { return std::to_string(trace_mask_size + i); });
     broken_evaluation.PushBack(value);
     boundary_constraints.emplace_back(
         original_oracle.Width() + i, point_transformed, broken_evaluation.At(i));
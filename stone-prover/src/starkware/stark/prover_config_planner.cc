@@ -0,0 +1,373 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/stark/prover_config_planner.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <iomanip>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+#include "starkware/error_handling/error_handling.h"
+#include "starkware/math/math.h"
+#include "starkware/stark/composition_oracle.h"
+
+namespace starkware {
+
+namespace {
+
+// The size of a Merkle tree node.
+constexpr uint64_t kHashSize = 32;
+
+// Costs of the basic operations, in nanoseconds on a single thread, for the 252-bit prime field.
+constexpr double kFftNsPerElementPerLayer = 10;
+constexpr double kMulNs = 20;
+constexpr double kHashNsPerByte = 4;
+constexpr double kConstraintNsPerRow = 60;
+constexpr double kTaskOverheadNs = 5000;
+
+// The largest number of Merkle layers that the planner considers keeping out of memory. Each
+// layer halves the memory of a tree and doubles the rows that are recomputed per query.
+constexpr size_t kMaxOutOfMemoryMerkleLayers = 5;
+
+constexpr uint64_t kMinConstraintPolynomialTaskSize = 64;
+constexpr uint64_t kMaxConstraintPolynomialTaskSize = 16384;
+constexpr size_t kMaxTableProverNTasksPerSegment = 128;
+
+/*
+  The fraction of the threads that is busy when n_tasks equal tasks are executed.
+*/
+double Efficiency(uint64_t n_tasks, size_t n_threads) {
+  if (n_tasks == 0) {
+    return 1;
+  }
+  const uint64_t n_rounds = DivCeil(n_tasks, n_threads);
+  return static_cast<double>(n_tasks) / static_cast<double>(n_rounds * n_threads);
+}
+
+/*
+  Returns the time in nanoseconds of work_ns split into n_tasks equal tasks.
+*/
+double ParallelNs(double work_ns, uint64_t n_tasks, size_t n_threads) {
+  const double total_ns = work_ns + kTaskOverheadNs * static_cast<double>(n_tasks);
+  return total_ns / (static_cast<double>(n_threads) * Efficiency(n_tasks, n_threads));
+}
+
+uint64_t MerkleTreeBytes(uint64_t n_rows, size_t n_out_of_memory_merkle_layers) {
+  return std::max<uint64_t>(
+      2 * kHashSize * n_rows / Pow2(n_out_of_memory_merkle_layers), 2 * kHashSize);
+}
+
+}  // namespace
+
+ProverPlanInput ProverPlanInput::FromStarkParameters(
+    const StarkParameters& params, size_t n_threads, size_t n_verifier_friendly_commitment_layers) {
+  const Air& air = *params.air;
+  const uint64_t trace_length = params.TraceLength();
+  const auto interaction_params = air.GetInteractionParams();
+  return {
+      /*trace_length=*/trace_length,
+      /*n_cosets=*/params.NumCosets(),
+      /*n_columns_first=*/air.GetNColumnsFirst(),
+      /*n_columns_interaction=*/
+      interaction_params.has_value() ? interaction_params->n_columns_second : 0,
+      /*n_composition_columns=*/
+      SafeDiv(air.GetCompositionPolynomialDegreeBound(), trace_length),
+      /*n_constraints=*/air.GetNumConstraints(),
+      /*mask_size=*/air.GetMask().size(),
+      /*element_size_in_bytes=*/params.field.ElementSizeInBytes(),
+      /*fri_step_list=*/params.fri_params->fri_step_list,
+      /*n_queries=*/params.fri_params->n_queries,
+      /*n_threads=*/std::max<size_t>(n_threads, 1),
+      /*n_verifier_friendly_commitment_layers=*/n_verifier_friendly_commitment_layers,
+  };
+}
+
+std::pair<uint64_t, std::string> ProverConfigPlanner::EstimatePeakMemory(
+    const StarkProverConfig& config) const {
+  const uint64_t n_rows = input_.trace_length;
+  const uint64_t n_cosets = input_.n_cosets;
+  const uint64_t element_size = input_.element_size_in_bytes;
+  const bool store_full_lde = config.cached_lde_config.store_full_lde;
+  const size_t merkle_layers = config.n_out_of_memory_merkle_layers;
+
+  // A single coset (or the coefficients) of a trace with n_columns columns.
+  const auto coset_bytes = [&](size_t n_columns) { return n_columns * n_rows * element_size; };
+  // The memory kept from the commitment of a trace until the end of the proof.
+  const auto committed_bytes = [&](size_t n_columns) -> uint64_t {
+    if (n_columns == 0) {
+      return 0;
+    }
+    return coset_bytes(n_columns) + (store_full_lde ? n_cosets * coset_bytes(n_columns) : 0) +
+           MerkleTreeBytes(n_rows * n_cosets, merkle_layers);
+  };
+
+  const size_t n_columns_first = input_.n_columns_first;
+  const size_t n_columns_interaction = input_.n_columns_interaction;
+  const size_t n_columns_composition = input_.n_composition_columns;
+  const uint64_t first = committed_bytes(n_columns_first);
+  const uint64_t interaction = committed_bytes(n_columns_interaction);
+  const uint64_t composition = committed_bytes(n_columns_composition);
+  const uint64_t composition_evaluation = coset_bytes(n_columns_composition);
+
+  // FRI keeps the witness (the evaluation of the first layer) and every committed layer.
+  uint64_t fri_bytes = n_rows * n_cosets * element_size;
+  uint64_t layer_size = n_rows * n_cosets;
+  const std::vector<size_t>& fri_step_list = input_.fri_step_list;
+  for (size_t layer = 1; layer < fri_step_list.size(); ++layer) {
+    layer_size /= Pow2(fri_step_list[layer - 1]);
+    fri_bytes += layer_size * element_size +
+                 MerkleTreeBytes(layer_size / Pow2(fri_step_list[layer]), merkle_layers);
+  }
+
+  const std::vector<std::pair<std::string, uint64_t>> stages = {
+      {"Commit on trace", first + coset_bytes(n_columns_first)},
+      {"Interaction", first + interaction + coset_bytes(n_columns_interaction)},
+      // EvalComposition() keeps the LDE of kNCosetsInMemory cosets (bit reversed copies of the
+      // cached cosets, or the computed cosets when the LDE is not stored).
+      {"Composition",
+       first + interaction + composition_evaluation +
+           std::min<uint64_t>(CompositionOracleProver::kNCosetsInMemory, n_cosets) *
+               coset_bytes(n_columns_first + n_columns_interaction)},
+      {"Commit on composition",
+       first + interaction + composition + coset_bytes(n_columns_composition)},
+      {"FRI", first + interaction + composition + fri_bytes +
+                  (store_full_lde ? 0
+                                  : coset_bytes(
+                                        n_columns_first + n_columns_interaction +
+                                        n_columns_composition))},
+  };
+  const auto by_bytes = [](const auto& a, const auto& b) { return a.second < b.second; };
+  const auto peak = std::max_element(stages.begin(), stages.end(), by_bytes);
+  return {peak->second, peak->first};
+}
+
+double ProverConfigPlanner::EstimateSeconds(const StarkProverConfig& config) const {
+  const uint64_t n_rows = input_.trace_length;
+  const uint64_t n_cosets = input_.n_cosets;
+  const auto log_n_rows = static_cast<double>(SafeLog2(n_rows));
+  const auto element_size = static_cast<double>(input_.element_size_in_bytes);
+  const size_t n_threads = input_.n_threads;
+  const CachedLdeManager::Config& lde_config = config.cached_lde_config;
+  const uint64_t n_rows_per_query = Pow2(config.n_out_of_memory_merkle_layers);
+  const uint64_t n_queried_rows = input_.n_queries * n_rows_per_query;
+
+  // An FFT of n_columns columns, one task per column.
+  const auto fft_ns = [&](size_t n_columns) {
+    return ParallelNs(
+        static_cast<double>(n_columns * n_rows) * log_n_rows * kFftNsPerElementPerLayer, n_columns,
+        n_threads);
+  };
+
+  // Evaluating n_columns columns on every coset when the LDE is not stored.
+  const auto recompute_lde_ns = [&](size_t n_columns) {
+    return lde_config.store_full_lde ? 0 : static_cast<double>(n_cosets) * fft_ns(n_columns);
+  };
+
+  const auto commit_ns = [&](size_t n_columns) -> double {
+    if (n_columns == 0) {
+      return 0;
+    }
+    // Interpolation and LDE.
+    double total = fft_ns(n_columns);
+    if (lde_config.eval_all_cosets_at_once) {
+      total += ParallelNs(
+          static_cast<double>(n_cosets * n_columns * n_rows) * log_n_rows *
+              kFftNsPerElementPerLayer,
+          n_cosets * n_columns, n_threads);
+    } else {
+      total += static_cast<double>(n_cosets) * fft_ns(n_columns);
+    }
+
+    // Hashing, segment by segment (a segment is a coset).
+    const uint64_t n_tasks_per_segment =
+        std::min<uint64_t>(config.table_prover_n_tasks_per_segment, n_rows);
+    const double segment_hash_ns =
+        static_cast<double>(n_rows) *
+        (static_cast<double>(n_columns) * element_size + 2 * kHashSize) * kHashNsPerByte;
+    total += static_cast<double>(n_cosets) *
+             ParallelNs(segment_hash_ns, n_tasks_per_segment, n_threads);
+
+    // Decommitment: the rows below the out of memory Merkle layers are recomputed.
+    total += static_cast<double>(n_queried_rows * n_columns) * element_size * kHashNsPerByte;
+    if (!lde_config.store_full_lde) {
+      if (lde_config.use_fft_for_eval) {
+        total += static_cast<double>(std::min(n_cosets, n_queried_rows)) * fft_ns(n_columns);
+      } else {
+        total += ParallelNs(
+            static_cast<double>(n_queried_rows * n_columns * n_rows) * kMulNs, n_queried_rows,
+            n_threads);
+      }
+    }
+    return total;
+  };
+
+  const size_t n_trace_columns = input_.n_columns_first + input_.n_columns_interaction;
+  const size_t n_columns_composition = input_.n_composition_columns;
+
+  double total_ns = commit_ns(input_.n_columns_first) + commit_ns(input_.n_columns_interaction);
+
+  // Composition polynomial, evaluated on n_columns_composition cosets.
+  const uint64_t task_size = std::min(config.constraint_polynomial_task_size, n_rows);
+  total_ns += static_cast<double>(n_columns_composition) *
+              (ParallelNs(
+                   static_cast<double>(n_rows * input_.n_constraints) * kConstraintNsPerRow,
+                   DivCeil(n_rows, task_size), n_threads) +
+               (lde_config.store_full_lde ? 0 : fft_ns(n_trace_columns)));
+  total_ns += commit_ns(n_columns_composition);
+
+  // The DEEP composition, which is the first FRI layer, and the FRI layers.
+  const uint64_t domain_size = n_rows * n_cosets;
+  total_ns += recompute_lde_ns(n_trace_columns + n_columns_composition);
+  total_ns += ParallelNs(
+      static_cast<double>(domain_size * (input_.mask_size + n_columns_composition)) * 2 * kMulNs,
+      n_threads, n_threads);
+  total_ns += ParallelNs(
+      static_cast<double>(domain_size) * (kMulNs + 2 * element_size * kHashNsPerByte), n_threads,
+      n_threads);
+
+  return total_ns * 1e-9;
+}
+
+ProverPlan ProverConfigPlanner::Estimate(const StarkProverConfig& config) const {
+  const auto [peak_memory_bytes, peak_memory_stage] = EstimatePeakMemory(config);
+  return {config, peak_memory_bytes, peak_memory_stage, EstimateSeconds(config), true};
+}
+
+std::vector<StarkProverConfig> ProverConfigPlanner::Candidates(
+    const StarkProverConfig& base) const {
+  const std::vector<CachedLdeManager::Config> lde_configs = {
+      {/*store_full_lde=*/true, /*use_fft_for_eval=*/false, /*eval_all_cosets_at_once=*/false},
+      {/*store_full_lde=*/true, /*use_fft_for_eval=*/false, /*eval_all_cosets_at_once=*/true},
+      {/*store_full_lde=*/false, /*use_fft_for_eval=*/false, /*eval_all_cosets_at_once=*/false},
+      {/*store_full_lde=*/false, /*use_fft_for_eval=*/true, /*eval_all_cosets_at_once=*/false},
+  };
+
+  std::set<uint64_t> task_sizes = {base.constraint_polynomial_task_size};
+  for (uint64_t task_size = kMinConstraintPolynomialTaskSize;
+       task_size <= std::min(kMaxConstraintPolynomialTaskSize, input_.trace_length);
+       task_size *= 4) {
+    task_sizes.insert(task_size);
+  }
+
+  // The verifier friendly layers are counted in units of log(table_prover_n_tasks_per_segment),
+  // so it may not change when they are used.
+  std::set<size_t> n_tasks_per_segment_options = {base.table_prover_n_tasks_per_segment};
+  if (input_.n_verifier_friendly_commitment_layers == 0) {
+    for (size_t n_tasks = 1;
+         n_tasks <= std::min<uint64_t>(kMaxTableProverNTasksPerSegment, input_.trace_length);
+         n_tasks *= 2) {
+      n_tasks_per_segment_options.insert(n_tasks);
+    }
+  }
+
+  const size_t max_merkle_layers =
+      std::min<size_t>(kMaxOutOfMemoryMerkleLayers, SafeLog2(input_.trace_length));
+
+  std::vector<StarkProverConfig> candidates;
+  for (const CachedLdeManager::Config& lde_config : lde_configs) {
+    for (uint64_t task_size : task_sizes) {
+      for (size_t n_tasks_per_segment : n_tasks_per_segment_options) {
+        for (size_t merkle_layers = 0; merkle_layers <= max_merkle_layers; ++merkle_layers) {
+          StarkProverConfig config = base;
+          config.cached_lde_config = lde_config;
+          config.constraint_polynomial_task_size = task_size;
+          config.table_prover_n_tasks_per_segment = n_tasks_per_segment;
+          config.n_out_of_memory_merkle_layers = merkle_layers;
+          candidates.push_back(config);
+        }
+      }
+    }
+  }
+  return candidates;
+}
+
+ProverPlan ProverConfigPlanner::Plan(const StarkProverConfig& base, uint64_t memory_budget) const {
+  std::optional<ProverPlan> fastest;
+  std::optional<ProverPlan> smallest;
+  for (const StarkProverConfig& config : Candidates(base)) {
+    ProverPlan plan = Estimate(config);
+    const auto by_time = [](const ProverPlan& plan) {
+      return std::make_tuple(plan.predicted_seconds, plan.peak_memory_bytes);
+    };
+    const auto by_memory = [](const ProverPlan& plan) {
+      return std::make_tuple(plan.peak_memory_bytes, plan.predicted_seconds);
+    };
+    if (!smallest.has_value() || by_memory(plan) < by_memory(*smallest)) {
+      smallest = plan;
+    }
+    if (plan.peak_memory_bytes <= memory_budget &&
+        (!fastest.has_value() || by_time(plan) < by_time(*fastest))) {
+      fastest = plan;
+    }
+  }
+
+  if (fastest.has_value()) {
+    return *fastest;
+  }
+  ASSERT_RELEASE(smallest.has_value(), "No candidate prover configs.");
+  smallest->fits_memory_budget = false;
+  return *smallest;
+}
+
+std::string ProverPlan::ToString() const {
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(1) << std::boolalpha;
+  if (!fits_memory_budget) {
+    ss << "Does not fit in the memory budget. ";
+  }
+  ss << "Peak memory: " << static_cast<double>(peak_memory_bytes) / (1024 * 1024) << " MB ("
+     << peak_memory_stage << "), time: " << predicted_seconds << " s"
+     << ", store_full_lde: " << config.cached_lde_config.store_full_lde
+     << ", use_fft_for_eval: " << config.cached_lde_config.use_fft_for_eval
+     << ", eval_all_cosets_at_once: " << config.cached_lde_config.eval_all_cosets_at_once
+     << ", constraint_polynomial_task_size: " << config.constraint_polynomial_task_size
+     << ", table_prover_n_tasks_per_segment: " << config.table_prover_n_tasks_per_segment
+     << ", n_out_of_memory_merkle_layers: " << config.n_out_of_memory_merkle_layers;
+  return ss.str();
+}
+
+uint64_t ParseMemorySize(const std::string& size) {
+  size_t pos = 0;
+  uint64_t value = 0;
+  while (pos < size.size() && std::isdigit(static_cast<unsigned char>(size[pos])) != 0) {
+    const uint64_t digit = size[pos] - '0';
+    ASSERT_RELEASE(value <= (UINT64_MAX - digit) / 10, "Memory size is too large: " + size);
+    value = value * 10 + digit;
+    ++pos;
+  }
+  ASSERT_RELEASE(pos > 0, "Invalid memory size: " + size);
+
+  std::string suffix = size.substr(pos);
+  std::transform(suffix.begin(), suffix.end(), suffix.begin(), [](unsigned char c) {
+    return static_cast<char>(std::toupper(c));
+  });
+  const std::vector<std::pair<std::string, size_t>> units = {
+      {"", 0}, {"B", 0}, {"K", 10}, {"M", 20}, {"G", 30}, {"T", 40}};
+  for (const auto& [unit, log_multiplier] : units) {
+    if (suffix == unit || (!unit.empty() && unit != "B" &&
+                           (suffix == unit + "B" || suffix == unit + "IB"))) {
+      ASSERT_RELEASE(
+          value <= (UINT64_MAX >> log_multiplier), "Memory size is too large: " + size);
+      return value << log_multiplier;
+    }
+  }
+  THROW_STARKWARE_EXCEPTION("Invalid memory size: " + size);
+}
+
+}  // namespace starkware
@@ -0,0 +1,124 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#ifndef STARKWARE_STARK_PROVER_CONFIG_PLANNER_H_
+#define STARKWARE_STARK_PROVER_CONFIG_PLANNER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "starkware/stark/stark.h"
+
+namespace starkware {
+
+/*
+  The properties of a proof that determine the memory and time of the prover.
+*/
+struct ProverPlanInput {
+  uint64_t trace_length;
+  size_t n_cosets;
+  size_t n_columns_first;
+  // 0 if the AIR has no interaction.
+  size_t n_columns_interaction;
+  // The number of columns of the composition trace (the composition degree bound divided by the
+  // trace length).
+  size_t n_composition_columns;
+  size_t n_constraints;
+  size_t mask_size;
+  size_t element_size_in_bytes;
+  std::vector<size_t> fri_step_list;
+  size_t n_queries;
+  size_t n_threads;
+  // When nonzero, table_prover_n_tasks_per_segment is tied to it and is not tuned (see
+  // CalculateNVerifierFriendlyLayersInSegment).
+  size_t n_verifier_friendly_commitment_layers;
+
+  static ProverPlanInput FromStarkParameters(
+      const StarkParameters& params, size_t n_threads,
+      size_t n_verifier_friendly_commitment_layers);
+};
+
+/*
+  A prover config together with its predicted cost.
+*/
+struct ProverPlan {
+  StarkProverConfig config;
+  uint64_t peak_memory_bytes;
+  // The stage of the proof at which the memory peaks.
+  std::string peak_memory_stage;
+  double predicted_seconds;
+  // False if no candidate config fits the memory budget. In this case config is the one with the
+  // smallest peak memory.
+  bool fits_memory_budget;
+
+  std::string ToString() const;
+};
+
+/*
+  Predicts the peak memory and the running time of the prover for a given StarkProverConfig, and
+  chooses the fastest config that fits in a memory budget.
+
+  Memory is modeled from the sizes of the buffers the prover keeps alive: for every committed trace
+  (the execution trace, the interaction trace and the composition trace) its coefficients, its LDE
+  on all the cosets if store_full_lde is set, and the cached layers of its Merkle tree; and on top
+  of those, the transient buffers of the current stage (a coset evaluation, the composition
+  evaluation and the FRI layers). The prediction does not include the memory of the statement
+  itself (e.g. the Cairo memory and the private input), so the budget should leave room for it.
+
+  Time is modeled from the number of FFT butterflies, field multiplications and hashed bytes of
+  each stage, with per-operation costs calibrated for the 252-bit prime field, divided among the
+  threads according to the number of tasks each stage is split into. The absolute prediction is
+  rough; it is meant for ranking configs against each other.
+*/
+class ProverConfigPlanner {
+ public:
+  explicit ProverConfigPlanner(ProverPlanInput input) : input_(std::move(input)) {}
+
+  /*
+    Returns the predicted peak memory in bytes, and the stage at which it is reached.
+  */
+  std::pair<uint64_t, std::string> EstimatePeakMemory(const StarkProverConfig& config) const;
+
+  double EstimateSeconds(const StarkProverConfig& config) const;
+
+  ProverPlan Estimate(const StarkProverConfig& config) const;
+
+  /*
+    Returns the configs the planner chooses from. The tuned fields are the LDE caching mode,
+    constraint_polynomial_task_size, table_prover_n_tasks_per_segment and
+    n_out_of_memory_merkle_layers; the rest are taken from base.
+  */
+  std::vector<StarkProverConfig> Candidates(const StarkProverConfig& base) const;
+
+  /*
+    Returns the fastest candidate whose predicted peak memory is at most memory_budget bytes.
+  */
+  ProverPlan Plan(const StarkProverConfig& base, uint64_t memory_budget) const;
+
+ private:
+  ProverPlanInput input_;
+};
+
+/*
+  Parses a memory size such as "64G", "512MB" or "1073741824". The suffixes K, M, G and T (with an
+  optional B or iB) are powers of 1024.
+*/
+uint64_t ParseMemorySize(const std::string& size);
+
+}  // namespace starkware
+
+#endif  // STARKWARE_STARK_PROVER_CONFIG_PLANNER_H_
@@ -0,0 +1,149 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/stark/prover_config_planner.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/error_handling/test_utils.h"
+
+namespace starkware {
+namespace {
+
+using testing::HasSubstr;
+
+ProverPlanInput TestInput() {
+  return {
+      /*trace_length=*/Pow2(20),
+      /*n_cosets=*/8,
+      /*n_columns_first=*/20,
+      /*n_columns_interaction=*/4,
+      /*n_composition_columns=*/2,
+      /*n_constraints=*/30,
+      /*mask_size=*/40,
+      /*element_size_in_bytes=*/32,
+      /*fri_step_list=*/{0, 3, 3, 3, 3, 3, 3, 2},
+      /*n_queries=*/18,
+      /*n_threads=*/8,
+      /*n_verifier_friendly_commitment_layers=*/0,
+  };
+}
+
+TEST(ProverConfigPlanner, StoringTheLdeCostsMemoryAndSavesTime) {
+  const ProverConfigPlanner planner(TestInput());
+  StarkProverConfig full_lde = StarkProverConfig::InRam();
+  StarkProverConfig no_lde = full_lde;
+  no_lde.cached_lde_config.store_full_lde = false;
+  no_lde.cached_lde_config.use_fft_for_eval = true;
+
+  const ProverPlan full_lde_plan = planner.Estimate(full_lde);
+  const ProverPlan no_lde_plan = planner.Estimate(no_lde);
+  EXPECT_GT(full_lde_plan.peak_memory_bytes, no_lde_plan.peak_memory_bytes);
+  EXPECT_LT(full_lde_plan.predicted_seconds, no_lde_plan.predicted_seconds);
+
+  // The LDE of the 20 first columns on 8 cosets alone is 5 GB.
+  EXPECT_GT(full_lde_plan.peak_memory_bytes, 5 * Pow2(30));
+  EXPECT_LT(no_lde_plan.peak_memory_bytes, 5 * Pow2(30));
+}
+
+TEST(ProverConfigPlanner, OutOfMemoryMerkleLayersSaveMemory) {
+  const ProverConfigPlanner planner(TestInput());
+  StarkProverConfig config = StarkProverConfig::InRam();
+  config.n_out_of_memory_merkle_layers = 0;
+  const uint64_t all_in_memory = planner.EstimatePeakMemory(config).first;
+  config.n_out_of_memory_merkle_layers = 3;
+  EXPECT_LT(planner.EstimatePeakMemory(config).first, all_in_memory);
+}
+
+TEST(ProverConfigPlanner, PlanFitsTheBudget) {
+  const ProverConfigPlanner planner(TestInput());
+  const StarkProverConfig base = StarkProverConfig::InRam();
+
+  // With enough memory the LDE is stored.
+  const ProverPlan large_budget = planner.Plan(base, Pow2(40));
+  EXPECT_TRUE(large_budget.fits_memory_budget);
+  EXPECT_TRUE(large_budget.config.cached_lde_config.store_full_lde);
+
+  // Otherwise it is recomputed.
+  const uint64_t budget = large_budget.peak_memory_bytes - 1;
+  const ProverPlan small_budget = planner.Plan(base, budget);
+  EXPECT_TRUE(small_budget.fits_memory_budget);
+  EXPECT_LE(small_budget.peak_memory_bytes, budget);
+  EXPECT_GE(small_budget.predicted_seconds, large_budget.predicted_seconds);
+
+  // Every candidate fitting the budget is at most as fast as the plan.
+  for (const StarkProverConfig& config : planner.Candidates(base)) {
+    const ProverPlan plan = planner.Estimate(config);
+    if (plan.peak_memory_bytes <= budget) {
+      EXPECT_GE(plan.predicted_seconds, small_budget.predicted_seconds);
+    }
+  }
+
+  // When nothing fits, the smallest config is returned.
+  const ProverPlan no_fit = planner.Plan(base, 1);
+  EXPECT_FALSE(no_fit.fits_memory_budget);
+  EXPECT_THAT(no_fit.ToString(), HasSubstr("Does not fit in the memory budget."));
+  for (const StarkProverConfig& config : planner.Candidates(base)) {
+    EXPECT_GE(planner.EstimatePeakMemory(config).first, no_fit.peak_memory_bytes);
+  }
+}
+
+TEST(ProverConfigPlanner, VerifierFriendlyLayersKeepTasksPerSegment) {
+  ProverPlanInput input = TestInput();
+  input.n_verifier_friendly_commitment_layers = 8;
+  const ProverConfigPlanner planner(input);
+  const StarkProverConfig base = StarkProverConfig::InRam();
+  for (const StarkProverConfig& config : planner.Candidates(base)) {
+    EXPECT_EQ(config.table_prover_n_tasks_per_segment, base.table_prover_n_tasks_per_segment);
+  }
+}
+
+TEST(ProverConfigPlanner, ConfigJsonRoundTrip) {
+  StarkProverConfig config = StarkProverConfig::InRam();
+  config.cached_lde_config.store_full_lde = false;
+  config.cached_lde_config.use_fft_for_eval = true;
+  config.constraint_polynomial_task_size = 1024;
+  config.table_prover_n_tasks_per_segment = 4;
+  config.n_out_of_memory_merkle_layers = 3;
+  config.fri_prover_config.log_n_max_in_memory_fri_layer_elements = 10;
+
+  const StarkProverConfig parsed = StarkProverConfig::FromJson(config.ToJson());
+  EXPECT_FALSE(parsed.cached_lde_config.store_full_lde);
+  EXPECT_TRUE(parsed.cached_lde_config.use_fft_for_eval);
+  EXPECT_FALSE(parsed.cached_lde_config.eval_all_cosets_at_once);
+  EXPECT_EQ(parsed.constraint_polynomial_task_size, 1024U);
+  EXPECT_EQ(parsed.table_prover_n_tasks_per_segment, 4U);
+  EXPECT_EQ(parsed.n_out_of_memory_merkle_layers, 3U);
+  EXPECT_EQ(parsed.fri_prover_config.log_n_max_in_memory_fri_layer_elements, 10U);
+  EXPECT_EQ(
+      parsed.fri_prover_config.max_non_chunked_layer_size,
+      config.fri_prover_config.max_non_chunked_layer_size);
+}
+
+TEST(ParseMemorySize, Units) {
+  EXPECT_EQ(ParseMemorySize("1000"), 1000U);
+  EXPECT_EQ(ParseMemorySize("1000B"), 1000U);
+  EXPECT_EQ(ParseMemorySize("2K"), 2048U);
+  EXPECT_EQ(ParseMemorySize("512MB"), 512 * Pow2(20));
+  EXPECT_EQ(ParseMemorySize("64G"), 64 * Pow2(30));
+  EXPECT_EQ(ParseMemorySize("64gib"), 64 * Pow2(30));
+  EXPECT_EQ(ParseMemorySize("1T"), Pow2(40));
+  EXPECT_ASSERT(ParseMemorySize("G"), HasSubstr("Invalid memory size"));
+  EXPECT_ASSERT(ParseMemorySize("12X"), HasSubstr("Invalid memory size"));
+  EXPECT_ASSERT(ParseMemorySize("99999999999T"), HasSubstr("too large"));
+}
+
+}  // namespace
+}  // namespace starkware
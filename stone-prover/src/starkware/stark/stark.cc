@@ -30,7 +30,9 @@
 #include "starkware/stark/oods.h"
 #include "starkware/stl_utils/containers.h"
 #include "starkware/utils/bit_reversal.h"
+#include "starkware/utils/json_builder.h"
 #include "starkware/utils/profiling.h"
+#include "starkware/utils/progress.h"
 
 namespace starkware {
 
@@ -97,7 +99,7 @@ FieldElementVector GetInteractionElements(
   interaction_elms_vec.Reserve(n_interaction_elements);
   for (size_t i = 0; i < n_interaction_elements; ++i) {
     interaction_elms_vec.PushBack(channel->GetRandomFieldElementFromVerifier(
-        field, "Interaction element #" + std::to_string(i)));
+        field, [&] { return "Interaction element #" + std::to_string(i); }));
   }
   return interaction_elms_vec;
 }
@@ -220,6 +222,9 @@ StarkParameters StarkParameters::FromJson(
 StarkProverConfig StarkProverConfig::FromJson(const JsonValue& json) {
   const bool store_full_lde = json["cached_lde_config"]["store_full_lde"].AsBool();
   const bool use_fft_for_eval = json["cached_lde_config"]["use_fft_for_eval"].AsBool();
+  const JsonValue eval_all_cosets_json = json["cached_lde_config"]["eval_all_cosets_at_once"];
+  const bool eval_all_cosets_at_once =
+      eval_all_cosets_json.HasValue() && eval_all_cosets_json.AsBool();
   const uint64_t constraint_polynomial_task_size =
       json["constraint_polynomial_task_size"].AsUint64();
   const size_t table_prover_n_tasks_per_segment =
@@ -251,6 +256,7 @@ StarkProverConfig StarkProverConfig::FromJson(const JsonValue& json) {
       {
           /*store_full_lde=*/store_full_lde,
           /*use_fft_for_eval=*/use_fft_for_eval,
+          /*eval_all_cosets_at_once=*/eval_all_cosets_at_once,
       },
       /*table_prover_n_tasks_per_segment=*/table_prover_n_tasks_per_segment,
       /*constraint_polynomial_task_size=*/constraint_polynomial_task_size,
@@ -263,6 +269,22 @@ StarkProverConfig StarkProverConfig::FromJson(const JsonValue& json) {
   };
 }
 
+JsonValue StarkProverConfig::ToJson() const {
+  JsonBuilder output;
+  output["cached_lde_config"]["store_full_lde"] = cached_lde_config.store_full_lde;
+  output["cached_lde_config"]["use_fft_for_eval"] = cached_lde_config.use_fft_for_eval;
+  output["cached_lde_config"]["eval_all_cosets_at_once"] =
+      cached_lde_config.eval_all_cosets_at_once;
+  output["constraint_polynomial_task_size"] = constraint_polynomial_task_size;
+  output["table_prover_n_tasks_per_segment"] = table_prover_n_tasks_per_segment;
+  output["n_out_of_memory_merkle_layers"] = n_out_of_memory_merkle_layers;
+  output["fri_prover"]["max_non_chunked_layer_size"] = fri_prover_config.max_non_chunked_layer_size;
+  output["fri_prover"]["n_chunks_between_layers"] = fri_prover_config.n_chunks_between_layers;
+  output["fri_prover"]["log_n_max_in_memory_fri_layer_elements"] =
+      fri_prover_config.log_n_max_in_memory_fri_layer_elements;
+  return output.Build();
+}
+
 // ------------------------------------------------------------------------------------------
 //  Prover
 // ------------------------------------------------------------------------------------------
@@ -281,6 +303,7 @@ void StarkProver::PerformLowDegreeTest(const CompositionOracleProver& oracle) {
           std::to_string(expected_fri_degree_bound) +
           ". STARK: " + std::to_string(oracle_degree_bound));
 
+  ProgressReporter::GetInstance().StartStage("FRI", 0.7, 1.0);
   ProfilingBlock profiling_block("FRI virtual oracle computation");
   // Evaluate composition polynomial.
   auto composition_polynomial_evaluation =
@@ -381,7 +404,13 @@ void StarkProver::ValidateFirstTraceSize(const size_t n_rows, const size_t n_col
 }
 
 void StarkProver::ProveStark(std::unique_ptr<TraceContext> trace_context) {
+  // The stages of the proof, and the fraction of the proving time they are expected to span, for
+  // progress reporting. The shares are rough estimates for typical CPU AIR proofs.
+  ProgressReporter& progress = ProgressReporter::GetInstance();
+  progress.StartProof();
+
   // First trace.
+  progress.StartStage("Trace generation", 0.0, 0.1);
   ProfilingBlock profiling_block("Trace generation");
   Trace trace = trace_context->GetTrace();
   profiling_block.CloseBlock();
@@ -394,6 +423,7 @@ void StarkProver::ProveStark(std::unique_ptr<TraceContext> trace_context) {
 
   std::vector<MaybeOwnedPtr<CommittedTraceProverBase>> traces;
   // Add first committed trace.
+  progress.StartStage("Commit on trace", 0.1, 0.25);
   {
     AnnotationScope scope(channel_.get(), "Original");
     CommittedTraceProver committed_trace(CommitOnTrace(
@@ -411,6 +441,7 @@ void StarkProver::ProveStark(std::unique_ptr<TraceContext> trace_context) {
         !params_->use_extension_field, "Extension field is not implemented for interaction.");
 
     AnnotationScope scope(channel_.get(), "Interaction");
+    progress.StartStage("Interaction", 0.25, 0.4);
 
     // Initialize interaction elements in trace context.
     trace_context->SetInteractionElements(starkware::GetInteractionElements(
@@ -447,10 +478,12 @@ void StarkProver::ProveStark(std::unique_ptr<TraceContext> trace_context) {
       UseOwned(&params_->evaluation_domain), std::move(traces), current_air->GetMask(),
       UseOwned(current_air), UseOwned(composition_polynomial.get()), channel_.get());
 
+  progress.StartStage("Composition and out of domain sampling", 0.4, 0.7);
   const CompositionOracleProver oods_composition_oracle =
       OutOfDomainSamplingProve(std::move(composition_oracle));
 
   PerformLowDegreeTest(oods_composition_oracle);
+  progress.Finish();
 }
 
 // ------------------------------------------------------------------------------------------
@@ -107,6 +107,7 @@ struct StarkProverConfig {
         {
             /*store_full_lde=*/true,
             /*use_fft_for_eval=*/false,
+            /*eval_all_cosets_at_once=*/false,
         },
         /*table_prover_n_tasks_per_segment=*/32,
         /*constraint_polynomial_task_size=*/256,
@@ -119,6 +120,11 @@ struct StarkProverConfig {
   }
 
   static StarkProverConfig FromJson(const JsonValue& json);
+
+  /*
+    Returns the config in the format read by FromJson().
+  */
+  JsonValue ToJson() const;
 };
 
 class StarkProver {
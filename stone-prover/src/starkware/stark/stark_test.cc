@@ -340,7 +340,8 @@ TYPED_TEST(PermutationStarkTest, PermutationAirCorrectness) {
 TYPED_TEST(FibonacciStarkTest, CorrectnessDontStoreFullLde) {
   this->stark_config.cached_lde_config = CachedLdeManager::Config{
       /*store_full_lde=*/false,
-      /*use_fft_for_eval=*/false};
+      /*use_fft_for_eval=*/false,
+      /*eval_all_cosets_at_once=*/false};
 
   // Generate proof.
   const auto proof_annotations_pair = this->GenerateProofWithAnnotations();
@@ -352,7 +353,21 @@ TYPED_TEST(FibonacciStarkTest, CorrectnessDontStoreFullLde) {
 TYPED_TEST(FibonacciStarkTest, CorrectnessRecomputeLdeWithFft) {
   this->stark_config.cached_lde_config = CachedLdeManager::Config{
       /*store_full_lde=*/false,
-      /*use_fft_for_eval=*/true};
+      /*use_fft_for_eval=*/true,
+      /*eval_all_cosets_at_once=*/false};
+
+  // Generate proof.
+  const auto proof_annotations_pair = this->GenerateProofWithAnnotations();
+
+  // Verify proof.
+  EXPECT_TRUE(this->VerifyProof(proof_annotations_pair.first, proof_annotations_pair.second));
+}
+
+TYPED_TEST(FibonacciStarkTest, CorrectnessEvalAllCosetsAtOnce) {
+  this->stark_config.cached_lde_config = CachedLdeManager::Config{
+      /*store_full_lde=*/true,
+      /*use_fft_for_eval=*/false,
+      /*eval_all_cosets_at_once=*/true};
 
   // Generate proof.
   const auto proof_annotations_pair = this->GenerateProofWithAnnotations();
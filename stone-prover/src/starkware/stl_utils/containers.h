@@ -76,6 +76,46 @@ bool AreDisjoint(const std::set<T>& set1, const std::set<T>& set2) {
   return true;
 }
 
+/*
+  Same as AreDisjoint(), for two spans that are sorted in increasing order.
+*/
+template <typename T>
+bool AreDisjointSorted(gsl::span<const T> sorted1, gsl::span<const T> sorted2) {
+  auto it1 = sorted1.begin();
+  auto it2 = sorted2.begin();
+  while (it1 != sorted1.end() && it2 != sorted2.end()) {
+    if (*it1 < *it2) {
+      ++it1;
+    } else if (*it2 < *it1) {
+      ++it2;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+  Sorts values in increasing order and removes duplicates. This is the flat alternative to
+  collecting the values in a std::set, when they are only iterated in order or binary searched
+  afterwards.
+*/
+template <typename T>
+void SortAndRemoveDuplicates(std::vector<T>* values) {
+  std::sort(values->begin(), values->end());
+  values->erase(std::unique(values->begin(), values->end()), values->end());
+}
+
+/*
+  Returns true if values is strictly increasing, i.e. sorted and without duplicates.
+*/
+template <typename T>
+bool IsSortedAndUnique(gsl::span<const T> values) {
+  return std::adjacent_find(values.begin(), values.end(), [](const T& a, const T& b) {
+           return !(a < b);
+         }) == values.end();
+}
+
 template <typename T>
 bool HasDuplicates(gsl::span<const T> values) {
   std::set<T> s;
@@ -113,7 +153,8 @@ std::vector<const T*> UniquePtrsToRawPointers(gsl::span<const std::unique_ptr<T>
 }
 
 /*
-  An adapter from vector<vector<T>> to span<span<T>>, through vector<span<T>>.
+  An adapter from vector<vector<T>> (with any allocator) to span<span<T>>, through
+  vector<span<T>>.
   Usage:
     vector<vector<int>> v;
     void f(span<span<int>> s) {
@@ -147,7 +188,9 @@ class ConstSpanAdapter {
 template <typename T>
 class SpanAdapter {
  public:
-  explicit SpanAdapter(std::vector<std::vector<T>>& vec) : inner_(vec.begin(), vec.end()) {}
+  template <typename AllocatorT>
+  explicit SpanAdapter(std::vector<std::vector<T, AllocatorT>>& vec)
+      : inner_(vec.begin(), vec.end()) {}
 
   operator gsl::span<const gsl::span<T>>() const {  // NOLINT: implicit cast.
     return gsl::span<const gsl::span<T>>(inner_);
@@ -89,6 +89,32 @@ TEST(StlContainers, AreDisjoint) {
   EXPECT_TRUE(AreDisjoint(std::set<int>{8, 7, 6, 5}, std::set<int>{3}));
 }
 
+TEST(StlContainers, AreDisjointSorted) {
+  EXPECT_FALSE(AreDisjointSorted<int>(std::vector<int>{1}, std::vector<int>{1}));
+  EXPECT_TRUE(AreDisjointSorted<int>(std::vector<int>{1}, std::vector<int>{7}));
+  EXPECT_TRUE(AreDisjointSorted<int>(std::vector<int>{}, std::vector<int>{7}));
+  EXPECT_FALSE(AreDisjointSorted<int>(std::vector<int>{1, 2}, std::vector<int>{2, 7}));
+  EXPECT_TRUE(AreDisjointSorted<int>(std::vector<int>{1, 5, 9}, std::vector<int>{2, 7, 10}));
+  EXPECT_FALSE(AreDisjointSorted<int>(std::vector<int>{0, 17, 19}, std::vector<int>{1, 2, 19, 23}));
+}
+
+TEST(StlContainers, SortAndRemoveDuplicates) {
+  std::vector<int> values = {5, 1, 10, 5, 3, 1, 1};
+  SortAndRemoveDuplicates(&values);
+  EXPECT_THAT(values, ElementsAre(1, 3, 5, 10));
+
+  std::vector<int> empty;
+  SortAndRemoveDuplicates(&empty);
+  EXPECT_THAT(empty, IsEmpty());
+}
+
+TEST(StlContainers, IsSortedAndUnique) {
+  EXPECT_TRUE(IsSortedAndUnique<int>(std::vector<int>{}));
+  EXPECT_TRUE(IsSortedAndUnique<int>(std::vector<int>{1, 3, 5, 10}));
+  EXPECT_FALSE(IsSortedAndUnique<int>(std::vector<int>{1, 3, 3, 10}));
+  EXPECT_FALSE(IsSortedAndUnique<int>(std::vector<int>{1, 5, 3, 10}));
+}
+
 TEST(StlContainers, HasDuplicates) {
   EXPECT_FALSE(HasDuplicates<int>(std::vector<int>{}));
   EXPECT_FALSE(HasDuplicates<int>(std::vector<int>{1, 10, 5, 3}));
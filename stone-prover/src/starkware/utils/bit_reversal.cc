@@ -32,23 +32,7 @@ void BitReverseVector(const ConstFieldElementSpan& src, const FieldElementSpan&
   InvokeFieldTemplateVersion(
       [&](auto field_tag) {
         using FieldElementT = typename decltype(field_tag)::type;
-        const auto& src_arr = src.As<FieldElementT>();
-        const auto& dst_arr = dst.As<FieldElementT>();
-
-        const int logn = SafeLog2(src_arr.size());
-        const size_t min_work_chunk = 1024;
-
-        TaskManager& task_manager = TaskManager::GetInstance();
-
-        task_manager.ParallelFor(
-            src_arr.size(),
-            [src_arr, dst_arr, logn](const TaskInfo& task_info) {
-              for (size_t k = task_info.start_idx; k < task_info.end_idx; ++k) {
-                const size_t rk = BitReverse(k, logn);
-                dst_arr[rk] = src_arr[k];
-              }
-            },
-            src_arr.size(), min_work_chunk);
+        BitReverseVector<FieldElementT>(src.As<FieldElementT>(), dst.As<FieldElementT>());
       },
       src.GetField());
 }
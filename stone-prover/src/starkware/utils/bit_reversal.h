@@ -15,6 +15,8 @@
 #ifndef STARKWARE_UTILS_BIT_REVERSAL_H_
 #define STARKWARE_UTILS_BIT_REVERSAL_H_
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <utility>
 #include <vector>
@@ -59,30 +61,153 @@ static inline uint64_t BitReverse(uint64_t n, const size_t number_of_bits) {
   return n >> (64 - number_of_bits);
 }
 
+namespace bit_reversal {
+namespace details {
+
+/*
+  Returns the log of the side of the tiles used by the blocked bit reversal of arrays of T. A tile
+  of 2^log_tile x 2^log_tile elements occupies at most 16KB, so that the tiles of a task stay in
+  the L1 cache.
+*/
+template <typename T>
+constexpr size_t LogTileSize() {
+  constexpr size_t kLogTileBytes = 14;
+  return (kLogTileBytes - std::min<size_t>(Log2Ceil(sizeof(T)), kLogTileBytes)) / 2;
+}
+
+/*
+  Copies the tile of middle index b into tile, transposed and with the rows in bit reversed order.
+  An index k of arr is split into (a, b, c), where a and c have log_tile bits, so that
+  tile[BitReverse(a) * 2^log_tile + c] = arr[k]. Reads contiguous rows of arr.
+*/
+template <typename T>
+void LoadTile(
+    gsl::span<const T> arr, size_t log_tile, size_t log_middle, size_t b, gsl::span<T> tile) {
+  const size_t tile_size = Pow2(log_tile);
+  for (size_t a = 0; a < tile_size; ++a) {
+    const size_t row_start = (a << (log_middle + log_tile)) | (b << log_tile);
+    std::copy_n(
+        arr.begin() + row_start, tile_size, tile.begin() + BitReverse(a, log_tile) * tile_size);
+  }
+}
+
+/*
+  Writes a tile that was read by LoadTile() for the middle index b to the positions of its
+  elements after the bit reversal. Writes contiguous rows of arr.
+*/
+template <typename T>
+void StoreTile(
+    gsl::span<const T> tile, size_t log_tile, size_t log_middle, size_t b, gsl::span<T> arr) {
+  const size_t tile_size = Pow2(log_tile);
+  const size_t reversed_b = BitReverse(b, log_middle);
+  for (size_t c = 0; c < tile_size; ++c) {
+    const size_t row_start =
+        (BitReverse(c, log_tile) << (log_middle + log_tile)) | (reversed_b << log_tile);
+    for (size_t reversed_a = 0; reversed_a < tile_size; ++reversed_a) {
+      arr[row_start + reversed_a] = tile[reversed_a * tile_size + c];
+    }
+  }
+}
+
+}  // namespace details
+}  // namespace bit_reversal
+
 /*
   Applies the bit reversal permutation of the input span.
   The input size needs to be Pow2(logn).
   The result will satify:
   new_input[i] = input[(BitReverse(i, logn)] for each i in [0, Pow2(logn)).
+
+  Large arrays are permuted tile by tile (see LoadTile()): the tiles of middle indices b and
+  BitReverse(b) are swapped through a buffer, so that the memory is accessed in contiguous rows
+  instead of one random access per element.
 */
 template <typename T>
 void BitReverseInPlace(gsl::span<T> arr) {
-  const int logn = SafeLog2(arr.size());
+  using bit_reversal::details::LoadTile;
+  using bit_reversal::details::StoreTile;
+  const size_t logn = SafeLog2(arr.size());
   const size_t min_work_chunk = 1024;
+  const size_t log_tile = bit_reversal::details::LogTileSize<T>();
 
   TaskManager& task_manager = TaskManager::GetInstance();
 
+  if (logn < 2 * log_tile) {
+    task_manager.ParallelFor(
+        arr.size(),
+        [arr, logn](const TaskInfo& task_info) {
+          for (size_t k = task_info.start_idx; k < task_info.end_idx; ++k) {
+            const size_t rk = BitReverse(k, logn);
+            if (k < rk) {
+              std::swap(arr[k], arr[rk]);
+            }
+          }
+        },
+        arr.size(), min_work_chunk);
+    return;
+  }
+
+  const size_t log_middle = logn - 2 * log_tile;
+  const size_t tile_area = Pow2(2 * log_tile);
   task_manager.ParallelFor(
-      arr.size(),
-      [arr, logn](const TaskInfo& task_info) {
-        for (size_t k = task_info.start_idx; k < task_info.end_idx; ++k) {
-          const size_t rk = BitReverse(k, logn);
-          if (k < rk) {
-            std::swap(arr[k], arr[rk]);
+      Pow2(log_middle),
+      [arr, log_tile, log_middle, tile_area](const TaskInfo& task_info) {
+        std::vector<T> tile(tile_area, arr[0]);
+        std::vector<T> reversed_tile(tile_area, arr[0]);
+        for (size_t b = task_info.start_idx; b < task_info.end_idx; ++b) {
+          const size_t reversed_b = BitReverse(b, log_middle);
+          if (b > reversed_b) {
+            continue;
           }
+          LoadTile<T>(arr, log_tile, log_middle, b, tile);
+          if (b != reversed_b) {
+            LoadTile<T>(arr, log_tile, log_middle, reversed_b, reversed_tile);
+            StoreTile<T>(reversed_tile, log_tile, log_middle, reversed_b, arr);
+          }
+          StoreTile<T>(tile, log_tile, log_middle, b, arr);
+        }
+      },
+      Pow2(log_middle), std::max<size_t>(min_work_chunk / tile_area, 1));
+}
+
+/*
+  Out of place version of BitReverseInPlace(): dst[i] = src[BitReverse(i, logn)].
+*/
+template <typename T>
+void BitReverseVector(gsl::span<const T> src, gsl::span<T> dst) {
+  using bit_reversal::details::LoadTile;
+  using bit_reversal::details::StoreTile;
+  ASSERT_RELEASE(src.size() == dst.size(), "Span size must be the same");
+  const size_t logn = SafeLog2(src.size());
+  const size_t min_work_chunk = 1024;
+  const size_t log_tile = bit_reversal::details::LogTileSize<T>();
+
+  TaskManager& task_manager = TaskManager::GetInstance();
+
+  if (logn < 2 * log_tile) {
+    task_manager.ParallelFor(
+        src.size(),
+        [src, dst, logn](const TaskInfo& task_info) {
+          for (size_t k = task_info.start_idx; k < task_info.end_idx; ++k) {
+            dst[BitReverse(k, logn)] = src[k];
+          }
+        },
+        src.size(), min_work_chunk);
+    return;
+  }
+
+  const size_t log_middle = logn - 2 * log_tile;
+  const size_t tile_area = Pow2(2 * log_tile);
+  task_manager.ParallelFor(
+      Pow2(log_middle),
+      [src, dst, log_tile, log_middle, tile_area](const TaskInfo& task_info) {
+        std::vector<T> tile(tile_area, src[0]);
+        for (size_t b = task_info.start_idx; b < task_info.end_idx; ++b) {
+          LoadTile<T>(src, log_tile, log_middle, b, tile);
+          StoreTile<T>(tile, log_tile, log_middle, b, dst);
         }
       },
-      arr.size(), min_work_chunk);
+      Pow2(log_middle), std::max<size_t>(min_work_chunk / tile_area, 1));
 }
 
 void BitReverseInPlace(const FieldElementSpan& arr);
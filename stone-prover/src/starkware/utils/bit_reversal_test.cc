@@ -82,5 +82,27 @@ TEST(BitReverse, FieldElementSpan) {
   }
 }
 
+TEST(BitReverse, Blocked) {
+  // Test sizes around the smallest size that is permuted in tiles.
+  const size_t log_tile = bit_reversal::details::LogTileSize<uint64_t>();
+  for (size_t log_n = 2 * log_tile - 1; log_n <= 2 * log_tile + 3; ++log_n) {
+    const uint64_t n = Pow2(log_n);
+    std::vector<uint64_t> a;
+    a.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      a.push_back(i);
+    }
+
+    std::vector<uint64_t> a_rev(n);
+    BitReverseVector<uint64_t>(a, a_rev);
+    std::vector<uint64_t> a_rev_in_place = a;
+    BitReverseInPlace<uint64_t>(a_rev_in_place);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(a_rev[BitReverse(i, log_n)], i);
+      ASSERT_EQ(a_rev_in_place[BitReverse(i, log_n)], i);
+    }
+  }
+}
+
 }  // namespace
 }  // namespace starkware
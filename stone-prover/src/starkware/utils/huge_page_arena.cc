@@ -0,0 +1,208 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/utils/huge_page_arena.h"
+
+#include <sys/mman.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "glog/logging.h"
+
+#include "starkware/error_handling/error_handling.h"
+#include "starkware/utils/task_manager.h"
+
+DEFINE_bool(
+    huge_page_arena, false,
+    "Serve the large buffers of the prover (traces, LDEs, composition polynomial evaluations, "
+    "Merkle trees) from a pool of pre-faulted huge pages, which is reused across the phases of "
+    "the proof.");
+
+namespace starkware {
+
+namespace {
+
+constexpr size_t kSmallPageSize = size_t(1) << 12;
+constexpr size_t kHugePageSize = size_t(1) << 21;
+constexpr size_t kGiantPageSize = size_t(1) << 30;
+constexpr int kHugePageFlag = 21 << MAP_HUGE_SHIFT;
+constexpr int kGiantPageFlag = 30 << MAP_HUGE_SHIFT;
+
+size_t RoundUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+void* MapHugetlb(size_t size, int page_size_flag) {
+  void* ptr = mmap(
+      nullptr, size, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | page_size_flag, -1, 0);
+  return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+/*
+  Maps size bytes of regular pages aligned to kHugePageSize, and asks the kernel to back them with
+  transparent huge pages.
+*/
+void* MapTransparentHugePages(size_t size) {
+  const size_t mapped_size = size + kHugePageSize;
+  void* ptr =
+      mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  ASSERT_RELEASE(ptr != MAP_FAILED, "Failed to map " + std::to_string(size) + " bytes.");
+
+  // Trim the unaligned head and the tail of the mapping.
+  auto* begin = static_cast<std::byte*>(ptr);
+  auto* aligned_begin = reinterpret_cast<std::byte*>(
+      RoundUp(reinterpret_cast<uintptr_t>(begin), kHugePageSize));
+  if (aligned_begin != begin) {
+    munmap(begin, aligned_begin - begin);
+  }
+  std::byte* aligned_end = aligned_begin + size;
+  std::byte* end = begin + mapped_size;
+  if (end != aligned_end) {
+    munmap(aligned_end, end - aligned_end);
+  }
+
+  // May fail if transparent huge pages are disabled, in which case regular pages are used.
+  madvise(aligned_begin, size, MADV_HUGEPAGE);
+  return aligned_begin;
+}
+
+/*
+  Touches every page of the buffer, splitting the work among the threads of the TaskManager.
+*/
+void Prefault(void* ptr, size_t size) {
+  auto* bytes = static_cast<volatile char*>(ptr);
+  TaskManager::GetInstance().ParallelFor(
+      size / kHugePageSize, [bytes](const TaskInfo& task_info) {
+        for (size_t offset = task_info.start_idx * kHugePageSize;
+             offset < task_info.end_idx * kHugePageSize; offset += kSmallPageSize) {
+          bytes[offset] = 0;
+        }
+      });
+}
+
+}  // namespace
+
+HugePageArena::~HugePageArena() {
+  ReleaseCachedBuffers();
+  for (const auto& [ptr, mapping] : in_use_) {
+    Unmap(ptr, mapping);
+  }
+}
+
+HugePageArena& HugePageArena::GetInstance() {
+  // Never destroyed, so that static objects may still free their buffers at exit.
+  static auto* instance = new HugePageArena();
+  return *instance;
+}
+
+void* HugePageArena::Allocate(size_t n_bytes) {
+  const size_t size = RoundUp(std::max<size_t>(n_bytes, 1), kHugePageSize);
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Use the smallest kept buffer that fits, unless it wastes more than half of its memory.
+    auto it = cached_.lower_bound(size);
+    if (it != cached_.end() && it->first < 2 * size) {
+      const auto [ptr, mapping] = it->second;
+      cached_.erase(it);
+      in_use_.emplace(ptr, mapping);
+      stats_.cached_bytes -= mapping.size;
+      stats_.reused_bytes += n_bytes;
+      return ptr;
+    }
+    ReleaseCachedBuffersLocked();
+  }
+
+  // Map and pre-fault outside the lock, as these are the expensive parts.
+  Mapping mapping{};
+  void* ptr = Map(size, &mapping);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  in_use_.emplace(ptr, mapping);
+  stats_.mapped_bytes += mapping.size;
+  stats_.peak_mapped_bytes = std::max(stats_.peak_mapped_bytes, stats_.mapped_bytes);
+  if (mapping.is_hugetlb) {
+    stats_.hugetlb_bytes += mapping.size;
+  }
+  return ptr;
+}
+
+void HugePageArena::Deallocate(void* ptr) {
+  ASSERT_RELEASE(TryDeallocate(ptr), "Buffer was not allocated by the arena.");
+}
+
+bool HugePageArena::TryDeallocate(void* ptr) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = in_use_.find(ptr);
+  if (it == in_use_.end()) {
+    return false;
+  }
+  const Mapping mapping = it->second;
+  in_use_.erase(it);
+  cached_.emplace(mapping.size, std::make_pair(ptr, mapping));
+  stats_.cached_bytes += mapping.size;
+  return true;
+}
+
+void HugePageArena::ReleaseCachedBuffers() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  ReleaseCachedBuffersLocked();
+}
+
+HugePageArena::Stats HugePageArena::GetStats() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void* HugePageArena::Map(size_t n_bytes, Mapping* mapping) {
+  void* ptr = nullptr;
+  if (n_bytes >= kGiantPageSize) {
+    mapping->size = RoundUp(n_bytes, kGiantPageSize);
+    ptr = MapHugetlb(mapping->size, kGiantPageFlag);
+  }
+  if (ptr == nullptr) {
+    mapping->size = n_bytes;
+    ptr = MapHugetlb(mapping->size, kHugePageFlag);
+  }
+  mapping->is_hugetlb = ptr != nullptr;
+  if (ptr == nullptr) {
+    ptr = MapTransparentHugePages(mapping->size);
+  }
+  VLOG(3) << "Mapped " << mapping->size << " bytes"
+          << (mapping->is_hugetlb ? " of hugetlbfs pages." : ".");
+
+  Prefault(ptr, mapping->size);
+  return ptr;
+}
+
+void HugePageArena::Unmap(void* ptr, const Mapping& mapping) {
+  munmap(ptr, mapping.size);
+  stats_.mapped_bytes -= mapping.size;
+  if (mapping.is_hugetlb) {
+    stats_.hugetlb_bytes -= mapping.size;
+  }
+}
+
+void HugePageArena::ReleaseCachedBuffersLocked() {
+  for (const auto& [size, buffer] : cached_) {
+    (void)size;  // Unused.
+    Unmap(buffer.first, buffer.second);
+  }
+  cached_.clear();
+  stats_.cached_bytes = 0;
+}
+
+}  // namespace starkware
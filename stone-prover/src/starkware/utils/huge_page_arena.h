@@ -0,0 +1,174 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#ifndef STARKWARE_UTILS_HUGE_PAGE_ARENA_H_
+#define STARKWARE_UTILS_HUGE_PAGE_ARENA_H_
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+DECLARE_bool(huge_page_arena);
+
+namespace starkware {
+
+/*
+  A process-wide pool of large buffers, backed by huge pages.
+
+  Buffers are mapped directly with mmap. 1GB and 2MB hugetlbfs pages are used when the system has
+  reserved such pages, and transparent huge pages (through madvise) otherwise. Freshly mapped
+  buffers are pre-faulted in parallel by the threads of the TaskManager, instead of page by page by
+  the first thread that writes to them. With a first-touch NUMA policy this also spreads the pages
+  across the nodes of the threads that later process them.
+
+  Freed buffers are kept and handed out again to later allocations of a similar size, so that the
+  buffers of one prover phase are reused by the next one without being faulted in again. When no
+  kept buffer fits a new allocation, all the kept buffers are released first, so the arena never
+  holds more memory than the peak memory in use plus the new allocation.
+
+  The arena is used by HugePageAllocator only when --huge_page_arena is set.
+*/
+class HugePageArena {
+ public:
+  struct Stats {
+    // Memory currently mapped by the arena, including kept buffers.
+    size_t mapped_bytes = 0;
+    size_t peak_mapped_bytes = 0;
+    // Memory of freed buffers that is kept for reuse.
+    size_t cached_bytes = 0;
+    // Total size of allocations that were served by a kept buffer.
+    size_t reused_bytes = 0;
+    // Memory currently mapped using hugetlbfs pages.
+    size_t hugetlb_bytes = 0;
+  };
+
+  /*
+    Allocations smaller than this are not served by the arena (see HugePageAllocator).
+  */
+  static constexpr size_t kMinAllocationSize = size_t(1) << 20;
+
+  HugePageArena() = default;
+  ~HugePageArena();
+  HugePageArena(const HugePageArena&) = delete;
+  HugePageArena& operator=(const HugePageArena&) = delete;
+  HugePageArena(HugePageArena&&) = delete;
+  HugePageArena& operator=(HugePageArena&&) = delete;
+
+  static HugePageArena& GetInstance();
+
+  /*
+    Returns a buffer of at least n_bytes bytes, aligned to 2MB. The content of the buffer is
+    undefined.
+  */
+  void* Allocate(size_t n_bytes);
+
+  /*
+    Returns a buffer obtained by Allocate() to the arena, for reuse by later allocations.
+  */
+  void Deallocate(void* ptr);
+
+  /*
+    Same as Deallocate(), but returns false (and does nothing) if ptr was not allocated by the
+    arena.
+  */
+  bool TryDeallocate(void* ptr);
+
+  /*
+    Unmaps all the buffers kept for reuse.
+  */
+  void ReleaseCachedBuffers();
+
+  Stats GetStats() const;
+
+ private:
+  struct Mapping {
+    size_t size;
+    bool is_hugetlb;
+  };
+
+  /*
+    Maps a new buffer of at least n_bytes bytes and pre-faults it.
+  */
+  void* Map(size_t n_bytes, Mapping* mapping);
+  void Unmap(void* ptr, const Mapping& mapping);
+  void ReleaseCachedBuffersLocked();
+
+  mutable std::mutex mutex_;
+  // Buffers that are currently allocated, by address.
+  std::unordered_map<void*, Mapping> in_use_;
+  // Buffers that were deallocated and are kept for reuse, by size.
+  std::multimap<size_t, std::pair<void*, Mapping>> cached_;
+  Stats stats_;
+};
+
+/*
+  A std::allocator replacement that serves large allocations from the HugePageArena when
+  --huge_page_arena is set, and from the global allocator otherwise.
+
+  Example usage:
+    std::vector<HashT, HugePageAllocator<HashT>> nodes(n_nodes);
+
+  The traces, the LDEs and the composition polynomial evaluations of the prover are stored in
+  HugePageVector-s (see Trace::Allocate() and FieldElementVector::MakeUninitializedHugePage()).
+*/
+template <typename T>
+class HugePageAllocator {
+ public:
+  using value_type = T;
+
+  HugePageAllocator() = default;
+
+  template <typename U>
+  HugePageAllocator(const HugePageAllocator<U>& /*other*/) {}  // NOLINT: implicit conversion.
+
+  T* allocate(size_t n) {
+    if (FLAGS_huge_page_arena && n * sizeof(T) >= HugePageArena::kMinAllocationSize) {
+      return static_cast<T*>(HugePageArena::GetInstance().Allocate(n * sizeof(T)));
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, size_t n) {
+    // The buffer is looked up in the arena regardless of the flag, which may have changed since the
+    // allocation.
+    if (n * sizeof(T) >= HugePageArena::kMinAllocationSize &&
+        HugePageArena::GetInstance().TryDeallocate(ptr)) {
+      return;
+    }
+    ::operator delete(ptr);
+  }
+
+  template <typename U>
+  bool operator==(const HugePageAllocator<U>& /*other*/) const {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const HugePageAllocator<U>& /*other*/) const {
+    return false;
+  }
+};
+
+template <typename T>
+using HugePageVector = std::vector<T, HugePageAllocator<T>>;
+
+}  // namespace starkware
+
+#endif  // STARKWARE_UTILS_HUGE_PAGE_ARENA_H_
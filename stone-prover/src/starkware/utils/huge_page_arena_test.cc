@@ -0,0 +1,129 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/utils/huge_page_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/error_handling/test_utils.h"
+
+namespace starkware {
+namespace {
+
+constexpr size_t kMB = size_t(1) << 20;
+
+TEST(HugePageArena, AllocateIsAligned) {
+  HugePageArena arena;
+  void* ptr = arena.Allocate(3 * kMB);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % (2 * kMB), 0U);
+  EXPECT_EQ(arena.GetStats().mapped_bytes, 4 * kMB);
+
+  // The buffer is writable.
+  auto* bytes = static_cast<std::byte*>(ptr);
+  std::fill(bytes, bytes + 3 * kMB, std::byte{1});
+  arena.Deallocate(ptr);
+}
+
+TEST(HugePageArena, ReuseFreedBuffer) {
+  HugePageArena arena;
+  void* first = arena.Allocate(4 * kMB);
+  arena.Deallocate(first);
+  EXPECT_EQ(arena.GetStats().cached_bytes, 4 * kMB);
+
+  // A buffer of a similar size reuses the freed buffer.
+  void* second = arena.Allocate(3 * kMB);
+  EXPECT_EQ(second, first);
+  EXPECT_EQ(arena.GetStats().cached_bytes, 0U);
+  EXPECT_EQ(arena.GetStats().reused_bytes, 3 * kMB);
+  EXPECT_EQ(arena.GetStats().mapped_bytes, 4 * kMB);
+  arena.Deallocate(second);
+}
+
+TEST(HugePageArena, NoReuseOfMuchLargerBuffer) {
+  HugePageArena arena;
+  void* large = arena.Allocate(16 * kMB);
+  arena.Deallocate(large);
+
+  // The kept buffer is too large, so it is released and a new buffer is mapped.
+  void* small = arena.Allocate(2 * kMB);
+  const HugePageArena::Stats stats = arena.GetStats();
+  EXPECT_EQ(stats.cached_bytes, 0U);
+  EXPECT_EQ(stats.reused_bytes, 0U);
+  EXPECT_EQ(stats.mapped_bytes, 2 * kMB);
+  EXPECT_EQ(stats.peak_mapped_bytes, 16 * kMB);
+  arena.Deallocate(small);
+
+  arena.ReleaseCachedBuffers();
+  EXPECT_EQ(arena.GetStats().mapped_bytes, 0U);
+}
+
+TEST(HugePageArena, DeallocateUnknownBuffer) {
+  HugePageArena arena;
+  int value = 0;
+  EXPECT_ASSERT(arena.Deallocate(&value), testing::HasSubstr("not allocated by the arena"));
+}
+
+TEST(HugePageArena, TryDeallocateUnknownBuffer) {
+  HugePageArena arena;
+  int value = 0;
+  EXPECT_FALSE(arena.TryDeallocate(&value));
+  void* ptr = arena.Allocate(kMB);
+  EXPECT_TRUE(arena.TryDeallocate(ptr));
+}
+
+TEST(HugePageAllocator, Vector) {
+  FLAGS_huge_page_arena = true;
+  const HugePageArena::Stats stats_before = HugePageArena::GetInstance().GetStats();
+
+  // Small vectors do not use the arena.
+  HugePageVector<uint64_t> small(16);
+  EXPECT_EQ(HugePageArena::GetInstance().GetStats().mapped_bytes, stats_before.mapped_bytes);
+
+  const size_t size = 2 * HugePageArena::kMinAllocationSize / sizeof(uint64_t);
+  {
+    HugePageVector<uint64_t> large(size);
+    std::iota(large.begin(), large.end(), 0);
+    EXPECT_EQ(large[size - 1], size - 1);
+    EXPECT_GT(HugePageArena::GetInstance().GetStats().mapped_bytes, stats_before.mapped_bytes);
+  }
+  EXPECT_GT(HugePageArena::GetInstance().GetStats().cached_bytes, stats_before.cached_bytes);
+  HugePageArena::GetInstance().ReleaseCachedBuffers();
+  FLAGS_huge_page_arena = false;
+}
+
+TEST(HugePageAllocator, DisabledByFlag) {
+  ASSERT_FALSE(FLAGS_huge_page_arena);
+  const HugePageArena::Stats stats_before = HugePageArena::GetInstance().GetStats();
+  const size_t size = 2 * HugePageArena::kMinAllocationSize / sizeof(uint64_t);
+  {
+    HugePageVector<uint64_t> large(size);
+    EXPECT_EQ(HugePageArena::GetInstance().GetStats().mapped_bytes, stats_before.mapped_bytes);
+
+    // A vector allocated while the flag is set may be freed after it is cleared.
+    FLAGS_huge_page_arena = true;
+    HugePageVector<uint64_t> from_arena(size);
+    FLAGS_huge_page_arena = false;
+    EXPECT_GT(HugePageArena::GetInstance().GetStats().mapped_bytes, stats_before.mapped_bytes);
+  }
+  HugePageArena::GetInstance().ReleaseCachedBuffers();
+  EXPECT_EQ(HugePageArena::GetInstance().GetStats().mapped_bytes, stats_before.mapped_bytes);
+}
+
+}  // namespace
+}  // namespace starkware
@@ -16,6 +16,7 @@
 
 #include <fstream>
 #include <optional>
+#include <sstream>
 
 #include "starkware/algebra/utils/name_to_field.h"
 
@@ -51,6 +52,12 @@ void JsonValue::Write(const std::string& filename) const {
   file << value_;
 }
 
+std::string JsonValue::ToString() const {
+  std::ostringstream s;
+  s << value_;
+  return s.str();
+}
+
 bool JsonValue::operator==(const JsonValue& other) const { return value_ == other.value_; }
 
 bool JsonValue::operator!=(const JsonValue& other) const { return !(*this == other); }
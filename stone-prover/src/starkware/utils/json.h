@@ -56,6 +56,11 @@ class JsonValue {
 
   void Write(const std::string& filename) const;
 
+  /*
+    Returns the serialized JSON document.
+  */
+  std::string ToString() const;
+
   bool operator==(const JsonValue& other) const;
 
   bool operator!=(const JsonValue& other) const;
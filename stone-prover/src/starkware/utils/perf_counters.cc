@@ -0,0 +1,194 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/utils/perf_counters.h"
+
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+#include "glog/logging.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+DEFINE_bool(
+    perf_counters, false,
+    "Collect hardware performance counters (cycles, instructions, LLC, dTLB and branch misses) in "
+    "each ProfilingBlock, using perf_event_open.");
+
+namespace starkware {
+
+namespace {
+
+constexpr std::array<const char*, PerfCounters::kNumEvents> kEventNames = {
+    "cycles", "instructions", "LLC misses", "dTLB misses", "branch misses"};
+
+/*
+  Opens a counter of the given event for the calling thread. Returns -1 on failure.
+*/
+int OpenCounter(size_t event) {
+#ifdef __linux__
+  // Type and config of each event, ordered as PerfCounters::Event.
+  constexpr std::array<std::pair<uint32_t, uint64_t>, PerfCounters::kNumEvents> kEvents = {{
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+      {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+  }};
+
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = kEvents[event].first;
+  attr.config = kEvents[event].second;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(
+      SYS_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, /*group_fd=*/-1, /*flags=*/0));
+#else
+  (void)event;  // Unused.
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+
+/*
+  Returns the value of the counter, scaled by the fraction of the time it was running.
+*/
+uint64_t ReadCounter(int fd) {
+  // Value, time enabled, time running.
+  std::array<uint64_t, 3> data{};
+  if (read(fd, data.data(), sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) {
+    return 0;
+  }
+  if (data[1] == data[2]) {
+    return data[0];
+  }
+  return static_cast<uint64_t>(
+      static_cast<long double>(data[0]) * static_cast<long double>(data[1]) /
+      static_cast<long double>(data[2]));
+}
+
+}  // namespace
+
+PerfCounters::~PerfCounters() {
+  for (const auto& fds : thread_fds_) {
+    for (int fd : fds) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+}
+
+PerfCounters& PerfCounters::GetInstance() {
+  // Never destroyed, so that the counters remain valid while other static objects are destroyed.
+  static auto* instance = new PerfCounters();
+  return *instance;
+}
+
+void PerfCounters::AttachToCurrentThread() {
+  thread_local bool attached = false;
+  if (!FLAGS_perf_counters || attached) {
+    return;
+  }
+  attached = true;
+
+  std::array<int, kNumEvents> fds{};
+  int first_error = 0;
+  for (size_t event = 0; event < kNumEvents; ++event) {
+    fds[event] = OpenCounter(event);
+    if (fds[event] < 0 && first_error == 0) {
+      first_error = errno;
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  thread_fds_.push_back(fds);
+  for (size_t event = 0; event < kNumEvents; ++event) {
+    is_available_[event] = is_available_[event] || fds[event] >= 0;
+  }
+  if (first_error != 0 && !reported_unavailable_) {
+    reported_unavailable_ = true;
+    LOG(WARNING) << "Some hardware performance counters are unavailable: "
+                 << std::strerror(first_error) << ". Check /proc/sys/kernel/perf_event_paranoid.";
+  }
+}
+
+bool PerfCounters::IsAvailable() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (bool is_available : is_available_) {
+    if (is_available) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PerfCounters::IsAvailable(Event event) const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return is_available_.at(event);
+}
+
+PerfCounters::Values PerfCounters::Read() const {
+  Values values{};
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (const auto& fds : thread_fds_) {
+    for (size_t event = 0; event < kNumEvents; ++event) {
+      if (fds[event] >= 0) {
+        values[event] += ReadCounter(fds[event]);
+      }
+    }
+  }
+  return values;
+}
+
+PerfCounters::Values PerfCounters::Difference(const Values& start, const Values& end) {
+  Values delta{};
+  for (size_t event = 0; event < kNumEvents; ++event) {
+    // Scaled values of multiplexed counters are estimates, and may decrease slightly.
+    delta[event] = end[event] > start[event] ? end[event] - start[event] : 0;
+  }
+  return delta;
+}
+
+std::string PerfCounters::ToString(const Values& start, const Values& end) const {
+  const Values delta = Difference(start, end);
+  std::stringstream os;
+  bool first = true;
+  for (size_t event = 0; event < kNumEvents; ++event) {
+    if (!IsAvailable(static_cast<Event>(event))) {
+      continue;
+    }
+    os << (first ? "" : ", ") << kEventNames[event] << ": " << delta[event];
+    first = false;
+  }
+  const uint64_t cycles = delta[kCycles];
+  if (IsAvailable(kCycles) && IsAvailable(kInstructions) && cycles > 0) {
+    const uint64_t instructions = delta[kInstructions];
+    os << ", IPC: " << std::fixed << std::setprecision(2)
+       << static_cast<double>(instructions) / static_cast<double>(cycles);
+  }
+  return os.str();
+}
+
+}  // namespace starkware
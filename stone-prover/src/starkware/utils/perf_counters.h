@@ -0,0 +1,97 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#ifndef STARKWARE_UTILS_PERF_COUNTERS_H_
+#define STARKWARE_UTILS_PERF_COUNTERS_H_
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+DECLARE_bool(perf_counters);
+
+namespace starkware {
+
+/*
+  Hardware performance counters of the process, collected with the Linux perf_event_open system
+  call and enabled by --perf_counters.
+
+  Each thread that calls AttachToCurrentThread() (the TaskManager does so for all its threads) gets
+  its own set of counters, and Read() returns the sum over all of them. Counting is restricted to
+  user space, so it works with the default perf_event_paranoid setting.
+
+  When perf events are not available (no kernel support, a restrictive perf_event_paranoid or a
+  seccomp filter, as in many containers), or some of the events are not supported by the CPU, the
+  missing events are reported as unavailable and are omitted from ToString().
+*/
+class PerfCounters {
+ public:
+  enum Event { kCycles, kInstructions, kLlcMisses, kDtlbMisses, kBranchMisses, kNumEvents };
+  using Values = std::array<uint64_t, kNumEvents>;
+
+  ~PerfCounters();
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+  PerfCounters(PerfCounters&&) = delete;
+  PerfCounters& operator=(PerfCounters&&) = delete;
+
+  static PerfCounters& GetInstance();
+
+  /*
+    Starts counting the events of the calling thread. Does nothing if --perf_counters is false or if
+    the thread is already attached.
+  */
+  void AttachToCurrentThread();
+
+  /*
+    Returns true if at least one of the events is counted.
+  */
+  bool IsAvailable() const;
+
+  bool IsAvailable(Event event) const;
+
+  /*
+    Returns the values of the counters, summed over all the attached threads. Values are scaled to
+    compensate for the time a counter was not running, when the kernel multiplexes counters.
+  */
+  Values Read() const;
+
+  /*
+    Returns the number of events counted between two readings.
+  */
+  static Values Difference(const Values& start, const Values& end);
+
+  /*
+    Returns a human readable description of the difference between two readings, including the
+    derived instructions-per-cycle ratio.
+  */
+  std::string ToString(const Values& start, const Values& end) const;
+
+ private:
+  PerfCounters() = default;
+
+  mutable std::mutex mutex_;
+  // The file descriptors of the counters of each attached thread. -1 for unavailable events.
+  std::vector<std::array<int, kNumEvents>> thread_fds_;
+  std::array<bool, kNumEvents> is_available_{};
+  bool reported_unavailable_ = false;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_UTILS_PERF_COUNTERS_H_
@@ -0,0 +1,80 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/utils/perf_counters.h"
+
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace starkware {
+namespace {
+
+using testing::HasSubstr;
+
+/*
+  Runs a loop the compiler cannot remove.
+*/
+uint64_t DoWork() {
+  volatile uint64_t sum = 0;
+  for (uint64_t i = 0; i < 1000000; ++i) {
+    sum = sum + i * i;
+  }
+  return sum;
+}
+
+// Must run first, before any thread is attached.
+TEST(PerfCounters, DisabledByDefault) {
+  ASSERT_FALSE(FLAGS_perf_counters);
+  std::thread([] { PerfCounters::GetInstance().AttachToCurrentThread(); }).join();
+  EXPECT_FALSE(PerfCounters::GetInstance().IsAvailable());
+  const PerfCounters::Values values = PerfCounters::GetInstance().Read();
+  EXPECT_EQ(values, PerfCounters::Values{});
+  EXPECT_EQ(PerfCounters::GetInstance().ToString(values, values), "");
+}
+
+TEST(PerfCounters, CountInstructions) {
+  FLAGS_perf_counters = true;
+  PerfCounters& perf_counters = PerfCounters::GetInstance();
+  perf_counters.AttachToCurrentThread();
+  if (!perf_counters.IsAvailable(PerfCounters::kInstructions)) {
+    // Perf events are not available on this machine. Reading must still work.
+    const PerfCounters::Values values = perf_counters.Read();
+    EXPECT_EQ(values[PerfCounters::kInstructions], 0U);
+    FLAGS_perf_counters = false;
+    GTEST_SKIP() << "Instruction counter is unavailable.";
+  }
+
+  const PerfCounters::Values start = perf_counters.Read();
+  DoWork();
+  const PerfCounters::Values end = perf_counters.Read();
+  EXPECT_GT(end[PerfCounters::kInstructions], start[PerfCounters::kInstructions] + 1000000);
+  EXPECT_THAT(perf_counters.ToString(start, end), HasSubstr("instructions: "));
+
+  // Counters of other attached threads are added.
+  const PerfCounters::Values before_thread = perf_counters.Read();
+  std::thread([&perf_counters] {
+    perf_counters.AttachToCurrentThread();
+    DoWork();
+  }).join();
+  const PerfCounters::Values after_thread = perf_counters.Read();
+  EXPECT_GT(
+      after_thread[PerfCounters::kInstructions],
+      before_thread[PerfCounters::kInstructions] + 1000000);
+  FLAGS_perf_counters = false;
+}
+
+}  // namespace
+}  // namespace starkware
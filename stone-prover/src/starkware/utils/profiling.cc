@@ -23,6 +23,7 @@
 #include "glog/logging.h"
 
 #include "starkware/error_handling/error_handling.h"
+#include "starkware/utils/progress.h"
 #include "starkware/utils/stats.h"
 
 namespace starkware {
@@ -44,6 +45,17 @@ ProfilingBlock::ProfilingBlock(std::string description, int k_vlog)
     : start_time_(std::chrono::system_clock::now()),
       description_(std::move(description)),
       k_vlog_(k_vlog) {
+  if (ProgressReporter::IsEnabled()) {
+    ProgressReporter::GetInstance().EnterPhase(description_);
+    in_progress_phase_ = true;
+  }
+  if (FLAGS_perf_counters) {
+    PerfCounters& perf_counters = PerfCounters::GetInstance();
+    perf_counters.AttachToCurrentThread();
+    if (perf_counters.IsAvailable()) {
+      start_counters_ = perf_counters.Read();
+    }
+  }
   if (FLAGS_v < k_vlog_) {
     return;
   }
@@ -65,6 +77,20 @@ ProfilingBlock::~ProfilingBlock() {
 }
 
 void ProfilingBlock::CloseBlock() {
+  if (in_progress_phase_) {
+    ProgressReporter::GetInstance().ExitPhase(description_);
+    in_progress_phase_ = false;
+  }
+  std::optional<PerfCounters::Values> perf_counters;
+  if (start_counters_.has_value()) {
+    perf_counters =
+        PerfCounters::Difference(*start_counters_, PerfCounters::GetInstance().Read());
+    start_counters_.reset();
+  }
+  if (perf_counters.has_value() && FLAGS_v <= k_vlog_) {
+    // With a higher verbosity, the stats are saved and logged below.
+    SaveStats(description_, perf_counters);
+  }
   if (FLAGS_v < k_vlog_) {
     return;
   }
@@ -83,8 +109,12 @@ void ProfilingBlock::CloseBlock() {
   PrintDuration(&os, now - start_time_);
 
   VLOG(k_vlog_) << os.str();
+  if (perf_counters.has_value()) {
+    VLOG(k_vlog_) << description_ << " counters: "
+                  << PerfCounters::GetInstance().ToString(PerfCounters::Values{}, *perf_counters);
+  }
   if (FLAGS_v > k_vlog_) {
-    std::string stats_to_print = SaveStats(description_);
+    std::string stats_to_print = SaveStats(description_, perf_counters);
     VLOG(k_vlog_) << stats_to_print;
   }
   closed_ = true;
@@ -16,15 +16,22 @@
 #define STARKWARE_UTILS_PROFILING_H_
 
 #include <chrono>
+#include <optional>
 #include <string>
 
+#include "starkware/utils/perf_counters.h"
+
 namespace starkware {
 
 /*
   This class is used to annotate different stages in the prover.
   The class can print out the current stage the prover is located in to assist in profiling.
 
-  Pass the cmd line args -v=1 --logtostderr too see the logging.
+  Pass the cmd line args -v=1 --logtostderr too see the logging. With --perf_counters, the
+  hardware performance counters of the block (see PerfCounters) are recorded by SaveStats(),
+  regardless of the verbosity, and are logged as well. With
+  --status_file, open blocks are reported as the current phase of the proof (see
+  ProgressReporter), regardless of the verbosity.
 
   The class can be used in scoped RAII-style:
 
@@ -65,6 +72,11 @@ class ProfilingBlock {
   const std::string description_;
   const int k_vlog_;
   bool closed_ = false;
+  // True while the block is reported to the ProgressReporter.
+  bool in_progress_phase_ = false;
+  // Counter values at the start of the block, when --perf_counters is set. Reset when the counters
+  // of the block are recorded.
+  std::optional<PerfCounters::Values> start_counters_;
 };
 
 }  // namespace starkware
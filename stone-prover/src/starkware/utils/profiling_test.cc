@@ -15,6 +15,8 @@
 #include "starkware/utils/profiling.h"
 #include "starkware/utils/stats.h"
 
+#include <cstdint>
+
 #include "glog/logging.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -35,5 +37,29 @@ TEST(Profiling, DoubleClose) {
   FLAGS_v = 0;
 }
 
+TEST(Profiling, PerfCountersRegardlessOfVerbosity) {
+  FLAGS_v = 0;
+  FLAGS_perf_counters = true;
+  PerfCounters::GetInstance().AttachToCurrentThread();
+  if (!PerfCounters::GetInstance().IsAvailable(PerfCounters::kInstructions)) {
+    FLAGS_perf_counters = false;
+    GTEST_SKIP() << "Instruction counter is unavailable.";
+  }
+
+  {
+    ProfilingBlock profiling_block("counted block");
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < 1000000; ++i) {
+      sum = sum + i * i;
+    }
+  }
+  ASSERT_FALSE(GetStats().empty());
+  const PerformanceStats& stats = GetStats().back();
+  EXPECT_EQ(stats.name, "counted block");
+  ASSERT_TRUE(stats.perf_counters.has_value());
+  EXPECT_GT((*stats.perf_counters)[PerfCounters::kInstructions], 1000000U);
+  FLAGS_perf_counters = false;
+}
+
 }  // namespace
 }  // namespace starkware
@@ -0,0 +1,293 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/utils/progress.h"
+
+#include <sys/resource.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <utility>
+
+#include "glog/logging.h"
+
+#include "starkware/utils/task_manager.h"
+
+DEFINE_string(
+    status_file, "",
+    "Optional. A file to which the progress of the proof is periodically written, in the "
+    "Prometheus text format.");
+DEFINE_uint64(status_interval_ms, 1000, "The interval between writes of --status_file.");
+
+namespace starkware {
+
+namespace {
+
+/*
+  Escapes a Prometheus label value.
+*/
+std::string EscapeLabel(const std::string& value) {
+  std::string escaped;
+  for (char c : value) {
+    if (c == '\\' || c == '"') {
+      escaped += '\\';
+      escaped += c;
+    } else if (c == '\n') {
+      escaped += "\\n";
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+/*
+  Returns the user and system CPU time of all the threads of the process.
+*/
+double ProcessCpuSeconds() {
+  struct rusage usage {};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+         static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+uint64_t ResidentMemoryBytes() {
+  std::ifstream statm("/proc/self/statm");
+  uint64_t allocated_pages = 0;
+  uint64_t resident_pages = 0;
+  statm >> allocated_pages >> resident_pages;
+  return resident_pages * static_cast<uint64_t>(sysconf(_SC_PAGE_SIZE));
+}
+
+void WriteMetric(
+    std::ostream* os, const std::string& name, const std::string& help, double value,
+    const std::string& labels = "") {
+  *os << "# HELP " << name << " " << help << "\n";
+  *os << "# TYPE " << name << " gauge\n";
+  *os << name << labels << " " << value << "\n";
+}
+
+}  // namespace
+
+ProgressReporter::~ProgressReporter() { StopWriter(); }
+
+ProgressReporter& ProgressReporter::GetInstance() {
+  // Never destroyed, so that ProfilingBlocks of static objects may still report.
+  static auto* instance = new ProgressReporter();
+  return *instance;
+}
+
+void ProgressReporter::StartProof() {
+  if (!IsEnabled()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  StartWriterLocked();
+  start_time_ = Clock::now();
+  stage_ = "Starting";
+  stage_start_fraction_ = stage_end_fraction_ = stage_fraction_done_ = 0;
+  step_name_.clear();
+  step_n_done_ = 0;
+  step_n_total_ = 0;
+  done_ = false;
+  OnProgressLocked();
+}
+
+void ProgressReporter::StartStage(
+    const std::string& name, double start_fraction, double end_fraction) {
+  if (!IsEnabled()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  StartWriterLocked();
+  stage_ = name;
+  stage_start_fraction_ = start_fraction;
+  stage_end_fraction_ = end_fraction;
+  stage_fraction_done_ = 0;
+  step_name_.clear();
+  step_n_done_ = 0;
+  step_n_total_ = 0;
+  OnProgressLocked();
+}
+
+void ProgressReporter::Finish() {
+  if (!IsEnabled()) {
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_ = true;
+    stage_ = "Done";
+    stage_start_fraction_ = stage_end_fraction_ = 1;
+    OnProgressLocked();
+  }
+  WriteStatusFile();
+}
+
+void ProgressReporter::EnterPhase(const std::string& name) {
+  if (!IsEnabled()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  StartWriterLocked();
+  phases_.push_back(name);
+  OnProgressLocked();
+}
+
+void ProgressReporter::ExitPhase(const std::string& name) {
+  if (!IsEnabled()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  // Blocks of different threads may interleave, so remove the innermost phase with this name.
+  auto it = std::find(phases_.rbegin(), phases_.rend(), name);
+  if (it != phases_.rend()) {
+    phases_.erase(std::next(it).base());
+  }
+  OnProgressLocked();
+}
+
+void ProgressReporter::ReportStep(const std::string& name, uint64_t n_done, uint64_t n_total) {
+  if (!IsEnabled() || n_total == 0) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  step_name_ = name;
+  step_n_done_ = n_done;
+  step_n_total_ = n_total;
+  // A stage may consist of several sequences of steps, keep the fraction monotone.
+  stage_fraction_done_ = std::max(
+      stage_fraction_done_, static_cast<double>(n_done) / static_cast<double>(n_total));
+  OnProgressLocked();
+}
+
+double ProgressReporter::ProgressFractionLocked() const {
+  return stage_start_fraction_ +
+         (stage_end_fraction_ - stage_start_fraction_) * std::min(stage_fraction_done_, 1.0);
+}
+
+std::string ProgressReporter::GetMetrics() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const Clock::time_point now = Clock::now();
+  const double elapsed = std::chrono::duration<double>(now - start_time_).count();
+  const double fraction = ProgressFractionLocked();
+
+  // Utilization of the TaskManager threads since the previous sample.
+  const double cpu_seconds = ProcessCpuSeconds();
+  const double sample_seconds = std::chrono::duration<double>(now - previous_sample_time_).count();
+  const double utilization =
+      sample_seconds > 0 ? (cpu_seconds - previous_cpu_seconds_) / sample_seconds / FLAGS_n_threads
+                         : 0;
+  previous_sample_time_ = now;
+  previous_cpu_seconds_ = cpu_seconds;
+
+  std::string phase;
+  for (const std::string& name : phases_) {
+    phase += (phase.empty() ? "" : " / ") + name;
+  }
+
+  std::stringstream os;
+  os << std::fixed << std::setprecision(3);
+  WriteMetric(
+      &os, "stone_prover_stage", "The current stage of the proof.", 1,
+      "{stage=\"" + EscapeLabel(stage_) + "\",phase=\"" + EscapeLabel(phase) + "\"}");
+  WriteMetric(
+      &os, "stone_prover_step", "The number of steps done in the current stage.",
+      static_cast<double>(step_n_done_), "{step=\"" + EscapeLabel(step_name_) + "\"}");
+  WriteMetric(
+      &os, "stone_prover_steps", "The total number of steps in the current stage.",
+      static_cast<double>(step_n_total_), "{step=\"" + EscapeLabel(step_name_) + "\"}");
+  WriteMetric(
+      &os, "stone_prover_progress_ratio", "Estimated fraction of the proof that is complete.",
+      fraction);
+  WriteMetric(&os, "stone_prover_elapsed_seconds", "Time since the prover started.", elapsed);
+  if (fraction > 0) {
+    WriteMetric(
+        &os, "stone_prover_eta_seconds", "Estimated time until the proof is complete.",
+        elapsed * (1 - fraction) / fraction);
+  }
+  WriteMetric(
+      &os, "stone_prover_last_progress_timestamp_seconds",
+      "Unix time of the last change of stage, phase or step.",
+      std::chrono::duration<double>(last_progress_.time_since_epoch()).count());
+  WriteMetric(&os, "stone_prover_done", "1 if the proof is complete.", done_ ? 1 : 0);
+  WriteMetric(
+      &os, "stone_prover_resident_memory_bytes", "Resident memory of the prover.",
+      static_cast<double>(ResidentMemoryBytes()));
+  WriteMetric(
+      &os, "stone_prover_threads", "Number of threads used to execute tasks.",
+      static_cast<double>(FLAGS_n_threads));
+  WriteMetric(
+      &os, "stone_prover_thread_utilization_ratio",
+      "CPU time of the process divided by the wall time of all the threads, since the previous "
+      "write.",
+      utilization);
+  return os.str();
+}
+
+void ProgressReporter::WriteStatusFile() {
+  if (!IsEnabled()) {
+    return;
+  }
+  std::unique_lock<std::mutex> write_lock(write_mutex_);
+  const std::string temp_file = FLAGS_status_file + ".tmp";
+  {
+    std::ofstream file(temp_file, std::ios::trunc);
+    file << GetMetrics();
+    if (!file) {
+      LOG(ERROR) << "Failed to write the status file " << temp_file;
+      return;
+    }
+  }
+  if (std::rename(temp_file.c_str(), FLAGS_status_file.c_str()) != 0) {
+    LOG(ERROR) << "Failed to rename " << temp_file << " to " << FLAGS_status_file;
+  }
+}
+
+void ProgressReporter::StopWriter() {
+  std::thread writer;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // The running writer thread exits once it sees that its generation is no longer current.
+    writer_generation_++;
+    writer = std::move(writer_);
+  }
+  stop_cv_.notify_all();
+  if (writer.joinable()) {
+    writer.join();
+  }
+}
+
+void ProgressReporter::StartWriterLocked() {
+  if (writer_.joinable()) {
+    return;
+  }
+  writer_ = std::thread([this, generation = writer_generation_]() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (generation == writer_generation_) {
+      lock.unlock();
+      WriteStatusFile();
+      lock.lock();
+      stop_cv_.wait_for(lock, std::chrono::milliseconds(FLAGS_status_interval_ms), [&]() {
+        return generation != writer_generation_;
+      });
+    }
+  });
+}
+
+}  // namespace starkware
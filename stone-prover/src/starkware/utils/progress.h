@@ -0,0 +1,145 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#ifndef STARKWARE_UTILS_PROGRESS_H_
+#define STARKWARE_UTILS_PROGRESS_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+DECLARE_string(status_file);
+DECLARE_uint64(status_interval_ms);
+
+namespace starkware {
+
+/*
+  Tracks the progress of a running proof, and periodically rewrites --status_file with it.
+
+  The file is written in the Prometheus text exposition format, so it can be served as-is at a
+  /metrics endpoint (e.g. by the node exporter textfile collector) or parsed by a scheduler. It is
+  rewritten atomically (write and rename) every --status_interval_ms milliseconds, and contains:
+  the current phase (the stack of open ProfilingBlocks), the current step (e.g. LDE coset k of n),
+  the estimated fraction of the proof that is complete and the remaining time, the time of the
+  last progress (to detect stalls), the resident memory and the CPU utilization of the threads.
+
+  The fraction complete is an estimate: the prover declares stages with their expected share of
+  the total time (see StartStage()), and steps reported within a stage advance it linearly.
+
+  All the methods do nothing if --status_file is empty.
+*/
+class ProgressReporter {
+ public:
+  ~ProgressReporter();
+  ProgressReporter(const ProgressReporter&) = delete;
+  ProgressReporter& operator=(const ProgressReporter&) = delete;
+  ProgressReporter(ProgressReporter&&) = delete;
+  ProgressReporter& operator=(ProgressReporter&&) = delete;
+
+  static ProgressReporter& GetInstance();
+
+  static bool IsEnabled() { return !FLAGS_status_file.empty(); }
+
+  /*
+    Resets the status at the start of a proof: the elapsed time, the stage and the done flag. Must
+    be called at the start of every proof of a long-running process (e.g. --serve).
+  */
+  void StartProof();
+
+  /*
+    Starts a stage of the proof, which spans the given fractions of the total proving time.
+  */
+  void StartStage(const std::string& name, double start_fraction, double end_fraction);
+
+  /*
+    Marks the proof as done and writes the status file immediately.
+  */
+  void Finish();
+
+  /*
+    Called by ProfilingBlock when a block is opened and closed.
+  */
+  void EnterPhase(const std::string& name);
+  void ExitPhase(const std::string& name);
+
+  /*
+    Reports that n_done out of n_total steps of the given kind are done in the current stage.
+  */
+  void ReportStep(const std::string& name, uint64_t n_done, uint64_t n_total);
+
+  /*
+    Returns the current status in the Prometheus text format.
+  */
+  std::string GetMetrics();
+
+  /*
+    Writes the status file immediately.
+  */
+  void WriteStatusFile();
+
+  /*
+    Stops the thread that periodically writes the status file and waits for it to exit. The thread
+    is started again on the next StartProof(), StartStage() or EnterPhase(). Call this before
+    changing --status_file.
+  */
+  void StopWriter();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  ProgressReporter() = default;
+
+  /*
+    Starts the thread that periodically writes the status file, if not started yet. Must be called
+    with mutex_ held.
+  */
+  void StartWriterLocked();
+  void OnProgressLocked() { last_progress_ = std::chrono::system_clock::now(); }
+  double ProgressFractionLocked() const;
+
+  std::mutex mutex_;
+  // Serializes WriteStatusFile() calls of the writer thread and of Finish(), which use the same
+  // temporary file.
+  std::mutex write_mutex_;
+  std::condition_variable stop_cv_;
+  std::thread writer_;
+  // Incremented by StopWriter() to stop the current writer thread.
+  uint64_t writer_generation_ = 0;
+
+  Clock::time_point start_time_ = Clock::now();
+  std::chrono::system_clock::time_point last_progress_ = std::chrono::system_clock::now();
+  std::vector<std::string> phases_;
+  std::string stage_ = "Starting";
+  double stage_start_fraction_ = 0;
+  double stage_end_fraction_ = 0;
+  double stage_fraction_done_ = 0;
+  std::string step_name_;
+  uint64_t step_n_done_ = 0;
+  uint64_t step_n_total_ = 0;
+  bool done_ = false;
+
+  // CPU time and wall time at the previous call to GetMetrics(), to compute utilization.
+  Clock::time_point previous_sample_time_ = Clock::now();
+  double previous_cpu_seconds_ = 0;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_UTILS_PROGRESS_H_
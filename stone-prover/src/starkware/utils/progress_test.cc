@@ -0,0 +1,116 @@
+// Copyright 2023 StarkWare Industries Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.starkware.co/open-source-license/
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "starkware/utils/progress.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace starkware {
+namespace {
+
+using testing::HasSubstr;
+using testing::Not;
+
+class ProgressReporterTest : public ::testing::Test {
+ public:
+  ProgressReporterTest() {
+    // Only the writes of the test itself, besides the first write of the writer thread.
+    FLAGS_status_interval_ms = 3600 * 1000;
+    FLAGS_status_file = ::testing::TempDir() + "/progress_test_status";
+  }
+  ~ProgressReporterTest() override {
+    // The writer thread reads the flag, so stop it before changing the flag.
+    ProgressReporter::GetInstance().StopWriter();
+    std::remove(FLAGS_status_file.c_str());
+    FLAGS_status_file = "";
+  }
+
+  static std::string ReadStatusFile() {
+    std::ifstream file(FLAGS_status_file);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+  }
+};
+
+TEST_F(ProgressReporterTest, StagesPhasesAndSteps) {
+  ProgressReporter& progress = ProgressReporter::GetInstance();
+  progress.StartStage("Commit on trace", 0.2, 0.6);
+  progress.EnterPhase("Commit on trace");
+  progress.EnterPhase("LDE");
+  progress.ReportStep("LDE coset", 3, 4);
+
+  progress.WriteStatusFile();
+  const std::string status = ReadStatusFile();
+  EXPECT_THAT(
+      status, HasSubstr("stone_prover_stage{stage=\"Commit on trace\",phase=\"Commit on trace / "
+                        "LDE\"} 1.000\n"));
+  EXPECT_THAT(status, HasSubstr("stone_prover_step{step=\"LDE coset\"} 3.000\n"));
+  EXPECT_THAT(status, HasSubstr("stone_prover_steps{step=\"LDE coset\"} 4.000\n"));
+  // 0.2 + (0.6 - 0.2) * 3 / 4.
+  EXPECT_THAT(status, HasSubstr("stone_prover_progress_ratio 0.500\n"));
+  EXPECT_THAT(status, HasSubstr("stone_prover_eta_seconds "));
+  EXPECT_THAT(status, HasSubstr("stone_prover_done 0.000\n"));
+  EXPECT_THAT(status, HasSubstr("# TYPE stone_prover_resident_memory_bytes gauge\n"));
+
+  // Progress within a stage never goes back.
+  progress.ExitPhase("LDE");
+  progress.ReportStep("Other step", 1, 4);
+  EXPECT_THAT(progress.GetMetrics(), HasSubstr("stone_prover_progress_ratio 0.500\n"));
+  EXPECT_THAT(progress.GetMetrics(), HasSubstr("phase=\"Commit on trace\""));
+
+  progress.ExitPhase("Commit on trace");
+  progress.Finish();
+  const std::string final_status = ReadStatusFile();
+  EXPECT_THAT(final_status, HasSubstr("stage=\"Done\""));
+  EXPECT_THAT(final_status, HasSubstr("stone_prover_progress_ratio 1.000\n"));
+  EXPECT_THAT(final_status, HasSubstr("stone_prover_done 1.000\n"));
+}
+
+TEST_F(ProgressReporterTest, StartProofResetsTheStatus) {
+  ProgressReporter& progress = ProgressReporter::GetInstance();
+  progress.StartStage("FRI", 0.7, 1.0);
+  progress.Finish();
+  EXPECT_THAT(progress.GetMetrics(), HasSubstr("stone_prover_done 1.000\n"));
+
+  progress.StartProof();
+  const std::string status = progress.GetMetrics();
+  EXPECT_THAT(status, HasSubstr("stone_prover_done 0.000\n"));
+  EXPECT_THAT(status, HasSubstr("stage=\"Starting\""));
+  EXPECT_THAT(status, HasSubstr("stone_prover_progress_ratio 0.000\n"));
+  // The elapsed time is measured from the start of this proof.
+  EXPECT_THAT(status, HasSubstr("stone_prover_elapsed_seconds 0.0"));
+}
+
+TEST_F(ProgressReporterTest, EscapeLabels) {
+  ProgressReporter& progress = ProgressReporter::GetInstance();
+  progress.StartStage("A \"quoted\" stage", 0, 1);
+  EXPECT_THAT(progress.GetMetrics(), HasSubstr("stage=\"A \\\"quoted\\\" stage\""));
+}
+
+TEST(ProgressReporter, Disabled) {
+  ASSERT_TRUE(FLAGS_status_file.empty());
+  ProgressReporter& progress = ProgressReporter::GetInstance();
+  progress.StartStage("Ignored stage", 0, 1);
+  EXPECT_THAT(progress.GetMetrics(), Not(HasSubstr("Ignored stage")));
+}
+
+}  // namespace
+}  // namespace starkware
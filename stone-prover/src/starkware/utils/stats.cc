@@ -14,6 +14,7 @@
 
 
 
+#include <sys/resource.h>
 #include <unistd.h>
 #include <chrono>
 #include <fstream>
@@ -26,6 +27,7 @@
 #include "glog/logging.h"
 
 #include "starkware/error_handling/error_handling.h"
+#include "starkware/utils/huge_page_arena.h"
 #include "starkware/utils/profiling.h"
 #include "starkware/utils/stats.h"
 
@@ -44,12 +46,19 @@ std::string GetLineToPrint(PerformanceStats stats) {
   os << stats.name << ", ";
   os << "RM:" << stats.resident_memory_usage_mb << "mb, ";
   os << "AM:" << stats.allocated_memory_usage_mb << "mb, ";
+  os << "PRM:" << stats.peak_resident_memory_usage_mb << "mb, ";
+  os << "HP:" << stats.huge_page_arena_usage_mb << "mb, ";
+  os << "PF:" << stats.minor_page_faults << "/" << stats.major_page_faults << ", ";
   os << "T:" << stats.duration.count() << "sec";
+  if (stats.perf_counters.has_value()) {
+    os << ", " << PerfCounters::GetInstance().ToString(PerfCounters::Values{}, *stats.perf_counters);
+  }
   os << std::endl;
   return os.str();
 }
-std::string SaveStats(std::string name) {
-  if (FLAGS_v < kVlog) {
+std::string SaveStats(
+    std::string name, const std::optional<PerfCounters::Values>& perf_counters) {
+  if (FLAGS_v < kVlog && !perf_counters.has_value()) {
     return "";
   }
   auto now = std::chrono::system_clock::now();
@@ -62,18 +71,30 @@ std::string SaveStats(std::string name) {
   std::istringstream iss(str);
   size_t resident_memory_usage_pages, allocated_memory_usage_pages;
   iss >> allocated_memory_usage_pages >> resident_memory_usage_pages;
+  struct rusage usage {};
+  getrusage(RUSAGE_SELF, &usage);
+  const size_t huge_page_arena_usage_bytes = HugePageArena::GetInstance().GetStats().mapped_bytes;
   PerformanceStats stats{/*duration=*/now - program_start,
                          /*resident_memory_usage_mb=*/resident_memory_usage_pages *
                              sysconf(_SC_PAGE_SIZE) / (1024 * 1024),
                          /*allocated_memory_usage_mb=*/allocated_memory_usage_pages *
                              sysconf(_SC_PAGE_SIZE) / (1024 * 1024),
-                         /*name=*/std::move(name)};
+                         // ru_maxrss is in kilobytes.
+                         /*peak_resident_memory_usage_mb=*/static_cast<size_t>(usage.ru_maxrss) /
+                             1024,
+                         /*huge_page_arena_usage_mb=*/huge_page_arena_usage_bytes / (1024 * 1024),
+                         /*minor_page_faults=*/static_cast<size_t>(usage.ru_minflt),
+                         /*major_page_faults=*/static_cast<size_t>(usage.ru_majflt),
+                         /*name=*/std::move(name),
+                         /*perf_counters=*/perf_counters};
   stats_vector.push_back(stats);
   return GetLineToPrint(stats);
 }
 
+const std::vector<PerformanceStats>& GetStats() { return stats_vector; }
+
 void WriteStats() {
-  if (FLAGS_v < kVlog) {
+  if (stats_vector.empty()) {
     return;
   }
   std::stringstream os;
@@ -81,8 +102,8 @@ void WriteStats() {
   for (auto& stats : stats_vector) {
     os << GetLineToPrint(stats);
   }
-  // if --v>=kVlog, it will print.
-  VLOG(kVlog) << os.str();
+  // Stats are only recorded with --v>=kVlog or --perf_counters.
+  LOG(INFO) << os.str();
 }
 
 }  // namespace starkware
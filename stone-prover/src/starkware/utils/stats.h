@@ -16,7 +16,11 @@
 #define STARKWARE_UTILS_STATS_H_
 
 #include <chrono>
+#include <optional>
 #include <string>
+#include <vector>
+
+#include "starkware/utils/perf_counters.h"
 
 namespace starkware {
 
@@ -24,10 +28,31 @@ struct PerformanceStats {
   std::chrono::duration<double> duration;
   size_t resident_memory_usage_mb;
   size_t allocated_memory_usage_mb;
+  size_t peak_resident_memory_usage_mb;
+  // Memory mapped by the HugePageArena.
+  size_t huge_page_arena_usage_mb;
+  size_t minor_page_faults;
+  size_t major_page_faults;
   std::string name;
+  // The hardware performance counters of the block, see ProfilingBlock.
+  std::optional<PerfCounters::Values> perf_counters;
 };
 
-std::string SaveStats(std::string name);
+/*
+  Records the stats of the process at the end of the block name, and returns them as a line of
+  text. Stats are recorded with --v>=2, or when perf_counters (the counters of the block) are given.
+*/
+std::string SaveStats(
+    std::string name, const std::optional<PerfCounters::Values>& perf_counters = std::nullopt);
+
+/*
+  Returns the stats recorded by SaveStats().
+*/
+const std::vector<PerformanceStats>& GetStats();
+
+/*
+  Logs all the recorded stats.
+*/
 void WriteStats();
 
 }  // namespace starkware
@@ -14,12 +14,16 @@
 
 #include "starkware/utils/stats.h"
 
+#include <cstddef>
+#include <string>
 #include <vector>
 
+#include "glog/logging.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 #include "starkware/error_handling/test_utils.h"
+#include "starkware/utils/huge_page_arena.h"
 
 namespace starkware {
 namespace {
@@ -41,5 +45,39 @@ TEST(Stats, AttemptToSaveAndPrintStats) {
   WriteStats();
 }
 
+TEST(Stats, ReportsHugePageArenaUsage) {
+  // Stats are only collected with --v=2.
+  const int v_before = FLAGS_v;
+  FLAGS_v = 2;
+  FLAGS_huge_page_arena = true;
+  const size_t size_mb = 16;
+  {
+    HugePageVector<std::byte> buffer(size_mb * 1024 * 1024);
+    // The printed line contains "HP:<n>mb", where n is the memory mapped by the arena.
+    const std::string line = SaveStats("Huge page arena block");
+    const size_t pos = line.find("HP:");
+    ASSERT_NE(pos, std::string::npos);
+    EXPECT_GE(std::stoul(line.substr(pos + 3)), size_mb);
+  }
+  HugePageArena::GetInstance().ReleaseCachedBuffers();
+  FLAGS_huge_page_arena = false;
+  FLAGS_v = v_before;
+}
+
+TEST(Stats, RecordsPerfCountersRegardlessOfVerbosity) {
+  const int v_before = FLAGS_v;
+  FLAGS_v = 0;
+  const size_t n_stats = GetStats().size();
+  EXPECT_EQ(SaveStats("Block without counters"), "");
+  EXPECT_EQ(GetStats().size(), n_stats);
+
+  const PerfCounters::Values perf_counters = {1, 2, 3, 4, 5};
+  EXPECT_NE(SaveStats("Block with counters", perf_counters), "");
+  ASSERT_EQ(GetStats().size(), n_stats + 1);
+  EXPECT_EQ(GetStats().back().name, "Block with counters");
+  EXPECT_EQ(GetStats().back().perf_counters, perf_counters);
+  FLAGS_v = v_before;
+}
+
 }  // namespace
 }  // namespace starkware
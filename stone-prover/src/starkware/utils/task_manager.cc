@@ -20,6 +20,7 @@
 #include "glog/logging.h"
 
 #include "starkware/math/math.h"
+#include "starkware/utils/perf_counters.h"
 
 #ifdef __EMSCRIPTEN__
 DEFINE_uint32(n_threads, 1, "Number of threads to use.");
@@ -36,9 +37,11 @@ TaskManager::TaskManager(const size_t n_threads) {
 #endif
 
   SetWorkerIdForCurrentThread(0);
+  PerfCounters::GetInstance().AttachToCurrentThread();
   for (size_t i = 0; i < n_threads - 1; i++) {
     workers_.emplace_back([this, id = i + 1]() {
       SetWorkerIdForCurrentThread(id);
+      PerfCounters::GetInstance().AttachToCurrentThread();
       TaskRunner(&new_pending_task_, &continue_running_);
     });
   }